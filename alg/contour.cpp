@@ -19,11 +19,16 @@
 #include "contour_generator.h"
 #include "segment_merger.h"
 #include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
 
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
@@ -218,6 +223,313 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/*                       GDALContourLineCollector                       */
+/************************************************************************/
+
+// Receives the lines of the segment merger of a strip, in the
+// multi-threaded mode.
+struct GDALContourLineCollector
+{
+    struct Line
+    {
+        double dfLevel = 0;
+        marching_squares::LineString ls{};
+        bool bClosed = false;
+    };
+
+    std::vector<Line> aoLines{};
+
+    void addLine(double level, marching_squares::LineString &ls, bool closed)
+    {
+        // Note: rings of skipped levels are emitted empty, and must be
+        // forwarded as they are, as they still define a level range.
+        aoLines.emplace_back();
+        aoLines.back().dfLevel = level;
+        aoLines.back().ls.swap(ls);
+        aoLines.back().bClosed = closed;
+    }
+};
+
+struct GDALContourStrip
+{
+    int nYOff = 0;
+    int nLines = 0;
+
+    // Values of the line above the strip (if nYOff > 0), then of its lines.
+    std::vector<double> adfData{};
+
+    GDALContourLineCollector oCollector{};
+
+    bool bOK = false;
+    std::atomic<bool> bDone{false};
+};
+
+/************************************************************************/
+/*                        GDALContourStitchLines()                      */
+/************************************************************************/
+
+// Join the pieces of lines of a level that have been cut at strip boundaries
+// by their end points, and send the resulting lines to oLineWriter.
+template <typename LineWriter>
+static void
+GDALContourStitchLines(double dfLevel,
+                       std::vector<marching_squares::LineString> &aoPieces,
+                       LineWriter &oLineWriter)
+{
+    using marching_squares::LineString;
+    using marching_squares::Point;
+
+    const auto Key = [](const Point &pt) { return std::make_pair(pt.x, pt.y); };
+    std::multimap<std::pair<double, double>, size_t> oMapEndPoints;
+    for (size_t i = 0; i < aoPieces.size(); ++i)
+    {
+        oMapEndPoints.emplace(Key(aoPieces[i].front()), i);
+        oMapEndPoints.emplace(Key(aoPieces[i].back()), i);
+    }
+    std::vector<bool> abUsed(aoPieces.size());
+
+    // Return an unused piece having pt as an end point, or -1.
+    const auto FindPiece = [&oMapEndPoints, &abUsed, &Key](const Point &pt)
+    {
+        const auto oRange = oMapEndPoints.equal_range(Key(pt));
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
+        {
+            if (!abUsed[oIter->second])
+                return oIter->second;
+        }
+        return static_cast<size_t>(-1);
+    };
+
+    for (size_t i = 0; i < aoPieces.size(); ++i)
+    {
+        if (abUsed[i])
+            continue;
+        abUsed[i] = true;
+        LineString ls;
+        ls.swap(aoPieces[i]);
+
+        // Extend the line at its end, then at its start.
+        for (const bool bAtEnd : {true, false})
+        {
+            while (!(ls.front() == ls.back()))
+            {
+                const Point pt = bAtEnd ? ls.back() : ls.front();
+                const size_t j = FindPiece(pt);
+                if (j == static_cast<size_t>(-1))
+                    break;
+                abUsed[j] = true;
+                LineString &other = aoPieces[j];
+                if (bAtEnd)
+                {
+                    if (!(other.front() == pt))
+                        other.reverse();
+                    ls.pop_back();
+                    ls.splice(ls.end(), other);
+                }
+                else
+                {
+                    if (!(other.back() == pt))
+                        other.reverse();
+                    ls.pop_front();
+                    ls.splice(ls.begin(), other);
+                }
+            }
+        }
+
+        oLineWriter.addLine(dfLevel, ls, ls.front() == ls.back());
+    }
+}
+
+/************************************************************************/
+/*                  GDALContourGenerateMultiThreaded()                  */
+/************************************************************************/
+
+// Same algorithm as the single-threaded code of GDALContourGenerateEx(),
+// with the raster processed by horizontal strips, concurrently by nThreads
+// threads of the global thread pool. Strips are read by the calling thread.
+//
+// The squares of each strip are processed and their segments merged into
+// lines in a worker thread, with the line above the strip as the previous
+// line of its first line, so that the segments are the same as with the
+// single-threaded algorithm. Lines that do not touch a strip boundary are
+// complete, and are sent to oLineWriter by the calling thread as soon as the
+// strip is done. The pieces of the other lines are joined by their end
+// points once all strips are processed.
+template <typename LineWriter>
+static bool GDALContourGenerateMultiThreaded(
+    GDALRasterBandH hBand, bool bUseNoData, double dfNoDataValue,
+    const marching_squares::FixedLevelRangeIterator &oLevels, bool bPolygonize,
+    const std::vector<int> &anSkipLevels, LineWriter &oLineWriter,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+
+    // Enough strips to balance the load between threads, but strips not
+    // larger than needed, to limit memory usage.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const int nMaxStripLines = static_cast<int>(std::max<size_t>(
+        1, MAX_STRIP_BYTES / (static_cast<size_t>(nXSize) * sizeof(double))));
+    const int nStripLines =
+        std::max(1, std::min(nMaxStripLines,
+                             (nYSize + 4 * nThreads - 1) / (4 * nThreads)));
+    const int nStrips = (nYSize + nStripLines - 1) / nStripLines;
+
+    // Strips being computed, and the ones being read or consumed.
+    std::vector<GDALContourStrip> asStrips(2 * nThreads);
+
+    const auto ReadStrip =
+        [hBand, nXSize, nYSize, nStripLines](GDALContourStrip &sStrip,
+                                             int iStrip)
+    {
+        sStrip.nYOff = iStrip * nStripLines;
+        sStrip.nLines = std::min(nStripLines, nYSize - sStrip.nYOff);
+        const int nReadYOff = std::max(0, sStrip.nYOff - 1);
+        const int nReadLines = sStrip.nYOff + sStrip.nLines - nReadYOff;
+        try
+        {
+            sStrip.adfData.resize(static_cast<size_t>(nXSize) * nReadLines);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory allocating strip buffer");
+            return false;
+        }
+        if (GDALRasterIO(hBand, GF_Read, 0, nReadYOff, nXSize, nReadLines,
+                         sStrip.adfData.data(), nXSize, nReadLines,
+                         GDT_Float64, 0, 0) != CE_None)
+        {
+            CPLDebug("CONTOUR", "failed fetch %d %d", nReadYOff, nXSize);
+            return false;
+        }
+        return true;
+    };
+
+    const auto ComputeStrip = [&oLevels, &anSkipLevels, bUseNoData,
+                               dfNoDataValue, bPolygonize, nXSize,
+                               nYSize](GDALContourStrip &sStrip)
+    {
+        try
+        {
+            FixedLevelRangeIterator oStripLevels(oLevels);
+            SegmentMerger<GDALContourLineCollector, FixedLevelRangeIterator>
+                oMerger(sStrip.oCollector, oStripLevels, bPolygonize);
+            if (bPolygonize)
+                oMerger.setSkipLevels(anSkipLevels);
+            ContourGenerator<decltype(oMerger), FixedLevelRangeIterator> oCG(
+                nXSize, nYSize, bUseNoData, dfNoDataValue, oMerger,
+                oStripLevels);
+            const double *padfLine = sStrip.adfData.data();
+            if (sStrip.nYOff > 0)
+            {
+                oCG.setStartLine(sStrip.nYOff, padfLine);
+                padfLine += nXSize;
+            }
+            for (int i = 0; i < sStrip.nLines; ++i)
+                oCG.feedLine(padfLine + static_cast<size_t>(i) * nXSize);
+            // oMerger emits its remaining lines when destroyed.
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
+            return false;
+        }
+        return true;
+    };
+
+    // Pieces of the lines touching a strip boundary, by level.
+    std::map<double, std::vector<LineString>> oMapPieces;
+
+    const auto ConsumeStrip = [&oMapPieces, &oLineWriter,
+                               nYSize](GDALContourStrip &sStrip)
+    {
+        // Y of the pixel centers of the last line of the previous strip, and
+        // of the last line of this strip, where lines can cross boundaries.
+        const double dfTop = sStrip.nYOff - 0.5;
+        const double dfBottom = sStrip.nYOff + sStrip.nLines - 0.5;
+        const bool bHasTop = sStrip.nYOff > 0;
+        const bool bHasBottom = sStrip.nYOff + sStrip.nLines < nYSize;
+        const auto IsOnBoundary = [=](const Point &pt)
+        {
+            return (bHasTop && pt.y == dfTop) ||
+                   (bHasBottom && pt.y == dfBottom);
+        };
+
+        for (auto &oLine : sStrip.oCollector.aoLines)
+        {
+            if (!oLine.bClosed && !oLine.ls.empty() &&
+                (IsOnBoundary(oLine.ls.front()) ||
+                 IsOnBoundary(oLine.ls.back())))
+            {
+                oMapPieces[oLine.dfLevel].emplace_back();
+                oMapPieces[oLine.dfLevel].back().swap(oLine.ls);
+            }
+            else
+            {
+                oLineWriter.addLine(oLine.dfLevel, oLine.ls, oLine.bClosed);
+            }
+        }
+        sStrip.oCollector.aoLines.clear();
+    };
+
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    bool bOK = true;
+    int iNextToRead = 0;
+    for (int i = 0; i < nStrips && bOK; ++i)
+    {
+        while (iNextToRead < nStrips &&
+               iNextToRead - i < static_cast<int>(asStrips.size()))
+        {
+            auto &sStrip = asStrips[iNextToRead % asStrips.size()];
+            bOK = ReadStrip(sStrip, iNextToRead);
+            if (!bOK)
+                break;
+
+            sStrip.bDone = false;
+            poJobQueue->SubmitJob(
+                [&sStrip, &ComputeStrip]()
+                {
+                    sStrip.bOK = ComputeStrip(sStrip);
+                    sStrip.bDone = true;
+                });
+            ++iNextToRead;
+        }
+        if (!bOK)
+            break;
+
+        auto &sStrip = asStrips[i % asStrips.size()];
+        while (!sStrip.bDone && poJobQueue->WaitEvent())
+        {
+        }
+        bOK = sStrip.bOK;
+        if (bOK)
+        {
+            ConsumeStrip(sStrip);
+            if (!pfnProgress(static_cast<double>(sStrip.nYOff + sStrip.nLines) /
+                                 nYSize,
+                             "Processing line", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bOK = false;
+            }
+        }
+    }
+
+    // Jobs reference asStrips.
+    poJobQueue->WaitCompletion();
+
+    if (bOK)
+    {
+        for (auto &oIter : oMapPieces)
+            GDALContourStitchLines(oIter.first, oIter.second, oLineWriter);
+    }
+    return bOK;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -563,6 +875,16 @@ mode.
  * A negative value means a single transaction. The function takes care of
  * issuing the starting transaction and committing the final one.
  *
+ *   NUM_THREADS=number_of_threads|ALL_CPUS
+ *
+ * (GDAL >= 3.11) Number of threads to use. Defaults to 1. With more than one
+ * thread, the raster is processed by horizontal strips, concurrently, and
+ * the lines (or rings) crossing strip boundaries are joined afterwards. The
+ * contours are the same as with a single thread, but they are written in a
+ * different order, and rings may start at a different vertex. Next to nodata
+ * pixels, where a ring can touch itself at a vertex, it may also be split
+ * there into several rings, covering the same area.
+ *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
 CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
@@ -680,6 +1002,14 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    int nThreads = 1;
+    opt = CSLFetchNameValue(options, "NUM_THREADS");
+    if (opt)
+    {
+        nThreads = EQUAL(opt, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(opt);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -847,17 +1177,27 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(),
                     -std::numeric_limits<double>::infinity(), dfMaximum);
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
                 std::vector<int> aoiSkipLevels;
                 // Skip first and last levels (min/max) in polygonal case
                 aoiSkipLevels.push_back(0);
                 aoiSkipLevels.push_back(static_cast<int>(levels.levelsCount()));
-                writer.setSkipLevels(aoiSkipLevels);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (nThreads > 1)
+                {
+                    ok = GDALContourGenerateMultiThreaded(
+                        hBand, useNoData, noDataValue, levels,
+                        /* polygonize */ true, aoiSkipLevels, appender,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<RingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ true);
+                    writer.setSkipLevels(aoiSkipLevels);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
         else
@@ -895,12 +1235,22 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 fixedLevels.erase(uniqueIt, fixedLevels.end());
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(), dfMinimum, dfMaximum);
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (nThreads > 1)
+                {
+                    ok = GDALContourGenerateMultiThreaded(
+                        hBand, useNoData, noDataValue, levels,
+                        /* polygonize */ false, std::vector<int>(), appender,
+                        nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
     }
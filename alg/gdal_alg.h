@@ -359,6 +359,12 @@ bool CPL_DLL GDALIsLineOfSightVisible(
     const int xB, const int yB, const double zB, int *pnxTerrainIntersection,
     int *pnyTerrainIntersection, CSLConstList papszOptions);
 
+CPLErr CPL_DLL GDALIsLineOfSightVisibleMulti(
+    GDALRasterBandH hBand, int nCount, const int *panXA, const int *panYA,
+    const double *padfZA, const int *panXB, const int *panYB,
+    const double *padfZB, bool *pabVisible, int *panXTerrainIntersection,
+    int *panYTerrainIntersection, CSLConstList papszOptions);
+
 /************************************************************************/
 /*      Rasterizer API - geometries burned into GDAL raster.            */
 /************************************************************************/
@@ -626,6 +632,25 @@ CPLErr CPL_DLL GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
                                       void *pData, GDALProgressFunc pfnProgress,
                                       void *pProgressArg);
 
+/** Scatter grid context opaque type */
+typedef struct GDALGridScatterContext GDALGridScatterContext;
+
+GDALGridScatterContext CPL_DLL *
+GDALGridScatterContextCreate(GDALGridAlgorithm eAlgorithm,
+                             const void *poOptions, double dfXMin,
+                             double dfXMax, double dfYMin, double dfYMax,
+                             GUInt32 nXSize, GUInt32 nYSize);
+
+CPLErr CPL_DLL GDALGridScatterContextAddPoints(
+    GDALGridScatterContext *psContext, GUInt32 nPoints, const double *padfX,
+    const double *padfY, const double *padfZ);
+
+CPLErr CPL_DLL GDALGridScatterContextGetResult(
+    GDALGridScatterContext *psContext, GUInt32 nXOff, GUInt32 nYOff,
+    GUInt32 nXSize, GUInt32 nYSize, GDALDataType eType, void *pData);
+
+void CPL_DLL GDALGridScatterContextFree(GDALGridScatterContext *psContext);
+
 GDAL_GCP CPL_DLL *GDALComputeMatchingPoints(GDALDatasetH hFirstImage,
                                             GDALDatasetH hSecondImage,
                                             char **papszOptions,
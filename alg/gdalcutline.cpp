@@ -14,16 +14,21 @@
 #include "cpl_port.h"
 #include "gdalwarper.h"
 
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <limits>
+#include <new>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_alg_priv.h"
 #include "gdal_priv.h"
 #include "memdataset.h"
 #include "ogr_api.h"
@@ -45,7 +50,9 @@ static CPLErr BlendMaskGenerator(int /* nXOff */, int /* nYOff */,
                                  double /* dfBlendDist */)
 {
     CPLError(CE_Failure, CPLE_AppDefined,
-             "Blend distance support not available without the GEOS library.");
+             "Blend distance support not available without the GEOS library. "
+             "Use the CUTLINE_BLEND_ALGORITHM=DISTANCE_TRANSFORM warping "
+             "option instead.");
     return CE_Failure;
 }
 #else
@@ -185,6 +192,260 @@ static CPLErr BlendMaskGenerator(int nXOff, int nYOff, int nXSize, int nYSize,
 }
 #endif  // HAVE_GEOS
 
+/************************************************************************/
+/*                  BlendMaskGeneratorDistanceTransform()               */
+/*                                                                      */
+/*      Raster based alternative to BlendMaskGenerator(), selected      */
+/*      with CUTLINE_BLEND_ALGORITHM=DISTANCE_TRANSFORM. The segments   */
+/*      of the cutline boundary are burnt with the line rasterizer in   */
+/*      a window extending the chunk by the blend distance, each        */
+/*      touched pixel recording its nearest segment. The nearest        */
+/*      segments are then propagated to the other pixels by a two-pass  */
+/*      vector distance transform, and the distance of each pixel is    */
+/*      computed to its nearest segment. This does not need GEOS and    */
+/*      its cost per pixel does not depend on the blend distance, but   */
+/*      the distance may be slightly overestimated in rare              */
+/*      configurations where the propagation misses the nearest         */
+/*      segment.                                                        */
+/************************************************************************/
+
+namespace
+{
+struct CutlineSegment
+{
+    double dfX1;
+    double dfY1;
+    double dfX2;
+    double dfY2;
+
+    // Squared distance from (dfX, dfY) to the segment.
+    double SquaredDistanceTo(double dfX, double dfY) const
+    {
+        const double dfDX = dfX2 - dfX1;
+        const double dfDY = dfY2 - dfY1;
+        const double dfSqLength = dfDX * dfDX + dfDY * dfDY;
+        double dfT = 0;
+        if (dfSqLength > 0)
+        {
+            dfT = ((dfX - dfX1) * dfDX + (dfY - dfY1) * dfDY) / dfSqLength;
+            dfT = std::min(1.0, std::max(0.0, dfT));
+        }
+        const double dfNearestX = dfX1 + dfT * dfDX - dfX;
+        const double dfNearestY = dfY1 + dfT * dfDY - dfY;
+        return dfNearestX * dfNearestX + dfNearestY * dfNearestY;
+    }
+};
+
+struct CutlineBoundaryBurnInfo : public GDALRasterizeInfo
+{
+    int nWinXSize = 0;
+    const CutlineSegment *pasSegments = nullptr;
+    // Nearest segment to the pixel center (-1 if none has been found yet),
+    // and its squared distance.
+    int *panNearestSegment = nullptr;
+    double *padfSqDist = nullptr;
+    // Segment being burnt.
+    int iSegment = 0;
+};
+}  // namespace
+
+static void CutlineBoundaryPointFunc(GDALRasterizeInfo *psInfo, int nY, int nX,
+                                     double /* dfVariant */)
+{
+    auto psBurnInfo = static_cast<CutlineBoundaryBurnInfo *>(psInfo);
+    const double dfSqDist =
+        psBurnInfo->pasSegments[psBurnInfo->iSegment].SquaredDistanceTo(
+            nX + 0.5, nY + 0.5);
+    const size_t nIdx = static_cast<size_t>(nY) * psBurnInfo->nWinXSize + nX;
+    if (psBurnInfo->panNearestSegment[nIdx] < 0 ||
+        dfSqDist < psBurnInfo->padfSqDist[nIdx])
+    {
+        psBurnInfo->panNearestSegment[nIdx] = psBurnInfo->iSegment;
+        psBurnInfo->padfSqDist[nIdx] = dfSqDist;
+    }
+}
+
+static CPLErr BlendMaskGeneratorDistanceTransform(
+    int nXOff, int nYOff, int nXSize, int nYSize, const GByte *pabyPolyMask,
+    float *pafValidityMask, OGRGeometryH hPolygon, double dfBlendDist)
+{
+    /* -------------------------------------------------------------------- */
+    /*      The working window extends the chunk by the blend distance,     */
+    /*      so that all the boundary segments within the blend distance     */
+    /*      of a pixel of the chunk are burnt.                              */
+    /* -------------------------------------------------------------------- */
+    const double dfMargin = std::ceil(dfBlendDist) + 1;
+    if (!(nXSize + 2 * dfMargin < INT_MAX && nYSize + 2 * dfMargin < INT_MAX))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Too large cutline blend distance");
+        return CE_Failure;
+    }
+    const int nMargin = static_cast<int>(dfMargin);
+    const int nWinXSize = nXSize + 2 * nMargin;
+    const int nWinYSize = nYSize + 2 * nMargin;
+    const double dfWinXOff = static_cast<double>(nXOff) - nMargin;
+    const double dfWinYOff = static_cast<double>(nYOff) - nMargin;
+
+    std::vector<CutlineSegment> asSegments;
+    std::vector<int> anNearestSegment;
+    std::vector<double> adfSqDist;
+    try
+    {
+        const auto AddRing = [&asSegments, dfWinXOff,
+                              dfWinYOff](const OGRLinearRing *poRing)
+        {
+            for (int i = 1; i < poRing->getNumPoints(); ++i)
+            {
+                asSegments.push_back({poRing->getX(i - 1) - dfWinXOff,
+                                      poRing->getY(i - 1) - dfWinYOff,
+                                      poRing->getX(i) - dfWinXOff,
+                                      poRing->getY(i) - dfWinYOff});
+            }
+        };
+
+        const OGRGeometry *poGeom = OGRGeometry::FromHandle(hPolygon);
+        if (wkbFlatten(poGeom->getGeometryType()) == wkbPolygon)
+        {
+            for (const auto *poRing : *(poGeom->toPolygon()))
+                AddRing(poRing);
+        }
+        else
+        {
+            for (const auto *poPoly : *(poGeom->toMultiPolygon()))
+            {
+                for (const auto *poRing : *poPoly)
+                    AddRing(poRing);
+            }
+        }
+
+        const size_t nWinPixels = static_cast<size_t>(nWinXSize) * nWinYSize;
+        anNearestSegment.resize(nWinPixels, -1);
+        adfSqDist.resize(nWinPixels);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers for cutline blending");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the segments.                                              */
+    /* -------------------------------------------------------------------- */
+    CutlineBoundaryBurnInfo sBurnInfo;
+    sBurnInfo.nWinXSize = nWinXSize;
+    sBurnInfo.pasSegments = asSegments.data();
+    sBurnInfo.panNearestSegment = anNearestSegment.data();
+    sBurnInfo.padfSqDist = adfSqDist.data();
+
+    for (size_t i = 0; i < asSegments.size(); ++i)
+    {
+        double adfX[2] = {asSegments[i].dfX1, asSegments[i].dfX2};
+        double adfY[2] = {asSegments[i].dfY1, asSegments[i].dfY2};
+        const int nPartSize = 2;
+        sBurnInfo.iSegment = static_cast<int>(i);
+        GDALdllImageLineAllTouched(nWinXSize, nWinYSize, 1, &nPartSize, adfX,
+                                   adfY, nullptr, CutlineBoundaryPointFunc,
+                                   &sBurnInfo, false, false);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Propagate the nearest segments, with a forward pass and a       */
+    /*      backward pass, each row being swept in both directions.         */
+    /* -------------------------------------------------------------------- */
+    const auto TryNeighbour =
+        [&asSegments, &anNearestSegment, &adfSqDist](
+            int iX, int iY, size_t nIdx, size_t nNeighbourIdx)
+    {
+        const int iSegment = anNearestSegment[nNeighbourIdx];
+        if (iSegment < 0 || iSegment == anNearestSegment[nIdx])
+            return;
+        const double dfSqDist =
+            asSegments[iSegment].SquaredDistanceTo(iX + 0.5, iY + 0.5);
+        if (anNearestSegment[nIdx] < 0 || dfSqDist < adfSqDist[nIdx])
+        {
+            anNearestSegment[nIdx] = iSegment;
+            adfSqDist[nIdx] = dfSqDist;
+        }
+    };
+
+    for (int iY = 0; iY < nWinYSize; ++iY)
+    {
+        const size_t nRowIdx = static_cast<size_t>(iY) * nWinXSize;
+        for (int iX = 0; iX < nWinXSize; ++iX)
+        {
+            const size_t nIdx = nRowIdx + iX;
+            if (iX > 0)
+                TryNeighbour(iX, iY, nIdx, nIdx - 1);
+            if (iY > 0)
+            {
+                if (iX > 0)
+                    TryNeighbour(iX, iY, nIdx, nIdx - nWinXSize - 1);
+                TryNeighbour(iX, iY, nIdx, nIdx - nWinXSize);
+                if (iX + 1 < nWinXSize)
+                    TryNeighbour(iX, iY, nIdx, nIdx - nWinXSize + 1);
+            }
+        }
+        for (int iX = nWinXSize - 2; iX >= 0; --iX)
+            TryNeighbour(iX, iY, nRowIdx + iX, nRowIdx + iX + 1);
+    }
+
+    for (int iY = nWinYSize - 1; iY >= 0; --iY)
+    {
+        const size_t nRowIdx = static_cast<size_t>(iY) * nWinXSize;
+        for (int iX = nWinXSize - 1; iX >= 0; --iX)
+        {
+            const size_t nIdx = nRowIdx + iX;
+            if (iX + 1 < nWinXSize)
+                TryNeighbour(iX, iY, nIdx, nIdx + 1);
+            if (iY + 1 < nWinYSize)
+            {
+                if (iX + 1 < nWinXSize)
+                    TryNeighbour(iX, iY, nIdx, nIdx + nWinXSize + 1);
+                TryNeighbour(iX, iY, nIdx, nIdx + nWinXSize);
+                if (iX > 0)
+                    TryNeighbour(iX, iY, nIdx, nIdx + nWinXSize - 1);
+            }
+        }
+        for (int iX = 1; iX < nWinXSize; ++iX)
+            TryNeighbour(iX, iY, nRowIdx + iX, nRowIdx + iX - 1);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Apply the same falloff as BlendMaskGenerator().                 */
+    /* -------------------------------------------------------------------- */
+    for (int iY = 0; iY < nYSize; iY++)
+    {
+        const size_t nWinRowIdx =
+            static_cast<size_t>(iY + nMargin) * nWinXSize + nMargin;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const size_t nIdx = static_cast<size_t>(iY) * nXSize + iX;
+            const double dfDist =
+                anNearestSegment[nWinRowIdx + iX] < 0
+                    ? std::numeric_limits<double>::infinity()
+                    : std::sqrt(adfSqDist[nWinRowIdx + iX]);
+            if (dfDist > dfBlendDist)
+            {
+                if (pabyPolyMask[nIdx] == 0)
+                    pafValidityMask[nIdx] = 0.0;
+
+                continue;
+            }
+
+            const double dfRatio =
+                pabyPolyMask[nIdx] == 0
+                    ? 0.5 - (dfDist / dfBlendDist) * 0.5   // Outside.
+                    : 0.5 + (dfDist / dfBlendDist) * 0.5;  // Inside.
+
+            pafValidityMask[nIdx] *= static_cast<float>(dfRatio);
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                         CutlineTransformer()                         */
 /*                                                                      */
@@ -391,9 +652,29 @@ CPLErr GDALWarpCutlineMaskerEx(void *pMaskFuncArg, int /* nBandCount */,
     }
     else
     {
-        eErr = BlendMaskGenerator(nXOff, nYOff, nXSize, nYSize, pabyPolyMask,
-                                  static_cast<float *>(pValidityMask), hPolygon,
-                                  psWO->dfCutlineBlendDist);
+        const char *pszBlendAlgorithm = CSLFetchNameValueDef(
+            psWO->papszWarpOptions, "CUTLINE_BLEND_ALGORITHM", "GEOS");
+        if (EQUAL(pszBlendAlgorithm, "DISTANCE_TRANSFORM"))
+        {
+            eErr = BlendMaskGeneratorDistanceTransform(
+                nXOff, nYOff, nXSize, nYSize, pabyPolyMask,
+                static_cast<float *>(pValidityMask), hPolygon,
+                psWO->dfCutlineBlendDist);
+        }
+        else if (EQUAL(pszBlendAlgorithm, "GEOS"))
+        {
+            eErr = BlendMaskGenerator(nXOff, nYOff, nXSize, nYSize,
+                                      pabyPolyMask,
+                                      static_cast<float *>(pValidityMask),
+                                      hPolygon, psWO->dfCutlineBlendDist);
+        }
+        else
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Unsupported value for CUTLINE_BLEND_ALGORITHM: %s",
+                     pszBlendAlgorithm);
+            eErr = CE_Failure;
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -23,8 +23,10 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -56,6 +58,244 @@ static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
     pBounds->maxy = dfY;
 }
 
+/************************************************************************/
+/*                         GDALGridBucketIndex                          */
+/************************************************************************/
+
+// Uniform grid of buckets over the extent of the points, usable instead of
+// the quadtree for the searches of the algorithms with a search radius.
+// The points are stored in structure of arrays layout, sorted by bucket in
+// row-major order, so that the points of consecutive buckets of a row are
+// contiguous in memory.
+struct GDALGridBucketIndex
+{
+    double dfMinX = 0;
+    double dfMinY = 0;
+    double dfInvCellSize = 0;
+    int nCellsX = 0;
+    int nCellsY = 0;
+    // Index of the first point of each bucket, followed by the number of
+    // points.
+    std::vector<GUInt32> anCellStart{};
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<double> adfZ{};
+};
+
+// Points within [dfMinY, dfMaxY] of the bucket rows intersecting it, grouped
+// by bucket column. All the pixels of an output line do searches with the
+// same Y extent, so they share this list and only have to filter it along X.
+// Only the bucket columns [nCellX0, nCellX1] that the searches of the line
+// have overlapped so far are filled: the pixels of a line are processed from
+// left to right, so the cache is extended to the right as they move.
+struct GDALGridBucketRowCache
+{
+    double dfMinY = 0;
+    double dfMaxY = -1;
+    int nCellX0 = 0;
+    int nCellX1 = -1;
+    // Index of the first point of each filled column, relative to nCellX0,
+    // followed by the number of points.
+    std::vector<GUInt32> anColumnStart{};
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<double> adfZ{};
+};
+
+/************************************************************************/
+/*                       GDALGridBucketGetCell()                        */
+/************************************************************************/
+
+static int GDALGridBucketGetCell(double dfVal, double dfMin,
+                                 double dfInvCellSize, int nCells)
+{
+    const double dfCell = (dfVal - dfMin) * dfInvCellSize;
+    if (!(dfCell >= 0))
+        return 0;
+    if (dfCell >= nCells - 1)
+        return nCells - 1;
+    return static_cast<int>(dfCell);
+}
+
+/************************************************************************/
+/*                     GDALGridBucketRowCacheFill()                     */
+/************************************************************************/
+
+// Makes the cache hold the points within [dfMinY, dfMaxY] of the bucket
+// columns [nCellX0, nCellX1], extending the columns already filled for the
+// same Y extent when possible.
+static bool GDALGridBucketRowCacheFill(const GDALGridBucketIndex *psIndex,
+                                       GDALGridBucketRowCache *psCache,
+                                       double dfMinY, double dfMaxY,
+                                       int nCellY0, int nCellY1, int nCellX0,
+                                       int nCellX1)
+{
+    int nFirstNewCellX = nCellX0;
+    if (dfMinY == psCache->dfMinY && dfMaxY == psCache->dfMaxY &&
+        nCellX0 >= psCache->nCellX0 && nCellX0 <= psCache->nCellX1 + 1)
+    {
+        // Append the missing columns on the right.
+        nFirstNewCellX = psCache->nCellX1 + 1;
+    }
+    else
+    {
+        psCache->adfX.clear();
+        psCache->adfY.clear();
+        psCache->adfZ.clear();
+        psCache->anColumnStart.clear();
+        psCache->nCellX0 = nCellX0;
+    }
+    psCache->dfMinY = 0;
+    psCache->dfMaxY = -1;
+    psCache->nCellX1 = nFirstNewCellX - 1;
+
+    const int nCellsX = psIndex->nCellsX;
+    try
+    {
+        if (psCache->anColumnStart.empty())
+            psCache->anColumnStart.push_back(0);
+        for (int nCellX = nFirstNewCellX; nCellX <= nCellX1; ++nCellX)
+        {
+            for (int nCellY = nCellY0; nCellY <= nCellY1; ++nCellY)
+            {
+                const size_t nCell =
+                    static_cast<size_t>(nCellY) * nCellsX + nCellX;
+                for (GUInt32 j = psIndex->anCellStart[nCell];
+                     j < psIndex->anCellStart[nCell + 1]; ++j)
+                {
+                    const double dfY = psIndex->adfY[j];
+                    if (dfY >= dfMinY && dfY <= dfMaxY)
+                    {
+                        psCache->adfX.push_back(psIndex->adfX[j]);
+                        psCache->adfY.push_back(dfY);
+                        psCache->adfZ.push_back(psIndex->adfZ[j]);
+                    }
+                }
+            }
+            // End of this column, which is the start of the next one.
+            psCache->anColumnStart.push_back(
+                static_cast<GUInt32>(psCache->adfX.size()));
+        }
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    psCache->dfMinY = dfMinY;
+    psCache->dfMaxY = dfMaxY;
+    psCache->nCellX1 = std::max(psCache->nCellX1, nCellX1);
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALGridHasPointIndex()                       */
+/************************************************************************/
+
+static bool GDALGridHasPointIndex(const GDALGridExtraParameters *psExtraParams)
+{
+    return psExtraParams->hQuadTree != nullptr ||
+           psExtraParams->psBucketIndex != nullptr;
+}
+
+/************************************************************************/
+/*                        GDALGridSearchPoints()                        */
+/************************************************************************/
+
+// Calls visitor(dfX, dfY, dfZ) for each point within sAoi, using the point
+// index of psExtraParams, which must have one.
+template <class Visitor>
+static void GDALGridSearchPoints(GDALGridExtraParameters *psExtraParams,
+                                 const double *padfX, const double *padfY,
+                                 const double *padfZ, const CPLRectObj &sAoi,
+                                 Visitor visitor)
+{
+    const GDALGridBucketIndex *psIndex = psExtraParams->psBucketIndex;
+    if (psIndex == nullptr)
+    {
+        int nFeatureCount = 0;
+        GDALGridPoint **papsPoints =
+            reinterpret_cast<GDALGridPoint **>(CPLQuadTreeSearch(
+                psExtraParams->hQuadTree, &sAoi, &nFeatureCount));
+        for (int k = 0; k < nFeatureCount; k++)
+        {
+            const int i = papsPoints[k]->i;
+            visitor(padfX[i], padfY[i], padfZ[i]);
+        }
+        CPLFree(papsPoints);
+        return;
+    }
+
+    const int nCellX0 = GDALGridBucketGetCell(
+        sAoi.minx, psIndex->dfMinX, psIndex->dfInvCellSize, psIndex->nCellsX);
+    const int nCellX1 = GDALGridBucketGetCell(
+        sAoi.maxx, psIndex->dfMinX, psIndex->dfInvCellSize, psIndex->nCellsX);
+    const int nCellY0 = GDALGridBucketGetCell(
+        sAoi.miny, psIndex->dfMinY, psIndex->dfInvCellSize, psIndex->nCellsY);
+    const int nCellY1 = GDALGridBucketGetCell(
+        sAoi.maxy, psIndex->dfMinY, psIndex->dfInvCellSize, psIndex->nCellsY);
+
+    // Refill the cache at the first search of an output line, and extend it
+    // when a search of the line reaches bucket columns not yet cached.
+    // Searches larger than the cached band, such as the ones of the nearest
+    // neighbour algorithm when it increases its search radius, do not evict
+    // it.
+    GDALGridBucketRowCache *psCache = psExtraParams->psBucketRowCache;
+    if (psCache != nullptr)
+    {
+        const bool bSameY =
+            sAoi.miny == psCache->dfMinY && sAoi.maxy == psCache->dfMaxY;
+        if ((!bSameY &&
+             (psCache->dfMinY > psCache->dfMaxY ||
+              sAoi.maxy - sAoi.miny <= psCache->dfMaxY - psCache->dfMinY)) ||
+            (bSameY &&
+             (nCellX0 < psCache->nCellX0 || nCellX1 > psCache->nCellX1)))
+        {
+            GDALGridBucketRowCacheFill(psIndex, psCache, sAoi.miny, sAoi.maxy,
+                                       nCellY0, nCellY1, nCellX0, nCellX1);
+        }
+    }
+
+    if (psCache != nullptr && sAoi.miny == psCache->dfMinY &&
+        sAoi.maxy == psCache->dfMaxY && nCellX0 >= psCache->nCellX0 &&
+        nCellX1 <= psCache->nCellX1)
+    {
+        const double *padfCacheX = psCache->adfX.data();
+        const double *padfCacheY = psCache->adfY.data();
+        const double *padfCacheZ = psCache->adfZ.data();
+        const GUInt32 *panColumnStart = psCache->anColumnStart.data();
+        const GUInt32 nEnd = panColumnStart[nCellX1 + 1 - psCache->nCellX0];
+        for (GUInt32 j = panColumnStart[nCellX0 - psCache->nCellX0]; j < nEnd;
+             ++j)
+        {
+            const double dfX = padfCacheX[j];
+            if (dfX >= sAoi.minx && dfX <= sAoi.maxx)
+                visitor(dfX, padfCacheY[j], padfCacheZ[j]);
+        }
+        return;
+    }
+
+    const double *padfIndexX = psIndex->adfX.data();
+    const double *padfIndexY = psIndex->adfY.data();
+    const double *padfIndexZ = psIndex->adfZ.data();
+    for (int nCellY = nCellY0; nCellY <= nCellY1; ++nCellY)
+    {
+        const size_t nRowOffset =
+            static_cast<size_t>(nCellY) * psIndex->nCellsX;
+        const GUInt32 nEnd = psIndex->anCellStart[nRowOffset + nCellX1 + 1];
+        for (GUInt32 j = psIndex->anCellStart[nRowOffset + nCellX0]; j < nEnd;
+             ++j)
+        {
+            const double dfX = padfIndexX[j];
+            const double dfY = padfIndexY[j];
+            if (dfX >= sAoi.minx && dfX <= sAoi.maxx && dfY >= sAoi.miny &&
+                dfY <= sAoi.maxy)
+            {
+                visitor(dfX, dfY, padfIndexZ[j]);
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                   GDALGridInverseDistanceToAPower()                  */
 /************************************************************************/
@@ -257,8 +497,7 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -271,35 +510,34 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    bool bCoincidentPointFound = false;
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            if (bCoincidentPointFound)
+                return;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
 
             const double dfR2 = dfRX * dfRX + dfRY * dfRY;
             // real distance + smoothing
             const double dfRsmoothed2 = dfR2 + dfSmoothing2;
             if (dfRsmoothed2 < 0.0000000000001)
             {
-                *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
-                return CE_None;
+                *pdfValue = dfZ;
+                bCoincidentPointFound = true;
+                return;
             }
             // is point within real distance?
             if (dfR2 <= dfRPower2)
             {
                 oMapDistanceToZValues.insert(
-                    std::make_pair(dfRsmoothed2, padfZ[i]));
+                    std::make_pair(dfRsmoothed2, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
+    if (bCoincidentPointFound)
+        return CE_None;
 
     double dfNominator = 0.0;
     double dfDenominator = 0.0;
@@ -366,8 +604,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -379,25 +616,24 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    bool bCoincidentPointFound = false;
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            if (bCoincidentPointFound)
+                return;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
 
             const double dfR2 = dfRX * dfRX + dfRY * dfRY;
             // real distance + smoothing
             const double dfRsmoothed2 = dfR2 + dfSmoothing2;
             if (dfRsmoothed2 < 0.0000000000001)
             {
-                *pdfValue = padfZ[i];
-                CPLFree(papsPoints);
-                return CE_None;
+                *pdfValue = dfZ;
+                bCoincidentPointFound = true;
+                return;
             }
             // is point within real distance?
             if (dfR2 <= dfRPower2)
@@ -405,11 +641,11 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRsmoothed2, padfZ[i]));
+                    std::make_pair(dfRsmoothed2, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
+    if (bCoincidentPointFound)
+        return CE_None;
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -646,7 +882,7 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -658,34 +894,28 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
     double dfAccumulator = 0.0;
 
     GUInt32 n = 0;  // Used after for.
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double dfZ)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
                     dfR12Square)
                 {
-                    dfAccumulator += padfZ[i];
+                    dfAccumulator += dfZ;
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -749,8 +979,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
@@ -761,16 +990,12 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
             const double dfRYSquare = dfRY * dfRY;
 
@@ -780,11 +1005,9 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRXSquare + dfRYSquare, padfZ[i]));
+                    std::make_pair(dfRXSquare + dfRYSquare, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -893,7 +1116,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     const double dfR12Square = dfRadius1Square * dfRadius2Square;
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *hQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -906,7 +1129,7 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
     GUInt32 i = 0;
 
     double dfSearchRadius = psExtraParams->dfInitialSearchRadius;
-    if (hQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
             dfSearchRadius =
@@ -918,33 +1141,26 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             sAoi.miny = dfYPoint - dfSearchRadius;
             sAoi.maxx = dfXPoint + dfSearchRadius;
             sAoi.maxy = dfYPoint + dfSearchRadius;
-            int nFeatureCount = 0;
-            GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
-            if (nFeatureCount != 0)
-            {
-                // Nearest distance will be initialized with the distance to the
-                // first point in array.
-                double dfNearestRSquare = std::numeric_limits<double>::max();
-                for (int k = 0; k < nFeatureCount; k++)
+            bool bFound = false;
+            double dfNearestRSquare = std::numeric_limits<double>::max();
+            GDALGridSearchPoints(
+                psExtraParams, padfX, padfY, padfZ, sAoi,
+                [&](double dfX, double dfY, double dfZ)
                 {
-                    const int idx = papsPoints[k]->i;
-                    const double dfRX = padfX[idx] - dfXPoint;
-                    const double dfRY = padfY[idx] - dfYPoint;
+                    const double dfRX = dfX - dfXPoint;
+                    const double dfRY = dfY - dfYPoint;
 
                     const double dfR2 = dfRX * dfRX + dfRY * dfRY;
                     if (dfR2 <= dfNearestRSquare)
                     {
                         dfNearestRSquare = dfR2;
-                        dfNearestValue = padfZ[idx];
+                        dfNearestValue = dfZ;
                     }
-                }
-
-                CPLFree(papsPoints);
+                    bFound = true;
+                });
+            if (bFound)
                 break;
-            }
 
-            CPLFree(papsPoints);
             if (poOptions->dfRadius1 > 0 || poOptions->dfRadius2 > 0)
                 break;
             dfSearchRadius *= 2;
@@ -1051,7 +1267,7 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1061,35 +1277,29 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double dfZ)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
                     dfR12Square)
                 {
-                    if (dfMinimumValue > padfZ[i])
-                        dfMinimumValue = padfZ[i];
+                    if (dfMinimumValue > dfZ)
+                        dfMinimumValue = dfZ;
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -1163,26 +1373,21 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
             const double dfRYSquare = dfRY * dfRY;
 
@@ -1192,11 +1397,9 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRXSquare + dfRYSquare, padfZ[i]));
+                    std::make_pair(dfRXSquare + dfRYSquare, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1345,7 +1548,7 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1355,35 +1558,29 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
 
     double dfMaximumValue = -std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double dfZ)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
                     dfR12Square)
                 {
-                    if (dfMaximumValue < padfZ[i])
-                        dfMaximumValue = padfZ[i];
+                    if (dfMaximumValue < dfZ)
+                        dfMaximumValue = dfZ;
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -1501,7 +1698,7 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1512,37 +1709,31 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
     double dfMaximumValue = -std::numeric_limits<double>::max();
     double dfMinimumValue = std::numeric_limits<double>::max();
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double dfZ)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
                     dfR12Square)
                 {
-                    if (dfMinimumValue > padfZ[i])
-                        dfMinimumValue = padfZ[i];
-                    if (dfMaximumValue < padfZ[i])
-                        dfMaximumValue = padfZ[i];
+                    if (dfMinimumValue > dfZ)
+                        dfMinimumValue = dfZ;
+                    if (dfMaximumValue < dfZ)
+                        dfMaximumValue = dfZ;
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -1616,26 +1807,21 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
             const double dfRYSquare = dfRY * dfRY;
 
@@ -1645,11 +1831,9 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRXSquare + dfRYSquare, padfZ[i]));
+                    std::make_pair(dfRXSquare + dfRYSquare, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -1773,7 +1957,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -1782,23 +1966,19 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
     const double dfCoeff2 = bRotated ? sin(dfAngle) : 0.0;
 
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double /* dfZ */)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
@@ -1806,9 +1986,7 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
                 {
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -1878,26 +2056,21 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
             const double dfRYSquare = dfRY * dfRY;
 
@@ -1907,11 +2080,9 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRXSquare + dfRYSquare, padfZ[i]));
+                    std::make_pair(dfRXSquare + dfRYSquare, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2033,7 +2204,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2043,23 +2214,19 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
-        {
-            for (int k = 0; k < nFeatureCount; k++)
+        GDALGridSearchPoints(
+            psExtraParams, padfX, padfY, padfZ, sAoi,
+            [&](double dfX, double dfY, double /* dfZ */)
             {
-                const int i = papsPoints[k]->i;
-                const double dfRX = padfX[i] - dfXPoint;
-                const double dfRY = padfY[i] - dfYPoint;
+                const double dfRX = dfX - dfXPoint;
+                const double dfRY = dfY - dfYPoint;
 
                 if (dfRadius2Square * dfRX * dfRX +
                         dfRadius1Square * dfRY * dfRY <=
@@ -2068,9 +2235,7 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
                     dfAccumulator += sqrt(dfRX * dfRX + dfRY * dfRY);
                     n++;
                 }
-            }
-        }
-        CPLFree(papsPoints);
+            });
     }
     else
     {
@@ -2142,26 +2307,21 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(GDALGridHasPointIndex(psExtraParams));
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
     sAoi.miny = dfYPoint - dfSearchRadius;
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
-    int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
-    if (nFeatureCount != 0)
-    {
-        for (int k = 0; k < nFeatureCount; k++)
+    GDALGridSearchPoints(
+        psExtraParams, padfX, padfY, padfZ, sAoi,
+        [&](double dfX, double dfY, double dfZ)
         {
-            const int i = papsPoints[k]->i;
-            const double dfRX = padfX[i] - dfXPoint;
-            const double dfRY = padfY[i] - dfYPoint;
+            const double dfRX = dfX - dfXPoint;
+            const double dfRY = dfY - dfYPoint;
             const double dfRXSquare = dfRX * dfRX;
             const double dfRYSquare = dfRY * dfRY;
 
@@ -2171,11 +2331,9 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
                 const int iQuadrant =
                     ((dfRX >= 0) ? 1 : 0) | (((dfRY >= 0) ? 1 : 0) << 1);
                 oMapDistanceToZValuesPerQuadrant[iQuadrant].insert(
-                    std::make_pair(dfRXSquare + dfRYSquare, padfZ[i]));
+                    std::make_pair(dfRXSquare + dfRYSquare, dfZ));
             }
-        }
-    }
-    CPLFree(papsPoints);
+        });
 
     std::multimap<double, double>::iterator aoIter[] = {
         oMapDistanceToZValuesPerQuadrant[0].begin(),
@@ -2299,7 +2457,7 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
+    const bool bHasPointIndex = GDALGridHasPointIndex(psExtraParams);
 
     // Compute coefficients for coordinate system rotation.
     const double dfAngle = TO_RADIANS * poOptions->dfAngle;
@@ -2309,51 +2467,51 @@ CPLErr GDALGridDataMetricAverageDistancePts(
 
     double dfAccumulator = 0.0;
     GUInt32 n = 0;
-    if (phQuadTree != nullptr)
+    if (bHasPointIndex)
     {
         CPLRectObj sAoi;
         sAoi.minx = dfXPoint - dfSearchRadius;
         sAoi.miny = dfYPoint - dfSearchRadius;
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
-        int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
-        if (nFeatureCount != 0)
+        std::vector<double> adfFoundX;
+        std::vector<double> adfFoundY;
+        GDALGridSearchPoints(psExtraParams, padfX, padfY, padfZ, sAoi,
+                             [&](double dfX, double dfY, double /* dfZ */)
+                             {
+                                 adfFoundX.push_back(dfX);
+                                 adfFoundY.push_back(dfY);
+                             });
+        const int nFeatureCount = static_cast<int>(adfFoundX.size());
+        for (int k = 0; k < nFeatureCount - 1; k++)
         {
-            for (int k = 0; k < nFeatureCount - 1; k++)
-            {
-                const int i = papsPoints[k]->i;
-                const double dfRX1 = padfX[i] - dfXPoint;
-                const double dfRY1 = padfY[i] - dfYPoint;
+            const double dfRX1 = adfFoundX[k] - dfXPoint;
+            const double dfRY1 = adfFoundY[k] - dfYPoint;
 
-                if (dfRadius2Square * dfRX1 * dfRX1 +
-                        dfRadius1Square * dfRY1 * dfRY1 <=
-                    dfR12Square)
+            if (dfRadius2Square * dfRX1 * dfRX1 +
+                    dfRadius1Square * dfRY1 * dfRY1 <=
+                dfR12Square)
+            {
+                for (int j = k; j < nFeatureCount; j++)
+                // Search all the remaining points within the ellipse and
+                // compute distances between them and the first point.
                 {
-                    for (int j = k; j < nFeatureCount; j++)
-                    // Search all the remaining points within the ellipse and
-                    // compute distances between them and the first point.
-                    {
-                        const int ji = papsPoints[j]->i;
-                        double dfRX2 = padfX[ji] - dfXPoint;
-                        double dfRY2 = padfY[ji] - dfYPoint;
+                    double dfRX2 = adfFoundX[j] - dfXPoint;
+                    double dfRY2 = adfFoundY[j] - dfYPoint;
 
-                        if (dfRadius2Square * dfRX2 * dfRX2 +
-                                dfRadius1Square * dfRY2 * dfRY2 <=
-                            dfR12Square)
-                        {
-                            const double dfRX = padfX[ji] - padfX[i];
-                            const double dfRY = padfY[ji] - padfY[i];
+                    if (dfRadius2Square * dfRX2 * dfRX2 +
+                            dfRadius1Square * dfRY2 * dfRY2 <=
+                        dfR12Square)
+                    {
+                        const double dfRX = adfFoundX[j] - adfFoundX[k];
+                        const double dfRY = adfFoundY[j] - adfFoundY[k];
 
-                            dfAccumulator += sqrt(dfRX * dfRX + dfRY * dfRY);
-                            n++;
-                        }
+                        dfAccumulator += sqrt(dfRX * dfRX + dfRY * dfRY);
+                        n++;
                     }
                 }
             }
         }
-        CPLFree(papsPoints);
     }
     else
     {
@@ -2640,6 +2798,9 @@ static void GDALGridJobProcess(void *user_data)
     // Have a local copy of sExtraParameters since we want to modify
     // nInitialFacetIdx.
     GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    GDALGridBucketRowCache oBucketRowCache;
+    if (sExtraParameters.psBucketIndex != nullptr)
+        sExtraParameters.psBucketRowCache = &oBucketRowCache;
     const GDALDataType eType = psJob->eType;
 
     const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
@@ -2702,7 +2863,7 @@ struct GDALGridContext
     CPLWorkerThreadPool *poWorkerThreadPool;
 };
 
-static void GDALGridContextCreateQuadTree(GDALGridContext *psContext);
+static void GDALGridContextCreatePointIndex(GDALGridContext *psContext);
 
 /**
  * Creates a context to do regular gridding from the scattered data.
@@ -2728,6 +2889,11 @@ static void GDALGridContextCreateQuadTree(GDALGridContext *psContext);
  * the number of worker threads, or ALL_CPUS to use all the cores/CPUs of the
  * computer (default value).
  *
+ * The points are indexed with a quadtree for the algorithms that use a search
+ * radius. Setting the GDAL_GRID_POINT_INDEX configuration option to GRID
+ * (GDAL >= 3.11) indexes them with a uniform grid of buckets instead, which
+ * is generally faster.
+ *
  * @param eAlgorithm Gridding method.
  * @param poOptions Options to control chosen gridding method.
  * @param nPoints Number of elements in input arrays.
@@ -3198,6 +3364,8 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     psContext->sXYArrays.padfX = padfX;
     psContext->sXYArrays.padfY = padfY;
     psContext->sExtraParameters.hQuadTree = nullptr;
+    psContext->sExtraParameters.psBucketIndex = nullptr;
+    psContext->sExtraParameters.psBucketRowCache = nullptr;
     psContext->sExtraParameters.dfInitialSearchRadius = 0.0;
     psContext->sExtraParameters.pafX = pafXAligned;
     psContext->sExtraParameters.pafY = pafYAligned;
@@ -3211,12 +3379,12 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
         pafXAligned ? false : !bCallerWillKeepPointArraysAlive;
 
     /* -------------------------------------------------------------------- */
-    /*  Create quadtree if requested and possible.                          */
+    /*  Create point index if requested and possible.                       */
     /* -------------------------------------------------------------------- */
     if (bCreateQuadTree)
     {
-        GDALGridContextCreateQuadTree(psContext);
-        if (psContext->sExtraParameters.hQuadTree == nullptr &&
+        GDALGridContextCreatePointIndex(psContext);
+        if (!GDALGridHasPointIndex(&psContext->sExtraParameters) &&
             (eAlgorithm == GGA_InverseDistanceToAPowerNearestNeighbor ||
              pfnGDALGridMethod == GDALGridMovingAveragePerQuadrant))
         {
@@ -3290,42 +3458,199 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
 }
 
 /************************************************************************/
-/*                      GDALGridContextCreateQuadTree()                 */
+/*                       GDALGridGetSearchRadius()                      */
 /************************************************************************/
 
-void GDALGridContextCreateQuadTree(GDALGridContext *psContext)
+// Returns the largest search radius of the algorithm, or 0 if it has none.
+static double GDALGridGetSearchRadius(GDALGridAlgorithm eAlgorithm,
+                                      const void *poOptions)
 {
-    const GUInt32 nPoints = psContext->nPoints;
-    psContext->pasGridPoints = static_cast<GDALGridPoint *>(
-        VSI_MALLOC2_VERBOSE(nPoints, sizeof(GDALGridPoint)));
-    if (psContext->pasGridPoints != nullptr)
+    switch (eAlgorithm)
+    {
+        case GGA_InverseDistanceToAPowerNearestNeighbor:
+        {
+            const auto poOpts = static_cast<
+                const GDALGridInverseDistanceToAPowerNearestNeighborOptions *>(
+                poOptions);
+            return poOpts->dfRadius;
+        }
+        case GGA_MovingAverage:
+        {
+            const auto poOpts =
+                static_cast<const GDALGridMovingAverageOptions *>(poOptions);
+            return std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+        }
+        case GGA_NearestNeighbor:
+        {
+            const auto poOpts =
+                static_cast<const GDALGridNearestNeighborOptions *>(poOptions);
+            return std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+        }
+        case GGA_MetricMinimum:
+        case GGA_MetricMaximum:
+        case GGA_MetricRange:
+        case GGA_MetricCount:
+        case GGA_MetricAverageDistance:
+        case GGA_MetricAverageDistancePts:
+        {
+            const auto poOpts =
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions);
+            return std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+        }
+        case GGA_Linear:
+            return std::max(
+                0.0, static_cast<const GDALGridLinearOptions *>(poOptions)
+                         ->dfRadius);
+        case GGA_InverseDistanceToAPower:
+            break;
+    }
+    return 0.0;
+}
+
+/************************************************************************/
+/*                      GDALGridBucketIndexCreate()                     */
+/************************************************************************/
+
+static GDALGridBucketIndex *
+GDALGridBucketIndexCreate(GUInt32 nPoints, const double *padfX,
+                          const double *padfY, const double *padfZ,
+                          const CPLRectObj &sRect, double dfCellSize)
+{
+    const double dfExtentX = sRect.maxx - sRect.minx;
+    const double dfExtentY = sRect.maxy - sRect.miny;
+    if (!(dfCellSize > 0) || !std::isfinite(dfCellSize))
+        dfCellSize = std::max(dfExtentX, dfExtentY);
+    if (!(dfCellSize > 0) || !std::isfinite(dfCellSize))
+        dfCellSize = 1.0;
+
+    // Keep the number of buckets in the order of the number of points, so
+    // that the index stays small when the search radius is tiny.
+    const double dfMaxCells = std::min(1e8, std::max(16.0, 4.0 * nPoints));
+    double dfCellsX = std::floor(dfExtentX / dfCellSize) + 1;
+    double dfCellsY = std::floor(dfExtentY / dfCellSize) + 1;
+    while (dfCellsX * dfCellsY > dfMaxCells)
     {
-        const double *const padfX = psContext->padfX;
-        const double *const padfY = psContext->padfY;
+        dfCellSize *=
+            std::max(1.5, std::sqrt(dfCellsX * dfCellsY / dfMaxCells));
+        dfCellsX = std::floor(dfExtentX / dfCellSize) + 1;
+        dfCellsY = std::floor(dfExtentY / dfCellSize) + 1;
+    }
+
+    auto psIndex = std::make_unique<GDALGridBucketIndex>();
+    psIndex->dfMinX = sRect.minx;
+    psIndex->dfMinY = sRect.miny;
+    psIndex->dfInvCellSize = 1.0 / dfCellSize;
+    psIndex->nCellsX = static_cast<int>(dfCellsX);
+    psIndex->nCellsY = static_cast<int>(dfCellsY);
+    const size_t nCells =
+        static_cast<size_t>(psIndex->nCellsX) * psIndex->nCellsY;
 
-        // Determine point extents.
-        CPLRectObj sRect;
-        sRect.minx = padfX[0];
-        sRect.miny = padfY[0];
-        sRect.maxx = padfX[0];
-        sRect.maxy = padfY[0];
-        for (GUInt32 i = 1; i < nPoints; i++)
+    try
+    {
+        // Counting sort of the points by bucket, which keeps the original
+        // order of the points within a bucket.
+        std::vector<GUInt32> anPointCell(nPoints);
+        psIndex->anCellStart.resize(nCells + 1);
+        for (GUInt32 i = 0; i < nPoints; i++)
         {
-            if (padfX[i] < sRect.minx)
-                sRect.minx = padfX[i];
-            if (padfY[i] < sRect.miny)
-                sRect.miny = padfY[i];
-            if (padfX[i] > sRect.maxx)
-                sRect.maxx = padfX[i];
-            if (padfY[i] > sRect.maxy)
-                sRect.maxy = padfY[i];
+            const int nCellX =
+                GDALGridBucketGetCell(padfX[i], psIndex->dfMinX,
+                                      psIndex->dfInvCellSize, psIndex->nCellsX);
+            const int nCellY =
+                GDALGridBucketGetCell(padfY[i], psIndex->dfMinY,
+                                      psIndex->dfInvCellSize, psIndex->nCellsY);
+            anPointCell[i] = static_cast<GUInt32>(
+                static_cast<size_t>(nCellY) * psIndex->nCellsX + nCellX);
+            psIndex->anCellStart[anPointCell[i] + 1]++;
         }
+        for (size_t i = 0; i < nCells; i++)
+            psIndex->anCellStart[i + 1] += psIndex->anCellStart[i];
+
+        std::vector<GUInt32> anInsertPos(psIndex->anCellStart.begin(),
+                                         psIndex->anCellStart.end() - 1);
+        psIndex->adfX.resize(nPoints);
+        psIndex->adfY.resize(nPoints);
+        psIndex->adfZ.resize(nPoints);
+        for (GUInt32 i = 0; i < nPoints; i++)
+        {
+            const GUInt32 nPos = anInsertPos[anPointCell[i]]++;
+            psIndex->adfX[nPos] = padfX[i];
+            psIndex->adfY[nPos] = padfY[i];
+            psIndex->adfZ[nPos] = padfZ[i];
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for the point index");
+        return nullptr;
+    }
+
+    CPLDebug("GDAL_GRID", "Using a %dx%d bucket grid point index",
+             psIndex->nCellsX, psIndex->nCellsY);
+    return psIndex.release();
+}
+
+/************************************************************************/
+/*                    GDALGridContextCreatePointIndex()                 */
+/************************************************************************/
+
+void GDALGridContextCreatePointIndex(GDALGridContext *psContext)
+{
+    const GUInt32 nPoints = psContext->nPoints;
+    const double *const padfX = psContext->padfX;
+    const double *const padfY = psContext->padfY;
+
+    // Determine point extents.
+    CPLRectObj sRect;
+    sRect.minx = padfX[0];
+    sRect.miny = padfY[0];
+    sRect.maxx = padfX[0];
+    sRect.maxy = padfY[0];
+    for (GUInt32 i = 1; i < nPoints; i++)
+    {
+        if (padfX[i] < sRect.minx)
+            sRect.minx = padfX[i];
+        if (padfY[i] < sRect.miny)
+            sRect.miny = padfY[i];
+        if (padfX[i] > sRect.maxx)
+            sRect.maxx = padfX[i];
+        if (padfY[i] > sRect.maxy)
+            sRect.maxy = padfY[i];
+    }
 
-        // Initial value for search radius is the typical dimension of a
-        // "pixel" of the point array (assuming rather uniform distribution).
-        psContext->sExtraParameters.dfInitialSearchRadius = sqrt(
-            (sRect.maxx - sRect.minx) * (sRect.maxy - sRect.miny) / nPoints);
+    // Initial value for search radius is the typical dimension of a
+    // "pixel" of the point array (assuming rather uniform distribution).
+    psContext->sExtraParameters.dfInitialSearchRadius =
+        sqrt((sRect.maxx - sRect.minx) * (sRect.maxy - sRect.miny) / nPoints);
 
+    const char *pszPointIndex =
+        CPLGetConfigOption("GDAL_GRID_POINT_INDEX", "QUADTREE");
+    if (EQUAL(pszPointIndex, "GRID"))
+    {
+        // Buckets of half the search radius: a search then only visits
+        // about twice as many points as the ones within its rectangle.
+        const double dfSearchRadius = GDALGridGetSearchRadius(
+            psContext->eAlgorithm, psContext->poOptions);
+        psContext->sExtraParameters.psBucketIndex = GDALGridBucketIndexCreate(
+            nPoints, padfX, padfY, psContext->padfZ, sRect,
+            dfSearchRadius > 0
+                ? dfSearchRadius / 2
+                : psContext->sExtraParameters.dfInitialSearchRadius);
+        return;
+    }
+    else if (!EQUAL(pszPointIndex, "QUADTREE"))
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Unsupported value for GDAL_GRID_POINT_INDEX: %s. "
+                 "Using QUADTREE",
+                 pszPointIndex);
+    }
+
+    psContext->pasGridPoints = static_cast<GDALGridPoint *>(
+        VSI_MALLOC2_VERBOSE(nPoints, sizeof(GDALGridPoint)));
+    if (psContext->pasGridPoints != nullptr)
+    {
         psContext->sExtraParameters.hQuadTree =
             CPLQuadTreeCreate(&sRect, GDALGridGetPointBounds);
 
@@ -3358,6 +3683,7 @@ void GDALGridContextFree(GDALGridContext *psContext)
         CPLFree(psContext->pasGridPoints);
         if (psContext->sExtraParameters.hQuadTree != nullptr)
             CPLQuadTreeDestroy(psContext->sExtraParameters.hQuadTree);
+        delete psContext->sExtraParameters.psBucketIndex;
         if (psContext->bFreePadfXYZArrays)
         {
             CPLFree(psContext->padfX);
@@ -3427,7 +3753,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     // by sampling along the edges.  If all points on edges are within
     // triangles, then interior points will also be.
     if (psContext->eAlgorithm == GGA_Linear &&
-        psContext->sExtraParameters.hQuadTree == nullptr)
+        !GDALGridHasPointIndex(&psContext->sExtraParameters))
     {
         bool bNeedNearest = false;
         int nStartLeft = 0;
@@ -3476,7 +3802,7 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
         if (bNeedNearest)
         {
             CPLDebug("GDAL_GRID", "Will need nearest neighbour");
-            GDALGridContextCreateQuadTree(psContext);
+            GDALGridContextCreatePointIndex(psContext);
         }
     }
 
@@ -3660,6 +3986,597 @@ CPLErr GDALGridCreate(GDALGridAlgorithm eAlgorithm, const void *poOptions,
     return eErr;
 }
 
+/************************************************************************/
+/*                        GDALGridScatterContext                        */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+struct GDALGridScatterContext
+{
+    GDALGridAlgorithm eAlgorithm = GGA_MetricCount;
+    double dfRadius1Square = 0;
+    double dfRadius2Square = 0;
+    double dfR12Square = 0;
+    double dfHalfExtentX = 0;
+    double dfHalfExtentY = 0;
+    bool bRotated = false;
+    double dfCoeff1 = 0;
+    double dfCoeff2 = 0;
+    GUInt32 nMinPoints = 0;
+    double dfNoDataValue = 0;
+
+    double dfXMin = 0;
+    double dfYMin = 0;
+    double dfDeltaX = 0;
+    double dfDeltaY = 0;
+    GUInt32 nXSize = 0;
+    GUInt32 nYSize = 0;
+
+    // Per output pixel: number of points, and their sum, minimum or maximum.
+    // For the range, adfValue holds the minimum and adfValue2 the maximum.
+    std::vector<GUIntBig> anCount{};
+    std::vector<double> adfValue{};
+    std::vector<double> adfValue2{};
+
+    // Each worker thread accumulates the points of a batch into its own
+    // tile, a band of nTileYSize output lines, so that tiles need no
+    // synchronization.
+    GUInt32 nTileYSize = 0;
+    std::vector<std::vector<GUInt32>> aanTilePoints{};
+    std::unique_ptr<CPLWorkerThreadPool> poWorkerThreadPool{};
+};
+
+//! @endcond
+
+/************************************************************************/
+/*                     GDALGridScatterGetRange()                        */
+/************************************************************************/
+
+// Computes the range of pixel indices whose center may be at less than
+// dfHalfExtent from dfVal. Returns false if it is empty.
+static bool GDALGridScatterGetRange(double dfVal, double dfHalfExtent,
+                                    double dfMin, double dfDelta, GUInt32 nSize,
+                                    GUInt32 &nStart, GUInt32 &nEnd)
+{
+    const double dfIdx1 = (dfVal - dfHalfExtent - dfMin) / dfDelta - 0.5;
+    const double dfIdx2 = (dfVal + dfHalfExtent - dfMin) / dfDelta - 0.5;
+    // The bounds are widened by one pixel by floor() / ceil(). Whether a
+    // pixel is actually covered is decided by the exact ellipse test.
+    const double dfStart = std::floor(std::min(dfIdx1, dfIdx2));
+    const double dfEnd = std::ceil(std::max(dfIdx1, dfIdx2));
+    if (!(dfEnd >= 0) || !(dfStart <= static_cast<double>(nSize) - 1))
+        return false;
+    nStart = dfStart > 0 ? static_cast<GUInt32>(dfStart) : 0;
+    nEnd = dfEnd < static_cast<double>(nSize) - 1 ? static_cast<GUInt32>(dfEnd)
+                                                  : nSize - 1;
+    return true;
+}
+
+/************************************************************************/
+/*                     GDALGridScatterAccumulate()                      */
+/************************************************************************/
+
+// Accumulates the given points into the output lines [nTileYStart,
+// nTileYEnd]. If panIndices is not NULL, only the nCount points it
+// references are processed.
+static void GDALGridScatterAccumulate(GDALGridScatterContext *psContext,
+                                      GUInt32 nTileYStart, GUInt32 nTileYEnd,
+                                      const double *padfX, const double *padfY,
+                                      const double *padfZ,
+                                      const GUInt32 *panIndices, size_t nCount)
+{
+    const GDALGridAlgorithm eAlgorithm = psContext->eAlgorithm;
+    const double dfRadius1Square = psContext->dfRadius1Square;
+    const double dfRadius2Square = psContext->dfRadius2Square;
+    const double dfR12Square = psContext->dfR12Square;
+    const bool bRotated = psContext->bRotated;
+    const double dfCoeff1 = psContext->dfCoeff1;
+    const double dfCoeff2 = psContext->dfCoeff2;
+    const double dfXMin = psContext->dfXMin;
+    const double dfYMin = psContext->dfYMin;
+    const double dfDeltaX = psContext->dfDeltaX;
+    const double dfDeltaY = psContext->dfDeltaY;
+    const size_t nXSize = psContext->nXSize;
+    GUIntBig *panCount = psContext->anCount.data();
+    double *padfValue = psContext->adfValue.data();
+    double *padfValue2 = psContext->adfValue2.data();
+
+    for (size_t k = 0; k < nCount; k++)
+    {
+        const size_t i = panIndices ? panIndices[k] : k;
+        const double dfX = padfX[i];
+        const double dfY = padfY[i];
+        const double dfZ = padfZ[i];
+
+        GUInt32 nXStart, nXEnd, nYStart, nYEnd;
+        if (!GDALGridScatterGetRange(dfX, psContext->dfHalfExtentX, dfXMin,
+                                     dfDeltaX, psContext->nXSize, nXStart,
+                                     nXEnd) ||
+            !GDALGridScatterGetRange(dfY, psContext->dfHalfExtentY, dfYMin,
+                                     dfDeltaY, psContext->nYSize, nYStart,
+                                     nYEnd))
+        {
+            continue;
+        }
+        nYStart = std::max(nYStart, nTileYStart);
+        nYEnd = std::min(nYEnd, nTileYEnd);
+
+        for (GUInt32 nYPoint = nYStart; nYPoint <= nYEnd; nYPoint++)
+        {
+            // Same pixel center and ellipse test as the data metrics
+            // evaluated by GDALGridContextProcess().
+            const double dfYPoint = dfYMin + (nYPoint + 0.5) * dfDeltaY;
+            const size_t nLineOffset = nYPoint * nXSize;
+            for (GUInt32 nXPoint = nXStart; nXPoint <= nXEnd; nXPoint++)
+            {
+                const double dfXPoint = dfXMin + (nXPoint + 0.5) * dfDeltaX;
+                double dfRX = dfX - dfXPoint;
+                double dfRY = dfY - dfYPoint;
+
+                if (bRotated)
+                {
+                    const double dfRXRotated =
+                        dfRX * dfCoeff1 + dfRY * dfCoeff2;
+                    const double dfRYRotated =
+                        dfRY * dfCoeff1 - dfRX * dfCoeff2;
+
+                    dfRX = dfRXRotated;
+                    dfRY = dfRYRotated;
+                }
+
+                if (dfRadius2Square * dfRX * dfRX +
+                        dfRadius1Square * dfRY * dfRY >
+                    dfR12Square)
+                {
+                    continue;
+                }
+
+                const size_t nOffset = nLineOffset + nXPoint;
+                panCount[nOffset]++;
+                switch (eAlgorithm)
+                {
+                    case GGA_MovingAverage:
+                        padfValue[nOffset] += dfZ;
+                        break;
+                    case GGA_MetricMinimum:
+                        if (padfValue[nOffset] > dfZ)
+                            padfValue[nOffset] = dfZ;
+                        break;
+                    case GGA_MetricMaximum:
+                        if (padfValue[nOffset] < dfZ)
+                            padfValue[nOffset] = dfZ;
+                        break;
+                    case GGA_MetricRange:
+                        if (padfValue[nOffset] > dfZ)
+                            padfValue[nOffset] = dfZ;
+                        if (padfValue2[nOffset] < dfZ)
+                            padfValue2[nOffset] = dfZ;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                    GDALGridScatterContextCreate()                    */
+/************************************************************************/
+
+/**
+ * Creates a context to grid scattered data by accumulating each point into
+ * the output grid nodes it covers.
+ *
+ * Instead of searching the points around each grid node, as
+ * GDALGridContextProcess() does, each point passed to
+ * GDALGridScatterContextAddPoints() is splatted into the grid nodes whose
+ * search ellipse contains it. This takes time proportional to the number of
+ * points times the number of grid nodes covered by the ellipse, and does not
+ * require all the points to be in memory at once, so it is well suited to
+ * huge point sets with a search ellipse spanning a few grid nodes. The
+ * accumulators of the whole output grid are kept in memory.
+ *
+ * Only the GGA_MovingAverage, GGA_MetricCount, GGA_MetricMinimum,
+ * GGA_MetricMaximum and GGA_MetricRange algorithms are supported, with
+ * non-zero radius1 and radius2, and without per-quadrant constraints.
+ * The result is the same as the one of GDALGridContextProcess(), except
+ * for floating-point rounding of the moving average.
+ *
+ * The GDAL_NUM_THREADS configuration option can be set to accumulate the
+ * points in parallel, each worker thread being assigned a band of output
+ * lines.
+ *
+ * @param eAlgorithm Gridding method.
+ * @param poOptions Options to control chosen gridding method.
+ * @param dfXMin Lowest X border of output grid.
+ * @param dfXMax Highest X border of output grid.
+ * @param dfYMin Lowest Y border of output grid.
+ * @param dfYMax Highest Y border of output grid.
+ * @param nXSize Number of columns in output grid.
+ * @param nYSize Number of rows in output grid.
+ *
+ * @return the context (to be freed with GDALGridScatterContextFree()) or NULL
+ *         in case of error.
+ *
+ * @since GDAL 3.11
+ */
+
+GDALGridScatterContext *
+GDALGridScatterContextCreate(GDALGridAlgorithm eAlgorithm,
+                             const void *poOptions, double dfXMin,
+                             double dfXMax, double dfYMin, double dfYMax,
+                             GUInt32 nXSize, GUInt32 nYSize)
+{
+    CPLAssert(poOptions);
+
+    if (nXSize == 0 || nYSize == 0)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Output raster dimensions should have non-zero size.");
+        return nullptr;
+    }
+
+    auto psContext = std::make_unique<GDALGridScatterContext>();
+    psContext->eAlgorithm = eAlgorithm;
+
+    double dfRadius1 = 0;
+    double dfRadius2 = 0;
+    double dfAngle = 0;
+    switch (eAlgorithm)
+    {
+        case GGA_MovingAverage:
+        {
+            const auto poOpts =
+                static_cast<const GDALGridMovingAverageOptions *>(poOptions);
+            if (poOpts->nSizeOfStructure != sizeof(*poOpts))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Wrong value of nSizeOfStructure member");
+                return nullptr;
+            }
+            if (poOpts->nMinPointsPerQuadrant != 0 ||
+                poOpts->nMaxPointsPerQuadrant != 0)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Per-quadrant parameters are not supported in "
+                         "scatter mode");
+                return nullptr;
+            }
+            dfRadius1 = poOpts->dfRadius1;
+            dfRadius2 = poOpts->dfRadius2;
+            dfAngle = poOpts->dfAngle;
+            psContext->nMinPoints = poOpts->nMinPoints;
+            psContext->dfNoDataValue = poOpts->dfNoDataValue;
+            break;
+        }
+        case GGA_MetricCount:
+        case GGA_MetricMinimum:
+        case GGA_MetricMaximum:
+        case GGA_MetricRange:
+        {
+            const auto poOpts =
+                static_cast<const GDALGridDataMetricsOptions *>(poOptions);
+            if (poOpts->nSizeOfStructure != sizeof(*poOpts))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Wrong value of nSizeOfStructure member");
+                return nullptr;
+            }
+            if (poOpts->nMinPointsPerQuadrant != 0 ||
+                poOpts->nMaxPointsPerQuadrant != 0)
+            {
+                CPLError(CE_Failure, CPLE_NotSupported,
+                         "Per-quadrant parameters are not supported in "
+                         "scatter mode");
+                return nullptr;
+            }
+            dfRadius1 = poOpts->dfRadius1;
+            dfRadius2 = poOpts->dfRadius2;
+            dfAngle = poOpts->dfAngle;
+            psContext->nMinPoints = poOpts->nMinPoints;
+            psContext->dfNoDataValue = poOpts->dfNoDataValue;
+            break;
+        }
+        default:
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "Scatter mode is only supported for the average, count, "
+                     "minimum, maximum and range algorithms");
+            return nullptr;
+    }
+
+    if (!(dfRadius1 > 0) || !(dfRadius2 > 0) || !std::isfinite(dfRadius1) ||
+        !std::isfinite(dfRadius2))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Scatter mode requires strictly positive radius1 and "
+                 "radius2");
+        return nullptr;
+    }
+
+    psContext->dfRadius1Square = dfRadius1 * dfRadius1;
+    psContext->dfRadius2Square = dfRadius2 * dfRadius2;
+    psContext->dfR12Square =
+        psContext->dfRadius1Square * psContext->dfRadius2Square;
+    const double dfAngleRad = TO_RADIANS * dfAngle;
+    psContext->bRotated = dfAngleRad != 0.0;
+    psContext->dfCoeff1 = psContext->bRotated ? cos(dfAngleRad) : 0.0;
+    psContext->dfCoeff2 = psContext->bRotated ? sin(dfAngleRad) : 0.0;
+    // Half extents of the bounding box of the search ellipse.
+    psContext->dfHalfExtentX =
+        psContext->bRotated ? std::max(dfRadius1, dfRadius2) : dfRadius1;
+    psContext->dfHalfExtentY =
+        psContext->bRotated ? std::max(dfRadius1, dfRadius2) : dfRadius2;
+
+    psContext->dfXMin = dfXMin;
+    psContext->dfYMin = dfYMin;
+    psContext->dfDeltaX = (dfXMax - dfXMin) / nXSize;
+    psContext->dfDeltaY = (dfYMax - dfYMin) / nYSize;
+    psContext->nXSize = nXSize;
+    psContext->nYSize = nYSize;
+
+    const size_t nPixels = static_cast<size_t>(nXSize) * nYSize;
+    try
+    {
+        psContext->anCount.resize(nPixels);
+        if (eAlgorithm == GGA_MovingAverage)
+            psContext->adfValue.resize(nPixels, 0.0);
+        else if (eAlgorithm == GGA_MetricMinimum ||
+                 eAlgorithm == GGA_MetricRange)
+            psContext->adfValue.resize(nPixels,
+                                       std::numeric_limits<double>::max());
+        else if (eAlgorithm == GGA_MetricMaximum)
+            psContext->adfValue.resize(nPixels,
+                                       std::numeric_limits<double>::lowest());
+        if (eAlgorithm == GGA_MetricRange)
+            psContext->adfValue2.resize(nPixels,
+                                        std::numeric_limits<double>::lowest());
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate accumulators for a %u x %u grid", nXSize,
+                 nYSize);
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*  Start thread pool.                                                  */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreads = 0;
+    if (EQUAL(pszThreads, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszThreads);
+    if (nThreads > 128)
+        nThreads = 128;
+    nThreads = std::max(nThreads, 1);
+    if (static_cast<GUInt32>(nThreads) > nYSize)
+        nThreads = static_cast<int>(nYSize);
+    if (nThreads > 1)
+    {
+        psContext->poWorkerThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!psContext->poWorkerThreadPool->Setup(nThreads, nullptr, nullptr))
+        {
+            psContext->poWorkerThreadPool.reset();
+            nThreads = 1;
+        }
+        else
+        {
+            CPLDebug("GDAL_GRID", "Using %d threads", nThreads);
+        }
+    }
+    const GUInt32 nTiles = static_cast<GUInt32>(nThreads);
+    psContext->nTileYSize = (nYSize + nTiles - 1) / nTiles;
+    psContext->aanTilePoints.resize(
+        (nYSize + psContext->nTileYSize - 1) / psContext->nTileYSize);
+
+    return psContext.release();
+}
+
+/************************************************************************/
+/*                   GDALGridScatterContextAddPoints()                  */
+/************************************************************************/
+
+/**
+ * Accumulates a batch of points into a scatter gridding context.
+ *
+ * The points are accumulated in the order in which they are passed, whatever
+ * the number of threads used, so the result does not depend on it.
+ *
+ * @param psContext Context created by GDALGridScatterContextCreate().
+ * @param nPoints Number of elements in input arrays.
+ * @param padfX Input array of X coordinates.
+ * @param padfY Input array of Y coordinates.
+ * @param padfZ Input array of Z values.
+ *
+ * @return CE_None on success or CE_Failure if something goes wrong.
+ *
+ * @since GDAL 3.11
+ */
+
+CPLErr GDALGridScatterContextAddPoints(GDALGridScatterContext *psContext,
+                                       GUInt32 nPoints, const double *padfX,
+                                       const double *padfY,
+                                       const double *padfZ)
+{
+    CPLAssert(psContext);
+    if (nPoints == 0)
+        return CE_None;
+    CPLAssert(padfX);
+    CPLAssert(padfY);
+    CPLAssert(padfZ);
+
+    if (!psContext->poWorkerThreadPool)
+    {
+        GDALGridScatterAccumulate(psContext, 0, psContext->nYSize - 1, padfX,
+                                  padfY, padfZ, nullptr, nPoints);
+        return CE_None;
+    }
+
+    // Bin the points into the tiles their search ellipse intersects.
+    auto &aanTilePoints = psContext->aanTilePoints;
+    const GUInt32 nTileYSize = psContext->nTileYSize;
+    try
+    {
+        for (auto &anTilePoints : aanTilePoints)
+            anTilePoints.clear();
+        for (GUInt32 i = 0; i < nPoints; i++)
+        {
+            GUInt32 nYStart, nYEnd;
+            if (GDALGridScatterGetRange(padfY[i], psContext->dfHalfExtentY,
+                                        psContext->dfYMin, psContext->dfDeltaY,
+                                        psContext->nYSize, nYStart, nYEnd))
+            {
+                for (GUInt32 iTile = nYStart / nTileYSize;
+                     iTile <= nYEnd / nTileYSize; iTile++)
+                {
+                    aanTilePoints[iTile].push_back(i);
+                }
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory to dispatch points");
+        return CE_Failure;
+    }
+
+    for (size_t iTile = 0; iTile < aanTilePoints.size(); iTile++)
+    {
+        if (aanTilePoints[iTile].empty())
+            continue;
+        psContext->poWorkerThreadPool->SubmitJob(
+            [psContext, iTile, padfX, padfY, padfZ]()
+            {
+                const auto &anTilePoints = psContext->aanTilePoints[iTile];
+                const GUInt32 nTileYStart =
+                    static_cast<GUInt32>(iTile) * psContext->nTileYSize;
+                const GUInt32 nTileYEnd =
+                    std::min(psContext->nYSize,
+                             nTileYStart + psContext->nTileYSize) -
+                    1;
+                GDALGridScatterAccumulate(psContext, nTileYStart, nTileYEnd,
+                                          padfX, padfY, padfZ,
+                                          anTilePoints.data(),
+                                          anTilePoints.size());
+            });
+    }
+    psContext->poWorkerThreadPool->WaitCompletion();
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                   GDALGridScatterContextGetResult()                  */
+/************************************************************************/
+
+/**
+ * Fetches a window of the grid computed from the points accumulated into a
+ * scatter gridding context.
+ *
+ * @param psContext Context created by GDALGridScatterContextCreate().
+ * @param nXOff Column offset of the window.
+ * @param nYOff Line offset of the window.
+ * @param nXSize Number of columns of the window.
+ * @param nYSize Number of lines of the window.
+ * @param eType Data type of output array.
+ * @param pData Pointer to array of nXSize * nYSize values where the window
+ *              will be stored.
+ *
+ * @return CE_None on success or CE_Failure if something goes wrong.
+ *
+ * @since GDAL 3.11
+ */
+
+CPLErr GDALGridScatterContextGetResult(GDALGridScatterContext *psContext,
+                                       GUInt32 nXOff, GUInt32 nYOff,
+                                       GUInt32 nXSize, GUInt32 nYSize,
+                                       GDALDataType eType, void *pData)
+{
+    CPLAssert(psContext);
+    CPLAssert(pData);
+
+    if (nXOff > psContext->nXSize || nXSize > psContext->nXSize - nXOff ||
+        nYOff > psContext->nYSize || nYSize > psContext->nYSize - nYOff)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg,
+                 "Window is out of the output grid");
+        return CE_Failure;
+    }
+
+    std::vector<double> adfLine;
+    try
+    {
+        adfLine.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate line buffer");
+        return CE_Failure;
+    }
+
+    const GDALGridAlgorithm eAlgorithm = psContext->eAlgorithm;
+    const GUInt32 nMinPoints = psContext->nMinPoints;
+    const double dfNoDataValue = psContext->dfNoDataValue;
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
+    for (GUInt32 iLine = 0; iLine < nYSize; iLine++)
+    {
+        const size_t nOffset =
+            static_cast<size_t>(nYOff + iLine) * psContext->nXSize + nXOff;
+        for (GUInt32 iCol = 0; iCol < nXSize; iCol++)
+        {
+            const GUIntBig n = psContext->anCount[nOffset + iCol];
+            if (n < nMinPoints || (n == 0 && eAlgorithm != GGA_MetricCount))
+            {
+                adfLine[iCol] = dfNoDataValue;
+                continue;
+            }
+            switch (eAlgorithm)
+            {
+                case GGA_MovingAverage:
+                    adfLine[iCol] = psContext->adfValue[nOffset + iCol] /
+                                    static_cast<double>(n);
+                    break;
+                case GGA_MetricRange:
+                    adfLine[iCol] = psContext->adfValue2[nOffset + iCol] -
+                                    psContext->adfValue[nOffset + iCol];
+                    break;
+                case GGA_MetricCount:
+                    adfLine[iCol] = static_cast<double>(n);
+                    break;
+                default:
+                    adfLine[iCol] = psContext->adfValue[nOffset + iCol];
+                    break;
+            }
+        }
+        GDALCopyWords64(adfLine.data(), GDT_Float64, sizeof(double),
+                        static_cast<GByte *>(pData) +
+                            static_cast<size_t>(iLine) * nXSize * nDataTypeSize,
+                        eType, nDataTypeSize, nXSize);
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                     GDALGridScatterContextFree()                     */
+/************************************************************************/
+
+/**
+ * Free a context created by GDALGridScatterContextCreate()
+ *
+ * @param psContext the context.
+ *
+ * @since GDAL 3.11
+ */
+void GDALGridScatterContextFree(GDALGridScatterContext *psContext)
+{
+    delete psContext;
+}
+
 /************************************************************************/
 /*                   GDALGridParseAlgorithmAndOptions()                 */
 /************************************************************************/
@@ -33,9 +33,17 @@ typedef struct
     int i;
 } GDALGridPoint;
 
+struct GDALGridBucketIndex;
+struct GDALGridBucketRowCache;
+
 typedef struct
 {
     CPLQuadTree *hQuadTree;
+    /*! Bucket grid point index, used instead of hQuadTree when not NULL. */
+    GDALGridBucketIndex *psBucketIndex;
+    /*! Per-thread cache of the points of psBucketIndex around the output
+     *  line being processed, or NULL. */
+    GDALGridBucketRowCache *psBucketRowCache;
     double dfInitialSearchRadius;
     float *pafX;  // Aligned to be usable with AVX
     float *pafY;
@@ -18,13 +18,18 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -33,6 +38,13 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+static CPLErr ComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg);
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -89,6 +101,20 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threshold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=[SCANLINE]/EXACT
+
+(GDAL >= 3.11) Selects how distances are computed. SCANLINE, the default,
+propagates the nearest target pixel with forward and backward scanline
+sweeps, which is fast but may slightly overestimate some distances.
+EXACT computes the exact Euclidean distance transform, in a separable way
+(a vertical pass per column, then a lower envelope of parabolas per line),
+and runs on several threads.
+
+  NUM_THREADS=n/ALL_CPUS
+
+(GDAL >= 3.11) Number of threads used by ALGORITHM=EXACT. Defaults to the
+value of the GDAL_NUM_THREADS configuration option, or 1.
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -137,6 +163,35 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm should be used?                                 */
+    /* -------------------------------------------------------------------- */
+    bool bExact = false;
+    pszOpt = CSLFetchNameValue(papszOptions, "ALGORITHM");
+    if (pszOpt)
+    {
+        if (EQUAL(pszOpt, "EXACT"))
+        {
+            bExact = true;
+        }
+        else if (!EQUAL(pszOpt, "SCANLINE"))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unrecognized ALGORITHM value '%s', should be SCANLINE "
+                     "or EXACT.",
+                     pszOpt);
+            return CE_Failure;
+        }
+    }
+
+    int nThreads = GDALGetNumThreads();
+    pszOpt = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszOpt)
+    {
+        nThreads = EQUAL(pszOpt, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszOpt);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      What is our maxdist value?                                      */
     /* -------------------------------------------------------------------- */
@@ -239,6 +294,8 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
     /*      temporary file for this purpose.                                */
+    /*      The exact algorithm stores vertical distances in pixels, that   */
+    /*      may not fit in a 8 or 16 bit band.                              */
     /* -------------------------------------------------------------------- */
     GDALRasterBandH hWorkProximityBand = hProximityBand;
     GDALDatasetH hWorkProximityDS = nullptr;
@@ -253,7 +310,8 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
     bool bTempFileAlreadyDeleted = false;
 
     if (eProxType == GDT_Byte || eProxType == GDT_UInt16 ||
-        eProxType == GDT_UInt32)
+        eProxType == GDT_UInt32 ||
+        (bExact && (eProxType == GDT_Int8 || eProxType == GDT_Int16)))
     {
         GDALDriverH hDriver = GDALGetDriverByName("GTiff");
         if (hDriver == nullptr)
@@ -278,6 +336,16 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         hWorkProximityBand = GDALGetRasterBand(hWorkProximityDS, 1);
     }
 
+    if (bExact)
+    {
+        eErr = ComputeProximityExact(
+            hSrcBand, hWorkProximityBand, hProximityBand, dfMaxDist,
+            dfDistMult, pdfSrcNoData, fNoDataValue, bFixedBufVal,
+            dfFixedBufVal, nTargetValues, panTargetValues, nThreads,
+            pfnProgress, pProgressArg);
+        goto end;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate buffer for two scanlines of distances as floats        */
     /*      (the current and last line).                                    */
@@ -573,3 +641,320 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
 
     return CE_None;
 }
+
+/************************************************************************/
+/*                            IsTargetValue()                           */
+/************************************************************************/
+
+static bool IsTargetValue(GInt32 nValue, int nTargetValues,
+                          const int *panTargetValues)
+{
+    if (nTargetValues == 0)
+        return nValue != 0;
+
+    for (int i = 0; i < nTargetValues; i++)
+    {
+        if (nValue == panTargetValues[i])
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                       ComputeLineSquareDistances()                   */
+/************************************************************************/
+
+// Given in padfLine the square of the vertical distance of each pixel of a
+// line to the nearest target pixel of its column (infinite if there is
+// none), replace it by the square of the distance to the nearest target
+// pixel of the whole image. This computes the lower envelope of the
+// parabolas rooted at each pixel, as described in "Distance Transforms of
+// Sampled Functions" (Felzenszwalb and Huttenlocher, 2012).
+// panVertices and padfVertexValues must have nXSize values, and padfBounds
+// nXSize + 1 values.
+
+static void ComputeLineSquareDistances(double *padfLine, int nXSize,
+                                       int *panVertices,
+                                       double *padfVertexValues,
+                                       double *padfBounds)
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    // Build the lower envelope.
+    int k = -1;
+    for (int q = 0; q < nXSize; q++)
+    {
+        const double dfFQ = padfLine[q];
+        if (dfFQ == INF)
+            continue;
+        const double dfQ = q;
+        double dfS = -INF;
+        while (k >= 0)
+        {
+            const double dfP = panVertices[k];
+            dfS = ((dfFQ + dfQ * dfQ) - (padfVertexValues[k] + dfP * dfP)) /
+                  (2 * (dfQ - dfP));
+            if (dfS > padfBounds[k])
+                break;
+            --k;
+            dfS = -INF;
+        }
+        ++k;
+        panVertices[k] = q;
+        padfVertexValues[k] = dfFQ;
+        padfBounds[k] = dfS;
+        padfBounds[k + 1] = INF;
+    }
+
+    // No target pixel within reach of this line.
+    if (k < 0)
+        return;
+
+    k = 0;
+    for (int q = 0; q < nXSize; q++)
+    {
+        while (padfBounds[k + 1] < q)
+            ++k;
+        const double dfDX = static_cast<double>(q) - panVertices[k];
+        padfLine[q] = dfDX * dfDX + padfVertexValues[k];
+    }
+}
+
+/************************************************************************/
+/*                        ComputeProximityExact()                       */
+/************************************************************************/
+
+// Implementation of ALGORITHM=EXACT. Lines are processed by chunks. A first
+// top-to-bottom pass writes in hWorkProximityBand the vertical distance of
+// each pixel to the nearest target pixel above it (or -1). A second
+// bottom-to-top pass combines it with the distance to the nearest target
+// pixel below, and computes the final distances line by line. Columns of
+// the vertical passes, and lines of the horizontal one, are split between
+// threads.
+
+static CPLErr ComputeProximityExact(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hWorkProximityBand,
+    GDALRasterBandH hProximityBand, double dfMaxDist, double dfDistMult,
+    const double *pdfSrcNoDataValue, float fNoDataValue, bool bFixedBufVal,
+    double dfFixedBufVal, int nTargetValues, const int *panTargetValues,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Size the chunks so that the source and distance buffers use about
+    // 64 MB.
+    constexpr size_t MAX_CHUNK_BYTES = 64 * 1024 * 1024;
+    const int nChunkLines = static_cast<int>(std::min<size_t>(
+        nYSize, std::max<size_t>(1, MAX_CHUNK_BYTES /
+                                        (static_cast<size_t>(nXSize) *
+                                         (sizeof(GInt32) + sizeof(double))))));
+    nThreads = std::max(1, std::min({nThreads, nXSize, nChunkLines}));
+
+    std::vector<GInt32> anSrc;
+    std::vector<float> afDist;
+    std::vector<double> adfSquareDist;
+    // Line of the nearest target pixel found so far, for each column.
+    std::vector<int> anNearestLine;
+    // Scratch buffers of ComputeLineSquareDistances(), for each thread.
+    std::vector<std::vector<int>> aanVertices;
+    std::vector<std::vector<double>> aadfVertexValues;
+    std::vector<std::vector<double>> aadfBounds;
+    try
+    {
+        const size_t nChunkValues = static_cast<size_t>(nXSize) * nChunkLines;
+        anSrc.resize(nChunkValues);
+        afDist.resize(nChunkValues);
+        adfSquareDist.resize(nChunkValues);
+        anNearestLine.resize(nXSize);
+        aanVertices.resize(nThreads, std::vector<int>(nXSize));
+        aadfVertexValues.resize(nThreads, std::vector<double>(nXSize));
+        aadfBounds.resize(nThreads, std::vector<double>(nXSize + 1));
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate working buffers for proximity computation");
+        return CE_Failure;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+        poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+
+    // Run pfnJob(iJob, nStart, nEnd) on nThreads sub-ranges of [0, nCount[
+    const auto RunJobs = [nThreads, &poJobQueue](int nCount, const auto &pfnJob)
+    {
+        if (!poJobQueue)
+        {
+            pfnJob(0, 0, nCount);
+            return;
+        }
+        for (int iJob = 0; iJob < nThreads; iJob++)
+        {
+            const int nStart = static_cast<int>(
+                static_cast<GIntBig>(nCount) * iJob / nThreads);
+            const int nEnd = static_cast<int>(static_cast<GIntBig>(nCount) *
+                                              (iJob + 1) / nThreads);
+            if (nStart < nEnd)
+            {
+                poJobQueue->SubmitJob([&pfnJob, iJob, nStart, nEnd]()
+                                      { pfnJob(iJob, nStart, nEnd); });
+            }
+        }
+        poJobQueue->WaitCompletion();
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      Top to bottom pass: vertical distance to the nearest target     */
+    /*      pixel above.                                                    */
+    /* -------------------------------------------------------------------- */
+    std::fill(anNearestLine.begin(), anNearestLine.end(), -1);
+
+    for (int iChunkLine = 0; iChunkLine < nYSize; iChunkLine += nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, nYSize - iChunkLine);
+        CPLErr eErr =
+            GDALRasterIO(hSrcBand, GF_Read, 0, iChunkLine, nXSize, nLines,
+                         anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            return eErr;
+
+        RunJobs(nXSize,
+                [&](int, int nStartX, int nEndX)
+                {
+                    for (int i = 0; i < nLines; i++)
+                    {
+                        const int iLine = iChunkLine + i;
+                        const size_t nOffset = static_cast<size_t>(i) * nXSize;
+                        for (int iX = nStartX; iX < nEndX; iX++)
+                        {
+                            if (IsTargetValue(anSrc[nOffset + iX],
+                                              nTargetValues, panTargetValues))
+                                anNearestLine[iX] = iLine;
+                            afDist[nOffset + iX] =
+                                anNearestLine[iX] < 0
+                                    ? -1.0f
+                                    : static_cast<float>(iLine -
+                                                         anNearestLine[iX]);
+                        }
+                    }
+                });
+
+        eErr = GDALRasterIO(hWorkProximityBand, GF_Write, 0, iChunkLine,
+                            nXSize, nLines, afDist.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            return eErr;
+
+        if (!pfnProgress(0.5 * (iChunkLine + nLines) /
+                             static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Bottom to top pass: combine with the vertical distance to the   */
+    /*      nearest target pixel below, and compute the distances along     */
+    /*      each line.                                                      */
+    /* -------------------------------------------------------------------- */
+    std::fill(anNearestLine.begin(), anNearestLine.end(), -1);
+
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    const double dfMaxDistSq = dfMaxDist * dfMaxDist;
+
+    for (int iChunkEnd = nYSize; iChunkEnd > 0; iChunkEnd -= nChunkLines)
+    {
+        const int nLines = std::min(nChunkLines, iChunkEnd);
+        const int iChunkLine = iChunkEnd - nLines;
+        CPLErr eErr =
+            GDALRasterIO(hSrcBand, GF_Read, 0, iChunkLine, nXSize, nLines,
+                         anSrc.data(), nXSize, nLines, GDT_Int32, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hWorkProximityBand, GF_Read, 0, iChunkLine,
+                                nXSize, nLines, afDist.data(), nXSize, nLines,
+                                GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            return eErr;
+
+        RunJobs(nXSize,
+                [&](int, int nStartX, int nEndX)
+                {
+                    for (int i = nLines - 1; i >= 0; i--)
+                    {
+                        const int iLine = iChunkLine + i;
+                        const size_t nOffset = static_cast<size_t>(i) * nXSize;
+                        for (int iX = nStartX; iX < nEndX; iX++)
+                        {
+                            if (IsTargetValue(anSrc[nOffset + iX],
+                                              nTargetValues, panTargetValues))
+                                anNearestLine[iX] = iLine;
+                            double dfDist = afDist[nOffset + iX];
+                            if (dfDist < 0)
+                                dfDist = INF;
+                            if (anNearestLine[iX] >= 0)
+                                dfDist = std::min<double>(
+                                    dfDist, anNearestLine[iX] - iLine);
+                            // Pixels beyond MAXDIST cannot be the nearest
+                            // target of a pixel within MAXDIST.
+                            adfSquareDist[nOffset + iX] =
+                                dfDist <= dfMaxDist ? dfDist * dfDist : INF;
+                        }
+                    }
+                });
+
+        RunJobs(nLines,
+                [&](int iJob, int nStartLine, int nEndLine)
+                {
+                    for (int i = nStartLine; i < nEndLine; i++)
+                    {
+                        const size_t nOffset = static_cast<size_t>(i) * nXSize;
+                        double *padfLine = adfSquareDist.data() + nOffset;
+                        ComputeLineSquareDistances(
+                            padfLine, nXSize, aanVertices[iJob].data(),
+                            aadfVertexValues[iJob].data(),
+                            aadfBounds[iJob].data());
+
+                        // Final post processing of distances, consistent
+                        // with ALGORITHM=SCANLINE.
+                        for (int iX = 0; iX < nXSize; iX++)
+                        {
+                            const double dfDistSq = padfLine[iX];
+                            float &fOut = afDist[nOffset + iX];
+                            if (dfDistSq == 0)
+                                fOut = 0.0f;
+                            else if (dfDistSq > dfMaxDistSq ||
+                                     (pdfSrcNoDataValue &&
+                                      anSrc[nOffset + iX] ==
+                                          *pdfSrcNoDataValue))
+                                fOut = fNoDataValue;
+                            else if (bFixedBufVal)
+                                fOut = static_cast<float>(dfFixedBufVal);
+                            else
+                                fOut = static_cast<float>(
+                                    static_cast<float>(sqrt(dfDistSq)) *
+                                    dfDistMult);
+                        }
+                    }
+                });
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iChunkLine, nXSize,
+                            nLines, afDist.data(), nXSize, nLines, GDT_Float32,
+                            0, 0);
+        if (eErr != CE_None)
+            return eErr;
+
+        if (!pfnProgress(0.5 + 0.5 * (nYSize - iChunkLine) /
+                                   static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
@@ -20,6 +20,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <atomic>
+#include <cmath>
 #include <limits>
 #include <vector>
 #include <algorithm>
@@ -29,9 +31,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -117,10 +121,19 @@ static inline void gvBurnScanlineBasic(GDALRasterizeInfo *psInfo, int nY,
         {
             T nVal;
             GDALCopyWord(burnValue, nVal);
-            for (int nX = nXStart; nX <= nXEnd; ++nX)
+            if (psInfo->nPixelSpace == static_cast<int>(sizeof(T)))
             {
-                *reinterpret_cast<T *>(pabyInsert) = nVal;
-                pabyInsert += psInfo->nPixelSpace;
+                // Contiguous span: let the compiler vectorize the fill.
+                std::fill_n(reinterpret_cast<T *>(pabyInsert),
+                            nXEnd - nXStart + 1, nVal);
+            }
+            else
+            {
+                for (int nX = nXStart; nX <= nXEnd; ++nX)
+                {
+                    *reinterpret_cast<T *>(pabyInsert) = nVal;
+                    pabyInsert += psInfo->nPixelSpace;
+                }
             }
         }
     }
@@ -170,6 +183,11 @@ static inline void gvBurnScanlineInt64UserBurnValue(GDALRasterizeInfo *psInfo,
                 }
             }
         }
+        else if (psInfo->nPixelSpace == static_cast<int>(sizeof(std::int64_t)))
+        {
+            std::fill_n(reinterpret_cast<std::int64_t *>(pabyInsert),
+                        nXEnd - nXStart + 1, burnValue);
+        }
         else
         {
             for (int nX = nXStart; nX <= nXEnd; ++nX)
@@ -925,6 +943,15 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * with tiled images to be efficient. The auto mode (the default) will chose
  * the algorithm based on input and output properties.
  * </li>
+ * <li>"NUM_THREADS": (GDAL >= 3.11) Number of worker threads, or "ALL_CPUS".
+ * Defaults to 1. When greater than 1, and unless OPTIM=VECTOR is set, the
+ * raster is processed by swaths of lines in parallel, each swath burning
+ * only the geometries whose extent intersects it (results are identical to
+ * OPTIM=RASTER with the same CHUNKYSIZE). CHUNKYSIZE may be used to set the
+ * height of the swaths. The transformer
+ * must be cloneable with GDALCloneTransformer(), otherwise a single thread
+ * is used.
+ * </li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1016,6 +1043,329 @@ CPLErr GDALRasterizeGeometriesInt64(
         pfnProgress, pProgressArg);
 }
 
+/************************************************************************/
+/*                GDALRasterizeGeometriesMultiThreaded()                */
+/************************************************************************/
+
+namespace
+{
+struct GDALRasterizeSwath
+{
+    int nYOff = 0;
+    int nLines = 0;
+    std::vector<GByte> abyBuffer{};
+    // Transformer owned by this swath slot, as transformers are not
+    // thread-safe in general.
+    void *pTransformArg = nullptr;
+    bool bOK = false;
+    std::atomic<bool> bDone{false};
+};
+}  // namespace
+
+// Same result as the OPTIM=RASTER algorithm, with the raster processed by
+// swaths of full lines, concurrently by nThreads threads of the global thread
+// pool. The range of lines covered by each geometry is computed once, so
+// that each swath only burns the geometries that intersect it, in their
+// original order, instead of all geometries. Swaths that no geometry
+// intersects are not read nor written. Swaths are read and written by the
+// calling thread, and at most 2 * nThreads swaths are in memory at once.
+//
+// *pbProcessed is set to false if the transformer cannot be cloned for
+// the worker threads, in which case nothing is done.
+static CPLErr GDALRasterizeGeometriesMultiThreaded(
+    GDALDataset *poDS, int nBandCount, const int *panBandList, int nGeomCount,
+    const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, GDALDataType eBurnValueType,
+    const double *padfGeomBurnValues, const int64_t *panGeomBurnValues,
+    int bAllTouched, GDALBurnValueSrc eBurnValueSource,
+    GDALRasterMergeAlg eMergeAlg, int nYChunkSize, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg, bool *pbProcessed)
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const GDALDataType eType = GDALGetNonComplexDataType(
+        poDS->GetRasterBand(panBandList[0])->GetRasterDataType());
+    const size_t nScanlineBytes = static_cast<size_t>(nBandCount) * nXSize *
+                                  GDALGetDataTypeSizeBytes(eType);
+
+    // Enough swaths to balance the load between threads, within the block
+    // cache size for the swaths in memory.
+    if (nYChunkSize <= 0)
+    {
+        const GIntBig nYChunkSize64 =
+            GDALGetCacheMax64() / (2 * nThreads) / nScanlineBytes;
+        nYChunkSize = static_cast<int>(std::min<GIntBig>(
+            nYChunkSize64, (nYSize + 2 * nThreads - 1) / (2 * nThreads)));
+    }
+    nYChunkSize = std::max(1, std::min(nYChunkSize, nYSize));
+    const int nSwaths = (nYSize + nYChunkSize - 1) / nYChunkSize;
+
+    std::vector<GDALRasterizeSwath> asSwaths(2 * nThreads);
+    const auto DestroyTransformers = [&asSwaths]()
+    {
+        for (auto &sSwath : asSwaths)
+        {
+            if (sSwath.pTransformArg)
+                GDALDestroyTransformer(sSwath.pTransformArg);
+        }
+    };
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        for (auto &sSwath : asSwaths)
+        {
+            sSwath.pTransformArg =
+                pTransformArg ? GDALCloneTransformer(pTransformArg) : nullptr;
+            if (sSwath.pTransformArg == nullptr)
+            {
+                CPLDebug("GDAL", "Cannot clone transformer: rasterizing with "
+                                 "a single thread");
+                DestroyTransformers();
+                *pbProcessed = false;
+                return CE_None;
+            }
+        }
+    }
+    *pbProcessed = true;
+
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the range of lines of each geometry, with a margin of   */
+    /*      one line for rounding and ALL_TOUCHED.                          */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anMinLine, anMaxLine;
+    std::vector<std::vector<int>> aanSwathGeoms;
+    try
+    {
+        anMinLine.resize(nGeomCount);
+        anMaxLine.resize(nGeomCount);
+        aanSwathGeoms.resize(nSwaths);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        DestroyTransformers();
+        return CE_Failure;
+    }
+
+    std::atomic<bool> bOK{true};
+    const int nGeomPerJob = (nGeomCount + nThreads - 1) / nThreads;
+    for (int iJob = 0; iJob < nThreads; ++iJob)
+    {
+        const int iStart = iJob * nGeomPerJob;
+        const int iEnd = std::min(nGeomCount, iStart + nGeomPerJob);
+        if (iStart >= iEnd)
+            break;
+        void *pJobTransformArg = asSwaths[iJob].pTransformArg;
+        poJobQueue->SubmitJob(
+            [&, iStart, iEnd, pJobTransformArg]()
+            {
+                std::vector<double> aPointX, aPointY, aPointVariant;
+                std::vector<int> aPartSize, anSuccess;
+                try
+                {
+                    for (int i = iStart; i < iEnd; ++i)
+                    {
+                        aPointX.clear();
+                        aPointY.clear();
+                        aPointVariant.clear();
+                        aPartSize.clear();
+                        GDALCollectRingsFromGeometry(
+                            OGRGeometry::FromHandle(pahGeometries[i]), aPointX,
+                            aPointY, aPointVariant, aPartSize,
+                            eBurnValueSource);
+                        if (aPointX.empty())
+                        {
+                            anMinLine[i] = 0;
+                            anMaxLine[i] = -1;
+                            continue;
+                        }
+                        anSuccess.resize(aPointX.size());
+                        pfnTransformer(pJobTransformArg, FALSE,
+                                       static_cast<int>(aPointX.size()),
+                                       aPointX.data(), aPointY.data(), nullptr,
+                                       anSuccess.data());
+                        double dfMinY = std::numeric_limits<double>::max();
+                        double dfMaxY = -std::numeric_limits<double>::max();
+                        for (size_t j = 0; j < aPointY.size(); ++j)
+                        {
+                            // Unknown or invalid positions: burn the geometry
+                            // in all swaths, as the sequential algorithm
+                            // does.
+                            if (!anSuccess[j] || std::isnan(aPointY[j]))
+                            {
+                                dfMinY = -std::numeric_limits<double>::max();
+                                dfMaxY = std::numeric_limits<double>::max();
+                                break;
+                            }
+                            dfMinY = std::min(dfMinY, aPointY[j]);
+                            dfMaxY = std::max(dfMaxY, aPointY[j]);
+                        }
+                        anMinLine[i] = static_cast<int>(
+                            std::max(-1.0, std::floor(dfMinY) - 1));
+                        anMaxLine[i] = static_cast<int>(
+                            std::min(static_cast<double>(nYSize),
+                                     std::floor(dfMaxY) + 1));
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in GDALRasterizeGeometries()");
+                    bOK = false;
+                }
+            });
+    }
+    poJobQueue->WaitCompletion();
+    if (!bOK)
+    {
+        DestroyTransformers();
+        return CE_Failure;
+    }
+
+    try
+    {
+        for (int i = 0; i < nGeomCount; ++i)
+        {
+            const int nMinLine = std::max(0, anMinLine[i]);
+            const int nMaxLine = std::min(nYSize - 1, anMaxLine[i]);
+            for (int iSwath = nMinLine / nYChunkSize;
+                 nMinLine <= nMaxLine && iSwath <= nMaxLine / nYChunkSize;
+                 ++iSwath)
+            {
+                aanSwathGeoms[iSwath].push_back(i);
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterizeGeometries()");
+        DestroyTransformers();
+        return CE_Failure;
+    }
+    anMinLine.clear();
+    anMaxLine.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Burn the swaths.                                                */
+    /* -------------------------------------------------------------------- */
+    const auto BurnSwath = [&](GDALRasterizeSwath &sSwath,
+                               const std::vector<int> &anGeoms)
+    {
+        for (const int iShape : anGeoms)
+        {
+            gv_rasterize_one_shape(
+                sSwath.abyBuffer.data(), 0, sSwath.nYOff, nXSize,
+                sSwath.nLines, nBandCount, eType, 0, 0, 0, bAllTouched,
+                OGRGeometry::FromHandle(pahGeometries[iShape]), eBurnValueType,
+                padfGeomBurnValues ? padfGeomBurnValues +
+                                         static_cast<size_t>(iShape) *
+                                             nBandCount
+                                   : nullptr,
+                panGeomBurnValues ? panGeomBurnValues +
+                                        static_cast<size_t>(iShape) * nBandCount
+                                  : nullptr,
+                eBurnValueSource, eMergeAlg, pfnTransformer,
+                sSwath.pTransformArg);
+        }
+    };
+
+    CPLErr eErr = CE_None;
+    pfnProgress(0.0, nullptr, pProgressArg);
+    int iNextToRead = 0;
+    for (int i = 0; i < nSwaths && eErr == CE_None; ++i)
+    {
+        while (iNextToRead < nSwaths &&
+               iNextToRead - i < static_cast<int>(asSwaths.size()))
+        {
+            auto &sSwath = asSwaths[iNextToRead % asSwaths.size()];
+            const auto &anGeoms = aanSwathGeoms[iNextToRead];
+            sSwath.nYOff = iNextToRead * nYChunkSize;
+            sSwath.nLines = std::min(nYChunkSize, nYSize - sSwath.nYOff);
+            ++iNextToRead;
+            if (anGeoms.empty())
+            {
+                sSwath.bOK = true;
+                sSwath.bDone = true;
+                continue;
+            }
+            try
+            {
+                sSwath.abyBuffer.resize(nScanlineBytes * sSwath.nLines);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating swath buffer");
+                eErr = CE_Failure;
+                break;
+            }
+            eErr = poDS->RasterIO(GF_Read, 0, sSwath.nYOff, nXSize,
+                                  sSwath.nLines, sSwath.abyBuffer.data(),
+                                  nXSize, sSwath.nLines, eType, nBandCount,
+                                  panBandList, 0, 0, 0, nullptr);
+            if (eErr != CE_None)
+                break;
+
+            sSwath.bDone = false;
+            poJobQueue->SubmitJob(
+                [&sSwath, &anGeoms, &BurnSwath]()
+                {
+                    try
+                    {
+                        BurnSwath(sSwath, anGeoms);
+                        sSwath.bOK = true;
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Out of memory in GDALRasterizeGeometries()");
+                        sSwath.bOK = false;
+                    }
+                    sSwath.bDone = true;
+                });
+        }
+        if (eErr != CE_None)
+            break;
+
+        auto &sSwath = asSwaths[i % asSwaths.size()];
+        while (!sSwath.bDone && poJobQueue->WaitEvent())
+        {
+        }
+        if (!sSwath.bOK)
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        if (!aanSwathGeoms[i].empty())
+        {
+            eErr = poDS->RasterIO(GF_Write, 0, sSwath.nYOff, nXSize,
+                                  sSwath.nLines, sSwath.abyBuffer.data(),
+                                  nXSize, sSwath.nLines, eType, nBandCount,
+                                  panBandList, 0, 0, 0, nullptr);
+            // Release memory of the geometry list.
+            std::vector<int>().swap(aanSwathGeoms[i]);
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress((sSwath.nYOff + sSwath.nLines) /
+                             static_cast<double>(nYSize),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    // Jobs reference asSwaths.
+    poJobQueue->WaitCompletion();
+    DestroyTransformers();
+
+    return eErr;
+}
+
 static CPLErr GDALRasterizeGeometriesInternal(
     GDALDatasetH hDS, int nBandCount, const int *panBandList, int nGeomCount,
     const OGRGeometryH *pahGeometries, GDALTransformerFunc pfnTransformer,
@@ -1106,6 +1456,36 @@ static CPLErr GDALRasterizeGeometriesInternal(
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Multi-threaded rasterization by swaths, unless the vector       */
+    /*      optimization is explicitly requested.                           */
+    /* -------------------------------------------------------------------- */
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads && eOptim != GRO_Vector)
+    {
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                           ? CPLGetNumCPUs()
+                           : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+        if (nThreads > 1)
+        {
+            bool bProcessed = false;
+            const CPLErr eErr = GDALRasterizeGeometriesMultiThreaded(
+                poDS, nBandCount, panBandList, nGeomCount, pahGeometries,
+                pfnTransformer, pTransformArg, eBurnValueType,
+                padfGeomBurnValues, panGeomBurnValues, bAllTouched,
+                eBurnValueSource, eMergeAlg,
+                atoi(CSLFetchNameValueDef(papszOptions, "CHUNKYSIZE", "0")),
+                nThreads, pfnProgress, pProgressArg, &bProcessed);
+            if (bProcessed)
+            {
+                if (bNeedToFreeTransformer)
+                    GDALDestroyTransformer(pTransformArg);
+                return eErr;
+            }
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Choice of optimisation in auto mode. Use vector optim :         */
     /*      1) if output is tiled                                           */
@@ -17,16 +17,23 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
@@ -57,14 +64,16 @@
 /************************************************************************/
 
 static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
-                              int iY, int nXSize, std::int64_t *panImageLine)
+                              int iY, int nXSize, std::int64_t *panImageLine,
+                              int nLines = 1)
 
 {
-    const CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                                     pabyMaskLine, nXSize, 1, GDT_Byte, 0, 0);
+    const CPLErr eErr =
+        GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, nLines, pabyMaskLine,
+                     nXSize, nLines, GDT_Byte, 0, 0);
     if (eErr == CE_None)
     {
-        for (int i = 0; i < nXSize; i++)
+        for (size_t i = 0; i < static_cast<size_t>(nXSize) * nLines; i++)
         {
             if (pabyMaskLine[i] == 0)
                 panImageLine[i] = GP_NODATA_MARKER;
@@ -125,6 +134,721 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
         anBigNeighbour[nPolyId2] = nPolyId1;
 }
 
+/************************************************************************/
+/*                         ResolveBigNeighbours()                       */
+/*                                                                      */
+/*      If our biggest neighbour is still smaller than the              */
+/*      threshold, then try tracking to that polygons biggest           */
+/*      neighbour, and so forth.                                        */
+/************************************************************************/
+
+static void ResolveBigNeighbours(const int *panPolyIdMap,
+                                 const std::int64_t *panPolyValue,
+                                 const std::vector<int> &anPolySizes,
+                                 std::vector<int> &anBigNeighbour,
+                                 int nSizeThreshold)
+{
+    int nFailedMerges = 0;
+    int nIsolatedSmall = 0;
+    int nSieveTargets = 0;
+
+    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
+    {
+        if (panPolyIdMap[iPoly] != iPoly)
+            continue;
+
+        // Ignore nodata polygons.
+        if (panPolyValue[iPoly] == GP_NODATA_MARKER)
+            continue;
+
+        // Don't try to merge polygons larger than the threshold.
+        if (anPolySizes[iPoly] >= nSizeThreshold)
+        {
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        nSieveTargets++;
+
+        // if we have no neighbours but we are small, what shall we do?
+        if (anBigNeighbour[iPoly] == -1)
+        {
+            nIsolatedSmall++;
+            continue;
+        }
+
+        std::set<int> oSetVisitedPoly;
+        oSetVisitedPoly.insert(iPoly);
+
+        // Walk through our neighbours until we find a polygon large enough.
+        int iFinalId = iPoly;
+        bool bFoundBigEnoughPoly = false;
+        while (true)
+        {
+            iFinalId = anBigNeighbour[iFinalId];
+            if (iFinalId < 0)
+            {
+                break;
+            }
+            // If the biggest neighbour is larger than the threshold
+            // then we are golden.
+            if (anPolySizes[iFinalId] >= nSizeThreshold)
+            {
+                bFoundBigEnoughPoly = true;
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
+                break;
+            oSetVisitedPoly.insert(iFinalId);
+        }
+
+        if (!bFoundBigEnoughPoly)
+        {
+            nFailedMerges++;
+            anBigNeighbour[iPoly] = -1;
+            continue;
+        }
+
+        // Map the whole intermediate chain to it.
+        int iPolyCur = iPoly;
+        while (anBigNeighbour[iPolyCur] != iFinalId)
+        {
+            int iNextPoly = anBigNeighbour[iPolyCur];
+            anBigNeighbour[iPolyCur] = iFinalId;
+            iPolyCur = iNextPoly;
+        }
+    }
+
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+}
+
+/************************************************************************/
+/*                               GSStrip                                */
+/************************************************************************/
+
+// Lines [nYOff, nYOff + nLines[ of the raster, processed as a unit by
+// GDALSieveFilterMultiThreaded().
+struct GSStrip
+{
+    int nXSize = 0;
+    int nYOff = 0;
+    int nLines = 0;
+
+    // Pixel values, with masked pixels set to GP_NODATA_MARKER.
+    std::vector<std::int64_t> anVal{};
+    // Pixel values to write, in the last pass.
+    std::vector<std::int64_t> anWriteVal{};
+    std::vector<GByte> abyMask{};
+
+    // Polygon id of each pixel of the strip, or -1 for nodata pixels. Ids
+    // are local to the strip, and numbered consecutively from 0.
+    std::vector<GInt32> anId{};
+    int nPolygons = 0;
+
+    // Size and value of each polygon of the strip, in the first pass.
+    std::vector<int> anPolySizes{};
+    std::vector<std::int64_t> anPolyValue{};
+
+    // (polygon, biggest neighbour) pairs, as global polygon ids, seen on
+    // all lines of the strip but the first one, in the second pass.
+    std::vector<std::pair<GInt32, GInt32>> aoBigNeighbours{};
+
+    bool bOK = false;
+    std::atomic<bool> bDone{false};
+
+    GInt32 *GetLineId(int iLine)
+    {
+        return anId.data() + static_cast<size_t>(iLine) * nXSize;
+    }
+};
+
+/************************************************************************/
+/*                          GSEnumerateStrip()                          */
+/************************************************************************/
+
+static bool GSEnumerateStrip(GSStrip &sStrip, int nConnectedness,
+                             bool bComputeSizes)
+{
+    const int nXSize = sStrip.nXSize;
+    GDALRasterPolygonEnumerator oEnum(nConnectedness);
+    try
+    {
+        sStrip.anId.resize(static_cast<size_t>(nXSize) * sStrip.nLines);
+        for (int iLine = 0; iLine < sStrip.nLines; ++iLine)
+        {
+            std::int64_t *panThisLineVal =
+                sStrip.anVal.data() + static_cast<size_t>(iLine) * nXSize;
+            GInt32 *panThisLineId = sStrip.GetLineId(iLine);
+            const bool bRet =
+                iLine == 0
+                    ? oEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
+                                        panThisLineId, nXSize)
+                    : oEnum.ProcessLine(panThisLineVal - nXSize,
+                                        panThisLineVal, panThisLineId - nXSize,
+                                        panThisLineId, nXSize);
+            if (!bRet)
+                return false;
+        }
+        oEnum.CompleteMerges();
+
+        // Number the final polygons consecutively.
+        std::vector<GInt32> anCompactId(oEnum.nNextPolygonId, -1);
+        sStrip.nPolygons = 0;
+        for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; ++iPoly)
+        {
+            if (oEnum.panPolyIdMap[iPoly] == iPoly)
+                anCompactId[iPoly] = sStrip.nPolygons++;
+        }
+        for (GInt32 &nId : sStrip.anId)
+        {
+            if (nId >= 0)
+                nId = anCompactId[oEnum.panPolyIdMap[nId]];
+        }
+
+        if (bComputeSizes)
+        {
+            sStrip.anPolySizes.assign(sStrip.nPolygons, 0);
+            sStrip.anPolyValue.resize(sStrip.nPolygons);
+            for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; ++iPoly)
+            {
+                if (anCompactId[iPoly] >= 0)
+                    sStrip.anPolyValue[anCompactId[iPoly]] =
+                        oEnum.panPolyValue[iPoly];
+            }
+            for (const GInt32 nId : sStrip.anId)
+            {
+                if (nId >= 0)
+                    sStrip.anPolySizes[nId]++;
+            }
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALSieveFilterMultiThreaded()                    */
+/************************************************************************/
+
+// Same algorithm as the single-threaded code of GDALSieveFilter(), with the
+// raster processed by horizontal strips, concurrently by nThreads threads of
+// the global thread pool. Strips are read and written by the calling thread.
+//
+// Polygons are enumerated within each strip, and unioned across strips with
+// a union-find in the first pass, to get their sizes. Each polygon of each
+// strip is a node of the union-find forest, and polygons are identified by
+// their root node afterwards.
+//
+// The second pass finds the biggest neighbour of each polygon. The
+// single-threaded algorithm retains the first neighbour, in raster order, of
+// the biggest size, so the neighbours seen within a strip are combined
+// the same way, and the biggest neighbours of strips are merged in strip
+// order by the calling thread. The comparisons with the line above a strip
+// and on its first line are done by the calling thread too, as they involve
+// polygons of the previous strip.
+static CPLErr GDALSieveFilterMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+    GDALRasterBandH hDstBand, int nSizeThreshold, int nConnectedness,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Enough strips to balance the load between threads, but strips not
+    // larger than needed, to limit memory usage.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    constexpr size_t BYTES_PER_PIXEL =
+        2 * sizeof(std::int64_t) + sizeof(GInt32) + 1;
+    const int nMaxStripLines = static_cast<int>(std::max<size_t>(
+        1, MAX_STRIP_BYTES / (static_cast<size_t>(nXSize) * BYTES_PER_PIXEL)));
+    const int nStripLines =
+        std::max(1, std::min(nMaxStripLines,
+                             (nYSize + 4 * nThreads - 1) / (4 * nThreads)));
+    const int nStrips = (nYSize + nStripLines - 1) / nStripLines;
+
+    // Strips being computed, and the ones being read or consumed.
+    std::vector<GSStrip> asStrips(2 * nThreads);
+
+    const auto ReadStrip = [hSrcBand, hMaskBand, nXSize, nYSize,
+                            nStripLines](GSStrip &sStrip, int iStrip,
+                                         bool bKeepWriteVal)
+    {
+        sStrip.nXSize = nXSize;
+        sStrip.nYOff = iStrip * nStripLines;
+        sStrip.nLines = std::min(nStripLines, nYSize - sStrip.nYOff);
+        const size_t nPixels = static_cast<size_t>(nXSize) * sStrip.nLines;
+        try
+        {
+            sStrip.anVal.resize(nPixels);
+            if (hMaskBand)
+                sStrip.abyMask.resize(nPixels);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory allocating strip buffers");
+            return CE_Failure;
+        }
+        CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, sStrip.nYOff, nXSize,
+                                   sStrip.nLines, sStrip.anVal.data(), nXSize,
+                                   sStrip.nLines, GDT_Int64, 0, 0);
+        if (eErr == CE_None && bKeepWriteVal)
+        {
+            try
+            {
+                sStrip.anWriteVal = sStrip.anVal;
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating strip buffers");
+                return CE_Failure;
+            }
+        }
+        if (eErr == CE_None && hMaskBand != nullptr)
+            eErr = GPMaskImageData(hMaskBand, sStrip.abyMask.data(),
+                                   sStrip.nYOff, nXSize, sStrip.anVal.data(),
+                                   sStrip.nLines);
+        return eErr;
+    };
+
+    // Compute all strips concurrently with pfnCompute(), and consume them
+    // in order with pfnConsume().
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    const auto ProcessStrips =
+        [&asStrips, &poJobQueue, &ReadStrip, nStrips](
+            bool bKeepWriteVal,
+            const std::function<bool(GSStrip &, int)> &pfnCompute,
+            const std::function<CPLErr(GSStrip &, int)> &pfnConsume)
+    {
+        CPLErr eErr = CE_None;
+        int iNextToRead = 0;
+        for (int i = 0; i < nStrips && eErr == CE_None; ++i)
+        {
+            while (eErr == CE_None && iNextToRead < nStrips &&
+                   iNextToRead - i < static_cast<int>(asStrips.size()))
+            {
+                auto &sStrip = asStrips[iNextToRead % asStrips.size()];
+                const int iStrip = iNextToRead;
+                eErr = ReadStrip(sStrip, iStrip, bKeepWriteVal);
+                if (eErr != CE_None)
+                    break;
+
+                sStrip.bDone = false;
+                poJobQueue->SubmitJob(
+                    [&sStrip, &pfnCompute, iStrip]()
+                    {
+                        sStrip.bOK = pfnCompute(sStrip, iStrip);
+                        sStrip.bDone = true;
+                    });
+                ++iNextToRead;
+            }
+            if (eErr != CE_None)
+                break;
+
+            auto &sStrip = asStrips[i % asStrips.size()];
+            while (!sStrip.bDone && poJobQueue->WaitEvent())
+            {
+            }
+            eErr = sStrip.bOK ? pfnConsume(sStrip, i) : CE_Failure;
+        }
+
+        // Jobs reference asStrips.
+        poJobQueue->WaitCompletion();
+        return eErr;
+    };
+
+    const auto ReportProgress =
+        [pfnProgress, pProgressArg, nYSize](double dfBase, double dfScale,
+                                            const GSStrip &sStrip)
+    {
+        if (!pfnProgress(dfBase + dfScale * (sStrip.nYOff + sStrip.nLines) /
+                                      nYSize,
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: polygon sizes, and union of polygons across         */
+    /*      strips.                                                         */
+    /* -------------------------------------------------------------------- */
+
+    // Union-find forest of the polygons of all strips, numbered
+    // consecutively, from anNodeBase[iStrip] for each strip.
+    std::vector<GInt32> anParent;
+    std::vector<int> anPolySizes;
+    std::vector<std::int64_t> anPolyValue;
+    std::vector<GInt32> anNodeBase;
+    // Node and value of each pixel of the last line of the previous strip.
+    std::vector<GInt32> anPrevLastLineNode;
+    std::vector<std::int64_t> anPrevLastLineVal;
+    try
+    {
+        anNodeBase.resize(nStrips);
+        anPrevLastLineNode.resize(nXSize);
+        anPrevLastLineVal.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALSieveFilter()");
+        return CE_Failure;
+    }
+
+    const auto FindRoot = [&anParent](GInt32 nNode)
+    {
+        while (anParent[nNode] != nNode)
+        {
+            anParent[nNode] = anParent[anParent[nNode]];
+            nNode = anParent[nNode];
+        }
+        return nNode;
+    };
+
+    const auto ComputeStripPass1 = [nConnectedness](GSStrip &sStrip, int)
+    { return GSEnumerateStrip(sStrip, nConnectedness, true); };
+
+    const auto ConsumeStripPass1 = [&](GSStrip &sStrip, int iStrip)
+    {
+        const GInt32 nNodeBase = static_cast<GInt32>(anParent.size());
+        if (sStrip.nPolygons >
+            std::numeric_limits<GInt32>::max() - 1 - nNodeBase)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALSieveFilter(): too many polygons");
+            return CE_Failure;
+        }
+        try
+        {
+            anNodeBase[iStrip] = nNodeBase;
+            for (int i = 0; i < sStrip.nPolygons; ++i)
+                anParent.push_back(nNodeBase + i);
+            anPolySizes.insert(anPolySizes.end(), sStrip.anPolySizes.begin(),
+                               sStrip.anPolySizes.end());
+            anPolyValue.insert(anPolyValue.end(), sStrip.anPolyValue.begin(),
+                               sStrip.anPolyValue.end());
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALSieveFilter()");
+            return CE_Failure;
+        }
+
+        // Union the polygons of the first line with the ones of the last
+        // line of the previous strip they are connected to.
+        const GInt32 *panLineId = sStrip.GetLineId(0);
+        if (iStrip > 0)
+        {
+            const std::int64_t *panLineVal = sStrip.anVal.data();
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                if (panLineId[iX] < 0)
+                    continue;
+                const int iXStart =
+                    nConnectedness == 8 ? std::max(0, iX - 1) : iX;
+                const int iXEnd =
+                    nConnectedness == 8 ? std::min(nXSize - 1, iX + 1) : iX;
+                for (int i = iXStart; i <= iXEnd; ++i)
+                {
+                    if (anPrevLastLineNode[i] < 0 ||
+                        anPrevLastLineVal[i] != panLineVal[iX])
+                        continue;
+                    const GInt32 nAboveRoot = FindRoot(anPrevLastLineNode[i]);
+                    const GInt32 nCurRoot = FindRoot(nNodeBase + panLineId[iX]);
+                    if (nAboveRoot < nCurRoot)
+                        anParent[nCurRoot] = nAboveRoot;
+                    else if (nCurRoot < nAboveRoot)
+                        anParent[nAboveRoot] = nCurRoot;
+                }
+            }
+        }
+
+        panLineId = sStrip.GetLineId(sStrip.nLines - 1);
+        const std::int64_t *panLineVal =
+            sStrip.anVal.data() +
+            static_cast<size_t>(sStrip.nLines - 1) * nXSize;
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            anPrevLastLineNode[iX] =
+                panLineId[iX] >= 0 ? nNodeBase + panLineId[iX] : -1;
+            anPrevLastLineVal[iX] = panLineVal[iX];
+        }
+
+        return ReportProgress(0.0, 0.25, sStrip);
+    };
+
+    CPLErr eErr = ProcessStrips(false, ComputeStripPass1, ConsumeStripPass1);
+    anPrevLastLineVal.clear();
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Check if there are polygons                                     */
+    /* -------------------------------------------------------------------- */
+    if (anParent.empty())
+    {
+        // Can happen if all pixels are masked
+        if (hSrcBand == hDstBand)
+        {
+            pfnProgress(1.0, "", pProgressArg);
+            return CE_None;
+        }
+        else
+        {
+            return GDALRasterBandCopyWholeRaster(hSrcBand, hDstBand, nullptr,
+                                                 pfnProgress, pProgressArg);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Point every node to its root, read concurrently by the          */
+    /*      computation of strips, and push the sizes of the polygons of    */
+    /*      strips into the size of their root.                             */
+    /* -------------------------------------------------------------------- */
+    for (GInt32 i = 0; i < static_cast<GInt32>(anParent.size()); ++i)
+    {
+        const GInt32 nRoot = FindRoot(i);
+        anParent[i] = nRoot;
+        if (nRoot != i)
+        {
+            const GIntBig nSize =
+                static_cast<GIntBig>(anPolySizes[nRoot]) + anPolySizes[i];
+            anPolySizes[nRoot] =
+                static_cast<int>(std::min<GIntBig>(nSize, MY_MAX_INT));
+            anPolySizes[i] = 0;
+        }
+    }
+
+    std::vector<int> anBigNeighbour;
+    try
+    {
+        anBigNeighbour.resize(anPolySizes.size(), -1);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
+        return CE_Failure;
+    }
+
+    /* ==================================================================== */
+    /*      Second pass ... identify the largest neighbour for each         */
+    /*      polygon.                                                        */
+    /* ==================================================================== */
+    const auto ComputeStripPass2 =
+        [nConnectedness, &anParent, &anPolySizes,
+         &anNodeBase](GSStrip &sStrip, int iStrip)
+    {
+        if (!GSEnumerateStrip(sStrip, nConnectedness, false))
+            return false;
+
+        // Polygons of the strip with the same root are handled as one, in
+        // slots numbered consecutively.
+        std::vector<GInt32> anSlotRoot;
+        std::vector<GInt32> anSlotBigNeighbour;
+        try
+        {
+            std::vector<GInt32> anSlot(sStrip.nPolygons);
+            std::unordered_map<GInt32, GInt32> oMapRootToSlot;
+            for (int i = 0; i < sStrip.nPolygons; ++i)
+            {
+                const GInt32 nRoot = anParent[anNodeBase[iStrip] + i];
+                const auto oIter = oMapRootToSlot.find(nRoot);
+                if (oIter != oMapRootToSlot.end())
+                {
+                    anSlot[i] = oIter->second;
+                }
+                else
+                {
+                    anSlot[i] = static_cast<GInt32>(anSlotRoot.size());
+                    oMapRootToSlot[nRoot] = anSlot[i];
+                    anSlotRoot.push_back(nRoot);
+                }
+            }
+            anSlotBigNeighbour.resize(anSlotRoot.size(), -1);
+            for (GInt32 &nId : sStrip.anId)
+            {
+                if (nId >= 0)
+                    nId = anSlot[nId];
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALSieveFilter()");
+            return false;
+        }
+
+        // Same as CompareNeighbour(), on slots.
+        const auto CompareSlots = [&anSlotRoot, &anSlotBigNeighbour,
+                                   &anPolySizes](GInt32 nSlot1, GInt32 nSlot2)
+        {
+            if (nSlot1 < 0 || nSlot2 < 0 || nSlot1 == nSlot2)
+                return;
+            const int nSize1 = anPolySizes[anSlotRoot[nSlot1]];
+            const int nSize2 = anPolySizes[anSlotRoot[nSlot2]];
+
+            if (anSlotBigNeighbour[nSlot1] == -1 ||
+                anPolySizes[anSlotRoot[anSlotBigNeighbour[nSlot1]]] < nSize2)
+                anSlotBigNeighbour[nSlot1] = nSlot2;
+
+            if (anSlotBigNeighbour[nSlot2] == -1 ||
+                anPolySizes[anSlotRoot[anSlotBigNeighbour[nSlot2]]] < nSize1)
+                anSlotBigNeighbour[nSlot2] = nSlot1;
+        };
+
+        const int nXSizeStrip = sStrip.nXSize;
+        for (int iLine = 1; iLine < sStrip.nLines; ++iLine)
+        {
+            const GInt32 *panThisLineId = sStrip.GetLineId(iLine);
+            const GInt32 *panLastLineId = panThisLineId - nXSizeStrip;
+            for (int iX = 0; iX < nXSizeStrip; iX++)
+            {
+                CompareSlots(panThisLineId[iX], panLastLineId[iX]);
+                if (iX > 0 && nConnectedness == 8)
+                    CompareSlots(panThisLineId[iX], panLastLineId[iX - 1]);
+                if (iX < nXSizeStrip - 1 && nConnectedness == 8)
+                    CompareSlots(panThisLineId[iX], panLastLineId[iX + 1]);
+                if (iX > 0)
+                    CompareSlots(panThisLineId[iX], panThisLineId[iX - 1]);
+            }
+        }
+
+        sStrip.aoBigNeighbours.clear();
+        for (size_t i = 0; i < anSlotRoot.size(); ++i)
+        {
+            if (anSlotBigNeighbour[i] >= 0)
+                sStrip.aoBigNeighbours.emplace_back(
+                    anSlotRoot[i], anSlotRoot[anSlotBigNeighbour[i]]);
+        }
+
+        // The calling thread only needs the roots of the first and last
+        // lines.
+        for (int iLine : {0, sStrip.nLines - 1})
+        {
+            GInt32 *panLineId = sStrip.GetLineId(iLine);
+            for (int iX = 0; iX < nXSizeStrip; iX++)
+            {
+                if (panLineId[iX] >= 0)
+                    panLineId[iX] = anSlotRoot[panLineId[iX]];
+            }
+            if (sStrip.nLines == 1)
+                break;
+        }
+        return true;
+    };
+
+    // Root of each pixel of the last line of the previous strip.
+    GInt32 *panLastLineRoot = anPrevLastLineNode.data();
+    const auto ConsumeStripPass2 = [&](GSStrip &sStrip, int iStrip)
+    {
+        // Comparisons of the first line, in the same order as in the
+        // single-threaded algorithm.
+        const GInt32 *panThisLineRoot = sStrip.GetLineId(0);
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (iStrip > 0)
+            {
+                CompareNeighbour(panThisLineRoot[iX], panLastLineRoot[iX],
+                                 anParent.data(), anPolyValue.data(),
+                                 anPolySizes, anBigNeighbour);
+
+                if (iX > 0 && nConnectedness == 8)
+                    CompareNeighbour(panThisLineRoot[iX],
+                                     panLastLineRoot[iX - 1], anParent.data(),
+                                     anPolyValue.data(), anPolySizes,
+                                     anBigNeighbour);
+
+                if (iX < nXSize - 1 && nConnectedness == 8)
+                    CompareNeighbour(panThisLineRoot[iX],
+                                     panLastLineRoot[iX + 1], anParent.data(),
+                                     anPolyValue.data(), anPolySizes,
+                                     anBigNeighbour);
+            }
+
+            if (iX > 0)
+                CompareNeighbour(panThisLineRoot[iX], panThisLineRoot[iX - 1],
+                                 anParent.data(), anPolyValue.data(),
+                                 anPolySizes, anBigNeighbour);
+        }
+
+        // The biggest neighbour of a polygon within the strip is the first
+        // one of the biggest size, and so is its biggest neighbour overall
+        // if it is strictly larger than the one of the previous lines.
+        for (const auto &oPair : sStrip.aoBigNeighbours)
+        {
+            const GInt32 nPoly = oPair.first;
+            const GInt32 nNeighbour = oPair.second;
+            if (anBigNeighbour[nPoly] == -1 ||
+                anPolySizes[anBigNeighbour[nPoly]] < anPolySizes[nNeighbour])
+                anBigNeighbour[nPoly] = nNeighbour;
+        }
+
+        std::copy_n(sStrip.GetLineId(sStrip.nLines - 1), nXSize,
+                    panLastLineRoot);
+
+        return ReportProgress(0.25, 0.25, sStrip);
+    };
+
+    eErr = ProcessStrips(false, ComputeStripPass2, ConsumeStripPass2);
+    anPrevLastLineNode.clear();
+    if (eErr != CE_None)
+        return eErr;
+
+    ResolveBigNeighbours(anParent.data(), anPolyValue.data(), anPolySizes,
+                         anBigNeighbour, nSizeThreshold);
+
+    /* ==================================================================== */
+    /*      Make a third pass over the image, actually applying the         */
+    /*      merges.                                                         */
+    /* ==================================================================== */
+    const auto ComputeStripPass3 =
+        [nConnectedness, &anParent, &anPolyValue, &anBigNeighbour,
+         &anNodeBase](GSStrip &sStrip, int iStrip)
+    {
+        if (!GSEnumerateStrip(sStrip, nConnectedness, false))
+            return false;
+        const GInt32 nNodeBase = anNodeBase[iStrip];
+        for (size_t i = 0; i < sStrip.anId.size(); ++i)
+        {
+            const GInt32 nId = sStrip.anId[i];
+            if (nId >= 0)
+            {
+                const int iBigNeighbour =
+                    anBigNeighbour[anParent[nNodeBase + nId]];
+                if (iBigNeighbour != -1)
+                    sStrip.anWriteVal[i] = anPolyValue[iBigNeighbour];
+            }
+        }
+        return true;
+    };
+
+    const auto ConsumeStripPass3 = [&](GSStrip &sStrip, int)
+    {
+        const CPLErr eErrWrite = GDALRasterIO(
+            hDstBand, GF_Write, 0, sStrip.nYOff, nXSize, sStrip.nLines,
+            sStrip.anWriteVal.data(), nXSize, sStrip.nLines, GDT_Int64, 0, 0);
+        if (eErrWrite != CE_None)
+            return eErrWrite;
+        return ReportProgress(0.5, 0.5, sStrip);
+    };
+
+    return ProcessStrips(true, ComputeStripPass3, ConsumeStripPass3);
+}
+
 /************************************************************************/
 /*                          GDALSieveFilter()                           */
 /************************************************************************/
@@ -156,6 +880,13 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * extremely noisy rasters with many one pixel polygons will end up being
  * expensive (in memory) to process.
  *
+ * With the NUM_THREADS option, the raster is processed by horizontal strips,
+ * concurrently, and polygons spanning several strips are merged. The result
+ * is the same as with a single thread. Memory use is still proportional to
+ * the number of polygons of the whole raster, and not bounded by the strip
+ * size: the enumeration state of a strip is released once it is done, but the
+ * size and neighbour of every polygon must be kept until the end.
+ *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
  * value other than zero will be considered suitable for inclusion in polygons.
@@ -166,8 +897,12 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * The following options are supported:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS. (GDAL >= 3.11) Number of
+ * threads to use. Defaults to 1.</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -179,7 +914,7 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
                                    int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -189,6 +924,18 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+    {
+        int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+        if (nThreads > 1)
+            return GDALSieveFilterMultiThreaded(
+                hSrcBand, hMaskBand, hDstBand, nSizeThreshold, nConnectedness,
+                nThreads, pfnProgress, pProgressArg);
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
@@ -463,86 +1210,8 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         }
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      If our biggest neighbour is still smaller than the              */
-    /*      threshold, then try tracking to that polygons biggest           */
-    /*      neighbour, and so forth.                                        */
-    /* -------------------------------------------------------------------- */
-    int nFailedMerges = 0;
-    int nIsolatedSmall = 0;
-    int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
-    }
-
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
+    ResolveBigNeighbours(oFirstEnum.panPolyIdMap, oFirstEnum.panPolyValue,
+                         anPolySizes, anBigNeighbour, nSizeThreshold);
 
     /* ==================================================================== */
     /*      Make a third pass over the image, actually applying the         */
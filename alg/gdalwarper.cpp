@@ -1146,6 +1146,15 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * <li>CUTLINE_BLEND_DIST: This may be set with a distance in pixels which
  * will be assigned to the dfCutlineBlendDist field in the GDALWarpOptions.</li>
  *
+ * <li>CUTLINE_BLEND_ALGORITHM=GEOS/DISTANCE_TRANSFORM: (GDAL >= 3.11)
+ * Method used to compute the distance of pixels to the cutline boundary when
+ * a blend distance is set. Defaults to GEOS, which computes the exact distance
+ * of each pixel near the boundary with the GEOS library. DISTANCE_TRANSFORM
+ * burns the boundary in raster space and propagates the distances with a
+ * distance transform. It is much faster for large blend distances, does not
+ * require GEOS, and gives the same falloff curve up to a small error on the
+ * distances.</li>
+ *
  * <li>CUTLINE_ALL_TOUCHED: This defaults to FALSE, but may be set to TRUE
  * to enable ALL_TOUCHEd mode when rasterizing cutline polygons.  This is
  * useful to ensure that that all pixels overlapping the cutline polygon
@@ -541,6 +541,16 @@ class CPL_DLL GDALWarpOperation
 
     bool m_bIsTranslationOnPixelBoundaries = false;
 
+    struct ChunkPipeline;
+    struct ChunkPipelineJob;
+
+    CPLErr WarpRegionToBufferInternal(
+        int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+        void *pDataBuf, GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
+        int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
+        double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale,
+        ChunkPipelineJob *psJob);
+
     void WipeChunkList();
     CPLErr CollectChunkListInternal(int nDstXOff, int nDstYOff, int nDstXSize,
                                     int nDstYSize);
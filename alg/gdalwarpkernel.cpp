@@ -75,6 +75,12 @@
 
 #endif
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+#define HAVE_AVX2_DISPATCH
+#include "cpl_cpu_features.h"
+#include "gdalwarpkernel_avx2.h"
+#endif
+
 constexpr double BAND_DENSITY_THRESHOLD = 0.0000000001;
 constexpr float SRC_DENSITY_THRESHOLD = 0.000000001f;
 
@@ -172,6 +178,7 @@ static CPLErr GWKNearestNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
 static CPLErr GWKBilinearNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyByte(GDALWarpKernel *poWK);
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyFloat(GDALWarpKernel *poWK);
+static CPLErr GWKCubicSplineNoMasksOrDstDensityOnlyFloat(GDALWarpKernel *poWK);
 #ifdef INSTANTIATE_FLOAT64_SSE2_IMPL
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyDouble(GDALWarpKernel *poWK);
 #endif
@@ -1273,6 +1280,10 @@ CPLErr GDALWarpKernel::PerformWarp()
         bNoMasksOrDstDensityOnly)
         return GWKCubicNoMasksOrDstDensityOnlyFloat(this);
 
+    if (eWorkingDataType == GDT_Float32 && eResample == GRA_CubicSpline &&
+        bNoMasksOrDstDensityOnly)
+        return GWKCubicSplineNoMasksOrDstDensityOnlyFloat(this);
+
 #ifdef INSTANTIATE_FLOAT64_SSE2_IMPL
     if (eWorkingDataType == GDT_Float64 && eResample == GRA_Bilinear &&
         bNoMasksOrDstDensityOnly)
@@ -2278,6 +2289,35 @@ static bool GWKGetPixelValueReal(const GDALWarpKernel *poWK, int iBand,
     return *pdfDensity != 0.0;
 }
 
+/************************************************************************/
+/*                        GWKMaskRangeIsAllSet()                        */
+/************************************************************************/
+
+// Return whether the nLen bits of a validity mask starting at iOffset are
+// all set, testing whole 32-bit words when possible.
+static bool GWKMaskRangeIsAllSet(const GUInt32 *panMask, std::size_t iOffset,
+                                 int nLen)
+{
+    std::size_t i = iOffset;
+    const std::size_t iEnd = iOffset + nLen;
+    for (; i < iEnd && (i & 0x1f) != 0; ++i)
+    {
+        if (!(panMask[i >> 5] & (0x01U << (i & 0x1f))))
+            return false;
+    }
+    for (; i + 32 <= iEnd; i += 32)
+    {
+        if (panMask[i >> 5] != 0xFFFFFFFFU)
+            return false;
+    }
+    for (; i < iEnd; ++i)
+    {
+        if (!(panMask[i >> 5] & (0x01U << (i & 0x1f))))
+            return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                          GWKGetPixelRow()                            */
 /************************************************************************/
@@ -2303,7 +2343,9 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
             padfDensity[i + 1] = 1.0;
         }
 
-        if (poWK->panUnifiedSrcValid != nullptr)
+        if (poWK->panUnifiedSrcValid != nullptr &&
+            !GWKMaskRangeIsAllSet(poWK->panUnifiedSrcValid, iSrcOffset,
+                                  nSrcLen))
         {
             for (int i = 0; i < nSrcLen; i += 2)
             {
@@ -2326,7 +2368,9 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
         }
 
         if (poWK->papanBandSrcValid != nullptr &&
-            poWK->papanBandSrcValid[iBand] != nullptr)
+            poWK->papanBandSrcValid[iBand] != nullptr &&
+            !GWKMaskRangeIsAllSet(poWK->papanBandSrcValid[iBand], iSrcOffset,
+                                  nSrcLen))
         {
             for (int i = 0; i < nSrcLen; i += 2)
             {
@@ -3606,6 +3650,9 @@ struct _GWKResampleWrkStruct
     double dfSinPiYScale;       // Only used by GWKResampleOptimizedLanczos.
     double dfCosPiYScaleOver3;  // Only used by GWKResampleOptimizedLanczos.
     double dfSinPiYScaleOver3;  // Only used by GWKResampleOptimizedLanczos.
+    // Only used by GWKResampleOptimizedLanczos: skip its vectorized paths,
+    // so that USE_GENERAL_CASE=TRUE gives a scalar reference.
+    bool bUseGeneralCase;
 
     // Space for saving a row of pixels.
     double *padfRowDensity;
@@ -3668,6 +3715,8 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
     if (poWK->eResample == GRA_Lanczos)
     {
         psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos;
+        psWrkStruct->bUseGeneralCase =
+            CPLFetchBool(poWK->papszWarpOptions, "USE_GENERAL_CASE", false);
 
         if (poWK->dfXScale < 1)
         {
@@ -3887,6 +3936,107 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
     return true;
 }
 
+/************************************************************************/
+/*                    GWKLanczosNoMasksConvoluteT()                     */
+/************************************************************************/
+
+// Apply the separable Lanczos weights to the kernel window starting at pSrc
+// (first row of the window, column 0 of the kernel), reading the source data
+// type directly instead of going through GWKGetPixelRow().
+template <class T>
+static double GWKLanczosNoMasksConvoluteT(const T *pSrc, int nSrcXSize,
+                                          int iMin, int iMax, int jMin,
+                                          int jMax,
+                                          const double *padfWeightsXShifted,
+                                          const double *padfWeightsYShifted)
+{
+    double dfAccumulatorReal = 0.0;
+
+#if defined(USE_SSE2)
+    const int nCols = iMax - iMin + 1;
+    if (nCols >= 4)
+    {
+        // This is just an optimized version of the general case in
+        // the else clause. The 4 partial sums of a row are not added in the
+        // same order as in the scalar loop, so results may differ from it
+        // in the last bits for non-integer data.
+
+        pSrc += iMin;
+        const double *const padfWeightsX = padfWeightsXShifted + iMin;
+
+        // The AVX2 variant adds in the same order as RowConvolute() below.
+#ifdef HAVE_AVX2_DISPATCH
+        if (CPLHaveRuntimeAVX2())
+        {
+            return GWKLanczosNoMasksConvolute_AVX2(
+                pSrc, nSrcXSize, nCols, jMax - jMin + 1, padfWeightsX,
+                padfWeightsYShifted + jMin);
+        }
+#endif
+
+        // Weighted sum of a row: by 4 columns, then the remaining ones.
+        const auto RowConvolute = [padfWeightsX, nCols](const T *pRow)
+        {
+            XMMReg4Double v_acc = XMMReg4Double::Load4Val(pRow) *
+                                  XMMReg4Double::Load4Val(padfWeightsX);
+            int i = 4;
+            for (; i + 3 < nCols; i += 4)
+            {
+                v_acc += XMMReg4Double::Load4Val(pRow + i) *
+                         XMMReg4Double::Load4Val(padfWeightsX + i);
+            }
+            const double dfRowAcc = v_acc.GetHorizSum();
+            double dfRowAccEnd = 0.0;
+            for (; i < nCols; ++i)
+                dfRowAccEnd += pRow[i] * padfWeightsX[i];
+            return dfRowAcc + dfRowAccEnd;
+        };
+
+        int j = jMin;
+        // Process 2 lines at the same time.
+        for (; j < jMax; j += 2)
+        {
+            const double dfRowAcc = RowConvolute(pSrc);
+            dfAccumulatorReal += dfRowAcc * padfWeightsYShifted[j];
+            const double dfRowAcc2 = RowConvolute(pSrc + nSrcXSize);
+            dfAccumulatorReal += dfRowAcc2 * padfWeightsYShifted[j + 1];
+            pSrc += 2 * nSrcXSize;
+        }
+        if (j == jMax)
+        {
+            // Process last line if there's an odd number of them.
+            dfAccumulatorReal += RowConvolute(pSrc) * padfWeightsYShifted[j];
+        }
+    }
+    else
+#endif
+    {
+        for (int j = jMin; j <= jMax; ++j)
+        {
+            int i = iMin;
+            double dfRowAcc1 = 0.0;
+            double dfRowAcc2 = 0.0;
+            // A bit of loop unrolling
+            for (; i < iMax; i += 2)
+            {
+                dfRowAcc1 += pSrc[i] * padfWeightsXShifted[i];
+                dfRowAcc2 += pSrc[i + 1] * padfWeightsXShifted[i + 1];
+            }
+            if (i == iMax)
+            {
+                // Process last column if there's an odd number of them.
+                dfRowAcc1 += pSrc[i] * padfWeightsXShifted[i];
+            }
+
+            dfAccumulatorReal +=
+                (dfRowAcc1 + dfRowAcc2) * padfWeightsYShifted[j];
+            pSrc += nSrcXSize;
+        }
+    }
+
+    return dfAccumulatorReal;
+}
+
 /************************************************************************/
 /*                      GWKResampleOptimizedLanczos()                   */
 /************************************************************************/
@@ -4229,11 +4379,16 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
 
     // Loop over pixel rows in the kernel.
 
-    if (poWK->eWorkingDataType == GDT_Byte && !poWK->panUnifiedSrcValid &&
+    if (!psWrkStruct->bUseGeneralCase && !poWK->panUnifiedSrcValid &&
         !poWK->papanBandSrcValid && !poWK->pafUnifiedSrcDensity &&
-        !padfRowDensity)
+        !padfRowDensity &&
+        (poWK->eWorkingDataType == GDT_Byte ||
+         poWK->eWorkingDataType == GDT_Int16 ||
+         poWK->eWorkingDataType == GDT_UInt16 ||
+         poWK->eWorkingDataType == GDT_Float32))
     {
-        // Optimization for Byte case without any masking/alpha
+        // Optimization for the most common data types without any
+        // masking/alpha
 
         if (dfAccumulatorWeight < 0.000001)
         {
@@ -4241,82 +4396,43 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
             return false;
         }
 
-        const GByte *pSrc =
-            reinterpret_cast<const GByte *>(poWK->papabySrcImage[iBand]);
-        pSrc += iSrcOffset + static_cast<GPtrDiff_t>(jMin) * nSrcXSize;
-
-#if defined(USE_SSE2)
-        if (iMax - iMin + 1 == 6)
-        {
-            // This is just an optimized version of the general case in
-            // the else clause.
-
-            pSrc += iMin;
-            int j = jMin;
-            const auto fourXWeights =
-                XMMReg4Double::Load4Val(padfWeightsXShifted + iMin);
-
-            // Process 2 lines at the same time.
-            for (; j < jMax; j += 2)
-            {
-                const XMMReg4Double v_acc =
-                    XMMReg4Double::Load4Val(pSrc) * fourXWeights;
-                const XMMReg4Double v_acc2 =
-                    XMMReg4Double::Load4Val(pSrc + nSrcXSize) * fourXWeights;
-                const double dfRowAcc = v_acc.GetHorizSum();
-                const double dfRowAccEnd =
-                    pSrc[4] * padfWeightsXShifted[iMin + 4] +
-                    pSrc[5] * padfWeightsXShifted[iMin + 5];
-                dfAccumulatorReal +=
-                    (dfRowAcc + dfRowAccEnd) * padfWeightsYShifted[j];
-                const double dfRowAcc2 = v_acc2.GetHorizSum();
-                const double dfRowAcc2End =
-                    pSrc[nSrcXSize + 4] * padfWeightsXShifted[iMin + 4] +
-                    pSrc[nSrcXSize + 5] * padfWeightsXShifted[iMin + 5];
-                dfAccumulatorReal +=
-                    (dfRowAcc2 + dfRowAcc2End) * padfWeightsYShifted[j + 1];
-                pSrc += 2 * nSrcXSize;
-            }
-            if (j == jMax)
-            {
-                // Process last line if there's an odd number of them.
-
-                const XMMReg4Double v_acc =
-                    XMMReg4Double::Load4Val(pSrc) * fourXWeights;
-                const double dfRowAcc = v_acc.GetHorizSum();
-                const double dfRowAccEnd =
-                    pSrc[4] * padfWeightsXShifted[iMin + 4] +
-                    pSrc[5] * padfWeightsXShifted[iMin + 5];
-                dfAccumulatorReal +=
-                    (dfRowAcc + dfRowAccEnd) * padfWeightsYShifted[j];
-            }
-        }
-        else
-#endif
+        const GPtrDiff_t iKernelOffset =
+            iSrcOffset + static_cast<GPtrDiff_t>(jMin) * nSrcXSize;
+        switch (poWK->eWorkingDataType)
         {
-            for (int j = jMin; j <= jMax; ++j)
-            {
-                int i = iMin;
-                double dfRowAcc1 = 0.0;
-                double dfRowAcc2 = 0.0;
-                // A bit of loop unrolling
-                for (; i < iMax; i += 2)
-                {
-                    dfRowAcc1 += pSrc[i] * padfWeightsXShifted[i];
-                    dfRowAcc2 += pSrc[i + 1] * padfWeightsXShifted[i + 1];
-                }
-                if (i == iMax)
-                {
-                    // Process last column if there's an odd number of them.
-                    dfRowAcc1 += pSrc[i] * padfWeightsXShifted[i];
-                }
-
-                dfAccumulatorReal +=
-                    (dfRowAcc1 + dfRowAcc2) * padfWeightsYShifted[j];
-                pSrc += nSrcXSize;
-            }
+            case GDT_Byte:
+                dfAccumulatorReal = GWKLanczosNoMasksConvoluteT(
+                    reinterpret_cast<const GByte *>(
+                        poWK->papabySrcImage[iBand]) +
+                        iKernelOffset,
+                    nSrcXSize, iMin, iMax, jMin, jMax, padfWeightsXShifted,
+                    padfWeightsYShifted);
+                break;
+            case GDT_Int16:
+                dfAccumulatorReal = GWKLanczosNoMasksConvoluteT(
+                    reinterpret_cast<const GInt16 *>(
+                        poWK->papabySrcImage[iBand]) +
+                        iKernelOffset,
+                    nSrcXSize, iMin, iMax, jMin, jMax, padfWeightsXShifted,
+                    padfWeightsYShifted);
+                break;
+            case GDT_UInt16:
+                dfAccumulatorReal = GWKLanczosNoMasksConvoluteT(
+                    reinterpret_cast<const GUInt16 *>(
+                        poWK->papabySrcImage[iBand]) +
+                        iKernelOffset,
+                    nSrcXSize, iMin, iMax, jMin, jMax, padfWeightsXShifted,
+                    padfWeightsYShifted);
+                break;
+            default:
+                dfAccumulatorReal = GWKLanczosNoMasksConvoluteT(
+                    reinterpret_cast<const float *>(
+                        poWK->papabySrcImage[iBand]) +
+                        iKernelOffset,
+                    nSrcXSize, iMin, iMax, jMin, jMax, padfWeightsXShifted,
+                    padfWeightsYShifted);
+                break;
         }
-
         // Calculate the output taking into account weighting.
         if (dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001)
         {
@@ -4357,7 +4473,52 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         // Iterate over pixels in row.
         if (padfRowDensity != nullptr)
         {
-            for (int i = iMin; i <= iMax; ++i)
+            int i = iMin;
+#if defined(USE_SSE2)
+            if (bIsNonComplex && !psWrkStruct->bUseGeneralCase)
+            {
+                // Optimized version of the loop below, 4 pixels at a time.
+                // Instead of being skipped, pixels under the density
+                // threshold contribute zero in their lane, so that invalid
+                // (possibly NaN) values never reach the accumulators.
+                const double dfThreshold = SRC_DENSITY_THRESHOLD;
+                const double dfOne = 1.0;
+                const auto v_threshold =
+                    XMMReg4Double::Load1ValHighAndLow(&dfThreshold);
+                const auto v_one = XMMReg4Double::Load1ValHighAndLow(&dfOne);
+                const auto v_weight1 =
+                    XMMReg4Double::Load1ValHighAndLow(&dfWeight1);
+                const auto v_zero = XMMReg4Double::Zero();
+                auto v_accReal = v_zero;
+                auto v_accDensity = v_zero;
+                auto v_accWeight = v_zero;
+                auto v_countValid = v_zero;
+                for (; i + 3 <= iMax; i += 4)
+                {
+                    const auto v_density =
+                        XMMReg4Double::Load4Val(padfRowDensity + i - iMin);
+                    const auto v_invalid =
+                        XMMReg4Double::Greater(v_threshold, v_density);
+                    const auto v_weight2 = XMMReg4Double::Ternary(
+                        v_invalid, v_zero,
+                        v_weight1 *
+                            XMMReg4Double::Load4Val(padfWeightsXShifted + i));
+                    const auto v_real = XMMReg4Double::Ternary(
+                        v_invalid, v_zero,
+                        XMMReg4Double::Load4Val(padfRowReal + i - iMin));
+                    v_accReal += v_real * v_weight2;
+                    v_accDensity += v_density * v_weight2;
+                    v_accWeight += v_weight2;
+                    v_countValid +=
+                        XMMReg4Double::Ternary(v_invalid, v_zero, v_one);
+                }
+                dfAccumulatorReal += v_accReal.GetHorizSum();
+                dfAccumulatorDensity += v_accDensity.GetHorizSum();
+                dfAccumulatorWeight += v_accWeight.GetHorizSum();
+                nCountValid += static_cast<int>(v_countValid.GetHorizSum());
+            }
+#endif
+            for (; i <= iMax; ++i)
             {
                 // Skip sampling if pixel has zero density.
                 if (padfRowDensity[i - iMin] < SRC_DENSITY_THRESHOLD)
@@ -5938,6 +6099,64 @@ static void GWKCubicResampleNoMasks4MultiBandT(const GDALWarpKernel *poWK,
 
 #endif  // defined(USE_SSE2)
 
+/************************************************************************/
+/*               GWKBilinearResampleNoMasks4MultiBandT()                */
+/************************************************************************/
+
+// Same result as GWKBilinearResampleNoMasks4SampleT() called on each band,
+// but with the source offset and the weights computed once for all bands.
+// With source masks, bilinear resampling still goes through the per-band
+// general case.
+template <class T>
+static void GWKBilinearResampleNoMasks4MultiBandT(const GDALWarpKernel *poWK,
+                                                  double dfSrcX, double dfSrcY,
+                                                  const GPtrDiff_t iDstOffset)
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+
+    if (iSrcX >= 0 && iSrcX + 1 < nSrcXSize && iSrcY >= 0 &&
+        iSrcY + 1 < poWK->nSrcYSize)
+    {
+        const GPtrDiff_t iSrcOffset =
+            iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+        const double dfRatioX = 1.5 - (dfSrcX - iSrcX);
+        const double dfRatioY = 1.5 - (dfSrcY - iSrcY);
+        const double dfRatioXComp = 1.0 - dfRatioX;
+        const double dfRatioYComp = 1.0 - dfRatioY;
+
+        for (int iBand = 0; iBand < poWK->nBands; iBand++)
+        {
+            const T *CPL_RESTRICT pSrc =
+                reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) +
+                iSrcOffset;
+            const double dfAccumulator =
+                (pSrc[0] * dfRatioX + pSrc[1] * dfRatioXComp) * dfRatioY +
+                (pSrc[nSrcXSize] * dfRatioX +
+                 pSrc[nSrcXSize + 1] * dfRatioXComp) *
+                    dfRatioYComp;
+            reinterpret_cast<T *>(poWK->papabyDstImage[iBand])[iDstOffset] =
+                GWKRoundValueT<T>(dfAccumulator);
+        }
+    }
+    else
+    {
+        // Partial kernel at the image borders.
+        for (int iBand = 0; iBand < poWK->nBands; iBand++)
+        {
+            T value = 0;
+            GWKBilinearResampleNoMasks4SampleT(poWK, iBand, dfSrcX, dfSrcY,
+                                               &value);
+            reinterpret_cast<T *>(poWK->papabyDstImage[iBand])[iDstOffset] =
+                value;
+        }
+    }
+
+    if (poWK->pafDstDensity)
+        poWK->pafDstDensity[iDstOffset] = 1.0f;
+}
+
 /************************************************************************/
 /*                GWKResampleNoMasksOrDstDensityOnlyThreadInternal()    */
 /************************************************************************/
@@ -6058,6 +6277,18 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal(void *pData)
             }
 #endif  // defined(USE_SSE2)
 
+            if constexpr (bUse4SamplesFormula && eResample == GRA_Bilinear)
+            {
+                if (poWK->nBands > 1 && !poWK->bApplyVerticalShift)
+                {
+                    GWKBilinearResampleNoMasks4MultiBandT<T>(
+                        poWK, padfX[iDstX] - poWK->nSrcXOff,
+                        padfY[iDstX] - poWK->nSrcYOff, iDstOffset);
+
+                    continue;
+                }
+            }
+
             [[maybe_unused]] double dfInvWeights = 0;
             for (int iBand = 0; iBand < poWK->nBands; iBand++)
             {
@@ -6178,6 +6409,13 @@ static CPLErr GWKCubicNoMasksOrDstDensityOnlyFloat(GDALWarpKernel *poWK)
         GWKResampleNoMasksOrDstDensityOnlyHas4SampleThread<float, GRA_Cubic>);
 }
 
+static CPLErr GWKCubicSplineNoMasksOrDstDensityOnlyFloat(GDALWarpKernel *poWK)
+{
+    return GWKRun(
+        poWK, "GWKCubicSplineNoMasksOrDstDensityOnlyFloat",
+        GWKResampleNoMasksOrDstDensityOnlyThread<float, GRA_CubicSpline>);
+}
+
 #ifdef INSTANTIATE_FLOAT64_SSE2_IMPL
 
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyDouble(GDALWarpKernel *poWK)
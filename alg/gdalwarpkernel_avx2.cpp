@@ -0,0 +1,137 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 specializations of warp kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#include "gdalwarpkernel_avx2.h"
+
+#include <immintrin.h>
+
+#include <cstring>
+
+// Note: we deliberately avoid gdalsse_priv.h and inline functions with
+// external linkage here, so that no AVX2 code gets selected by the linker for
+// other translation units.
+
+/************************************************************************/
+/*                              Load4Val()                              */
+/************************************************************************/
+
+static inline __m256d Load4Val(const GByte *ptr)
+{
+    GInt32 i;
+    memcpy(&i, ptr, sizeof(i));
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(i)));
+}
+
+static inline __m256d Load4Val(const GInt16 *ptr)
+{
+    GInt64 i;
+    memcpy(&i, ptr, sizeof(i));
+    return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_cvtsi64_si128(i)));
+}
+
+static inline __m256d Load4Val(const GUInt16 *ptr)
+{
+    GInt64 i;
+    memcpy(&i, ptr, sizeof(i));
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_cvtsi64_si128(i)));
+}
+
+static inline __m256d Load4Val(const float *ptr)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(ptr));
+}
+
+/************************************************************************/
+/*                 GWKLanczosNoMasksConvolute_AVX2T()                   */
+/************************************************************************/
+
+template <class T>
+static double GWKLanczosNoMasksConvolute_AVX2T(const T *pSrc, int nSrcXSize,
+                                               int nCols, int nRows,
+                                               const double *padfWeightsX,
+                                               const double *padfWeightsY)
+{
+    double dfAccumulator = 0.0;
+    for (int j = 0; j < nRows; ++j, pSrc += nSrcXSize)
+    {
+        // Weighted sum of a row: by 4 columns, then the remaining ones.
+        // There is deliberately no FMA, and the lanes are summed in the
+        // same order as XMMReg4Double::GetHorizSum() of the SSE2 code.
+        __m256d v_acc = _mm256_mul_pd(Load4Val(pSrc),
+                                      _mm256_loadu_pd(padfWeightsX));
+        int i = 4;
+        for (; i + 3 < nCols; i += 4)
+        {
+            v_acc = _mm256_add_pd(
+                v_acc, _mm256_mul_pd(Load4Val(pSrc + i),
+                                     _mm256_loadu_pd(padfWeightsX + i)));
+        }
+        const __m128d v_sum = _mm_add_pd(_mm256_castpd256_pd128(v_acc),
+                                         _mm256_extractf128_pd(v_acc, 1));
+        const double dfRowAcc = _mm_cvtsd_f64(
+            _mm_add_sd(v_sum, _mm_unpackhi_pd(v_sum, v_sum)));
+        double dfRowAccEnd = 0.0;
+        for (; i < nCols; ++i)
+            dfRowAccEnd += pSrc[i] * padfWeightsX[i];
+        dfAccumulator += (dfRowAcc + dfRowAccEnd) * padfWeightsY[j];
+    }
+
+    _mm256_zeroupper();
+
+    return dfAccumulator;
+}
+
+/************************************************************************/
+/*                  GWKLanczosNoMasksConvolute_AVX2()                   */
+/************************************************************************/
+
+double GWKLanczosNoMasksConvolute_AVX2(const GByte *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY)
+{
+    return GWKLanczosNoMasksConvolute_AVX2T(pSrc, nSrcXSize, nCols, nRows,
+                                            padfWeightsX, padfWeightsY);
+}
+
+double GWKLanczosNoMasksConvolute_AVX2(const GInt16 *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY)
+{
+    return GWKLanczosNoMasksConvolute_AVX2T(pSrc, nSrcXSize, nCols, nRows,
+                                            padfWeightsX, padfWeightsY);
+}
+
+double GWKLanczosNoMasksConvolute_AVX2(const GUInt16 *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY)
+{
+    return GWKLanczosNoMasksConvolute_AVX2T(pSrc, nSrcXSize, nCols, nRows,
+                                            padfWeightsX, padfWeightsY);
+}
+
+double GWKLanczosNoMasksConvolute_AVX2(const float *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY)
+{
+    return GWKLanczosNoMasksConvolute_AVX2T(pSrc, nSrcXSize, nCols, nRows,
+                                            padfWeightsX, padfWeightsY);
+}
+
+#endif  // defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) ||
+        // defined(_M_X64))
@@ -0,0 +1,50 @@
+/******************************************************************************
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX2 specializations of warp kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALWARPKERNEL_AVX2_H_INCLUDED
+#define GDALWARPKERNEL_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+//! @cond Doxygen_Suppress
+
+// Apply the separable Lanczos weights to the nRows x nCols window starting at
+// pSrc, whose lines are separated by nSrcXSize values, with nCols >= 4.
+// Must be kept consistent with the SSE2 path of GWKLanczosNoMasksConvoluteT()
+// of gdalwarpkernel.cpp, so that results do not depend on AVX2 availability.
+
+double GWKLanczosNoMasksConvolute_AVX2(const GByte *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY);
+
+double GWKLanczosNoMasksConvolute_AVX2(const GInt16 *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY);
+
+double GWKLanczosNoMasksConvolute_AVX2(const GUInt16 *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY);
+
+double GWKLanczosNoMasksConvolute_AVX2(const float *pSrc, int nSrcXSize,
+                                       int nCols, int nRows,
+                                       const double *padfWeightsX,
+                                       const double *padfWeightsY);
+
+//! @endcond
+
+#endif
+
+#endif /* GDALWARPKERNEL_AVX2_H_INCLUDED */
@@ -22,10 +22,12 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -1065,70 +1067,271 @@ CPLErr GDALChunkAndWarpImage(GDALWarpOperationH hOperation, int nDstXOff,
 }
 
 /************************************************************************/
-/*                          ChunkThreadMain()                           */
+/*                          DstWindowRasterIO()                         */
 /************************************************************************/
 
-struct ChunkThreadData
+// Reads or writes a window of the destination dataset from/into a buffer
+// of the working data type, as created by CreateDestinationBuffer().
+// Writes are followed by a flush if the WRITE_FLUSH warp option is set.
+static CPLErr DstWindowRasterIO(const GDALWarpOptions *psOptions,
+                                GDALRWFlag eRWFlag, int nDstXOff, int nDstYOff,
+                                int nDstXSize, int nDstYSize, void *pDstBuffer)
 {
-    GDALWarpOperation *poOperation = nullptr;
-    GDALWarpChunk *pasChunkInfo = nullptr;
-    CPLJoinableThread *hThreadHandle = nullptr;
+    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     CPLErr eErr = CE_None;
+    if (psOptions->nBandCount == 1)
+    {
+        // Particular case to simplify the stack a bit.
+        // TODO(rouault): Need an explanation of what and why r34502 helps.
+        eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
+                   ->RasterIO(eRWFlag, nDstXOff, nDstYOff, nDstXSize,
+                              nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
+                              psOptions->eWorkingDataType, 0, 0, nullptr);
+    }
+    else
+    {
+        eErr = poDstDS->RasterIO(eRWFlag, nDstXOff, nDstYOff, nDstXSize,
+                                 nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
+                                 psOptions->eWorkingDataType,
+                                 psOptions->nBandCount, psOptions->panDstBands,
+                                 0, 0, 0, nullptr);
+    }
+
+    if (eErr == CE_None && eRWFlag == GF_Write &&
+        CPLFetchBool(psOptions->papszWarpOptions, "WRITE_FLUSH", false))
+    {
+        const CPLErr eOldErr = CPLGetLastErrorType();
+        const CPLString osLastErrMsg = CPLGetLastErrorMsg();
+        GDALFlushCache(psOptions->hDstDS);
+        const CPLErr eNewErr = CPLGetLastErrorType();
+        if (eNewErr != eOldErr ||
+            osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
+            eErr = CE_Failure;
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                            ChunkPipeline                             */
+/************************************************************************/
+
+// ChunkAndWarpMulti() runs the chunks of the list built by CollectChunkList()
+// through three stages:
+// - a read stage, where the source window (and the destination window if
+//   the destination buffer is not initialized from INIT_DEST) is loaded and
+//   the masks are computed, under hIOMutex;
+// - a warp stage, running the (possibly multithreaded) warp kernel, under
+//   hWarpMutex;
+// - a write stage, where the calling thread writes the warped chunks in
+//   order.
+// Each chunk is handled by one of a few worker threads until it is warped.
+// Chunks enter the read stage in order, so that the source is read
+// sequentially, and as long as the memory used by the read stage (chunks
+// being read or waiting for the warp kernel) and by the write stage (warped
+// chunks waiting to be written) stay within WARP_MEMORY_LIMIT each.
+
+// State of one chunk in the pipeline.
+struct GDALWarpOperation::ChunkPipelineJob
+{
+    ChunkPipeline *poPipeline = nullptr;
+    const GDALWarpChunk *psChunk = nullptr;
     double dfProgressBase = 0;
     double dfProgressScale = 0;
-    CPLMutex *hIOMutex = nullptr;
-
-    CPLMutex *hCondMutex = nullptr;
-    volatile int bIOMutexTaken = 0;
-    CPLCond *hCond = nullptr;
+    // Working memory needed to read and warp the chunk.
+    double dfReadMemory = 0;
+    // Size of the destination buffer, kept until the chunk is written.
+    double dfWriteMemory = 0;
+    void *pDstBuffer = nullptr;
+    // Whether the job holds hIOMutex.
+    bool bReading = false;
+    // Whether the job is done with the read and warp stages.
+    bool bWarped = false;
+    CPLErr eErr = CE_None;
+};
 
-    CPLErrorAccumulator *poErrorAccumulator = nullptr;
+struct GDALWarpOperation::ChunkPipeline
+{
+    GDALWarpOperation *poOperation = nullptr;
+    std::vector<ChunkPipelineJob> asJobs{};
+
+    // Serializes the accesses to the destination dataset. This is hIOMutex
+    // if the source and the destination datasets are the same.
+    CPLMutex *hDstIOMutex = nullptr;
+
+    double dfStageMemoryLimit = 0;
+
+    CPLErrorAccumulator oErrorAccumulator{};
+
+    // Members below are protected by oMutex.
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    // Index of the next job to be taken by a worker thread.
+    size_t iNextJob = 0;
+    // Index of the next job to acquire hIOMutex.
+    size_t iNextReadJob = 0;
+    double dfReadStageMemory = 0;
+    double dfWriteStageMemory = 0;
+    bool bStop = false;
+
+    bool CanStartNextJob() const;
+    void LeaveReadStage(ChunkPipelineJob *psJob);
+    CPLErr RunJob(ChunkPipelineJob *psJob);
+    static void WorkerThread(void *pData);
 };
 
-static void ChunkThreadMain(void *pThreadData)
+/************************************************************************/
+/*                  ChunkPipeline::CanStartNextJob()                    */
+/************************************************************************/
+
+// Must be called with oMutex held.
+bool GDALWarpOperation::ChunkPipeline::CanStartNextJob() const
+{
+    if (bStop || iNextJob == asJobs.size())
+        return false;
+    const ChunkPipelineJob &sJob = asJobs[iNextJob];
+    // A stage always accepts a chunk when it is empty, even if it exceeds
+    // the budget on its own.
+    return (dfReadStageMemory == 0 ||
+            dfReadStageMemory + sJob.dfReadMemory <= dfStageMemoryLimit) &&
+           (dfWriteStageMemory == 0 ||
+            dfWriteStageMemory + sJob.dfWriteMemory <= dfStageMemoryLimit);
+}
 
+/************************************************************************/
+/*                   ChunkPipeline::LeaveReadStage()                    */
+/************************************************************************/
+
+void GDALWarpOperation::ChunkPipeline::LeaveReadStage(ChunkPipelineJob *psJob)
 {
-    volatile ChunkThreadData *psData =
-        static_cast<volatile ChunkThreadData *>(pThreadData);
+    CPLAssert(psJob->bReading);
+    psJob->bReading = false;
+    CPLReleaseMutex(poOperation->hIOMutex);
 
-    GDALWarpChunk *pasChunkInfo = psData->pasChunkInfo;
+    std::lock_guard<std::mutex> oLock(oMutex);
+    dfReadStageMemory -= psJob->dfReadMemory;
+    oCV.notify_all();
+}
 
-    /* -------------------------------------------------------------------- */
-    /*      Acquire IO mutex.                                               */
-    /* -------------------------------------------------------------------- */
-    if (!CPLAcquireMutex(psData->hIOMutex, 600.0))
+/************************************************************************/
+/*                       ChunkPipeline::RunJob()                        */
+/************************************************************************/
+
+// Reads and warps a chunk into psJob->pDstBuffer. Must be called with
+// hIOMutex held.
+CPLErr GDALWarpOperation::ChunkPipeline::RunJob(ChunkPipelineJob *psJob)
+{
+    const GDALWarpChunk *psChunk = psJob->psChunk;
+    const GDALWarpOptions *psOptions = poOperation->psOptions;
+
+    int bDstBufferInitialized = FALSE;
+    psJob->pDstBuffer = poOperation->CreateDestinationBuffer(
+        psChunk->dsx, psChunk->dsy, &bDstBufferInitialized);
+    if (psJob->pDstBuffer == nullptr)
+        return CE_Failure;
+
+    if (!bDstBufferInitialized)
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Failed to acquire IOMutex in WarpRegion().");
-        psData->eErr = CE_Failure;
+        if (!CPLAcquireMutex(hDstIOMutex, 600.0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire DstIOMutex in ChunkAndWarpMulti().");
+            return CE_Failure;
+        }
+        const CPLErr eErr =
+            DstWindowRasterIO(psOptions, GF_Read, psChunk->dx, psChunk->dy,
+                              psChunk->dsx, psChunk->dsy, psJob->pDstBuffer);
+        CPLReleaseMutex(hDstIOMutex);
+        if (eErr != CE_None)
+            return eErr;
     }
-    else
-    {
-        if (psData->hCond != nullptr)
+
+    if (psChunk->ssx == 0)
+        return CE_None;
+
+    return poOperation->WarpRegionToBufferInternal(
+        psChunk->dx, psChunk->dy, psChunk->dsx, psChunk->dsy,
+        psJob->pDstBuffer, psOptions->eWorkingDataType, psChunk->sx,
+        psChunk->sy, psChunk->ssx, psChunk->ssy, psChunk->sExtraSx,
+        psChunk->sExtraSy, psJob->dfProgressBase, psJob->dfProgressScale,
+        psJob);
+}
+
+/************************************************************************/
+/*                    ChunkPipeline::WorkerThread()                     */
+/************************************************************************/
+
+void GDALWarpOperation::ChunkPipeline::WorkerThread(void *pData)
+{
+    ChunkPipeline *poPipeline = static_cast<ChunkPipeline *>(pData);
+
+    auto oAccumulator = poPipeline->oErrorAccumulator.InstallForCurrentScope();
+    CPL_IGNORE_RET_VAL(oAccumulator);
+
+    while (true)
+    {
+        ChunkPipelineJob *psJob = nullptr;
+        size_t iJob = 0;
+        {
+            std::unique_lock<std::mutex> oLock(poPipeline->oMutex);
+            poPipeline->oCV.wait(oLock,
+                                 [poPipeline]
+                                 {
+                                     return poPipeline->bStop ||
+                                            poPipeline->iNextJob ==
+                                                poPipeline->asJobs.size() ||
+                                            poPipeline->CanStartNextJob();
+                                 });
+            if (poPipeline->bStop ||
+                poPipeline->iNextJob == poPipeline->asJobs.size())
+                break;
+            iJob = poPipeline->iNextJob++;
+            psJob = &poPipeline->asJobs[iJob];
+            poPipeline->dfReadStageMemory += psJob->dfReadMemory;
+
+            // Wait for the previous chunks to have started reading, so
+            // that the source is read in order.
+            poPipeline->oCV.wait(oLock,
+                                 [poPipeline, iJob] {
+                                     return poPipeline->iNextReadJob == iJob;
+                                 });
+        }
+
+        CPLDebug("GDAL", "Start chunk %d / %d.", static_cast<int>(iJob),
+                 static_cast<int>(poPipeline->asJobs.size()));
+
+        if (!CPLAcquireMutex(poPipeline->poOperation->hIOMutex, 600.0))
         {
-            CPLAcquireMutex(psData->hCondMutex, 1.0);
-            psData->bIOMutexTaken = TRUE;
-            CPLCondSignal(psData->hCond);
-            CPLReleaseMutex(psData->hCondMutex);
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire IOMutex in ChunkAndWarpMulti().");
+            psJob->eErr = CE_Failure;
+            std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+            poPipeline->iNextReadJob++;
+            poPipeline->dfReadStageMemory -= psJob->dfReadMemory;
         }
+        else
+        {
+            psJob->bReading = true;
+            {
+                std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+                poPipeline->iNextReadJob++;
+                poPipeline->oCV.notify_all();
+            }
 
-        auto oAccumulator =
-            psData->poErrorAccumulator->InstallForCurrentScope();
-        CPL_IGNORE_RET_VAL(oAccumulator);
+            psJob->eErr = poPipeline->RunJob(psJob);
 
-        psData->eErr = psData->poOperation->WarpRegion(
-            pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
-            pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
-            pasChunkInfo->ssx, pasChunkInfo->ssy, pasChunkInfo->sExtraSx,
-            pasChunkInfo->sExtraSy, psData->dfProgressBase,
-            psData->dfProgressScale);
+            // RunJob() returns before the warp stage if the chunk has no
+            // source window, or on error.
+            if (psJob->bReading)
+                poPipeline->LeaveReadStage(psJob);
+        }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Release the IO mutex. */
-        /* --------------------------------------------------------------------
-         */
-        CPLReleaseMutex(psData->hIOMutex);
+        std::lock_guard<std::mutex> oLock(poPipeline->oMutex);
+        psJob->bWarped = true;
+        poPipeline->dfWriteStageMemory += psJob->dfWriteMemory;
+        if (psJob->eErr != CE_None)
+            poPipeline->bStop = true;
+        poPipeline->oCV.notify_all();
     }
 }
 
@@ -1145,8 +1348,12 @@ static void ChunkThreadMain(void *pThreadData)
  * Progress is reported to the installed progress monitor, if any.
  *
  * Externally this method operates the same as ChunkAndWarpImage(), but
- * internally this method uses multiple threads to interleave input/output
- * for one region while the processing is being done for another.
+ * internally this method pipelines the processing of the chunks: while
+ * a chunk is being warped, the source data of the next chunks is read
+ * and the previously warped chunks are written to the destination dataset,
+ * in order. The memory used by the chunks being read and by the chunks
+ * waiting to be written is each limited to the warp memory limit
+ * (GDALWarpOptions::dfWarpMemoryLimit).
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -1160,137 +1367,170 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
-    hIOMutex = CPLCreateMutex();
-    hWarpMutex = CPLCreateMutex();
-
-    CPLReleaseMutex(hIOMutex);
-    CPLReleaseMutex(hWarpMutex);
+    if (hIOMutex == nullptr)
+    {
+        hIOMutex = CPLCreateMutex();
+        hWarpMutex = CPLCreateMutex();
 
-    CPLCond *hCond = CPLCreateCond();
-    CPLMutex *hCondMutex = CPLCreateMutex();
-    CPLReleaseMutex(hCondMutex);
+        CPLReleaseMutex(hIOMutex);
+        CPLReleaseMutex(hWarpMutex);
+    }
 
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
 
-    /* -------------------------------------------------------------------- */
-    /*      Process them one at a time, updating the progress               */
-    /*      information for each region.                                    */
-    /* -------------------------------------------------------------------- */
-    ChunkThreadData volatile asThreadData[2] = {};
-    CPLErrorAccumulator oErrorAccumulator;
-    for (int i = 0; i < 2; ++i)
+    ChunkPipeline oPipeline;
+    oPipeline.poOperation = this;
+    oPipeline.dfStageMemoryLimit = psOptions->dfWarpMemoryLimit;
+
+    CPLMutex *hOwnedDstIOMutex = nullptr;
+    if (psOptions->hDstDS == psOptions->hSrcDS)
+    {
+        oPipeline.hDstIOMutex = hIOMutex;
+    }
+    else
     {
-        asThreadData[i].poOperation = this;
-        asThreadData[i].hIOMutex = hIOMutex;
-        asThreadData[i].poErrorAccumulator = &oErrorAccumulator;
+        hOwnedDstIOMutex = CPLCreateMutex();
+        CPLReleaseMutex(hOwnedDstIOMutex);
+        oPipeline.hDstIOMutex = hOwnedDstIOMutex;
     }
 
+    const double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
     double dfPixelsProcessed = 0.0;
-    double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
 
     CPLErr eErr = CE_None;
-    for (int iChunk = 0; iChunk < nChunkListCount + 1; iChunk++)
+    try
     {
-        int iThread = iChunk % 2;
+        oPipeline.asJobs.resize(nChunkListCount);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in ChunkAndWarpMulti()");
+        eErr = CE_Failure;
+    }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Launch thread for this chunk. */
-        /* --------------------------------------------------------------------
-         */
-        if (pasChunkList != nullptr && iChunk < nChunkListCount)
-        {
-            GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
-            const double dfChunkPixels =
-                pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
+    for (size_t iJob = 0; iJob < oPipeline.asJobs.size(); ++iJob)
+    {
+        const GDALWarpChunk *psChunk = pasChunkList + iJob;
+        const double dfChunkPixels =
+            psChunk->dsx * static_cast<double>(psChunk->dsy);
 
-            asThreadData[iThread].dfProgressBase =
-                dfPixelsProcessed / dfTotalPixels;
-            asThreadData[iThread].dfProgressScale =
-                dfChunkPixels / dfTotalPixels;
+        ChunkPipelineJob &sJob = oPipeline.asJobs[iJob];
+        sJob.poPipeline = &oPipeline;
+        sJob.psChunk = psChunk;
+        sJob.dfProgressBase = dfPixelsProcessed / dfTotalPixels;
+        sJob.dfProgressScale = dfChunkPixels / dfTotalPixels;
+        sJob.dfReadMemory = GetWorkingMemoryForWindow(
+            psChunk->ssx, psChunk->ssy, psChunk->dsx, psChunk->dsy);
+        sJob.dfWriteMemory = dfChunkPixels * nWordSize * psOptions->nBandCount;
 
-            dfPixelsProcessed += dfChunkPixels;
+        dfPixelsProcessed += dfChunkPixels;
+    }
 
-            asThreadData[iThread].pasChunkInfo = pasThisChunk;
+    /* -------------------------------------------------------------------- */
+    /*      Start the worker threads. A few threads are enough to keep      */
+    /*      the read and warp stages busy, the memory budget of the read    */
+    /*      stage being the actual limit to the read-ahead.                 */
+    /* -------------------------------------------------------------------- */
+    constexpr int MAX_WORKER_THREADS = 4;
+    const int nWorkerThreads =
+        std::min(MAX_WORKER_THREADS, static_cast<int>(oPipeline.asJobs.size()));
+    std::vector<CPLJoinableThread *> ahThreads;
+    for (int i = 0; eErr == CE_None && i < nWorkerThreads; ++i)
+    {
+        CPLJoinableThread *hThread =
+            CPLCreateJoinableThread(ChunkPipeline::WorkerThread, &oPipeline);
+        if (hThread == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
+            eErr = CE_Failure;
+            std::lock_guard<std::mutex> oLock(oPipeline.oMutex);
+            oPipeline.bStop = true;
+            oPipeline.oCV.notify_all();
+            break;
+        }
+        ahThreads.push_back(hThread);
+    }
 
-            if (iChunk == 0)
-            {
-                asThreadData[iThread].hCond = hCond;
-                asThreadData[iThread].hCondMutex = hCondMutex;
-            }
-            else
-            {
-                asThreadData[iThread].hCond = nullptr;
-                asThreadData[iThread].hCondMutex = nullptr;
-            }
-            asThreadData[iThread].bIOMutexTaken = FALSE;
+    /* -------------------------------------------------------------------- */
+    /*      Write the warped chunks in order.                               */
+    /* -------------------------------------------------------------------- */
+    for (size_t iJob = 0; eErr == CE_None && iJob < oPipeline.asJobs.size();
+         ++iJob)
+    {
+        ChunkPipelineJob &sJob = oPipeline.asJobs[iJob];
+        {
+            std::unique_lock<std::mutex> oLock(oPipeline.oMutex);
+            // Chunks that have not been started when the pipeline is
+            // stopped never will.
+            oPipeline.oCV.wait(oLock,
+                               [&oPipeline, &sJob, iJob]
+                               {
+                                   return sJob.bWarped ||
+                                          (oPipeline.bStop &&
+                                           iJob >= oPipeline.iNextJob);
+                               });
+            if (!sJob.bWarped)
+                break;
+        }
 
-            CPLDebug("GDAL", "Start chunk %d / %d.", iChunk, nChunkListCount);
-            asThreadData[iThread].hThreadHandle = CPLCreateJoinableThread(
-                ChunkThreadMain,
-                const_cast<ChunkThreadData *>(&asThreadData[iThread]));
-            if (asThreadData[iThread].hThreadHandle == nullptr)
+        eErr = sJob.eErr;
+        if (eErr == CE_None)
+        {
+            if (!CPLAcquireMutex(oPipeline.hDstIOMutex, 600.0))
             {
-                CPLError(
-                    CE_Failure, CPLE_AppDefined,
-                    "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Failed to acquire DstIOMutex in "
+                         "ChunkAndWarpMulti().");
                 eErr = CE_Failure;
-                break;
             }
-
-            // Wait that the first thread has acquired the IO mutex before
-            // proceeding.  This will ensure that the first thread will run
-            // before the second one.
-            if (iChunk == 0)
+            else
             {
-                CPLAcquireMutex(hCondMutex, 1.0);
-                while (asThreadData[iThread].bIOMutexTaken == FALSE)
-                    CPLCondWait(hCond, hCondMutex);
-                CPLReleaseMutex(hCondMutex);
+                const GDALWarpChunk *psChunk = sJob.psChunk;
+                eErr = DstWindowRasterIO(psOptions, GF_Write, psChunk->dx,
+                                         psChunk->dy, psChunk->dsx,
+                                         psChunk->dsy, sJob.pDstBuffer);
+                CPLReleaseMutex(oPipeline.hDstIOMutex);
             }
         }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Wait for previous chunks thread to complete. */
-        /* --------------------------------------------------------------------
-         */
-        if (iChunk > 0)
-        {
-            iThread = (iChunk - 1) % 2;
-
-            // Wait for thread to finish.
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
-            asThreadData[iThread].hThreadHandle = nullptr;
+        DestroyDestinationBuffer(sJob.pDstBuffer);
+        sJob.pDstBuffer = nullptr;
 
-            CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk - 1,
-                     nChunkListCount);
+        CPLDebug("GDAL", "Finished chunk %d / %d.", static_cast<int>(iJob),
+                 nChunkListCount);
 
-            eErr = asThreadData[iThread].eErr;
-
-            if (eErr != CE_None)
-                break;
-        }
+        std::lock_guard<std::mutex> oLock(oPipeline.oMutex);
+        oPipeline.dfWriteStageMemory -= sJob.dfWriteMemory;
+        if (eErr != CE_None)
+            oPipeline.bStop = true;
+        oPipeline.oCV.notify_all();
     }
 
     /* -------------------------------------------------------------------- */
     /*      Wait for all threads to complete.                               */
     /* -------------------------------------------------------------------- */
-    for (int iThread = 0; iThread < 2; iThread++)
+    for (CPLJoinableThread *hThread : ahThreads)
+        CPLJoinThread(hThread);
+
+    // Chunks warped after an error.
+    for (ChunkPipelineJob &sJob : oPipeline.asJobs)
     {
-        if (asThreadData[iThread].hThreadHandle)
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
+        if (sJob.pDstBuffer)
+            DestroyDestinationBuffer(sJob.pDstBuffer);
     }
 
-    CPLDestroyCond(hCond);
-    CPLDestroyMutex(hCondMutex);
+    if (hOwnedDstIOMutex)
+        CPLDestroyMutex(hOwnedDstIOMutex);
 
     WipeChunkList();
 
-    oErrorAccumulator.ReplayErrors();
+    oPipeline.oErrorAccumulator.ReplayErrors();
 
     psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
 
@@ -1691,28 +1931,11 @@ CPLErr GDALWarpOperation::WarpRegion(
     /*      If we aren't doing fixed initialization of the output buffer    */
     /*      then read it from disk so we can overlay on existing imagery.   */
     /* -------------------------------------------------------------------- */
-    GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     if (!bDstBufferInitialized)
     {
-        CPLErr eErr = CE_None;
-        if (psOptions->nBandCount == 1)
-        {
-            // Particular case to simplify the stack a bit.
-            // TODO(rouault): Need an explanation of what and why r34502 helps.
-            eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
-                       ->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize,
-                                  nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
-                                  psOptions->eWorkingDataType, 0, 0, nullptr);
-        }
-        else
-        {
-            eErr = poDstDS->RasterIO(GF_Read, nDstXOff, nDstYOff, nDstXSize,
-                                     nDstYSize, pDstBuffer, nDstXSize,
-                                     nDstYSize, psOptions->eWorkingDataType,
-                                     psOptions->nBandCount,
-                                     psOptions->panDstBands, 0, 0, 0, nullptr);
-        }
-
+        const CPLErr eErr =
+            DstWindowRasterIO(psOptions, GF_Read, nDstXOff, nDstYOff,
+                              nDstXSize, nDstYSize, pDstBuffer);
         if (eErr != CE_None)
         {
             DestroyDestinationBuffer(pDstBuffer);
@@ -1738,34 +1961,8 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
-        if (psOptions->nBandCount == 1)
-        {
-            // Particular case to simplify the stack a bit.
-            eErr = poDstDS->GetRasterBand(psOptions->panDstBands[0])
-                       ->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
-                                  nDstYSize, pDstBuffer, nDstXSize, nDstYSize,
-                                  psOptions->eWorkingDataType, 0, 0, nullptr);
-        }
-        else
-        {
-            eErr = poDstDS->RasterIO(GF_Write, nDstXOff, nDstYOff, nDstXSize,
-                                     nDstYSize, pDstBuffer, nDstXSize,
-                                     nDstYSize, psOptions->eWorkingDataType,
-                                     psOptions->nBandCount,
-                                     psOptions->panDstBands, 0, 0, 0, nullptr);
-        }
-
-        if (eErr == CE_None &&
-            CPLFetchBool(psOptions->papszWarpOptions, "WRITE_FLUSH", false))
-        {
-            const CPLErr eOldErr = CPLGetLastErrorType();
-            const CPLString osLastErrMsg = CPLGetLastErrorMsg();
-            GDALFlushCache(psOptions->hDstDS);
-            const CPLErr eNewErr = CPLGetLastErrorType();
-            if (eNewErr != eOldErr ||
-                osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
-                eErr = CE_Failure;
-        }
+        eErr = DstWindowRasterIO(psOptions, GF_Write, nDstXOff, nDstYOff,
+                                 nDstXSize, nDstYSize, pDstBuffer);
         ReportTiming("Output buffer write");
     }
 
@@ -1873,13 +2070,36 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
  */
 
 CPLErr GDALWarpOperation::WarpRegionToBuffer(
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
+    GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff, int nSrcXSize,
+    int nSrcYSize, double dfSrcXExtraSize, double dfSrcYExtraSize,
+    double dfProgressBase, double dfProgressScale)
+{
+    return WarpRegionToBufferInternal(
+        nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDataBuf, eBufDataType,
+        nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
+        dfSrcYExtraSize, dfProgressBase, dfProgressScale, nullptr);
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+// psJob is set when called from ChunkAndWarpMulti(). In that case, hIOMutex
+// is released through psJob->poPipeline->LeaveReadStage() when entering the
+// warp stage and is not re-acquired afterwards, and the accesses to the
+// destination dataset are done under the pipeline's hDstIOMutex.
+
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal(
     int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
     // Only in a CPLAssert.
     CPL_UNUSED GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
     int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
-    double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
+    double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale,
+    ChunkPipelineJob *psJob)
 
 {
+    CPLMutex *hDstIOMutex = psJob ? psJob->poPipeline->hDstIOMutex : nullptr;
     const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
 
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
@@ -2115,10 +2335,24 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         eErr = CreateKernelMask(&oWK, 0 /* not used */, "DstDensity");
 
         if (eErr == CE_None)
-            eErr = GDALWarpDstAlphaMasker(
-                psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
-                oWK.nDstXOff, oWK.nDstYOff, oWK.nDstXSize, oWK.nDstYSize,
-                oWK.papabyDstImage, TRUE, oWK.pafDstDensity);
+        {
+            if (hDstIOMutex != nullptr && !CPLAcquireMutex(hDstIOMutex, 600.0))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Failed to acquire DstIOMutex in WarpRegion().");
+                eErr = CE_Failure;
+            }
+            else
+            {
+                eErr = GDALWarpDstAlphaMasker(
+                    psOptions, psOptions->nBandCount,
+                    psOptions->eWorkingDataType, oWK.nDstXOff, oWK.nDstYOff,
+                    oWK.nDstXSize, oWK.nDstYSize, oWK.papabyDstImage, TRUE,
+                    oWK.pafDstDensity);
+                if (hDstIOMutex != nullptr)
+                    CPLReleaseMutex(hDstIOMutex);
+            }
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -2329,7 +2563,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (hIOMutex != nullptr)
     {
-        CPLReleaseMutex(hIOMutex);
+        if (psJob)
+            psJob->poPipeline->LeaveReadStage(psJob);
+        else
+            CPLReleaseMutex(hIOMutex);
         if (!CPLAcquireMutex(hWarpMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -2367,7 +2604,7 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     if (hIOMutex != nullptr)
     {
         CPLReleaseMutex(hWarpMutex);
-        if (!CPLAcquireMutex(hIOMutex, 600.0))
+        if (psJob == nullptr && !CPLAcquireMutex(hIOMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Failed to acquire IOMutex in WarpRegion().");
@@ -2380,10 +2617,21 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None && psOptions->nDstAlphaBand > 0)
     {
-        eErr = GDALWarpDstAlphaMasker(
-            psOptions, -psOptions->nBandCount, psOptions->eWorkingDataType,
-            oWK.nDstXOff, oWK.nDstYOff, oWK.nDstXSize, oWK.nDstYSize,
-            oWK.papabyDstImage, TRUE, oWK.pafDstDensity);
+        if (hDstIOMutex != nullptr && !CPLAcquireMutex(hDstIOMutex, 600.0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire DstIOMutex in WarpRegion().");
+            eErr = CE_Failure;
+        }
+        else
+        {
+            eErr = GDALWarpDstAlphaMasker(
+                psOptions, -psOptions->nBandCount, psOptions->eWorkingDataType,
+                oWK.nDstXOff, oWK.nDstYOff, oWK.nDstXSize, oWK.nDstYSize,
+                oWK.papabyDstImage, TRUE, oWK.pafDstDensity);
+            if (hDstIOMutex != nullptr)
+                CPLReleaseMutex(hDstIOMutex);
+        }
     }
 
     /* -------------------------------------------------------------------- */
@@ -25,81 +25,54 @@
 
 #include "gdal_alg.h"
 
+namespace
+{
+// Non-horizontal edge of a polygon, oriented by increasing Y.
+struct llPolygonEdge
+{
+    double dfX1;
+    double dfY1;
+    double dfDX;
+    double dfDY;
+    int nYStart;  // first scanline whose center is crossed by the edge
+    int nYEnd;    // last scanline whose center is crossed by the edge
+};
+
+// Bottom horizontal edge of a polygon, lying on the center of scanline nY.
+struct llPolygonHorizontalEdge
+{
+    int nY;
+    int nX1;
+    int nX2;
+};
+
+// Edge crossing the current scanline at nX.
+struct llActiveEdge
+{
+    int nX;
+    const llPolygonEdge *psEdge;
+};
+}  // namespace
+
 /************************************************************************/
-/*                       dllImageFilledPolygon()                        */
-/*                                                                      */
-/*      Perform scanline conversion of the passed multi-ring            */
-/*      polygon.  Note the polygon does not need to be explicitly       */
-/*      closed.  The scanline function will be called with              */
-/*      horizontal scanline chunks which may not be entirely            */
-/*      contained within the valid raster area (in the X                */
-/*      direction).                                                     */
+/*                  llImageFilledPolygonScanAllEdges()                  */
 /*                                                                      */
-/*      NEW: Nodes' coordinate are kept as double  in order             */
-/*      to compute accurately the intersections with the lines          */
-/*                                                                      */
-/*      A pixel is considered inside a polygon if its center            */
-/*      falls inside the polygon. This is robust unless                 */
-/*      the nodes are placed in the center of the pixels in which       */
-/*      case, due to numerical inaccuracies, it's hard to predict       */
-/*      if the pixel will be considered inside or outside the shape.    */
+/*      Original algorithm, intersecting all the edges with each        */
+/*      scanline. Used when some coordinates are not finite.            */
 /************************************************************************/
 
-/*
- * NOTE: This code was originally adapted from the gdImageFilledPolygon()
- * function in libgd.
- *
- * http://www.boutell.com/gd/
- *
- * It was later adapted for direct inclusion in GDAL and relicensed under
- * the GDAL MIT license (pulled from the OpenEV distribution).
- */
-
-void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
-                               int nPartCount, const int *panPartSize,
-                               const double *padfX, const double *padfY,
-                               const double *dfVariant,
-                               llScanlineFunc pfnScanlineFunc,
-                               GDALRasterizeInfo *pCBData,
-                               bool bAvoidBurningSamePoints)
+static void llImageFilledPolygonScanAllEdges(
+    int miny, int maxy, int maxx, int n, const int *panPartSize,
+    const double *padfX, const double *padfY, const double *dfVariant,
+    llScanlineFunc pfnScanlineFunc, GDALRasterizeInfo *pCBData,
+    bool bAvoidBurningSamePoints)
 {
-    if (!nPartCount)
-    {
-        return;
-    }
-
-    int n = 0;
-    for (int part = 0; part < nPartCount; part++)
-        n += panPartSize[part];
-
     std::vector<int> polyInts(n);
     std::vector<int> polyInts2;
     if (bAvoidBurningSamePoints)
         polyInts2.resize(n);
 
-    double dminy = padfY[0];
-    double dmaxy = padfY[0];
-    for (int i = 1; i < n; i++)
-    {
-        if (padfY[i] < dminy)
-        {
-            dminy = padfY[i];
-        }
-        if (padfY[i] > dmaxy)
-        {
-            dmaxy = padfY[i];
-        }
-    }
-    int miny = static_cast<int>(dminy);
-    int maxy = static_cast<int>(dmaxy);
-
-    if (miny < 0)
-        miny = 0;
-    if (maxy >= nRasterYSize)
-        maxy = nRasterYSize - 1;
-
-    int minx = 0;
-    const int maxx = nRasterXSize - 1;
+    const int minx = 0;
 
     // Fix in 1.3: count a vertex only once.
     for (int y = miny; y <= maxy; y++)
@@ -226,6 +199,320 @@ void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
     }
 }
 
+/************************************************************************/
+/*                       dllImageFilledPolygon()                        */
+/*                                                                      */
+/*      Perform scanline conversion of the passed multi-ring            */
+/*      polygon.  Note the polygon does not need to be explicitly       */
+/*      closed.  The scanline function will be called with              */
+/*      horizontal scanline chunks which may not be entirely            */
+/*      contained within the valid raster area (in the X                */
+/*      direction).                                                     */
+/*                                                                      */
+/*      NEW: Nodes' coordinate are kept as double  in order             */
+/*      to compute accurately the intersections with the lines          */
+/*                                                                      */
+/*      A pixel is considered inside a polygon if its center            */
+/*      falls inside the polygon. This is robust unless                 */
+/*      the nodes are placed in the center of the pixels in which       */
+/*      case, due to numerical inaccuracies, it's hard to predict       */
+/*      if the pixel will be considered inside or outside the shape.    */
+/*                                                                      */
+/*      The edges are sorted by their first scanline once, and only     */
+/*      the edges crossing the current scanline (the active edge        */
+/*      table) are intersected with it. The intersections are           */
+/*      computed with the same expression as the original algorithm,    */
+/*      rather than by incremental stepping, so that the same pixels    */
+/*      are burnt.                                                      */
+/************************************************************************/
+
+/*
+ * NOTE: This code was originally adapted from the gdImageFilledPolygon()
+ * function in libgd.
+ *
+ * http://www.boutell.com/gd/
+ *
+ * It was later adapted for direct inclusion in GDAL and relicensed under
+ * the GDAL MIT license (pulled from the OpenEV distribution).
+ */
+
+void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
+                               int nPartCount, const int *panPartSize,
+                               const double *padfX, const double *padfY,
+                               const double *dfVariant,
+                               llScanlineFunc pfnScanlineFunc,
+                               GDALRasterizeInfo *pCBData,
+                               bool bAvoidBurningSamePoints)
+{
+    if (!nPartCount)
+    {
+        return;
+    }
+
+    int n = 0;
+    for (int part = 0; part < nPartCount; part++)
+        n += panPartSize[part];
+
+    bool bAllFinite = true;
+    double dminy = padfY[0];
+    double dmaxy = padfY[0];
+    for (int i = 0; i < n; i++)
+    {
+        if (padfY[i] < dminy)
+        {
+            dminy = padfY[i];
+        }
+        if (padfY[i] > dmaxy)
+        {
+            dmaxy = padfY[i];
+        }
+        if (!std::isfinite(padfY[i]))
+            bAllFinite = false;
+    }
+    int miny = static_cast<int>(dminy);
+    int maxy = static_cast<int>(dmaxy);
+
+    if (miny < 0)
+        miny = 0;
+    if (maxy >= nRasterYSize)
+        maxy = nRasterYSize - 1;
+
+    const int minx = 0;
+    const int maxx = nRasterXSize - 1;
+
+    if (!bAllFinite)
+    {
+        llImageFilledPolygonScanAllEdges(
+            miny, maxy, maxx, n, panPartSize, padfX, padfY, dfVariant,
+            pfnScanlineFunc, pCBData, bAvoidBurningSamePoints);
+        return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Build the edge table.                                           */
+    /* -------------------------------------------------------------------- */
+    std::vector<llPolygonEdge> asEdges;
+    std::vector<llPolygonHorizontalEdge> asHorizontalEdges;
+    asEdges.reserve(n);
+
+    int partoffset = 0;
+    int part = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (i == partoffset + panPartSize[part])
+        {
+            partoffset += panPartSize[part];
+            part++;
+        }
+
+        int ind1 = 0;
+        int ind2 = 0;
+        if (i == partoffset)
+        {
+            ind1 = partoffset + panPartSize[part] - 1;
+            ind2 = partoffset;
+        }
+        else
+        {
+            ind1 = i - 1;
+            ind2 = i;
+        }
+
+        double dy1 = padfY[ind1];
+        double dy2 = padfY[ind2];
+
+        double dx1 = 0.0;
+        double dx2 = 0.0;
+        if (dy1 < dy2)
+        {
+            dx1 = padfX[ind1];
+            dx2 = padfX[ind2];
+        }
+        else if (dy1 > dy2)
+        {
+            std::swap(dy1, dy2);
+            dx2 = padfX[ind1];
+            dx1 = padfX[ind2];
+        }
+        else
+        {
+            // Bottom horizontal segments are filled separately, but only
+            // on the scanline whose center they lie on. Top horizontal
+            // segments are skipped.
+            const double dfY = std::floor(dy1);
+            if (padfX[ind1] > padfX[ind2] && dfY + 0.5 == dy1 && dfY >= miny &&
+                dfY <= maxy)
+            {
+                const int horizontal_x1 =
+                    static_cast<int>(floor(padfX[ind2] + 0.5));
+                const int horizontal_x2 =
+                    static_cast<int>(floor(padfX[ind1] + 0.5));
+
+                if ((horizontal_x1 <= maxx) && (horizontal_x2 > minx))
+                {
+                    asHorizontalEdges.push_back(
+                        {static_cast<int>(dfY), horizontal_x1, horizontal_x2});
+                }
+            }
+            continue;
+        }
+
+        // Range of scanlines y such that dy1 <= y + 0.5 < dy2, clamped to
+        // [miny, maxy]. y + 0.5 is exactly representable, so the estimate
+        // is refined with the same comparisons as the original algorithm.
+        int nYStart = static_cast<int>(
+            std::clamp(std::ceil(dy1 - 0.5), static_cast<double>(miny),
+                       static_cast<double>(maxy) + 1));
+        while (nYStart > miny && nYStart - 0.5 >= dy1)
+            nYStart--;
+        while (nYStart <= maxy && nYStart + 0.5 < dy1)
+            nYStart++;
+
+        int nYEnd = static_cast<int>(
+            std::clamp(std::ceil(dy2 - 0.5) - 1, static_cast<double>(miny) - 1,
+                       static_cast<double>(maxy)));
+        while (nYEnd < maxy && nYEnd + 1.5 < dy2)
+            nYEnd++;
+        while (nYEnd >= miny && nYEnd + 0.5 >= dy2)
+            nYEnd--;
+
+        if (nYStart <= nYEnd)
+        {
+            asEdges.push_back(
+                {dx1, dy1, dx2 - dx1, dy2 - dy1, nYStart, nYEnd});
+        }
+    }
+
+    std::sort(asEdges.begin(), asEdges.end(),
+              [](const llPolygonEdge &a, const llPolygonEdge &b)
+              { return a.nYStart < b.nYStart; });
+    std::stable_sort(asHorizontalEdges.begin(), asHorizontalEdges.end(),
+                     [](const llPolygonHorizontalEdge &a,
+                        const llPolygonHorizontalEdge &b)
+                     { return a.nY < b.nY; });
+
+    /* -------------------------------------------------------------------- */
+    /*      Scan the polygon, maintaining the active edges sorted by        */
+    /*      their intersection with the current scanline.                   */
+    /* -------------------------------------------------------------------- */
+    std::vector<llActiveEdge> asActiveEdges;
+    std::vector<int> polyInts2;
+    size_t iNextEdge = 0;
+    size_t iNextHorizontalEdge = 0;
+    for (int y = miny; y <= maxy; y++)
+    {
+        asActiveEdges.erase(
+            std::remove_if(asActiveEdges.begin(), asActiveEdges.end(),
+                           [y](const llActiveEdge &sActiveEdge)
+                           { return sActiveEdge.psEdge->nYEnd < y; }),
+            asActiveEdges.end());
+
+        if (asActiveEdges.empty())
+        {
+            // Skip scanlines without edges.
+            int nNextY = maxy + 1;
+            if (iNextEdge < asEdges.size())
+                nNextY = asEdges[iNextEdge].nYStart;
+            if (iNextHorizontalEdge < asHorizontalEdges.size())
+                nNextY =
+                    std::min(nNextY, asHorizontalEdges[iNextHorizontalEdge].nY);
+            if (nNextY > maxy)
+                break;
+            y = std::max(y, nNextY);
+        }
+
+        const size_t nOldActiveEdges = asActiveEdges.size();
+        for (; iNextEdge < asEdges.size() && asEdges[iNextEdge].nYStart <= y;
+             ++iNextEdge)
+        {
+            asActiveEdges.push_back({0, &asEdges[iNextEdge]});
+        }
+
+        const double dy = y + 0.5;  // Center height of line.
+
+        for (auto &sActiveEdge : asActiveEdges)
+        {
+            const llPolygonEdge *psEdge = sActiveEdge.psEdge;
+            const double intersect =
+                (dy - psEdge->dfY1) * psEdge->dfDX / psEdge->dfDY +
+                psEdge->dfX1;
+            sActiveEdge.nX = static_cast<int>(floor(intersect + 0.5));
+        }
+
+        // The order of the intersections changes little from one scanline
+        // to the next one, so insertion sort is used, unless many edges were
+        // just added.
+        const auto lessX = [](const llActiveEdge &a, const llActiveEdge &b)
+        { return a.nX < b.nX; };
+        if (asActiveEdges.size() - nOldActiveEdges > 16)
+        {
+            std::sort(asActiveEdges.begin(), asActiveEdges.end(), lessX);
+        }
+        else
+        {
+            for (size_t i = 1; i < asActiveEdges.size(); ++i)
+            {
+                const llActiveEdge sActiveEdge = asActiveEdges[i];
+                size_t j = i;
+                for (; j > 0 && sActiveEdge.nX < asActiveEdges[j - 1].nX; --j)
+                    asActiveEdges[j] = asActiveEdges[j - 1];
+                asActiveEdges[j] = sActiveEdge;
+            }
+        }
+
+        polyInts2.clear();
+        for (; iNextHorizontalEdge < asHorizontalEdges.size() &&
+               asHorizontalEdges[iNextHorizontalEdge].nY == y;
+             ++iNextHorizontalEdge)
+        {
+            const auto &sHorizontalEdge =
+                asHorizontalEdges[iNextHorizontalEdge];
+            if (bAvoidBurningSamePoints)
+            {
+                polyInts2.push_back(sHorizontalEdge.nX1);
+                polyInts2.push_back(sHorizontalEdge.nX2);
+            }
+            else
+            {
+                pfnScanlineFunc(pCBData, y, sHorizontalEdge.nX1,
+                                sHorizontalEdge.nX2 - 1,
+                                dfVariant == nullptr ? 0 : dfVariant[0]);
+            }
+        }
+        std::sort(polyInts2.begin(), polyInts2.end());
+
+        const int ints = static_cast<int>(asActiveEdges.size());
+        for (int i = 0; i + 1 < ints; i += 2)
+        {
+            if (asActiveEdges[i].nX <= maxx && asActiveEdges[i + 1].nX > minx)
+            {
+                pfnScanlineFunc(pCBData, y, asActiveEdges[i].nX,
+                                asActiveEdges[i + 1].nX - 1,
+                                dfVariant == nullptr ? 0 : dfVariant[0]);
+            }
+        }
+
+        const int ints2 = static_cast<int>(polyInts2.size());
+        for (int i2 = 0, i = 0; i2 + 1 < ints2; i2 += 2)
+        {
+            if (polyInts2[i2] <= maxx && polyInts2[i2 + 1] > minx)
+            {
+                // "synchronize" asActiveEdges[i] with polyInts2[i2]
+                while (i + 1 < ints && asActiveEdges[i].nX < polyInts2[i2])
+                    i += 2;
+                // Only burn if we don't have a common segment between
+                // asActiveEdges[] and polyInts2[]
+                if (i + 1 >= ints || asActiveEdges[i].nX != polyInts2[i2])
+                {
+                    pfnScanlineFunc(pCBData, y, polyInts2[i2],
+                                    polyInts2[i2 + 1] - 1,
+                                    dfVariant == nullptr ? 0 : dfVariant[0]);
+                }
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                         GDALdllImagePoint()                          */
 /************************************************************************/
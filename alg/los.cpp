@@ -9,11 +9,21 @@
  * SPDX-License-Identifier: MIT
  ****************************************************************************/
 
-#include <functional>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_port.h"
+#include "cpl_mem_cache.h"
+#include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_alg.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 // There's a plethora of bresenham implementations, all questionable production quality.
 // Bresenham optimizes for integer math, which makes sense for raster datasets in 2D.
@@ -33,9 +43,9 @@
 // The callback is run at every point along the line,
 // which should return True if the point is above terrain.
 // Bresenham2D will return true if all points have LOS between the start and end.
-static bool
-Bresenham2D(const int x1, const int y1, const int x2, const int y2,
-            std::function<auto(const int, const int)->bool> OnBresenhamPoint)
+template <class OnBresenhamPointFunc>
+static bool Bresenham2D(const int x1, const int y1, const int x2, const int y2,
+                        OnBresenhamPointFunc OnBresenhamPoint)
 {
     bool isAboveTerrain = true;
     int dx, dy;
@@ -133,56 +143,20 @@ static bool IsAboveTerrain(const GDALRasterBandH hBand, const int x,
 }
 
 /************************************************************************/
-/*                        GDALIsLineOfSightVisible()                    */
+/*                          LineOfSightVisible()                        */
 /************************************************************************/
 
-/**
- * Check Line of Sight between two points.
- * Both input coordinates must be within the raster coordinate bounds.
- *
- * This algorithm will check line of sight using a Bresenham algorithm.
- * https://www.researchgate.net/publication/2411280_Efficient_Line-of-Sight_Algorithms_for_Real_Terrain_Data
- * Line of sight is computed in raster coordinate space, and thus may not be appropriate.
- * For example, datasets referenced against geographic coordinate at high latitudes may have issues.
- *
- * @param hBand The band to read the DEM data from. This must NOT be null.
- *
- * @param xA The X location (raster column) of the first point to check on the raster.
- *
- * @param yA The Y location (raster row) of the first point to check on the raster.
- *
- * @param zA The Z location (height) of the first point to check.
- *
- * @param xB The X location (raster column) of the second point to check on the raster.
- *
- * @param yB The Y location (raster row) of the second point to check on the raster.
- *
- * @param zB The Z location (height) of the second point to check.
- *
- * @param[out] pnxTerrainIntersection The X location where the LOS line
- *             intersects with terrain, or nullptr if it does not intersect
- *             terrain.
- *
- * @param[out] pnyTerrainIntersection The Y location where the LOS line
- *             intersects with terrain, or nullptr if it does not intersect
- *             terrain.
- *
- * @param papszOptions Options for the line of sight algorithm (currently ignored).
- *
- * @return True if the two points are within Line of Sight.
- *
- * @since GDAL 3.9
- */
-
-bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
-                              const int yA, const double zA, const int xB,
-                              const int yB, const double zB,
-                              int *pnxTerrainIntersection,
-                              int *pnyTerrainIntersection,
-                              CPL_UNUSED CSLConstList papszOptions)
+// Core of GDALIsLineOfSightVisible(), templated on the terrain check so that
+// the single pair and the batched APIs share the exact same traversal.
+// IsAboveTerrainAt(x, y, z) must return true if z is above the terrain at
+// (x, y), and false if it is not or if the elevation cannot be read.
+template <class IsAboveTerrainFunc>
+static bool LineOfSightVisible(IsAboveTerrainFunc IsAboveTerrainAt,
+                               const int xA, const int yA, const double zA,
+                               const int xB, const int yB, const double zB,
+                               int *pnxTerrainIntersection,
+                               int *pnyTerrainIntersection)
 {
-    VALIDATE_POINTER1(hBand, "GDALIsLineOfSightVisible", false);
-
     // A lambda to set the X-Y intersection if it's not null
     auto SetXYIntersection = [&](const int x, const int y)
     {
@@ -203,12 +177,12 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
         *pnyTerrainIntersection = -1;
 
     // Perform a preliminary check of the start and end points.
-    if (!IsAboveTerrain(hBand, xA, yA, zA))
+    if (!IsAboveTerrainAt(xA, yA, zA))
     {
         SetXYIntersection(xA, yA);
         return false;
     }
-    if (!IsAboveTerrain(hBand, xB, yB, zB))
+    if (!IsAboveTerrainAt(xB, yB, zB))
     {
         SetXYIntersection(xB, yB);
         return false;
@@ -256,7 +230,7 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
             for (int y = yA; y <= yB; ++y)
             {
                 const auto zTest = GetZValueFromY(y);
-                if (!IsAboveTerrain(hBand, xA, y, zTest))
+                if (!IsAboveTerrainAt(xA, y, zTest))
                 {
                     SetXYIntersection(xA, y);
                     return false;
@@ -269,7 +243,7 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
             for (int y = yA; y >= yB; --y)
             {
                 const auto zTest = GetZValueFromY(y);
-                if (!IsAboveTerrain(hBand, xA, y, zTest))
+                if (!IsAboveTerrainAt(xA, y, zTest))
                 {
                     SetXYIntersection(xA, y);
                     return false;
@@ -291,7 +265,7 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
             for (int x = xA; x <= xB; ++x)
             {
                 const auto zTest = GetZValueFromX(x);
-                if (!IsAboveTerrain(hBand, x, yA, zTest))
+                if (!IsAboveTerrainAt(x, yA, zTest))
                 {
                     SetXYIntersection(x, yA);
                     return false;
@@ -304,7 +278,7 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
             for (int x = xA; x >= xB; --x)
             {
                 const auto zTest = GetZValueFromX(x);
-                if (!IsAboveTerrain(hBand, x, yA, zTest))
+                if (!IsAboveTerrainAt(x, yA, zTest))
                 {
                     SetXYIntersection(x, yA);
                     return false;
@@ -349,13 +323,419 @@ bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
     auto OnBresenhamPoint = [&](const int x, const int y) -> bool
     {
         const auto z = GetZValueFromXY(x, y);
-        const auto isAbove = IsAboveTerrain(hBand, x, y, z);
+        const auto isAbove = IsAboveTerrainAt(x, y, z);
         if (!isAbove)
         {
             SetXYIntersection(x, y);
         }
-        return IsAboveTerrain(hBand, x, y, z);
+        return isAbove;
     };
 
     return Bresenham2D(xA, yA, xB, yB, OnBresenhamPoint);
 }
+
+/************************************************************************/
+/*                        GDALIsLineOfSightVisible()                    */
+/************************************************************************/
+
+/**
+ * Check Line of Sight between two points.
+ * Both input coordinates must be within the raster coordinate bounds.
+ *
+ * This algorithm will check line of sight using a Bresenham algorithm.
+ * https://www.researchgate.net/publication/2411280_Efficient_Line-of-Sight_Algorithms_for_Real_Terrain_Data
+ * Line of sight is computed in raster coordinate space, and thus may not be appropriate.
+ * For example, datasets referenced against geographic coordinate at high latitudes may have issues.
+ *
+ * @param hBand The band to read the DEM data from. This must NOT be null.
+ *
+ * @param xA The X location (raster column) of the first point to check on the raster.
+ *
+ * @param yA The Y location (raster row) of the first point to check on the raster.
+ *
+ * @param zA The Z location (height) of the first point to check.
+ *
+ * @param xB The X location (raster column) of the second point to check on the raster.
+ *
+ * @param yB The Y location (raster row) of the second point to check on the raster.
+ *
+ * @param zB The Z location (height) of the second point to check.
+ *
+ * @param[out] pnxTerrainIntersection The X location where the LOS line
+ *             intersects with terrain, or nullptr if it does not intersect
+ *             terrain.
+ *
+ * @param[out] pnyTerrainIntersection The Y location where the LOS line
+ *             intersects with terrain, or nullptr if it does not intersect
+ *             terrain.
+ *
+ * @param papszOptions Options for the line of sight algorithm (currently ignored).
+ *
+ * @return True if the two points are within Line of Sight.
+ *
+ * @since GDAL 3.9
+ */
+bool GDALIsLineOfSightVisible(const GDALRasterBandH hBand, const int xA,
+                              const int yA, const double zA, const int xB,
+                              const int yB, const double zB,
+                              int *pnxTerrainIntersection,
+                              int *pnyTerrainIntersection,
+                              CPL_UNUSED CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hBand, "GDALIsLineOfSightVisible", false);
+
+    return LineOfSightVisible(
+        [hBand](const int x, const int y, const double z)
+        { return IsAboveTerrain(hBand, x, y, z); },
+        xA, yA, zA, xB, yB, zB, pnxTerrainIntersection, pnyTerrainIntersection);
+}
+
+/************************************************************************/
+/*                             LOSTileCache                             */
+/************************************************************************/
+
+namespace
+{
+
+constexpr int LOS_TILE_SIZE = 256;
+
+// Float64 tiles of the DEM shared by the workers of
+// GDALIsLineOfSightVisibleMulti(). The band is only read under the mutex,
+// since it may not support concurrent access, and tiles are evicted in least
+// recently used order. A tile that cannot be read is not cached: GetTile()
+// returns nullptr and HasFailed() becomes true.
+class LOSTileCache
+{
+  public:
+    using Tile = std::shared_ptr<const std::vector<double>>;
+
+    LOSTileCache(GDALRasterBand *poBand, size_t nMaxTiles)
+        : m_poBand(poBand), m_nXSize(poBand->GetXSize()),
+          m_nYSize(poBand->GetYSize()),
+          m_nTilesPerRow(DIV_ROUND_UP(m_nXSize, LOS_TILE_SIZE)),
+          m_oCache(nMaxTiles, 0)
+    {
+    }
+
+    Tile GetTile(int nTileX, int nTileY)
+    {
+        const GIntBig nKey =
+            static_cast<GIntBig>(nTileY) * m_nTilesPerRow + nTileX;
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        Tile poTile;
+        if (m_oCache.tryGet(nKey, poTile))
+            return poTile;
+
+        const int nXOff = nTileX * LOS_TILE_SIZE;
+        const int nYOff = nTileY * LOS_TILE_SIZE;
+        const int nReqXSize = std::min(LOS_TILE_SIZE, m_nXSize - nXOff);
+        const int nReqYSize = std::min(LOS_TILE_SIZE, m_nYSize - nYOff);
+        try
+        {
+            auto poData = std::make_shared<std::vector<double>>(
+                LOS_TILE_SIZE * LOS_TILE_SIZE);
+            if (m_poBand->RasterIO(GF_Read, nXOff, nYOff, nReqXSize, nReqYSize,
+                                   poData->data(), nReqXSize, nReqYSize,
+                                   GDT_Float64, sizeof(double),
+                                   LOS_TILE_SIZE * sizeof(double),
+                                   nullptr) != CE_None)
+            {
+                m_bFailed = true;
+                return nullptr;
+            }
+            poTile = std::move(poData);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALIsLineOfSightVisibleMulti()");
+            m_bFailed = true;
+            return nullptr;
+        }
+        m_oCache.insert(nKey, poTile);
+        return poTile;
+    }
+
+    bool HasFailed() const
+    {
+        return m_bFailed;
+    }
+
+  private:
+    GDALRasterBand *const m_poBand;
+    const int m_nXSize;
+    const int m_nYSize;
+    const int m_nTilesPerRow;
+    std::mutex m_oMutex{};
+    lru11::Cache<GIntBig, Tile> m_oCache;
+    std::atomic<bool> m_bFailed{false};
+
+    CPL_DISALLOW_COPY_ASSIGN(LOSTileCache)
+};
+
+/************************************************************************/
+/*                           LOSTileAccessor                            */
+/************************************************************************/
+
+// Per-worker front of LOSTileCache, in the manner of
+// GDALCachedPixelAccessor: it keeps the most recently used tiles so that the
+// shared cache is only consulted when a ray crosses into another tile.
+class LOSTileAccessor
+{
+  public:
+    explicit LOSTileAccessor(LOSTileCache &oCache) : m_oCache(oCache)
+    {
+    }
+
+    bool IsAboveTerrain(const int x, const int y, const double z)
+    {
+        const int nTileX = x / LOS_TILE_SIZE;
+        const int nTileY = y / LOS_TILE_SIZE;
+        if (m_aoTiles[0].nTileX != nTileX || m_aoTiles[0].nTileY != nTileY)
+            SetFrontTile(nTileX, nTileY);
+        const auto *padfTile = m_aoTiles[0].padfData;
+        if (padfTile == nullptr)
+            return false;  // Read error: stops the ray.
+        return z > padfTile[(y % LOS_TILE_SIZE) * LOS_TILE_SIZE +
+                            (x % LOS_TILE_SIZE)];
+    }
+
+  private:
+    static constexpr int CACHED_TILE_COUNT = 8;
+
+    struct CachedTile
+    {
+        int nTileX = -1;
+        int nTileY = -1;
+        LOSTileCache::Tile poTile{};
+        const double *padfData = nullptr;
+    };
+
+    LOSTileCache &m_oCache;
+    std::array<CachedTile, CACHED_TILE_COUNT> m_aoTiles{};
+
+    void SetFrontTile(int nTileX, int nTileY)
+    {
+        int i = 1;
+        for (; i < CACHED_TILE_COUNT; ++i)
+        {
+            if (m_aoTiles[i].nTileX == nTileX && m_aoTiles[i].nTileY == nTileY)
+                break;
+        }
+        if (i == CACHED_TILE_COUNT)
+        {
+            i = CACHED_TILE_COUNT - 1;
+            auto &oTile = m_aoTiles[i];
+            oTile.nTileX = nTileX;
+            oTile.nTileY = nTileY;
+            oTile.poTile = m_oCache.GetTile(nTileX, nTileY);
+            if (oTile.poTile)
+            {
+                oTile.padfData = oTile.poTile->data();
+            }
+            else
+            {
+                // Do not keep a tile that could not be read.
+                oTile.nTileX = -1;
+                oTile.nTileY = -1;
+                oTile.padfData = nullptr;
+            }
+        }
+        std::rotate(m_aoTiles.begin(), m_aoTiles.begin() + i,
+                    m_aoTiles.begin() + i + 1);
+    }
+
+    CPL_DISALLOW_COPY_ASSIGN(LOSTileAccessor)
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                    GDALIsLineOfSightVisibleMulti()                   */
+/************************************************************************/
+
+/**
+ * Check Line of Sight between many pairs of points.
+ *
+ * This is the batched version of GDALIsLineOfSightVisible(): pair i goes from
+ * (panXA[i], panYA[i], padfZA[i]) to (panXB[i], panYB[i], padfZB[i]), and
+ * its result is the same as the one of GDALIsLineOfSightVisible() for this
+ * pair. The DEM is read by tiles that are shared by all the pairs, instead
+ * of pixel by pixel, and the pairs can be spread over several threads.
+ * All coordinates must be within the raster coordinate bounds.
+ *
+ * @param hBand The band to read the DEM data from. This must NOT be null.
+ *
+ * @param nCount Number of pairs.
+ *
+ * @param panXA X locations (raster columns) of the first points.
+ *
+ * @param panYA Y locations (raster rows) of the first points.
+ *
+ * @param padfZA Z locations (heights) of the first points.
+ *
+ * @param panXB X locations (raster columns) of the second points.
+ *
+ * @param panYB Y locations (raster rows) of the second points.
+ *
+ * @param padfZB Z locations (heights) of the second points.
+ *
+ * @param[out] pabVisible Array of nCount values, set to true for the pairs
+ *             that are within Line of Sight.
+ *
+ * @param[out] panXTerrainIntersection Array of nCount values set to the X
+ *             location where the LOS line of each pair intersects with
+ *             terrain, or -1. May be nullptr.
+ *
+ * @param[out] panYTerrainIntersection Array of nCount values set to the Y
+ *             location where the LOS line of each pair intersects with
+ *             terrain, or -1. May be nullptr.
+ *
+ * @param papszOptions Options for the line of sight algorithm:
+ * <ul>
+ * <li>"NUM_THREADS": Number of worker threads, or "ALL_CPUS". Defaults to
+ * 1.</li>
+ * </ul>
+ * DEM tiles are cached up to half of the GDAL block cache size
+ * (GDAL_CACHEMAX).
+ *
+ * @return CE_None on success, or CE_Failure if the arguments are invalid or
+ * the DEM cannot be read. In the latter case, the content of the output arrays
+ * is undefined.
+ *
+ * @since GDAL 3.11
+ */
+CPLErr GDALIsLineOfSightVisibleMulti(
+    GDALRasterBandH hBand, int nCount, const int *panXA, const int *panYA,
+    const double *padfZA, const int *panXB, const int *panYB,
+    const double *padfZB, bool *pabVisible, int *panXTerrainIntersection,
+    int *panYTerrainIntersection, CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hBand, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    if (nCount < 0)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Invalid nCount = %d", nCount);
+        return CE_Failure;
+    }
+    if (nCount == 0)
+        return CE_None;
+    VALIDATE_POINTER1(panXA, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(panYA, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(padfZA, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(panXB, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(panYB, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(padfZB, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+    VALIDATE_POINTER1(pabVisible, "GDALIsLineOfSightVisibleMulti", CE_Failure);
+
+    auto poBand = GDALRasterBand::FromHandle(hBand);
+    const int nXSize = poBand->GetXSize();
+    const int nYSize = poBand->GetYSize();
+    for (int i = 0; i < nCount; ++i)
+    {
+        if (panXA[i] < 0 || panXA[i] >= nXSize || panYA[i] < 0 ||
+            panYA[i] >= nYSize || panXB[i] < 0 || panXB[i] >= nXSize ||
+            panYB[i] < 0 || panYB[i] >= nYSize)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "Pair %d has a point outside of the raster", i);
+            return CE_Failure;
+        }
+    }
+
+    int nThreads = 1;
+    if (const char *pszNumThreads =
+            CSLFetchNameValue(papszOptions, "NUM_THREADS"))
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
+    // Process the pairs ordered by the tiles of their end points, so that
+    // consecutive rays tend to cross the same tiles.
+    std::vector<int> anOrder;
+    try
+    {
+        anOrder.resize(nCount);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALIsLineOfSightVisibleMulti()");
+        return CE_Failure;
+    }
+    for (int i = 0; i < nCount; ++i)
+        anOrder[i] = i;
+    const auto TileKey = [](int x, int y)
+    {
+        return std::make_pair(y / LOS_TILE_SIZE, x / LOS_TILE_SIZE);
+    };
+    std::sort(anOrder.begin(), anOrder.end(),
+              [&](int i, int j)
+              {
+                  const auto oKeyI = std::make_pair(
+                      TileKey(panXA[i], panYA[i]), TileKey(panXB[i], panYB[i]));
+                  const auto oKeyJ = std::make_pair(
+                      TileKey(panXA[j], panYA[j]), TileKey(panXB[j], panYB[j]));
+                  return oKeyI < oKeyJ;
+              });
+
+    constexpr GIntBig TILE_BYTES =
+        static_cast<GIntBig>(LOS_TILE_SIZE) * LOS_TILE_SIZE * sizeof(double);
+    const GIntBig nMaxTiles = std::max<GIntBig>(
+        4 * nThreads, GDALGetCacheMax64() / 2 / TILE_BYTES);
+    LOSTileCache oCache(poBand, static_cast<size_t>(nMaxTiles));
+
+    const auto ProcessPairs =
+        [&](LOSTileAccessor &oAccessor, int iStart, int iEnd)
+    {
+        const auto IsAboveTerrainAt =
+            [&oAccessor](const int x, const int y, const double z)
+        { return oAccessor.IsAboveTerrain(x, y, z); };
+        for (int k = iStart; k < iEnd && !oCache.HasFailed(); ++k)
+        {
+            const int i = anOrder[k];
+            pabVisible[i] = LineOfSightVisible(
+                IsAboveTerrainAt, panXA[i], panYA[i], padfZA[i], panXB[i],
+                panYB[i], padfZB[i],
+                panXTerrainIntersection ? panXTerrainIntersection + i
+                                        : nullptr,
+                panYTerrainIntersection ? panYTerrainIntersection + i
+                                        : nullptr);
+        }
+    };
+
+    if (nThreads == 1)
+    {
+        LOSTileAccessor oAccessor(oCache);
+        ProcessPairs(oAccessor, 0, nCount);
+        return oCache.HasFailed() ? CE_Failure : CE_None;
+    }
+
+    // Workers pick chunks of consecutive pairs until all are processed.
+    constexpr int CHUNK_SIZE = 256;
+    std::atomic<size_t> nNextPair{0};
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    for (int iJob = 0; iJob < nThreads; ++iJob)
+    {
+        poJobQueue->SubmitJob(
+            [&]()
+            {
+                LOSTileAccessor oAccessor(oCache);
+                while (true)
+                {
+                    const size_t iStart = nNextPair.fetch_add(CHUNK_SIZE);
+                    if (iStart >= static_cast<size_t>(nCount) ||
+                        oCache.HasFailed())
+                        break;
+                    const int iEnd = static_cast<int>(
+                        std::min(static_cast<size_t>(nCount),
+                                 iStart + CHUNK_SIZE));
+                    ProcessPairs(oAccessor, static_cast<int>(iStart), iEnd);
+                }
+            });
+    }
+    poJobQueue->WaitCompletion();
+
+    return oCache.HasFailed() ? CE_Failure : CE_None;
+}
@@ -54,6 +54,19 @@ class ContourGenerator
         return CE_None;
     }
 
+    // Start at line lineIdx instead of the first line, previousLine being the
+    // values of the line lineIdx - 1 (or nullptr if lineIdx is 0). Must be
+    // called before feeding any line. Used to process a raster by strips.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        if (previousLine != nullptr)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
   private:
     size_t width_;
     size_t height_;
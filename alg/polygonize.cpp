@@ -19,6 +19,8 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
@@ -34,6 +36,8 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -48,15 +52,17 @@ using namespace gdal::polygonizer;
 
 template <class DataType>
 static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
-                              int iY, int nXSize, DataType *panImageLine)
+                              int iY, int nXSize, DataType *panImageLine,
+                              int nLines = 1)
 
 {
-    const CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                                     pabyMaskLine, nXSize, 1, GDT_Byte, 0, 0);
+    const CPLErr eErr =
+        GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, nLines, pabyMaskLine,
+                     nXSize, nLines, GDT_Byte, 0, 0);
     if (eErr != CE_None)
         return eErr;
 
-    for (int i = 0; i < nXSize; i++)
+    for (size_t i = 0; i < static_cast<size_t>(nXSize) * nLines; i++)
     {
         if (pabyMaskLine[i] == 0)
             panImageLine[i] = GP_NODATA_MARKER;
@@ -65,6 +71,627 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/************************************************************************/
+/*                        GPIsConnectedToLine()                         */
+/*                                                                      */
+/*      Whether a pixel of value nValue at column iX is connected to    */
+/*      a pixel of the line above or below it.                          */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool GPIsConnectedToLine(const DataType *panOtherLineVal, int iX,
+                                int nXSize, DataType nValue,
+                                int nConnectedness)
+{
+    EqualityTest eq;
+    const int iXStart = nConnectedness == 8 ? std::max(0, iX - 1) : iX;
+    const int iXEnd = nConnectedness == 8 ? std::min(nXSize - 1, iX + 1) : iX;
+    for (int i = iXStart; i <= iXEnd; ++i)
+    {
+        if (panOtherLineVal[i] != GP_NODATA_MARKER &&
+            eq(panOtherLineVal[i], nValue))
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                               GPStrip                                */
+/************************************************************************/
+
+// Lines [nYOff, nYOff + nLines[ of the raster, processed as a unit by
+// GDALPolygonizeMultiThreaded().
+template <class DataType> struct GPStrip
+{
+    int nXSize = 0;
+    int nYOff = 0;
+    int nLines = 0;
+
+    // Whether anVal also contains the line above the strip, before its own
+    // lines, and the line below it, after them.
+    bool bHasLineAbove = false;
+    bool bHasLineBelow = false;
+    std::vector<DataType> anVal{};
+    std::vector<GByte> abyMask{};
+
+    // Polygon id of each pixel of the strip, or -1 for nodata pixels. Ids
+    // are local to the strip.
+    std::vector<GInt32> anId{};
+
+    // For each polygon id, rank of the polygon among the ones connected to
+    // pixels of the adjacent strips (seam polygons), or -1.
+    std::vector<GInt32> anSeamIdx{};
+    int nSeamPolygons = 0;
+
+    std::vector<typename OGRPolygonCollector<DataType>::CollectedPolygon>
+        aoPolygons{};
+
+    bool bOK = false;
+    std::atomic<bool> bDone{false};
+
+    // iLine is in [-1, nLines] if the strip has the lines around it.
+    DataType *GetLineVal(int iLine)
+    {
+        return anVal.data() +
+               static_cast<size_t>(iLine + (bHasLineAbove ? 1 : 0)) * nXSize;
+    }
+
+    GInt32 *GetLineId(int iLine)
+    {
+        return anId.data() + static_cast<size_t>(iLine) * nXSize;
+    }
+};
+
+/************************************************************************/
+/*                          GPEnumerateStrip()                          */
+/*                                                                      */
+/*      Assign final polygon ids to the pixels of a strip, and find     */
+/*      its seam polygons.                                              */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool GPEnumerateStrip(GPStrip<DataType> &sStrip, int nConnectedness)
+{
+    const int nXSize = sStrip.nXSize;
+    const int nLines = sStrip.nLines;
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oEnum(
+        nConnectedness);
+    try
+    {
+        sStrip.anId.resize(static_cast<size_t>(nXSize) * nLines);
+
+        for (int iLine = 0; iLine < nLines; ++iLine)
+        {
+            DataType *panThisLineVal = sStrip.GetLineVal(iLine);
+            GInt32 *panThisLineId = sStrip.GetLineId(iLine);
+            const bool bRet =
+                iLine == 0
+                    ? oEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
+                                        panThisLineId, nXSize)
+                    : oEnum.ProcessLine(panThisLineVal - nXSize,
+                                        panThisLineVal, panThisLineId - nXSize,
+                                        panThisLineId, nXSize);
+            if (!bRet)
+                return false;
+        }
+        oEnum.CompleteMerges();
+        for (GInt32 &nId : sStrip.anId)
+        {
+            if (nId >= 0)
+                nId = oEnum.panPolyIdMap[nId];
+        }
+
+        sStrip.anSeamIdx.assign(oEnum.nNextPolygonId, -1);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return false;
+    }
+
+    sStrip.nSeamPolygons = 0;
+    const auto FindSeamPolygons = [&sStrip, nXSize, nConnectedness](
+                                      int iLine, int iOtherLine)
+    {
+        const DataType *panLineVal = sStrip.GetLineVal(iLine);
+        const DataType *panOtherLineVal = sStrip.GetLineVal(iOtherLine);
+        const GInt32 *panLineId = sStrip.GetLineId(iLine);
+        for (int iX = 0; iX < nXSize; ++iX)
+        {
+            const GInt32 nId = panLineId[iX];
+            if (nId >= 0 && sStrip.anSeamIdx[nId] < 0 &&
+                GPIsConnectedToLine<DataType, EqualityTest>(
+                    panOtherLineVal, iX, nXSize, panLineVal[iX],
+                    nConnectedness))
+            {
+                sStrip.anSeamIdx[nId] = sStrip.nSeamPolygons++;
+            }
+        }
+    };
+    if (sStrip.bHasLineAbove)
+        FindSeamPolygons(0, -1);
+    if (sStrip.bHasLineBelow)
+        FindSeamPolygons(nLines - 1, nLines);
+
+    return true;
+}
+
+/************************************************************************/
+/*                     GPPolygonizeStripPolygons()                      */
+/*                                                                      */
+/*      Trace the polygons of a strip that are not seam polygons.       */
+/************************************************************************/
+
+template <class DataType>
+static bool GPPolygonizeStripPolygons(GPStrip<DataType> &sStrip,
+                                      const double *padfGeoTransform)
+{
+    const int nXSize = sStrip.nXSize;
+    OGRPolygonCollector<DataType> oCollector(padfGeoTransform);
+    Polygonizer<GInt32, DataType> oPolygonizer{-1, &oCollector};
+    std::vector<TwoArm> aoLastLineArm;
+    std::vector<TwoArm> aoThisLineArm;
+    std::vector<GInt32> anLineId;
+    try
+    {
+        aoLastLineArm.resize(nXSize + 2);
+        aoThisLineArm.resize(nXSize + 2);
+        anLineId.resize(nXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return false;
+    }
+    for (auto &oArm : aoLastLineArm)
+        oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+
+    // The pixels of seam polygons are handled as nodata ones, which does
+    // not change the geometry of the other polygons.
+    for (int iLine = 0; iLine <= sStrip.nLines; ++iLine)
+    {
+        if (iLine < sStrip.nLines)
+        {
+            const GInt32 *panId = sStrip.GetLineId(iLine);
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                const GInt32 nId = panId[iX];
+                anLineId[iX] =
+                    nId >= 0 && sStrip.anSeamIdx[nId] < 0 ? nId : -1;
+            }
+        }
+        else
+        {
+            std::fill(anLineId.begin(), anLineId.end(),
+                      decltype(oPolygonizer)::THE_OUTER_POLYGON_ID);
+        }
+
+        if (!oPolygonizer.processLine(
+                anLineId.data(), sStrip.GetLineVal(std::max(0, iLine - 1)),
+                aoThisLineArm.data(), aoLastLineArm.data(),
+                sStrip.nYOff + iLine, nXSize) ||
+            oCollector.getErr() != CE_None)
+        {
+            return false;
+        }
+        std::swap(aoThisLineArm, aoLastLineArm);
+    }
+
+    sStrip.aoPolygons = std::move(oCollector.getPolygons());
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALPolygonizeMultiThreaded()                     */
+/************************************************************************/
+
+// Polygonize the raster by horizontal strips, processed concurrently by
+// nThreads threads of the global thread pool. Strips are read by the calling
+// thread, which also writes the output features.
+//
+// A first pass enumerates and traces the polygons of each strip that are not
+// connected to pixels of the adjacent strips, and writes them as soon as the
+// strip is done. Seam polygons are unioned across strips. A second pass
+// re-enumerates the strips that have seam polygons, and traces these on the
+// calling thread, with all other pixels handled as nodata.
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+    int iPixValField, int nConnectedness, double *padfGeoTransform,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg,
+    GDALDataType eDT)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    // Enough strips to balance the load between threads, but strips not
+    // larger than needed, to limit memory usage.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const int nMaxStripLines = static_cast<int>(std::max<size_t>(
+        1, MAX_STRIP_BYTES / (static_cast<size_t>(nXSize) *
+                              (sizeof(DataType) + sizeof(GInt32) + 1))));
+    const int nStripLines =
+        std::max(1, std::min(nMaxStripLines,
+                             (nYSize + 4 * nThreads - 1) / (4 * nThreads)));
+    const int nStrips = (nYSize + nStripLines - 1) / nStripLines;
+
+    // Strips being computed, and the ones being read or consumed.
+    std::vector<GPStrip<DataType>> asStrips(2 * nThreads);
+
+    const auto ReadStrip = [hSrcBand, hMaskBand, nXSize, nYSize, nStripLines,
+                            eDT](GPStrip<DataType> &sStrip, int iStrip)
+    {
+        sStrip.nXSize = nXSize;
+        sStrip.nYOff = iStrip * nStripLines;
+        sStrip.nLines = std::min(nStripLines, nYSize - sStrip.nYOff);
+        sStrip.bHasLineAbove = sStrip.nYOff > 0;
+        sStrip.bHasLineBelow = sStrip.nYOff + sStrip.nLines < nYSize;
+        const int nSrcYOff = sStrip.nYOff - (sStrip.bHasLineAbove ? 1 : 0);
+        const int nSrcLines = sStrip.nLines +
+                              (sStrip.bHasLineAbove ? 1 : 0) +
+                              (sStrip.bHasLineBelow ? 1 : 0);
+        try
+        {
+            sStrip.anVal.resize(static_cast<size_t>(nSrcLines) * nXSize);
+            if (hMaskBand)
+                sStrip.abyMask.resize(static_cast<size_t>(nSrcLines) *
+                                      nXSize);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory allocating strip buffers");
+            return CE_Failure;
+        }
+        CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nSrcYOff, nXSize,
+                                   nSrcLines, sStrip.anVal.data(), nXSize,
+                                   nSrcLines, eDT, 0, 0);
+        if (eErr == CE_None && hMaskBand != nullptr)
+            eErr = GPMaskImageData(hMaskBand, sStrip.abyMask.data(),
+                                   nSrcYOff, nXSize, sStrip.anVal.data(),
+                                   nSrcLines);
+        return eErr;
+    };
+
+    // Compute the strips of anStripIdx concurrently with pfnCompute(), and
+    // consume them in order with pfnConsume().
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    const auto ProcessStrips =
+        [&asStrips, &poJobQueue, &ReadStrip](
+            const std::vector<int> &anStripIdx,
+            const std::function<bool(GPStrip<DataType> &, int)> &pfnCompute,
+            const std::function<CPLErr(GPStrip<DataType> &, int)> &pfnConsume)
+    {
+        const int nStripsToProcess = static_cast<int>(anStripIdx.size());
+        CPLErr eErr = CE_None;
+        int iNextToRead = 0;
+        for (int i = 0; i < nStripsToProcess && eErr == CE_None; ++i)
+        {
+            while (eErr == CE_None && iNextToRead < nStripsToProcess &&
+                   iNextToRead - i < static_cast<int>(asStrips.size()))
+            {
+                auto &sStrip = asStrips[iNextToRead % asStrips.size()];
+                const int iStrip = anStripIdx[iNextToRead];
+                eErr = ReadStrip(sStrip, iStrip);
+                if (eErr != CE_None)
+                    break;
+
+                sStrip.bDone = false;
+                poJobQueue->SubmitJob(
+                    [&sStrip, &pfnCompute, iStrip]()
+                    {
+                        sStrip.bOK = pfnCompute(sStrip, iStrip);
+                        sStrip.bDone = true;
+                    });
+                ++iNextToRead;
+            }
+            if (eErr != CE_None)
+                break;
+
+            auto &sStrip = asStrips[i % asStrips.size()];
+            while (!sStrip.bDone && poJobQueue->WaitEvent())
+            {
+            }
+            eErr = sStrip.bOK ? pfnConsume(sStrip, anStripIdx[i]) : CE_Failure;
+        }
+
+        // Jobs reference asStrips.
+        poJobQueue->WaitCompletion();
+        return eErr;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: polygons within strips, and union of seam           */
+    /*      polygons.                                                       */
+    /* -------------------------------------------------------------------- */
+
+    // Union-find forest of the seam polygons of all strips, numbered
+    // consecutively, from anNodeBase[iStrip] for each strip.
+    std::vector<GInt32> anParent;
+    std::vector<GInt32> anNodeBase(nStrips, -1);
+    std::vector<int> anStripsWithSeams;
+    // Seam polygon node of each pixel of the last line of the previous strip.
+    std::vector<GInt32> anPrevLastLineNode;
+
+    const auto FindRoot = [&anParent](GInt32 nNode)
+    {
+        while (anParent[nNode] != nNode)
+        {
+            anParent[nNode] = anParent[anParent[nNode]];
+            nNode = anParent[nNode];
+        }
+        return nNode;
+    };
+
+    OGRLayer *poOutLayer = OGRLayer::FromHandle(hOutLayer);
+    auto poFeature = std::make_unique<OGRFeature>(poOutLayer->GetLayerDefn());
+
+    const auto ComputeStripPass1 =
+        [nConnectedness, padfGeoTransform](GPStrip<DataType> &sStrip, int)
+    {
+        return GPEnumerateStrip<DataType, EqualityTest>(sStrip,
+                                                        nConnectedness) &&
+               GPPolygonizeStripPolygons(sStrip, padfGeoTransform);
+    };
+
+    const auto ConsumeStripPass1 = [&](GPStrip<DataType> &sStrip, int iStrip)
+    {
+        EqualityTest eq;
+        const GInt32 nNodeBase = static_cast<GInt32>(anParent.size());
+        if (sStrip.nSeamPolygons >
+            std::numeric_limits<GInt32>::max() - 1 - nNodeBase)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALPolygonize(): too many polygons");
+            return CE_Failure;
+        }
+        try
+        {
+            anNodeBase[iStrip] = nNodeBase;
+            if (sStrip.nSeamPolygons > 0)
+                anStripsWithSeams.push_back(iStrip);
+            for (int i = 0; i < sStrip.nSeamPolygons; ++i)
+                anParent.push_back(nNodeBase + i);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALPolygonize()");
+            return CE_Failure;
+        }
+
+        // Union the seam polygons of the first line with the ones of the
+        // last line of the previous strip they are connected to.
+        if (sStrip.bHasLineAbove)
+        {
+            const DataType *panAboveVal = sStrip.GetLineVal(-1);
+            const DataType *panLineVal = sStrip.GetLineVal(0);
+            const GInt32 *panLineId = sStrip.GetLineId(0);
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                const GInt32 nId = panLineId[iX];
+                if (nId < 0 || sStrip.anSeamIdx[nId] < 0)
+                    continue;
+                const GInt32 nRoot =
+                    FindRoot(nNodeBase + sStrip.anSeamIdx[nId]);
+                const int iXStart =
+                    nConnectedness == 8 ? std::max(0, iX - 1) : iX;
+                const int iXEnd =
+                    nConnectedness == 8 ? std::min(nXSize - 1, iX + 1) : iX;
+                for (int i = iXStart; i <= iXEnd; ++i)
+                {
+                    const GInt32 nAboveNode = anPrevLastLineNode[i];
+                    if (nAboveNode < 0 ||
+                        !eq(panAboveVal[i], panLineVal[iX]))
+                        continue;
+                    const GInt32 nAboveRoot = FindRoot(nAboveNode);
+                    const GInt32 nCurRoot = FindRoot(nRoot);
+                    if (nAboveRoot < nCurRoot)
+                        anParent[nCurRoot] = nAboveRoot;
+                    else if (nCurRoot < nAboveRoot)
+                        anParent[nAboveRoot] = nCurRoot;
+                }
+            }
+        }
+
+        if (sStrip.bHasLineBelow)
+        {
+            try
+            {
+                anPrevLastLineNode.resize(nXSize);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALPolygonize()");
+                return CE_Failure;
+            }
+            const GInt32 *panLineId = sStrip.GetLineId(sStrip.nLines - 1);
+            for (int iX = 0; iX < nXSize; ++iX)
+            {
+                const GInt32 nId = panLineId[iX];
+                anPrevLastLineNode[iX] =
+                    nId >= 0 && sStrip.anSeamIdx[nId] >= 0
+                        ? nNodeBase + sStrip.anSeamIdx[nId]
+                        : -1;
+            }
+        }
+
+        for (auto &oPolygon : sStrip.aoPolygons)
+        {
+            poFeature->SetGeometryDirectly(oPolygon.poPolygon.release());
+            poFeature->SetFID(OGRNullFID);
+            if (iPixValField >= 0)
+                poFeature->SetField(iPixValField, oPolygon.dfValue);
+            if (poOutLayer->CreateFeature(poFeature.get()) != OGRERR_NONE)
+                return CE_Failure;
+        }
+        sStrip.aoPolygons.clear();
+
+        if (!pfnProgress(0.5 * (sStrip.nYOff + sStrip.nLines) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    std::vector<int> anAllStrips;
+    try
+    {
+        anAllStrips.resize(nStrips);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALPolygonize()");
+        return CE_Failure;
+    }
+    for (int i = 0; i < nStrips; ++i)
+        anAllStrips[i] = i;
+    CPLErr eErr =
+        ProcessStrips(anAllStrips, ComputeStripPass1, ConsumeStripPass1);
+    anPrevLastLineNode.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: seam polygons.                                     */
+    /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && !anStripsWithSeams.empty())
+    {
+        // Ids of seam polygons are their root node, read concurrently by
+        // the computation of strips.
+        for (GInt32 i = 0; i < static_cast<GInt32>(anParent.size()); ++i)
+            anParent[i] = FindRoot(i);
+
+        OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                                  padfGeoTransform};
+        std::unique_ptr<Polygonizer<GInt32, DataType>> poPolygonizer;
+        std::vector<TwoArm> aoLastLineArm;
+        std::vector<TwoArm> aoThisLineArm;
+        std::vector<DataType> anLastLineVal;
+        std::vector<GInt32> anOuterLineId;
+        int iLastStrip = -1;
+        int nLastStripEnd = 0;
+
+        // Process the line below the last one of a run of strips with
+        // seam polygons, so that all of them are emitted.
+        const auto FinishPolygonizer = [&]()
+        {
+            if (!poPolygonizer->processLine(
+                    anOuterLineId.data(), anLastLineVal.data(),
+                    aoThisLineArm.data(), aoLastLineArm.data(),
+                    nLastStripEnd, nXSize))
+            {
+                return CE_Failure;
+            }
+            poPolygonizer.reset();
+            return oPolygonWriter.getErr();
+        };
+
+        const auto ComputeStripPass2 =
+            [nConnectedness, &anParent, &anNodeBase](GPStrip<DataType> &sStrip,
+                                                     int iStrip)
+        {
+            if (!GPEnumerateStrip<DataType, EqualityTest>(sStrip,
+                                                          nConnectedness))
+                return false;
+            const GInt32 nNodeBase = anNodeBase[iStrip];
+            for (GInt32 &nId : sStrip.anId)
+            {
+                if (nId >= 0)
+                {
+                    const GInt32 nSeamIdx = sStrip.anSeamIdx[nId];
+                    nId = nSeamIdx >= 0 ? anParent[nNodeBase + nSeamIdx] : -1;
+                }
+            }
+            return true;
+        };
+
+        const auto ConsumeStripPass2 = [&](GPStrip<DataType> &sStrip,
+                                           int iStrip)
+        {
+            CPLErr eErrStrip = CE_None;
+            if (poPolygonizer && iStrip != iLastStrip + 1)
+                eErrStrip = FinishPolygonizer();
+            if (eErrStrip == CE_None && !poPolygonizer)
+            {
+                try
+                {
+                    poPolygonizer =
+                        std::make_unique<Polygonizer<GInt32, DataType>>(
+                            -1, &oPolygonWriter);
+                    aoLastLineArm.assign(nXSize + 2, TwoArm());
+                    aoThisLineArm.assign(nXSize + 2, TwoArm());
+                    anLastLineVal.resize(nXSize);
+                    anOuterLineId.assign(
+                        nXSize, Polygonizer<GInt32,
+                                            DataType>::THE_OUTER_POLYGON_ID);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in GDALPolygonize()");
+                    return CE_Failure;
+                }
+                for (auto &oArm : aoLastLineArm)
+                    oArm.poPolyInside = poPolygonizer->getTheOuterPolygon();
+            }
+
+            for (int iLine = 0; eErrStrip == CE_None && iLine < sStrip.nLines;
+                 ++iLine)
+            {
+                const DataType *panLastLineVal =
+                    iLine > 0 || sStrip.bHasLineAbove
+                        ? sStrip.GetLineVal(iLine - 1)
+                        : sStrip.GetLineVal(0);
+                if (!poPolygonizer->processLine(
+                        sStrip.GetLineId(iLine), panLastLineVal,
+                        aoThisLineArm.data(), aoLastLineArm.data(),
+                        sStrip.nYOff + iLine, nXSize))
+                {
+                    eErrStrip = CE_Failure;
+                }
+                else
+                {
+                    eErrStrip = oPolygonWriter.getErr();
+                }
+                std::swap(aoThisLineArm, aoLastLineArm);
+            }
+            if (eErrStrip != CE_None)
+                return eErrStrip;
+
+            const DataType *panLineVal = sStrip.GetLineVal(sStrip.nLines - 1);
+            std::copy(panLineVal, panLineVal + nXSize, anLastLineVal.begin());
+            iLastStrip = iStrip;
+            nLastStripEnd = sStrip.nYOff + sStrip.nLines;
+
+            if (!pfnProgress(0.5 + 0.5 * nLastStripEnd / nYSize, "",
+                             pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+            return CE_None;
+        };
+
+        eErr = ProcessStrips(anStripsWithSeams, ComputeStripPass2,
+                             ConsumeStripPass2);
+        if (eErr == CE_None && poPolygonizer)
+            eErr = FinishPolygonizer();
+    }
+
+    if (eErr == CE_None && !pfnProgress(1.0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        eErr = CE_Failure;
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -86,6 +713,15 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     const int nConnectedness =
         CSLFetchNameValue(papszOptions, "8CONNECTED") ? 8 : 4;
 
+    int nThreads = 1;
+    const char *pszNumThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszNumThreads)
+    {
+        nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                    : atoi(pszNumThreads);
+        nThreads = std::max(1, std::min(128, nThreads));
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Confirm our output layer will support feature creation.         */
     /* -------------------------------------------------------------------- */
@@ -97,9 +733,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
     if (nXSize > std::numeric_limits<int>::max() - 2)
@@ -108,29 +741,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -166,6 +776,39 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    if (nThreads > 1)
+    {
+        return GDALPolygonizeMultiThreaded<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            adfGeoTransform, nThreads, pfnProgress, pProgressArg, eDT);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -487,6 +1130,12 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.11) Number of threads used to
+ * polygonize horizontal strips of the raster concurrently. Defaults to 1.
+ * With several threads, features are not written in the same order as with
+ * a single thread. Memory use is not bounded: as with a single thread, it is
+ * proportional to the number of polygons not yet completed, and the
+ * polygons crossing strip boundaries are kept until the end.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -561,6 +1210,12 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=n/ALL_CPUS: (GDAL >= 3.11) Number of threads used to
+ * polygonize horizontal strips of the raster concurrently. Defaults to 1.
+ * With several threads, features are not written in the same order as with
+ * a single thread. Memory use is not bounded: as with a single thread, it is
+ * proportional to the number of polygons not yet completed, and the
+ * polygons crossing strip boundaries are kept until the end.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -453,26 +453,25 @@ OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
     poFeature_->SetGeometryDirectly(poPolygon_);
 }
 
-template <typename DataType>
-void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
-                                         DataType nPolygonCellValue)
+bool RPolygonToOGRPolygon(const RPolygon *poPolygon,
+                          const double *padfGeoTransform,
+                          OGRPolygon *poOGRPolygon)
 {
     std::vector<bool> oAccessedArc(poPolygon->oArcs.size(), false);
-    double *padfGeoTransform = padfGeoTransform_;
 
-    OGRLinearRing *poFirstRing = poPolygon_->getExteriorRing();
-    if (poFirstRing && poPolygon_->getNumInteriorRings() == 0)
+    OGRLinearRing *poFirstRing = poOGRPolygon->getExteriorRing();
+    if (poFirstRing && poOGRPolygon->getNumInteriorRings() == 0)
     {
         poFirstRing->empty();
     }
     else
     {
         poFirstRing = nullptr;
-        poPolygon_->empty();
+        poOGRPolygon->empty();
     }
 
     auto AddRingToPolygon =
-        [this, &poPolygon, &oAccessedArc,
+        [poOGRPolygon, &poPolygon, &oAccessedArc,
          padfGeoTransform](std::size_t iFirstArcIndex, OGRLinearRing *poRing)
     {
         std::unique_ptr<OGRLinearRing> poNewRing;
@@ -538,7 +537,7 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         poRing->closeRings();
 
         if (poNewRing)
-            poPolygon_->addRingDirectly(poNewRing.release());
+            poOGRPolygon->addRingDirectly(poNewRing.release());
         return true;
     };
 
@@ -548,13 +547,25 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         {
             if (!AddRingToPolygon(i, poFirstRing))
             {
-                eErr_ = CE_Failure;
-                return;
+                return false;
             }
             poFirstRing = nullptr;
         }
     }
 
+    return true;
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
+                                         DataType nPolygonCellValue)
+{
+    if (!RPolygonToOGRPolygon(poPolygon, padfGeoTransform_, poPolygon_))
+    {
+        eErr_ = CE_Failure;
+        return;
+    }
+
     // Create the feature object
     poFeature_->SetFID(OGRNullFID);
     if (iPixValField_ >= 0)
@@ -573,6 +584,28 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
     }
 }
 
+template <typename DataType>
+OGRPolygonCollector<DataType>::OGRPolygonCollector(
+    const double *padfGeoTransform)
+    : PolygonReceiver<DataType>(), padfGeoTransform_(padfGeoTransform)
+{
+}
+
+template <typename DataType>
+void OGRPolygonCollector<DataType>::receive(RPolygon *poPolygon,
+                                            DataType nPolygonCellValue)
+{
+    auto poOGRPolygon = std::make_unique<OGRPolygon>();
+    if (!RPolygonToOGRPolygon(poPolygon, padfGeoTransform_,
+                              poOGRPolygon.get()))
+    {
+        eErr_ = CE_Failure;
+        return;
+    }
+    aoPolygons_.push_back(
+        {std::move(poOGRPolygon), static_cast<double>(nPolygonCellValue)});
+}
+
 }  // namespace polygonizer
 }  // namespace gdal
 
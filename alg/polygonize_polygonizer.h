@@ -22,6 +22,7 @@
 #include <vector>
 #include <limits>
 #include <map>
+#include <memory>
 
 #include "cpl_error.h"
 #include "ogr_api.h"
@@ -177,6 +178,15 @@ template <typename PolyIdType, typename DataType> class Polygonizer
                      IndexType nCols);
 };
 
+/**
+ * Convert a raster polygon object to an OGR polygon, in georeferenced
+ * coordinates. The exterior ring of poOGRPolygon is reused if it has no
+ * interior ring.
+ */
+bool RPolygonToOGRPolygon(const RPolygon *poPolygon,
+                          const double *padfGeoTransform,
+                          OGRPolygon *poOGRPolygon);
+
 /**
  * Write raster polygon object to OGR layer.
  */
@@ -211,6 +221,49 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
     }
 };
 
+/**
+ * Collect raster polygon objects as OGR polygons, for them to be written
+ * later to an OGR layer by another thread.
+ */
+template <typename DataType>
+class OGRPolygonCollector : public PolygonReceiver<DataType>
+{
+  public:
+    struct CollectedPolygon
+    {
+        std::unique_ptr<OGRPolygon> poPolygon{};
+        double dfValue = 0;
+    };
+
+  private:
+    const double *padfGeoTransform_;
+    std::vector<CollectedPolygon> aoPolygons_{};
+
+    CPLErr eErr_{CE_None};
+
+  public:
+    explicit OGRPolygonCollector(const double *padfGeoTransform);
+
+    OGRPolygonCollector(const OGRPolygonCollector<DataType> &) = delete;
+
+    ~OGRPolygonCollector() = default;
+
+    OGRPolygonCollector<DataType> &
+    operator=(const OGRPolygonCollector<DataType> &) = delete;
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
+
+    inline std::vector<CollectedPolygon> &getPolygons()
+    {
+        return aoPolygons_;
+    }
+
+    inline CPLErr getErr()
+    {
+        return eErr_;
+    }
+};
+
 }  // namespace polygonizer
 }  // namespace gdal
 
@@ -19,16 +19,20 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALFilterLine()                           */
@@ -344,6 +348,475 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+/************************************************************************/
+/*                      GDALFillNodataSmoothing()                       */
+/*                                                                      */
+/*      Iterative average filters over the interpolated values, in      */
+/*      the [dfProgressStart, 1] progress range.                        */
+/************************************************************************/
+
+static CPLErr GDALFillNodataSmoothing(GDALRasterBandH hTargetBand,
+                                      GDALRasterBandH hMaskBand,
+                                      GDALRasterBandH hFiltMaskBand,
+                                      bool bFlushMask, int nSmoothingIterations,
+                                      double dfProgressStart,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg)
+{
+    if (bFlushMask)
+    {
+        // Force masks to be to flushed and recomputed when the user
+        // didn't pass a user-provided hMaskBand, and we assigned it
+        // to be the mask band of hTargetBand.
+        GDALFlushRasterCache(hMaskBand);
+    }
+
+    void *pScaledProgress = GDALCreateScaledProgress(
+        dfProgressStart, 1.0, pfnProgress, pProgressArg);
+
+    const CPLErr eErr =
+        GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
+                        nSmoothingIterations, GDALScaledProgress,
+                        pScaledProgress);
+
+    GDALDestroyScaledProgress(pScaledProgress);
+    return eErr;
+}
+
+/************************************************************************/
+/*                       GDALFillNodataPyramid()                        */
+/*                                                                      */
+/*      Fill the nodata pixels with a pull-push scheme: a pyramid of    */
+/*      half resolution levels is built by averaging the valid pixels   */
+/*      of 2x2 blocks, up to a single pixel, and the invalid pixels of  */
+/*      each level are then interpolated bilinearly from the level      */
+/*      above it, from the coarsest level down to full resolution.      */
+/*      The whole raster is processed in memory, by strips of lines     */
+/*      shared between nThreads threads.                                */
+/************************************************************************/
+
+static CPLErr GDALFillNodataPyramid(GDALRasterBandH hTargetBand,
+                                    GDALRasterBandH hMaskBand, bool bUpdateMask,
+                                    GDALRasterBandH hFiltMaskBand,
+                                    double dfMaxSearchDist, bool bHasNoData,
+                                    float fNoData, int nThreads,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hTargetBand);
+    const int nYSize = GDALGetRasterBandYSize(hTargetBand);
+
+    struct Level
+    {
+        int nXSize = 0;
+        int nYSize = 0;
+        std::vector<float> afValue{};
+        // Whether afValue is set, either from a source pixel, or by the
+        // interpolation.
+        std::vector<GByte> abyValid{};
+    };
+
+    std::vector<Level> aoLevels;
+    std::vector<GByte> abyMask;
+    try
+    {
+        aoLevels.emplace_back();
+        aoLevels[0].nXSize = nXSize;
+        aoLevels[0].nYSize = nYSize;
+        while (aoLevels.back().nXSize > 1 || aoLevels.back().nYSize > 1)
+        {
+            Level oLevel;
+            oLevel.nXSize = (aoLevels.back().nXSize + 1) / 2;
+            oLevel.nYSize = (aoLevels.back().nYSize + 1) / 2;
+            aoLevels.push_back(std::move(oLevel));
+        }
+        for (auto &oLevel : aoLevels)
+        {
+            const size_t nPixels =
+                static_cast<size_t>(oLevel.nXSize) * oLevel.nYSize;
+            oLevel.afValue.resize(nPixels);
+            oLevel.abyValid.resize(nPixels);
+        }
+        abyMask.resize(static_cast<size_t>(nXSize) * nYSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate the pyramid of the raster. "
+                 "INTERPOLATION=PYRAMID requires it to fit in memory");
+        return CE_Failure;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+        poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+
+    // Run pfnJob(nStart, nEnd) on nThreads sub-ranges of [0, nCount[
+    const auto RunJobs = [nThreads, &poJobQueue](int nCount, const auto &pfnJob)
+    {
+        if (!poJobQueue)
+        {
+            pfnJob(0, nCount);
+            return;
+        }
+        for (int iJob = 0; iJob < nThreads; iJob++)
+        {
+            const int nStart = static_cast<int>(
+                static_cast<GIntBig>(nCount) * iJob / nThreads);
+            const int nEnd = static_cast<int>(static_cast<GIntBig>(nCount) *
+                                              (iJob + 1) / nThreads);
+            if (nStart < nEnd)
+            {
+                poJobQueue->SubmitJob([&pfnJob, nStart, nEnd]()
+                                      { pfnJob(nStart, nEnd); });
+            }
+        }
+        poJobQueue->WaitCompletion();
+    };
+
+    const auto Progress = [pfnProgress, pProgressArg](double dfComplete)
+    {
+        if (!pfnProgress(dfComplete, "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        return true;
+    };
+
+    // Square of the distance to the nearest source pixel, if needed.
+    std::vector<float> afSquareDist;
+    const double dfMaxSquareDist = dfMaxSearchDist * dfMaxSearchDist;
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the raster and its mask. Source pixels at the NODATA       */
+    /*      value are not interpolated from.                                */
+    /* -------------------------------------------------------------------- */
+    Level &oBase = aoLevels[0];
+    CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, 0, nXSize, nYSize,
+                               abyMask.data(), nXSize, nYSize, GDT_Byte, 0, 0);
+    if (eErr == CE_None)
+        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, 0, nXSize, nYSize,
+                            oBase.afValue.data(), nXSize, nYSize, GDT_Float32,
+                            0, 0);
+    if (eErr != CE_None)
+        return eErr;
+    for (size_t i = 0; i < abyMask.size(); ++i)
+    {
+        oBase.abyValid[i] =
+            abyMask[i] && !(bHasNoData && oBase.afValue[i] == fNoData);
+    }
+    if (!Progress(0.1))
+        return CE_Failure;
+
+    const bool bHasSource =
+        std::find_if(oBase.abyValid.begin(), oBase.abyValid.end(),
+                     [](GByte byValid) { return byValid != 0; }) !=
+        oBase.abyValid.end();
+    // Whether a pixel is within dfMaxSearchDist of a source pixel.
+    const auto IsInReach = [bHasSource, &afSquareDist,
+                            dfMaxSquareDist](size_t i)
+    {
+        return bHasSource &&
+               (afSquareDist.empty() || afSquareDist[i] <= dfMaxSquareDist);
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      Only fill pixels within dfMaxSearchDist of a source pixel,      */
+    /*      using an exact Euclidean distance transform (Felzenszwalb &     */
+    /*      Huttenlocher) computed by columns then by lines.                */
+    /* -------------------------------------------------------------------- */
+    if (dfMaxSquareDist < static_cast<double>(nXSize) * nXSize +
+                              static_cast<double>(nYSize) * nYSize)
+    {
+        try
+        {
+            afSquareDist.resize(static_cast<size_t>(nXSize) * nYSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate the distance buffer");
+            return CE_Failure;
+        }
+        // Larger than any distance within the raster.
+        const float fInfinity = static_cast<float>(
+            (static_cast<double>(nXSize) + nYSize) * (nXSize + nYSize));
+
+        RunJobs(nXSize,
+                [&](int nStartX, int nEndX)
+                {
+                    for (int iX = nStartX; iX < nEndX; ++iX)
+                    {
+                        // Vertical distance to the nearest source pixel.
+                        int iLastSrc = -1;
+                        for (int iY = 0; iY < nYSize; ++iY)
+                        {
+                            const size_t i =
+                                static_cast<size_t>(iY) * nXSize + iX;
+                            if (oBase.abyValid[i])
+                                iLastSrc = iY;
+                            afSquareDist[i] =
+                                iLastSrc >= 0
+                                    ? static_cast<float>(iY - iLastSrc)
+                                    : fInfinity;
+                        }
+                        iLastSrc = -1;
+                        for (int iY = nYSize - 1; iY >= 0; --iY)
+                        {
+                            const size_t i =
+                                static_cast<size_t>(iY) * nXSize + iX;
+                            if (oBase.abyValid[i])
+                                iLastSrc = iY;
+                            if (iLastSrc >= 0)
+                                afSquareDist[i] = std::min(
+                                    afSquareDist[i],
+                                    static_cast<float>(iLastSrc - iY));
+                            if (afSquareDist[i] < fInfinity)
+                                afSquareDist[i] *= afSquareDist[i];
+                        }
+                    }
+                });
+
+        RunJobs(nYSize,
+                [&](int nStartY, int nEndY)
+                {
+                    // Lower envelope of the parabolas of the line.
+                    std::vector<int> anVertex(nXSize);
+                    std::vector<double> adfBound(nXSize + 1);
+                    std::vector<float> afLine(nXSize);
+                    for (int iY = nStartY; iY < nEndY; ++iY)
+                    {
+                        float *pafLine =
+                            afSquareDist.data() +
+                            static_cast<size_t>(iY) * nXSize;
+                        std::copy_n(pafLine, nXSize, afLine.begin());
+                        int k = -1;
+                        for (int q = 0; q < nXSize; ++q)
+                        {
+                            if (afLine[q] >= fInfinity)
+                                continue;
+                            double s = 0;
+                            while (k >= 0)
+                            {
+                                const int v = anVertex[k];
+                                s = ((afLine[q] + static_cast<double>(q) * q) -
+                                     (afLine[v] + static_cast<double>(v) * v)) /
+                                    (2.0 * (q - v));
+                                if (s > adfBound[k])
+                                    break;
+                                --k;
+                            }
+                            ++k;
+                            anVertex[k] = q;
+                            adfBound[k] = k == 0 ? -HUGE_VAL : s;
+                            adfBound[k + 1] = HUGE_VAL;
+                        }
+                        if (k < 0)
+                            continue;
+                        int j = 0;
+                        for (int q = 0; q < nXSize; ++q)
+                        {
+                            while (adfBound[j + 1] < q)
+                                ++j;
+                            const int v = anVertex[j];
+                            pafLine[q] = static_cast<float>(
+                                static_cast<double>(q - v) * (q - v) +
+                                afLine[v]);
+                        }
+                    }
+                });
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Pull: average the valid pixels of 2x2 blocks.                   */
+    /* -------------------------------------------------------------------- */
+    for (size_t iLevel = 1; iLevel < aoLevels.size(); ++iLevel)
+    {
+        const Level &oFine = aoLevels[iLevel - 1];
+        Level &oCoarse = aoLevels[iLevel];
+        RunJobs(oCoarse.nYSize,
+                [&oFine, &oCoarse](int nStartY, int nEndY)
+                {
+                    for (int iY = nStartY; iY < nEndY; ++iY)
+                    {
+                        const int iFineYEnd =
+                            std::min(2 * iY + 2, oFine.nYSize);
+                        for (int iX = 0; iX < oCoarse.nXSize; ++iX)
+                        {
+                            const int iFineXEnd =
+                                std::min(2 * iX + 2, oFine.nXSize);
+                            double dfSum = 0;
+                            int nCount = 0;
+                            for (int iFineY = 2 * iY; iFineY < iFineYEnd;
+                                 ++iFineY)
+                            {
+                                for (int iFineX = 2 * iX; iFineX < iFineXEnd;
+                                     ++iFineX)
+                                {
+                                    const size_t i =
+                                        static_cast<size_t>(iFineY) *
+                                            oFine.nXSize +
+                                        iFineX;
+                                    if (oFine.abyValid[i])
+                                    {
+                                        dfSum += oFine.afValue[i];
+                                        ++nCount;
+                                    }
+                                }
+                            }
+                            const size_t i =
+                                static_cast<size_t>(iY) * oCoarse.nXSize + iX;
+                            oCoarse.abyValid[i] = nCount > 0;
+                            oCoarse.afValue[i] =
+                                nCount > 0 ? static_cast<float>(dfSum / nCount)
+                                           : 0.0f;
+                        }
+                    }
+                });
+    }
+    if (!Progress(0.5))
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Push: interpolate the invalid pixels of each level from the     */
+    /*      valid pixels of the level above it.                             */
+    /* -------------------------------------------------------------------- */
+    for (size_t iLevel = aoLevels.size() - 1; iLevel > 0; --iLevel)
+    {
+        const Level &oCoarse = aoLevels[iLevel];
+        Level &oFine = aoLevels[iLevel - 1];
+        // Pixels of the full resolution level that are valid in the mask,
+        // even if at the NODATA value, or out of reach of source pixels are
+        // left untouched.
+        const bool bFullRes = iLevel == 1;
+        RunJobs(
+            oFine.nYSize,
+            [&oFine, &oCoarse, bFullRes, &abyMask,
+             &IsInReach](int nStartY, int nEndY)
+            {
+                // The centre of fine pixel i is at coordinate i / 2 - 0.25 in
+                // the coarse level, between coarse pixels i / 2 - 1 and
+                // i / 2 for even i, and between (i - 1) / 2 and (i + 1) / 2
+                // for odd i, with weights 0.25 and 0.75.
+                const auto GetNeighbours = [](int i, int nSize, int &i0,
+                                              int &i1, double &dfW0)
+                {
+                    if ((i % 2) == 0)
+                    {
+                        i0 = std::max(0, i / 2 - 1);
+                        i1 = i / 2;
+                        dfW0 = 0.25;
+                    }
+                    else
+                    {
+                        i0 = i / 2;
+                        i1 = std::min(nSize - 1, i / 2 + 1);
+                        dfW0 = 0.75;
+                    }
+                };
+
+                for (int iY = nStartY; iY < nEndY; ++iY)
+                {
+                    int aiY[2];
+                    double adfWY[2];
+                    GetNeighbours(iY, oCoarse.nYSize, aiY[0], aiY[1],
+                                  adfWY[0]);
+                    adfWY[1] = 1.0 - adfWY[0];
+                    for (int iX = 0; iX < oFine.nXSize; ++iX)
+                    {
+                        const size_t iFine =
+                            static_cast<size_t>(iY) * oFine.nXSize + iX;
+                        if (oFine.abyValid[iFine] ||
+                            (bFullRes &&
+                             (abyMask[iFine] || !IsInReach(iFine))))
+                            continue;
+
+                        int aiX[2];
+                        double adfWX[2];
+                        GetNeighbours(iX, oCoarse.nXSize, aiX[0], aiX[1],
+                                      adfWX[0]);
+                        adfWX[1] = 1.0 - adfWX[0];
+
+                        double dfSum = 0;
+                        double dfWeightSum = 0;
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            for (int i = 0; i < 2; ++i)
+                            {
+                                const size_t iCoarse =
+                                    static_cast<size_t>(aiY[j]) *
+                                        oCoarse.nXSize +
+                                    aiX[i];
+                                if (oCoarse.abyValid[iCoarse])
+                                {
+                                    const double dfWeight = adfWY[j] * adfWX[i];
+                                    dfSum +=
+                                        dfWeight * oCoarse.afValue[iCoarse];
+                                    dfWeightSum += dfWeight;
+                                }
+                            }
+                        }
+                        if (dfWeightSum > 0)
+                        {
+                            oFine.afValue[iFine] =
+                                static_cast<float>(dfSum / dfWeightSum);
+                            oFine.abyValid[iFine] = 1;
+                        }
+                    }
+                }
+            });
+        if (!Progress(0.5 + 0.4 * (aoLevels.size() - iLevel) /
+                                (aoLevels.size() - 1)))
+            return CE_Failure;
+    }
+
+    if (!Progress(0.9))
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Write out the updated data and masks.                           */
+    /* -------------------------------------------------------------------- */
+    std::vector<GByte> abyFiltMask;
+    if (hFiltMaskBand)
+    {
+        try
+        {
+            abyFiltMask.resize(abyMask.size());
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate the filter mask buffer");
+            return CE_Failure;
+        }
+    }
+    for (size_t i = 0; i < abyMask.size(); ++i)
+    {
+        if (abyMask[i] || !IsInReach(i))
+            continue;
+        // All the pixels within reach of a source pixel have been
+        // interpolated.
+        CPLAssert(oBase.abyValid[i]);
+        abyMask[i] = 255;
+        if (hFiltMaskBand)
+            abyFiltMask[i] = 255;
+    }
+
+    eErr = GDALRasterIO(hTargetBand, GF_Write, 0, 0, nXSize, nYSize,
+                        oBase.afValue.data(), nXSize, nYSize, GDT_Float32, 0,
+                        0);
+    if (eErr == CE_None && bUpdateMask)
+        eErr = GDALRasterIO(hMaskBand, GF_Write, 0, 0, nXSize, nYSize,
+                            abyMask.data(), nXSize, nYSize, GDT_Byte, 0, 0);
+    if (eErr == CE_None && hFiltMaskBand)
+        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, 0, nXSize, nYSize,
+                            abyFiltMask.data(), nXSize, nYSize, GDT_Byte, 0, 0);
+    if (eErr == CE_None && !Progress(1.0))
+        eErr = CE_Failure;
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -354,7 +827,8 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * This algorithm will interpolate values for all designated
  * nodata pixels (marked by zeros in hMaskBand). For each pixel
  * a four direction conic search is done to find values to interpolate
- * from (using inverse distance weighting by default). Once all values are
+ * from (using inverse distance weighting by default), unless
+ * INTERPOLATION=PYRAMID is specified. Once all values are
  * interpolated, zero or more smoothing iterations (3x3 average
  * filters on interpolated pixels) are applied to smooth out
  * artifacts.
@@ -381,9 +855,16 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
- * <li>INTERPOLATION=INV_DIST/NEAREST (GDAL >= 3.9). By default, pixels are
- * interpolated using an inverse distance weighting (INV_DIST). It is also
- * possible to choose a nearest neighbour (NEAREST) strategy.</li>
+ * <li>INTERPOLATION=INV_DIST/NEAREST/PYRAMID (GDAL >= 3.9). By default,
+ * pixels are interpolated using an inverse distance weighting (INV_DIST). It
+ * is also possible to choose a nearest neighbour (NEAREST) strategy.
+ * PYRAMID (GDAL >= 3.11) fills coarser and coarser versions of the raster
+ * first, and interpolates each level from the one above it. Its cost is
+ * linear in the number of pixels whatever the size of the nodata areas,
+ * which makes it suited to large voids in elevation models, but it requires
+ * the raster to fit in memory.</li>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS (GDAL >= 3.11). Number of
+ * threads to use with INTERPOLATION=PYRAMID. Defaults to 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -413,8 +894,8 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     const char *pszInterpolation =
         CSLFetchNameValueDef(papszOptions, "INTERPOLATION", "INV_DIST");
     const bool bNearest = EQUAL(pszInterpolation, "NEAREST");
-    if (!EQUAL(pszInterpolation, "INV_DIST") &&
-        !EQUAL(pszInterpolation, "NEAREST"))
+    const bool bPyramid = EQUAL(pszInterpolation, "PYRAMID");
+    if (!EQUAL(pszInterpolation, "INV_DIST") && !bNearest && !bPyramid)
     {
         CPLError(CE_Failure, CPLE_NotSupported,
                  "Unsupported interpolation method: %s", pszInterpolation);
@@ -521,6 +1002,59 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Create a mask file to make it clear what pixels can be filtered */
+    /*      on the filtering pass.                                          */
+    /* -------------------------------------------------------------------- */
+    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
+
+    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
+                   aosWorkFileOptions.List())));
+
+    if (poFiltMaskDS == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Could not create mask work file. Check driver capabilities.");
+        return CE_Failure;
+    }
+    poFiltMaskDS->MarkSuppressOnClose();
+
+    GDALRasterBandH hFiltMaskBand =
+        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
+
+    /* -------------------------------------------------------------------- */
+    /*      Pyramid interpolation, done in memory.                          */
+    /* -------------------------------------------------------------------- */
+    if (bPyramid)
+    {
+        int nThreads = 1;
+        const char *pszNumThreads =
+            CSLFetchNameValue(papszOptions, "NUM_THREADS");
+        if (pszNumThreads)
+        {
+            nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                        : atoi(pszNumThreads);
+            nThreads = std::max(1, std::min(128, nThreads));
+        }
+
+        void *pScaledProgress = GDALCreateScaledProgress(
+            0.0, dfProgressRatio, pfnProgress, pProgressArg);
+        CPLErr eErr = GDALFillNodataPyramid(
+            hTargetBand, hMaskBand, poTmpMaskDS != nullptr,
+            nSmoothingIterations > 0 ? hFiltMaskBand : nullptr,
+            dfMaxSearchDist, bHasNoData, fNoData, nThreads,
+            GDALScaledProgress, pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+
+        if (eErr == CE_None && nSmoothingIterations > 0)
+            eErr = GDALFillNodataSmoothing(
+                hTargetBand, hMaskBand, hFiltMaskBand, poTmpMaskDS == nullptr,
+                nSmoothingIterations, dfProgressRatio, pfnProgress,
+                pProgressArg);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Create a work file to hold the Y "last value" indices.          */
     /* -------------------------------------------------------------------- */
@@ -565,27 +1099,6 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     GDALRasterBandH hValBand =
         GDALRasterBand::FromHandle(poValDS->GetRasterBand(1));
 
-    /* -------------------------------------------------------------------- */
-    /*      Create a mask file to make it clear what pixels can be filtered */
-    /*      on the filtering pass.                                          */
-    /* -------------------------------------------------------------------- */
-    const CPLString osFiltMaskTmpFile = osTmpFile + "fill_filtmask_work.tif";
-
-    auto poFiltMaskDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
-        GDALCreate(hDriver, osFiltMaskTmpFile, nXSize, nYSize, 1, GDT_Byte,
-                   aosWorkFileOptions.List())));
-
-    if (poFiltMaskDS == nullptr)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Could not create mask work file. Check driver capabilities.");
-        return CE_Failure;
-    }
-    poFiltMaskDS->MarkSuppressOnClose();
-
-    GDALRasterBandH hFiltMaskBand =
-        GDALRasterBand::FromHandle(poFiltMaskDS->GetRasterBand(1));
-
     /* -------------------------------------------------------------------- */
     /*      Allocate buffers for last scanline and this scanline.           */
     /* -------------------------------------------------------------------- */
@@ -972,22 +1485,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
     /* ==================================================================== */
     if (eErr == CE_None && nSmoothingIterations > 0)
     {
-        if (poTmpMaskDS == nullptr)
-        {
-            // Force masks to be to flushed and recomputed when the user
-            // didn't pass a user-provided hMaskBand, and we assigned it
-            // to be the mask band of hTargetBand.
-            GDALFlushRasterCache(hMaskBand);
-        }
-
-        void *pScaledProgress = GDALCreateScaledProgress(
-            dfProgressRatio, 1.0, pfnProgress, pProgressArg);
-
-        eErr = GDALMultiFilter(hTargetBand, hMaskBand, hFiltMaskBand,
-                               nSmoothingIterations, GDALScaledProgress,
-                               pScaledProgress);
-
-        GDALDestroyScaledProgress(pScaledProgress);
+        eErr = GDALFillNodataSmoothing(hTargetBand, hMaskBand, hFiltMaskBand,
+                                       poTmpMaskDS == nullptr,
+                                       nSmoothingIterations, dfProgressRatio,
+                                       pfnProgress, pProgressArg);
     }
 
 /* -------------------------------------------------------------------- */
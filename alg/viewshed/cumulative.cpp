@@ -5,10 +5,17 @@
  ****************************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <mutex>
 #include <thread>
 
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
 #include "cpl_worker_thread_pool.h"
+#include "memdataset.h"
 
 #include "combiner.h"
 #include "cumulative.h"
@@ -60,6 +67,9 @@ bool Cumulative::run(const std::string &srcFilename,
     m_extent.xStop = GDALGetRasterBandXSize(pSrcBand);
     m_extent.yStop = GDALGetRasterBandYSize(pSrcBand);
 
+    if (m_opts.maxDistance > 0)
+        return runTiled(*pSrcBand, pfnProgress, pProgressArg);
+
     // Make a bunch of observer locations based on the spacing and stick them on a queue
     // to be handled by viewshed executors.
     for (int x = 0; x < m_extent.xStop; x += m_opts.observerSpacing)
@@ -166,6 +176,358 @@ void Cumulative::runExecutor(const std::string &srcFilename, Progress &progress,
     }
 }
 
+/// Compute the cumulative viewshed of a raster band, the visibility from
+/// each observer being limited to the maximum distance.
+///
+/// The counts of visible observers are accumulated in a temporary tiled
+/// GeoTIFF file, so that the memory used doesn't depend on the size of the
+/// raster.
+///
+/// @param srcBand  Source raster band.
+/// @param pfnProgress  Pointer to the progress function. Can be null.
+/// @param pProgressArg  Argument passed to the progress function
+/// @return  True on success, false otherwise.
+bool Cumulative::runTiled(GDALRasterBand &srcBand,
+                          GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GDALDriver *tiffDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!tiffDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cumulative viewshed with a maximum distance needs GTiff "
+                 "driver");
+        return false;
+    }
+
+    const std::string tmpFilename = CPLGenerateTempFilenameSafe("viewshed");
+    CPLStringList tmpOpts;
+    tmpOpts.SetNameValue("TILED", "YES");
+    tmpOpts.SetNameValue("SPARSE_OK", "YES");
+    DatasetPtr countDS(tiffDriver->Create(
+        tmpFilename.c_str(), m_extent.xSize(), m_extent.ySize(), 1, GDT_UInt32,
+        tmpOpts.List()));
+    if (!countDS)
+        return false;
+    // On Unix, attempt at deleting the temporary file now, so that
+    // if the process gets interrupted, it is automatically destroyed
+    // by the operating system.
+    const bool tmpFileDeleted = VSIUnlink(tmpFilename.c_str()) == 0;
+
+    const bool ok = computeTiled(srcBand, *countDS->GetRasterBand(1),
+                                 pfnProgress, pProgressArg);
+
+    countDS.reset();
+    if (!tmpFileDeleted)
+        tiffDriver->Delete(tmpFilename.c_str());
+    return ok;
+}
+
+/// Compute the cumulative viewshed of a raster band with a maximum distance,
+/// accumulating the counts of visible observers in a raster band.
+///
+/// Observers are processed by batches, each batch sharing a tile of the DEM
+/// that covers the cells within the maximum distance of all its observers.
+/// The tile is read once, and its size is bounded by the GDAL block cache
+/// size, unless the area within the maximum distance of a single observer is
+/// larger. The viewshed of each observer is only computed on the cells within
+/// the maximum distance, and the counts of the cells of the tile are read
+/// from and written back to the count band once per batch.
+///
+/// @param srcBand  Source raster band.
+/// @param countBand  Band of the counts, initially zero, of the size of the
+///    output extent.
+/// @param pfnProgress  Pointer to the progress function. Can be null.
+/// @param pProgressArg  Argument passed to the progress function
+/// @return  True on success, false otherwise.
+bool Cumulative::computeTiled(GDALRasterBand &srcBand,
+                              GDALRasterBand &countBand,
+                              GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    std::array<double, 6> adfTransform;
+    std::array<double, 6> adfInvTransform;
+    srcBand.GetDataset()->GetGeoTransform(adfTransform.data());
+    if (!GDALInvGeoTransform(adfTransform.data(), adfInvTransform.data()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return false;
+    }
+
+    GDALDriver *memDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!memDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get MEM driver");
+        return false;
+    }
+
+    std::vector<int> observerXs;
+    std::vector<int> observerYs;
+    for (int x = 0; x < m_extent.xStop; x += m_opts.observerSpacing)
+        observerXs.push_back(x);
+    for (int y = 0; y < m_extent.yStop; y += m_opts.observerSpacing)
+        observerYs.push_back(y);
+
+    // Number of observers of a batch in each dimension, such that the tile
+    // of the batch, made of Float64 values, fits in the block cache.
+    const double dfTileSize = std::sqrt(
+        static_cast<double>(GDALGetCacheMax64()) / sizeof(double));
+    const auto batchSize = [this, dfTileSize](double dfPixelSize, size_t count)
+    {
+        const double dfRadius = std::fabs(dfPixelSize) * m_opts.maxDistance;
+        const double dfObservers =
+            (dfTileSize - 2 * (dfRadius + 2)) / m_opts.observerSpacing;
+        return static_cast<size_t>(
+            std::clamp(dfObservers, 1.0, static_cast<double>(count)));
+    };
+    const size_t nBatchXSize =
+        batchSize(adfInvTransform[1], observerXs.size());
+    const size_t nBatchYSize =
+        batchSize(adfInvTransform[5], observerYs.size());
+
+    // The Y extent of the viewshed of an observer doesn't depend on its X
+    // position.
+    size_t nExpectedLines = 0;
+    for (int y : observerYs)
+        nExpectedLines +=
+            maxDistanceExtent(m_extent, 0, y, adfInvTransform,
+                              m_opts.maxDistance)
+                .ySize();
+    Progress progress(pfnProgress, pProgressArg,
+                      nExpectedLines * observerXs.size());
+
+    std::mutex countBufMutex;
+    std::atomic<bool> err = false;
+    CPLWorkerThreadPool executorPool(m_opts.numJobs);
+    std::vector<double> tileBuf;
+    Buf32 countBuf;
+
+    struct Observer
+    {
+        Location loc;
+        Window extent;
+    };
+
+    std::vector<Observer> observers;
+    for (size_t iBatchY = 0; iBatchY < observerYs.size() && !err;
+         iBatchY += nBatchYSize)
+    {
+        for (size_t iBatchX = 0; iBatchX < observerXs.size() && !err;
+             iBatchX += nBatchXSize)
+        {
+            // The tile is the union of the extents of the observers.
+            Window tile{std::numeric_limits<int>::max(), 0,
+                        std::numeric_limits<int>::max(), 0};
+            observers.clear();
+            for (size_t iY = iBatchY;
+                 iY < std::min(iBatchY + nBatchYSize, observerYs.size()); ++iY)
+            {
+                for (size_t iX = iBatchX;
+                     iX < std::min(iBatchX + nBatchXSize, observerXs.size());
+                     ++iX)
+                {
+                    const Location loc{observerXs[iX], observerYs[iY]};
+                    const Window extent =
+                        maxDistanceExtent(m_extent, loc.x, loc.y,
+                                          adfInvTransform, m_opts.maxDistance);
+                    if (extent.xSize() <= 0 || extent.ySize() <= 0)
+                        continue;
+                    tile.xStart = std::min(tile.xStart, extent.xStart);
+                    tile.xStop = std::max(tile.xStop, extent.xStop);
+                    tile.yStart = std::min(tile.yStart, extent.yStart);
+                    tile.yStop = std::max(tile.yStop, extent.yStop);
+                    observers.push_back({loc, extent});
+                }
+            }
+            if (observers.empty())
+                continue;
+
+            try
+            {
+                tileBuf.resize(tile.size());
+                countBuf.resize(tile.size());
+            }
+            catch (const std::bad_alloc &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate DEM tile of %d x %d cells.",
+                         tile.xSize(), tile.ySize());
+                return false;
+            }
+            if (srcBand.RasterIO(GF_Read, tile.xStart, tile.yStart,
+                                 tile.xSize(), tile.ySize(), tileBuf.data(),
+                                 tile.xSize(), tile.ySize(), GDT_Float64, 0, 0,
+                                 nullptr) != CE_None ||
+                countBand.RasterIO(GF_Read, tile.xStart, tile.yStart,
+                                   tile.xSize(), tile.ySize(), countBuf.data(),
+                                   tile.xSize(), tile.ySize(), GDT_UInt32, 0,
+                                   0, nullptr) != CE_None)
+            {
+                return false;
+            }
+
+            std::array<double, 6> adfTileTransform = adfTransform;
+            adfTileTransform[0] += adfTransform[1] * tile.xStart +
+                                   adfTransform[2] * tile.yStart;
+            adfTileTransform[3] += adfTransform[4] * tile.xStart +
+                                   adfTransform[5] * tile.yStart;
+
+            auto pQueue = executorPool.CreateJobQueue();
+            for (const Observer &observer : observers)
+            {
+                pQueue->SubmitJob(
+                    [&, observer]()
+                    {
+                        if (err)
+                            return;
+
+                        // Each executor reads the shared tile through its own
+                        // dataset.
+                        DatasetPtr srcDS(MEMDataset::Create(
+                            "", tile.xSize(), tile.ySize(), 0, GDT_Float64,
+                            nullptr));
+                        static_cast<MEMDataset *>(srcDS.get())
+                            ->AddMEMBand(MEMCreateRasterBandEx(
+                                srcDS.get(), 1,
+                                reinterpret_cast<GByte *>(tileBuf.data()),
+                                GDT_Float64, 0, 0, false));
+                        srcDS->SetGeoTransform(adfTileTransform.data());
+
+                        const Window &extent = observer.extent;
+                        DatasetPtr dstDS(memDriver->Create(
+                            "", extent.xSize(), extent.ySize(), 1, GDT_Byte,
+                            nullptr));
+                        if (!dstDS)
+                        {
+                            err = true;
+                            return;
+                        }
+
+                        Window outExtent = extent;
+                        outExtent.shiftX(-tile.xStart);
+                        outExtent.shiftY(-tile.yStart);
+                        Window curExtent = outExtent;
+                        curExtent.shiftX(-outExtent.xStart);
+                        ViewshedExecutor executor(
+                            *srcDS->GetRasterBand(1), *dstDS->GetRasterBand(1),
+                            observer.loc.x - tile.xStart,
+                            observer.loc.y - tile.yStart, outExtent, curExtent,
+                            m_opts, progress);
+                        if (!executor.run())
+                        {
+                            err = true;
+                            return;
+                        }
+
+                        const uint8_t *srcP = static_cast<uint8_t *>(
+                            dstDS->GetInternalHandle("MEMORY1"));
+                        std::lock_guard<std::mutex> lock(countBufMutex);
+                        for (int y = outExtent.yStart; y < outExtent.yStop;
+                             ++y)
+                        {
+                            uint32_t *dstP =
+                                countBuf.data() +
+                                static_cast<size_t>(y) * tile.xSize() +
+                                outExtent.xStart;
+                            for (int x = 0; x < outExtent.xSize(); ++x)
+                                dstP[x] += *srcP++;
+                        }
+                    });
+            }
+            pQueue->WaitCompletion();
+
+            if (!err &&
+                countBand.RasterIO(GF_Write, tile.xStart, tile.yStart,
+                                   tile.xSize(), tile.ySize(), countBuf.data(),
+                                   tile.xSize(), tile.ySize(), GDT_UInt32, 0,
+                                   0, nullptr) != CE_None)
+            {
+                return false;
+            }
+        }
+    }
+    if (err)
+        return false;
+
+    if (!writeScaledOutput(srcBand, countBand))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unable to write to output file.");
+        return false;
+    }
+    progress.emit(1);
+
+    return true;
+}
+
+/// Scale the counts of a raster band so that they're fully spread in 8 bits,
+/// as scaleOutput() does, and write them to the output dataset. The counts
+/// are processed by blocks of the count band.
+///
+/// @param srcBand  Source raster band.
+/// @param countBand  Band of the counts, of the size of the output extent.
+/// @return True if the write was successful, false otherwise.
+bool Cumulative::writeScaledOutput(GDALRasterBand &srcBand,
+                                   GDALRasterBand &countBand)
+{
+    DatasetPtr pDstDS = createOutputDataset(srcBand, m_opts, m_extent);
+    if (!pDstDS)
+        return false;
+    GDALRasterBand *pDstBand = pDstDS->GetRasterBand(1);
+
+    int blockXSize = 0;
+    int blockYSize = 0;
+    countBand.GetBlockSize(&blockXSize, &blockYSize);
+    Buf32 buf(static_cast<size_t>(blockXSize) * blockYSize);
+
+    // Visit the blocks of the count band, and call processBlock() with each
+    // of them.
+    const auto forEachBlock = [&](const auto &processBlock)
+    {
+        for (int y = 0; y < m_extent.ySize(); y += blockYSize)
+        {
+            const int ySize = std::min(blockYSize, m_extent.ySize() - y);
+            for (int x = 0; x < m_extent.xSize(); x += blockXSize)
+            {
+                const int xSize = std::min(blockXSize, m_extent.xSize() - x);
+                if (countBand.RasterIO(GF_Read, x, y, xSize, ySize,
+                                       buf.data(), xSize, ySize, GDT_UInt32, 0,
+                                       0, nullptr) != CE_None ||
+                    !processBlock(x, y, xSize, ySize))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    uint32_t m = 0;  // Maximum count.
+    if (!forEachBlock(
+            [&buf, &m](int, int, int xSize, int ySize)
+            {
+                const size_t count = static_cast<size_t>(xSize) * ySize;
+                for (size_t i = 0; i < count; ++i)
+                    m = std::max(buf[i], m);
+                return true;
+            }))
+    {
+        return false;
+    }
+
+    const double factor =
+        m == 0 ? 0.0
+               : std::numeric_limits<uint8_t>::max() / static_cast<double>(m);
+    return forEachBlock(
+        [&buf, factor, pDstBand](int x, int y, int xSize, int ySize)
+        {
+            const size_t count = static_cast<size_t>(xSize) * ySize;
+            for (size_t i = 0; i < count; ++i)
+                buf[i] = static_cast<uint32_t>(std::floor(factor * buf[i]));
+            return pDstBand->RasterIO(GF_Write, x, y, xSize, ySize,
+                                      buf.data(), xSize, ySize, GDT_UInt32, 0,
+                                      0, nullptr) == CE_None;
+        });
+}
+
 // Add 8-bit rasters into the 32-bit raster buffer.
 void Cumulative::rollupRasters()
 {
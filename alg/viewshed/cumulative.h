@@ -57,6 +57,11 @@ class Cumulative
 
     void runExecutor(const std::string &srcFilename, Progress &progress,
                      std::atomic<bool> &err, std::atomic<int> &running);
+    bool runTiled(GDALRasterBand &srcBand, GDALProgressFunc pfnProgress,
+                  void *pProgressArg);
+    bool computeTiled(GDALRasterBand &srcBand, GDALRasterBand &countBand,
+                      GDALProgressFunc pfnProgress, void *pProgressArg);
+    bool writeScaledOutput(GDALRasterBand &srcBand, GDALRasterBand &countBand);
     void rollupRasters();
     void scaleOutput();
     bool writeOutput(DatasetPtr pDstDS);
@@ -5,6 +5,7 @@
  ****************************************************************************/
 
 #include <array>
+#include <cmath>
 
 #include "gdal_priv.h"
 #include "util.h"
@@ -84,5 +85,49 @@ DatasetPtr createOutputDataset(GDALRasterBand &srcBand, const Options &opts,
     return dataset;
 }
 
+/// Compute the part of a raster within the maximum distance of an observer.
+///
+/// @param  extent  Raster extent.
+/// @param  nX  X position of the observer.
+/// @param  nY  Y position of the observer.
+/// @param  adfInvTransform  Inverse geotransform of the raster.
+/// @param  maxDistance  Maximum distance from the observer, in georeferenced
+///    units.
+/// @return  The window of the raster within the maximum distance, or an empty
+///    window if there's no such cell.
+Window maxDistanceExtent(const Window &extent, int nX, int nY,
+                         const std::array<double, 6> &adfInvTransform,
+                         double maxDistance)
+{
+    constexpr double EPSILON = 1e-8;
+
+    //ABELL - This assumes that the transformation is only a scaling. Should be fixed.
+    //  Find the distance in the direction of the transformed unit vector in the X and Y
+    //  directions and use those factors to determine the limiting values in the raster space.
+    int nXStart = static_cast<int>(
+        std::floor(nX - adfInvTransform[1] * maxDistance + EPSILON));
+    int nXStop = static_cast<int>(
+        std::ceil(nX + adfInvTransform[1] * maxDistance - EPSILON) + 1);
+    int nYStart =
+        static_cast<int>(std::floor(
+            nY - std::fabs(adfInvTransform[5]) * maxDistance + EPSILON)) -
+        (adfInvTransform[5] > 0 ? 1 : 0);
+    int nYStop = static_cast<int>(
+        std::ceil(nY + std::fabs(adfInvTransform[5]) * maxDistance - EPSILON) +
+        (adfInvTransform[5] < 0 ? 1 : 0));
+
+    // If the limits are invalid, return an empty window.
+    if (nXStart >= extent.xStop || nXStop < 0 || nYStart >= extent.yStop ||
+        nYStop < 0)
+        return Window();
+
+    Window out = extent;
+    out.xStart = std::max(nXStart, 0);
+    out.xStop = std::min(nXStop, extent.xStop);
+    out.yStart = std::max(nYStart, 0);
+    out.yStop = std::min(nYStop, extent.yStop);
+    return out;
+}
+
 }  // namespace viewshed
 }  // namespace gdal
@@ -7,6 +7,8 @@
 #ifndef VIEWSHED_UTIL_H_INCLUDED
 #define VIEWSHED_UTIL_H_INCLUDED
 
+#include <array>
+
 #include "viewshed_types.h"
 
 namespace gdal
@@ -19,6 +21,10 @@ size_t bandSize(GDALRasterBand &band);
 DatasetPtr createOutputDataset(GDALRasterBand &srcBand, const Options &opts,
                                const Window &extent);
 
+Window maxDistanceExtent(const Window &extent, int nX, int nY,
+                         const std::array<double, 6> &adfInvTransform,
+                         double maxDistance);
+
 }  // namespace viewshed
 }  // namespace gdal
 
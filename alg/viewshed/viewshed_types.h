@@ -152,6 +152,14 @@ struct Window
         xStart += nShift;
         xStop += nShift;
     }
+
+    /// \brief  Shift the Y dimension by nShift.
+    /// \param  nShift  Amount to shift
+    void shiftY(int nShift)
+    {
+        yStart += nShift;
+        yStop += nShift;
+    }
 };
 
 }  // namespace viewshed
@@ -92,6 +92,7 @@ struct GDALGridOptions
     std::string osClipSrcWhere{};
     bool bNoDataSet = false;
     double dfNoDataValue = 0;
+    bool bScatter = false;
 
     GDALGridOptions()
     {
@@ -308,8 +309,8 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
                            const double dfIncreaseBurnValue,
                            const double dfMultiplyBurnValue, GDALDataType eType,
                            GDALGridAlgorithm eAlgorithm, void *pOptions,
-                           bool bQuiet, GDALProgressFunc pfnProgress,
-                           void *pProgressData)
+                           bool bScatter, bool bQuiet,
+                           GDALProgressFunc pfnProgress, void *pProgressData)
 
 {
     /* -------------------------------------------------------------------- */
@@ -329,6 +330,66 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Compute grid geometry.                                          */
+    /* -------------------------------------------------------------------- */
+    const auto ComputeGridGeometry = [&]()
+    {
+        if (!bIsXExtentSet || !bIsYExtentSet)
+        {
+            OGREnvelope sEnvelope;
+            if (poSrcLayer->GetExtent(&sEnvelope, TRUE) == OGRERR_FAILURE)
+            {
+                return false;
+            }
+
+            if (!bIsXExtentSet)
+            {
+                dfXMin = sEnvelope.MinX;
+                dfXMax = sEnvelope.MaxX;
+                bIsXExtentSet = true;
+            }
+
+            if (!bIsYExtentSet)
+            {
+                dfYMin = sEnvelope.MinY;
+                dfYMax = sEnvelope.MaxY;
+                bIsYExtentSet = true;
+            }
+        }
+
+        // Produce north-up images
+        if (dfYMin < dfYMax)
+            std::swap(dfYMin, dfYMax);
+
+        return true;
+    };
+
+    /* -------------------------------------------------------------------- */
+    /*      In scatter mode, the output grid must be known before reading   */
+    /*      the points, which are then accumulated into it by batches.      */
+    /* -------------------------------------------------------------------- */
+    struct GDALGridScatterContextReleaser
+    {
+        void operator()(GDALGridScatterContext *psContext)
+        {
+            GDALGridScatterContextFree(psContext);
+        }
+    };
+
+    std::unique_ptr<GDALGridScatterContext, GDALGridScatterContextReleaser>
+        psScatterContext;
+    if (bScatter)
+    {
+        if (!ComputeGridGeometry())
+            return CE_Failure;
+        psScatterContext.reset(GDALGridScatterContextCreate(
+            eAlgorithm, pOptions, dfXMin, dfXMax, dfYMin, dfYMax, nXSize,
+            nYSize));
+        if (!psScatterContext)
+            return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Collect the geometries from this layer, and build list of       */
     /*      values to be interpolated.                                      */
@@ -339,8 +400,30 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
     oVisitor.dfIncreaseBurnValue = dfIncreaseBurnValue;
     oVisitor.dfMultiplyBurnValue = dfMultiplyBurnValue;
 
+    // Number of points read at once in scatter mode.
+    constexpr size_t SCATTER_BATCH_SIZE = 1024 * 1024;
+    GUIntBig nPointCount = 0;
+    const auto FlushScatterBatch = [&]()
+    {
+        const CPLErr eFlushErr = GDALGridScatterContextAddPoints(
+            psScatterContext.get(), static_cast<GUInt32>(oVisitor.adfX.size()),
+            oVisitor.adfX.data(), oVisitor.adfY.data(), oVisitor.adfZ.data());
+        nPointCount += oVisitor.adfX.size();
+        oVisitor.adfX.clear();
+        oVisitor.adfY.clear();
+        oVisitor.adfZ.clear();
+        return eFlushErr;
+    };
+
+    // In scatter mode, reading the points takes most of the time.
+    const double dfReadProgressRatio = bScatter ? 0.9 : 0.0;
+    const GIntBig nFeatureCount =
+        bScatter ? poSrcLayer->GetFeatureCount(FALSE) : -1;
+    GIntBig nFeatureIdx = 0;
+
     for (auto &&poFeat : poSrcLayer)
     {
+        ++nFeatureIdx;
         const OGRGeometry *poGeom = poFeat->GetGeometryRef();
         if (poGeom)
         {
@@ -355,44 +438,45 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
 
             poGeom->accept(&oVisitor);
         }
-    }
 
-    if (oVisitor.adfX.empty())
-    {
-        printf("No point geometry found on layer %s, skipping.\n",
-               poSrcLayer->GetName());
-        return CE_None;
+        if (bScatter && oVisitor.adfX.size() >= SCATTER_BATCH_SIZE)
+        {
+            if (FlushScatterBatch() != CE_None)
+                return CE_Failure;
+            const double dfReadRatio =
+                nFeatureCount > 0
+                    ? std::min(1.0, static_cast<double>(nFeatureIdx) /
+                                        static_cast<double>(nFeatureCount))
+                    : 0.0;
+            if (pfnProgress &&
+                !pfnProgress(dfReadProgressRatio * dfReadRatio, "",
+                             pProgressData))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+        }
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Compute grid geometry.                                          */
-    /* -------------------------------------------------------------------- */
-    if (!bIsXExtentSet || !bIsYExtentSet)
+    if (bScatter)
     {
-        OGREnvelope sEnvelope;
-        if (poSrcLayer->GetExtent(&sEnvelope, TRUE) == OGRERR_FAILURE)
-        {
+        if (FlushScatterBatch() != CE_None)
             return CE_Failure;
-        }
-
-        if (!bIsXExtentSet)
-        {
-            dfXMin = sEnvelope.MinX;
-            dfXMax = sEnvelope.MaxX;
-            bIsXExtentSet = true;
-        }
+    }
+    else
+    {
+        nPointCount = oVisitor.adfX.size();
+    }
 
-        if (!bIsYExtentSet)
-        {
-            dfYMin = sEnvelope.MinY;
-            dfYMax = sEnvelope.MaxY;
-            bIsYExtentSet = true;
-        }
+    if (nPointCount == 0)
+    {
+        printf("No point geometry found on layer %s, skipping.\n",
+               poSrcLayer->GetName());
+        return CE_None;
     }
 
-    // Produce north-up images
-    if (dfYMin < dfYMax)
-        std::swap(dfYMin, dfYMax);
+    if (!bScatter && !ComputeGridGeometry())
+        return CE_Failure;
 
     /* -------------------------------------------------------------------- */
     /*      Perform gridding.                                               */
@@ -408,8 +492,7 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
         CPLprintf("Corner coordinates = (%f %f)-(%f %f).\n", dfXMin, dfYMin,
                   dfXMax, dfYMax);
         CPLprintf("Grid cell size = (%f %f).\n", dfDeltaX, dfDeltaY);
-        printf("Source point count = %lu.\n",
-               static_cast<unsigned long>(oVisitor.adfX.size()));
+        printf("Source point count = " CPL_FRMT_GUIB ".\n", nPointCount);
         PrintAlgorithmAndOptions(eAlgorithm, pOptions);
         printf("\n");
     }
@@ -467,14 +550,17 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
         }
     };
 
-    std::unique_ptr<GDALGridContext, GDALGridContextReleaser> psContext(
-        GDALGridContextCreate(eAlgorithm, pOptions,
-                              static_cast<int>(oVisitor.adfX.size()),
-                              &(oVisitor.adfX[0]), &(oVisitor.adfY[0]),
-                              &(oVisitor.adfZ[0]), TRUE));
-    if (!psContext)
+    std::unique_ptr<GDALGridContext, GDALGridContextReleaser> psContext;
+    if (!bScatter)
     {
-        return CE_Failure;
+        psContext.reset(GDALGridContextCreate(
+            eAlgorithm, pOptions, static_cast<int>(oVisitor.adfX.size()),
+            &(oVisitor.adfX[0]), &(oVisitor.adfY[0]), &(oVisitor.adfZ[0]),
+            TRUE));
+        if (!psContext)
+        {
+            return CE_Failure;
+        }
     }
 
     CPLErr eErr = CE_None;
@@ -484,11 +570,16 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
         for (int nXOffset = 0; nXOffset < nXSize && eErr == CE_None;
              nXOffset += nBlockXSize)
         {
+            const double dfBlockRatio = 1 - dfReadProgressRatio;
             std::unique_ptr<void, GDALScaledProgressReleaser> pScaledProgress(
                 GDALCreateScaledProgress(
-                    static_cast<double>(nBlock) / dfBlockCount,
-                    static_cast<double>(nBlock + 1) / dfBlockCount, pfnProgress,
-                    pProgressData));
+                    dfReadProgressRatio + dfBlockRatio *
+                                              static_cast<double>(nBlock) /
+                                              dfBlockCount,
+                    dfReadProgressRatio + dfBlockRatio *
+                                              static_cast<double>(nBlock + 1) /
+                                              dfBlockCount,
+                    pfnProgress, pProgressData));
             nBlock++;
 
             int nXRequest = nBlockXSize;
@@ -499,13 +590,22 @@ static CPLErr ProcessLayer(OGRLayer *poSrcLayer, GDALDataset *poDstDS,
             if (nYOffset > nYSize - nYRequest)
                 nYRequest = nYSize - nYOffset;
 
-            eErr = GDALGridContextProcess(
-                psContext.get(), dfXMin + dfDeltaX * nXOffset,
-                dfXMin + dfDeltaX * (nXOffset + nXRequest),
-                dfYMin + dfDeltaY * nYOffset,
-                dfYMin + dfDeltaY * (nYOffset + nYRequest), nXRequest,
-                nYRequest, eType, pData.get(), GDALScaledProgress,
-                pScaledProgress.get());
+            if (psScatterContext)
+            {
+                eErr = GDALGridScatterContextGetResult(
+                    psScatterContext.get(), nXOffset, nYOffset, nXRequest,
+                    nYRequest, eType, pData.get());
+            }
+            else
+            {
+                eErr = GDALGridContextProcess(
+                    psContext.get(), dfXMin + dfDeltaX * nXOffset,
+                    dfXMin + dfDeltaX * (nXOffset + nXRequest),
+                    dfYMin + dfDeltaY * nYOffset,
+                    dfYMin + dfDeltaY * (nYOffset + nYRequest), nXRequest,
+                    nYRequest, eType, pData.get(), GDALScaledProgress,
+                    pScaledProgress.get());
+            }
 
             if (eErr == CE_None)
                 eErr = poBand->RasterIO(GF_Write, nXOffset, nYOffset, nXRequest,
@@ -825,8 +925,9 @@ GDALDatasetH GDALGrid(const char *pszDest, GDALDatasetH hSrcDataset,
             nYSize, 1, bIsXExtentSet, bIsYExtentSet, dfXMin, dfXMax, dfYMin,
             dfYMax, psOptions->osBurnAttribute, psOptions->dfIncreaseBurnValue,
             psOptions->dfMultiplyBurnValue, psOptions->eOutputType,
-            psOptions->eAlgorithm, psOptions->pOptions.get(), psOptions->bQuiet,
-            psOptions->pfnProgress, psOptions->pProgressData);
+            psOptions->eAlgorithm, psOptions->pOptions.get(),
+            psOptions->bScatter, psOptions->bQuiet, psOptions->pfnProgress,
+            psOptions->pProgressData);
 
         poSrcDS->ReleaseResultSet(poLayer);
     }
@@ -878,7 +979,7 @@ GDALDatasetH GDALGrid(const char *pszDest, GDALDatasetH hSrcDataset,
             dfXMin, dfXMax, dfYMin, dfYMax, psOptions->osBurnAttribute,
             psOptions->dfIncreaseBurnValue, psOptions->dfMultiplyBurnValue,
             psOptions->eOutputType, psOptions->eAlgorithm,
-            psOptions->pOptions.get(), psOptions->bQuiet,
+            psOptions->pOptions.get(), psOptions->bScatter, psOptions->bQuiet,
             psOptions->pfnProgress, psOptions->pProgressData);
         if (eErr != CE_None)
             break;
@@ -1108,6 +1209,13 @@ GDALGridOptionsGetParser(GDALGridOptions *psOptions,
         .help(_("Set the interpolation algorithm or data metric name and "
                 "(optionally) its parameters."));
 
+    argParser->add_argument("-scatter")
+        .flag()
+        .store_into(psOptions->bScatter)
+        .help(_("Accumulate each point into the grid nodes it covers, reading "
+                "the points by batches (average, count, minimum, maximum and "
+                "range only)."));
+
     if (psOptionsForBinary)
     {
         argParser->add_open_options_argument(
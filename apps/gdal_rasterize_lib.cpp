@@ -290,6 +290,24 @@ GDALRasterizeOptionsGetParser(GDALRasterizeOptions *psOptions,
             })
         .help(_("Force the algorithm used."));
 
+    argParser->add_argument("-num_threads")
+        .metavar("<value>|ALL_CPUS")
+        .action(
+            [psOptions](const std::string &s)
+            {
+                const int nNumThreads = EQUAL(s.c_str(), "ALL_CPUS")
+                                            ? CPLGetNumCPUs()
+                                            : atoi(s.c_str());
+                if (nNumThreads <= 0)
+                {
+                    throw std::invalid_argument(CPLSPrintf(
+                        "Invalid value for -num_threads: %s.", s.c_str()));
+                }
+                psOptions->aosRasterizeOptions.SetNameValue("NUM_THREADS",
+                                                            s.c_str());
+            })
+        .help(_("Number of threads to use for the computation."));
+
     argParser->add_creation_options_argument(psOptions->aosCreationOptions)
         .action([psOptions](const std::string &)
                 { psOptions->bCreateOutput = true; });
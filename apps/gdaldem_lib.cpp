@@ -95,17 +95,24 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <vector>
 
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_virtual.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#include "gdaldem_lib.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -113,6 +120,10 @@
 #include "emmintrin.h"
 #endif
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+#define HAVE_AVX2_LINE_KERNELS
+#endif
+
 static const double kdfDegreesToRadians = M_PI / 180.0;
 static const double kdfRadiansToDegrees = 180.0 / M_PI;
 
@@ -123,21 +134,6 @@ typedef enum
     COLOR_SELECTION_EXACT_ENTRY
 } ColorSelectionMode;
 
-namespace gdal::GDALDEM
-{
-enum class GradientAlg
-{
-    HORN,
-    ZEVENBERGEN_THORNE,
-};
-
-enum class TRIAlg
-{
-    WILSON,
-    RILEY,
-};
-}  // namespace gdal::GDALDEM
-
 using namespace gdal::GDALDEM;
 
 struct GDALDEMProcessingOptions
@@ -171,6 +167,8 @@ struct GDALDEMProcessingOptions
     bool bMultiDirectional = false;
     CPLStringList aosCreationOptions{};
     int nBand = 1;
+    // 0 = use the GDAL_NUM_THREADS configuration option
+    int nNumThreads = 0;
 };
 
 /************************************************************************/
@@ -283,53 +281,46 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
 }
 
 /************************************************************************/
-/*                  GDALGeneric3x3Processing()                          */
+/*                   GDALGeneric3x3ProcessingParams                     */
 /************************************************************************/
 
-template <class T>
-static CPLErr GDALGeneric3x3Processing(
-    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
-    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
-    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
-        pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+template <class T> struct GDALGeneric3x3ProcessingParams
 {
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
-
-    /* -------------------------------------------------------------------- */
-    /*      Initialize progress counter.                                    */
-    /* -------------------------------------------------------------------- */
-    if (!pfnProgress(0.0, nullptr, pProgressData))
-    {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
-    }
-
-    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    int nXSize = 0;
+    int nYSize = 0;
+    bool bSrcHasNoData = false;
+    T fSrcNoDataValue = 0;
+    bool bIsSrcNoDataNan = false;
+    float fDstNoDataValue = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    // Whether pfnAlg_multisample may be run on lines with nodata values, the
+    // pixels whose window contains one being recomputed afterwards.
+    bool bAlgMultisampleIgnoresNoData = false;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+};
 
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
+/************************************************************************/
+/*                       GetSourceNoDataValue()                         */
+/************************************************************************/
 
+// Set bSrcHasNoData, fSrcNoDataValue and bIsSrcNoDataNan from the nodata
+// value of hSrcBand, and return the data type in which it must be read.
+template <class T>
+static GDALDataType GetSourceNoDataValue(GDALRasterBandH hSrcBand,
+                                         int &bSrcHasNoData,
+                                         T &fSrcNoDataValue,
+                                         int &bIsSrcNoDataNan)
+{
     GDALDataType eReadDT;
-    int bSrcHasNoData = FALSE;
+    bSrcHasNoData = FALSE;
+    fSrcNoDataValue = 0;
+    bIsSrcNoDataNan = FALSE;
     const double dfNoDataValue =
         GDALGetRasterNoDataValue(hSrcBand, &bSrcHasNoData);
 
-    int bIsSrcNoDataNan = FALSE;
-    T fSrcNoDataValue = 0;
     if (cpl::NumericLimits<T>::is_integer)
     {
         eReadDT = GDT_Int32;
@@ -362,12 +353,536 @@ static CPLErr GDALGeneric3x3Processing(
         fSrcNoDataValue = static_cast<T>(dfNoDataValue);
         bIsSrcNoDataNan = bSrcHasNoData && std::isnan(dfNoDataValue);
     }
+    return eReadDT;
+}
+
+/************************************************************************/
+/*                           IsSrcNoData()                              */
+/************************************************************************/
+
+// Must be kept consistent with ComputeVal().
+static inline bool
+IsSrcNoData(GInt32 nVal, const GDALGeneric3x3ProcessingParams<GInt32> &sParams)
+{
+    return sParams.bSrcHasNoData && nVal == sParams.fSrcNoDataValue;
+}
+
+static inline bool
+IsSrcNoData(float fVal, const GDALGeneric3x3ProcessingParams<float> &sParams)
+{
+    return sParams.bSrcHasNoData &&
+           ((!sParams.bIsSrcNoDataNan &&
+             ARE_REAL_EQUAL(fVal, sParams.fSrcNoDataValue)) ||
+            (sParams.bIsSrcNoDataNan && std::isnan(fVal)));
+}
+
+/************************************************************************/
+/*                          LineHasNoData()                             */
+/************************************************************************/
+
+// Whether ComputeVal() must check for nodata values on a window that
+// includes this line.
+template <class T>
+static bool LineHasNoData(const T *pafLine,
+                          const GDALGeneric3x3ProcessingParams<T> &sParams)
+{
+    if (!sParams.bSrcHasNoData)
+        return false;
+
+    const int nXSize = sParams.nXSize;
+    if (!cpl::NumericLimits<T>::is_integer)
+    {
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (IsSrcNoData(pafLine[iX], sParams))
+                return true;
+        }
+        return false;
+    }
+
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    int iX = 0;
+    for (; iX + 3 < nXSize; iX += 4)
+    {
+        if (pafLine[iX] == fSrcNoDataValue ||
+            pafLine[iX + 1] == fSrcNoDataValue ||
+            pafLine[iX + 2] == fSrcNoDataValue ||
+            pafLine[iX + 3] == fSrcNoDataValue)
+        {
+            return true;
+        }
+    }
+    for (; iX < nXSize; iX++)
+    {
+        if (pafLine[iX] == fSrcNoDataValue)
+            return true;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                         ComputeFirstLine()                           */
+/************************************************************************/
+
+// Compute the first output line from the first 2 source lines.
+template <class T>
+static void ComputeFirstLine(const T *pafLine1, const T *pafLine2,
+                             const GDALGeneric3x3ProcessingParams<T> &sParams,
+                             float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    if (!sParams.bComputeAtEdges || nXSize < 2 || sParams.nYSize < 2)
+    {
+        // Exclude the edges
+        for (int j = 0; j < nXSize; j++)
+        {
+            pafOutputBuf[j] = sParams.fDstNoDataValue;
+        }
+        return;
+    }
+
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            INTERPOL(pafLine1[jmin], pafLine2[jmin], bSrcHasNoData,
+                     fSrcNoDataValue),
+            INTERPOL(pafLine1[j], pafLine2[j], bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine1[jmax], pafLine2[jmax], bSrcHasNoData,
+                     fSrcNoDataValue),
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax]};
+        pafOutputBuf[j] = ComputeVal(
+            bSrcHasNoData, fSrcNoDataValue, sParams.bIsSrcNoDataNan, afWin,
+            sParams.fDstNoDataValue, sParams.pfnAlg, sParams.pData, true);
+    }
+}
+
+/************************************************************************/
+/*                          ComputeLastLine()                           */
+/************************************************************************/
+
+// Compute the last output line from the last 2 source lines.
+template <class T>
+static void ComputeLastLine(const T *pafLine1, const T *pafLine2,
+                            const GDALGeneric3x3ProcessingParams<T> &sParams,
+                            float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    if (!sParams.bComputeAtEdges || nXSize < 2 || sParams.nYSize < 2)
+    {
+        // Exclude the edges
+        for (int j = 0; j < nXSize; j++)
+        {
+            pafOutputBuf[j] = sParams.fDstNoDataValue;
+        }
+        return;
+    }
+
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    for (int j = 0; j < nXSize; j++)
+    {
+        int jmin = (j == 0) ? j : j - 1;
+        int jmax = (j == nXSize - 1) ? j : j + 1;
+
+        T afWin[9] = {
+            pafLine1[jmin],
+            pafLine1[j],
+            pafLine1[jmax],
+            pafLine2[jmin],
+            pafLine2[j],
+            pafLine2[jmax],
+            INTERPOL(pafLine2[jmin], pafLine1[jmin], bSrcHasNoData,
+                     fSrcNoDataValue),
+            INTERPOL(pafLine2[j], pafLine1[j], bSrcHasNoData, fSrcNoDataValue),
+            INTERPOL(pafLine2[jmax], pafLine1[jmax], bSrcHasNoData,
+                     fSrcNoDataValue),
+        };
+
+        pafOutputBuf[j] = ComputeVal(
+            bSrcHasNoData, fSrcNoDataValue, sParams.bIsSrcNoDataNan, afWin,
+            sParams.fDstNoDataValue, sParams.pfnAlg, sParams.pData, true);
+    }
+}
+
+/************************************************************************/
+/*                          ComputeInnerLine()                          */
+/************************************************************************/
+
+// Compute an output line that is neither the first nor the last one, from
+// the 3 source lines at offsets nLine1Off, nLine2Off and nLine3Off of
+// pafThreeLineWin. The line following nLine3Off must be readable, as
+// pfnAlg_multisample may read one value past it.
+template <class T>
+static void ComputeInnerLine(const T *pafThreeLineWin, int nLine1Off,
+                             int nLine2Off, int nLine3Off,
+                             bool bOneOfThreeLinesHasNoData,
+                             const GDALGeneric3x3ProcessingParams<T> &sParams,
+                             float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const bool bIsSrcNoDataNan = sParams.bIsSrcNoDataNan;
+    const float fDstNoDataValue = sParams.fDstNoDataValue;
+    const auto pfnAlg = sParams.pfnAlg;
+    void *const pData = sParams.pData;
+    const bool bComputeAtEdges = sParams.bComputeAtEdges;
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        int j = 0;
+        T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine1Off + j],
+                      pafThreeLineWin[nLine1Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j],
+                      pafThreeLineWin[nLine2Off + j + 1],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j + 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j],
+                      pafThreeLineWin[nLine3Off + j + 1]};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData,
+                                     fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                                     fDstNoDataValue, pfnAlg, pData,
+                                     bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        pafOutputBuf[0] = fDstNoDataValue;
+    }
+
+    const auto ComputeInnerVal = [&](int k)
+    {
+        T afWin[9] = {pafThreeLineWin[nLine1Off + k - 1],
+                      pafThreeLineWin[nLine1Off + k],
+                      pafThreeLineWin[nLine1Off + k + 1],
+                      pafThreeLineWin[nLine2Off + k - 1],
+                      pafThreeLineWin[nLine2Off + k],
+                      pafThreeLineWin[nLine2Off + k + 1],
+                      pafThreeLineWin[nLine3Off + k - 1],
+                      pafThreeLineWin[nLine3Off + k],
+                      pafThreeLineWin[nLine3Off + k + 1]};
+
+        return ComputeVal(bOneOfThreeLinesHasNoData, fSrcNoDataValue,
+                          bIsSrcNoDataNan, afWin, fDstNoDataValue, pfnAlg,
+                          pData, bComputeAtEdges);
+    };
+
+    int j = 1;
+    if (sParams.pfnAlg_multisample &&
+        (!bOneOfThreeLinesHasNoData || sParams.bAlgMultisampleIgnoresNoData))
+    {
+        j = sParams.pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
+                                       nLine3Off, nXSize, pData, pafOutputBuf);
+
+        if (bOneOfThreeLinesHasNoData && j > 1)
+        {
+            // pfnAlg_multisample ignored nodata values: recompute the pixels
+            // whose window contains one.
+            const auto IsColumnNoData = [&](int k)
+            {
+                return IsSrcNoData(pafThreeLineWin[nLine1Off + k], sParams) ||
+                       IsSrcNoData(pafThreeLineWin[nLine2Off + k], sParams) ||
+                       IsSrcNoData(pafThreeLineWin[nLine3Off + k], sParams);
+            };
+            bool bPrevColumnNoData = IsColumnNoData(0);
+            bool bColumnNoData = IsColumnNoData(1);
+            for (int k = 1; k < j; k++)
+            {
+                const bool bNextColumnNoData = IsColumnNoData(k + 1);
+                if (bPrevColumnNoData || bColumnNoData || bNextColumnNoData)
+                    pafOutputBuf[k] = ComputeInnerVal(k);
+                bPrevColumnNoData = bColumnNoData;
+                bColumnNoData = bNextColumnNoData;
+            }
+        }
+    }
+
+    for (; j < nXSize - 1; j++)
+    {
+        pafOutputBuf[j] = ComputeInnerVal(j);
+    }
+
+    if (bComputeAtEdges && nXSize >= 2)
+    {
+        j = nXSize - 1;
+
+        T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
+                      pafThreeLineWin[nLine1Off + j],
+                      INTERPOL(pafThreeLineWin[nLine1Off + j],
+                               pafThreeLineWin[nLine1Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine2Off + j - 1],
+                      pafThreeLineWin[nLine2Off + j],
+                      INTERPOL(pafThreeLineWin[nLine2Off + j],
+                               pafThreeLineWin[nLine2Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue),
+                      pafThreeLineWin[nLine3Off + j - 1],
+                      pafThreeLineWin[nLine3Off + j],
+                      INTERPOL(pafThreeLineWin[nLine3Off + j],
+                               pafThreeLineWin[nLine3Off + j - 1],
+                               bSrcHasNoData, fSrcNoDataValue)};
+
+        pafOutputBuf[j] = ComputeVal(bOneOfThreeLinesHasNoData,
+                                     fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                                     fDstNoDataValue, pfnAlg, pData,
+                                     bComputeAtEdges);
+    }
+    else
+    {
+        // Exclude the edges
+        if (nXSize > 1)
+            pafOutputBuf[nXSize - 1] = fDstNoDataValue;
+    }
+}
+
+/************************************************************************/
+/*                           ComputeStrip()                             */
+/************************************************************************/
+
+// Compute the nLines output lines starting at nYOff, from pafSrc, that holds
+// nSrcLines source lines starting at nSrcYOff, followed by one padding value.
+// pafSrc must contain the line above and below the strip, when they exist.
+template <class T>
+static void ComputeStrip(const T *pafSrc, int nSrcYOff, int nSrcLines,
+                         int nYOff, int nLines,
+                         const GDALGeneric3x3ProcessingParams<T> &sParams,
+                         float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const auto GetLineOff = [nSrcYOff, nXSize](int iLine)
+    { return (iLine - nSrcYOff) * nXSize; };
+
+    std::vector<bool> abLineHasNoData(nSrcLines);
+    for (int i = 0; i < nSrcLines; ++i)
+        abLineHasNoData[i] = LineHasNoData(pafSrc + i * nXSize, sParams);
+
+    for (int i = nYOff; i < nYOff + nLines; ++i)
+    {
+        float *pafOutputLine = pafOutputBuf + (i - nYOff) * nXSize;
+        if (i == 0)
+        {
+            ComputeFirstLine(pafSrc + GetLineOff(0),
+                             nYSize >= 2 ? pafSrc + GetLineOff(1) : nullptr,
+                             sParams, pafOutputLine);
+        }
+        else if (i == nYSize - 1)
+        {
+            ComputeLastLine(pafSrc + GetLineOff(i - 1),
+                            pafSrc + GetLineOff(i), sParams, pafOutputLine);
+        }
+        else
+        {
+            const bool bOneOfThreeLinesHasNoData =
+                abLineHasNoData[i - 1 - nSrcYOff] ||
+                abLineHasNoData[i - nSrcYOff] ||
+                abLineHasNoData[i + 1 - nSrcYOff];
+            ComputeInnerLine(pafSrc, GetLineOff(i - 1), GetLineOff(i),
+                             GetLineOff(i + 1), bOneOfThreeLinesHasNoData,
+                             sParams, pafOutputLine);
+        }
+    }
+}
+
+/************************************************************************/
+/*               GDALGeneric3x3ProcessingMultiThreaded()                */
+/************************************************************************/
+
+// Process the raster by horizontal strips, whose source lines are read by
+// the calling thread, computed concurrently by nThreads threads of the global
+// thread pool, and written in order by the calling thread.
+template <class T>
+static CPLErr GDALGeneric3x3ProcessingMultiThreaded(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand, GDALDataType eReadDT,
+    const GDALGeneric3x3ProcessingParams<T> &sParams, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+
+    // Enough strips to balance the load between threads, but strips not
+    // larger than needed, to limit memory usage.
+    constexpr size_t MAX_STRIP_BYTES = 16 * 1024 * 1024;
+    const int nMaxStripLines = static_cast<int>(std::max<size_t>(
+        1, MAX_STRIP_BYTES / (static_cast<size_t>(nXSize) *
+                              (sizeof(T) + sizeof(float)))));
+    const int nStripLines = std::max(
+        1, std::min(nMaxStripLines, DIV_ROUND_UP(nYSize, 4 * nThreads)));
+    const int nStrips = DIV_ROUND_UP(nYSize, nStripLines);
+
+    struct Strip
+    {
+        std::vector<T> afSrc{};
+        std::vector<float> afOutput{};
+        std::atomic<bool> bDone{false};
+    };
+
+    // Strips being computed, and the ones being read or written.
+    std::vector<Strip> asStrips(2 * nThreads);
+
+    auto poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    CPLErr eErr = CE_None;
+    int iNextStripToRead = 0;
+    for (int iStrip = 0; iStrip < nStrips && eErr == CE_None; ++iStrip)
+    {
+        while (eErr == CE_None && iNextStripToRead < nStrips &&
+               iNextStripToRead - iStrip < static_cast<int>(asStrips.size()))
+        {
+            auto &sStrip = asStrips[iNextStripToRead % asStrips.size()];
+            const int nYOff = iNextStripToRead * nStripLines;
+            const int nLines = std::min(nStripLines, nYSize - nYOff);
+            const int nSrcYOff = std::max(0, nYOff - 1);
+            const int nSrcLines =
+                std::min(nYSize, nYOff + nLines + 1) - nSrcYOff;
+            try
+            {
+                sStrip.afSrc.resize(static_cast<size_t>(nSrcLines) * nXSize +
+                                    1);
+                sStrip.afOutput.resize(static_cast<size_t>(nLines) * nXSize);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating strip buffers");
+                eErr = CE_Failure;
+                break;
+            }
+            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, nSrcYOff, nXSize,
+                                nSrcLines, sStrip.afSrc.data(), nXSize,
+                                nSrcLines, eReadDT, 0, 0);
+            if (eErr != CE_None)
+                break;
+
+            sStrip.bDone = false;
+            poJobQueue->SubmitJob(
+                [&sStrip, &sParams, nSrcYOff, nSrcLines, nYOff, nLines]()
+                {
+                    ComputeStrip(sStrip.afSrc.data(), nSrcYOff, nSrcLines,
+                                 nYOff, nLines, sParams,
+                                 sStrip.afOutput.data());
+                    sStrip.bDone = true;
+                });
+            ++iNextStripToRead;
+        }
+        if (eErr != CE_None)
+            break;
+
+        auto &sStrip = asStrips[iStrip % asStrips.size()];
+        while (!sStrip.bDone && poJobQueue->WaitEvent())
+        {
+        }
+
+        const int nYOff = iStrip * nStripLines;
+        const int nLines = std::min(nStripLines, nYSize - nYOff);
+        eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYOff, nXSize, nLines,
+                            sStrip.afOutput.data(), nXSize, nLines,
+                            GDT_Float32, 0, 0);
+        if (eErr == CE_None &&
+            !pfnProgress(static_cast<double>(nYOff + nLines) / nYSize,
+                         nullptr, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    // Jobs reference asStrips.
+    poJobQueue->WaitCompletion();
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                  GDALGeneric3x3Processing()                          */
+/************************************************************************/
+
+template <class T>
+static CPLErr GDALGeneric3x3Processing(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample,
+    bool bAlgMultisampleIgnoresNoData, void *pData, bool bComputeAtEdges,
+    int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    /* -------------------------------------------------------------------- */
+    /*      Initialize progress counter.                                    */
+    /* -------------------------------------------------------------------- */
+    if (!pfnProgress(0.0, nullptr, pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    GDALGeneric3x3ProcessingParams<T> sParams;
+    sParams.nXSize = GDALGetRasterBandXSize(hSrcBand);
+    sParams.nYSize = GDALGetRasterBandYSize(hSrcBand);
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.bAlgMultisampleIgnoresNoData = bAlgMultisampleIgnoresNoData;
+    sParams.pData = pData;
+    sParams.bComputeAtEdges = bComputeAtEdges;
+
+    int bSrcHasNoData = FALSE;
+    int bIsSrcNoDataNan = FALSE;
+    const GDALDataType eReadDT = GetSourceNoDataValue(
+        hSrcBand, bSrcHasNoData, sParams.fSrcNoDataValue, bIsSrcNoDataNan);
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
 
     int bDstHasNoData = FALSE;
-    float fDstNoDataValue =
+    sParams.fDstNoDataValue =
         static_cast<float>(GDALGetRasterNoDataValue(hDstBand, &bDstHasNoData));
     if (!bDstHasNoData)
-        fDstNoDataValue = 0.0;
+        sParams.fDstNoDataValue = 0.0;
+
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+
+    if (nThreads > 1 && nYSize > 2)
+    {
+        const CPLErr eErr = GDALGeneric3x3ProcessingMultiThreaded(
+            hSrcBand, hDstBand, eReadDT, sParams, nThreads, pfnProgress,
+            pProgressData);
+        if (eErr == CE_None)
+            pfnProgress(1.0, nullptr, pProgressData);
+        return eErr;
+    }
+
+    // 1 line destination buffer.
+    float *pafOutputBuf =
+        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
+    // 3 line rotating source buffer.
+    T *pafThreeLineWin =
+        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
+    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
+    {
+        VSIFree(pafOutputBuf);
+        VSIFree(pafThreeLineWin);
+        return CE_Failure;
+    }
 
     int nLine1Off = 0;
     int nLine2Off = nXSize;
@@ -382,9 +897,9 @@ static CPLErr GDALGeneric3x3Processing(
 
     /* Preload the first 2 lines */
 
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
+    bool abLineHasNoDataValue[3] = {sParams.bSrcHasNoData,
+                                    sParams.bSrcHasNoData,
+                                    sParams.bSrcHasNoData};
 
     // Create an extra scope for VC12 to ignore i.
     {
@@ -399,65 +914,22 @@ static CPLErr GDALGeneric3x3Processing(
 
                 return CE_Failure;
             }
-            if (cpl::NumericLimits<T>::is_integer && bSrcHasNoData)
-            {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
-                }
-            }
+            abLineHasNoDataValue[i] =
+                LineHasNoData(pafThreeLineWin + i * nXSize, sParams);
         }
     }  // End extra scope for VC12
 
     CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
+    ComputeFirstLine(pafThreeLineWin, pafThreeLineWin + nXSize, sParams,
+                     pafOutputBuf);
+    eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
+                        nXSize, 1, GDT_Float32, 0, 0);
+    if (eErr == CE_None && nYSize > 1 &&
+        !(bComputeAtEdges && nXSize >= 2 && nYSize >= 2))
     {
         // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr == CE_None && nYSize > 1)
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
+        eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
+                            pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
     }
     if (eErr != CE_None)
     {
@@ -484,125 +956,14 @@ static CPLErr GDALGeneric3x3Processing(
 
         // In case none of the 3 lines have nodata values, then no need to
         // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (cpl::NumericLimits<T>::is_integer && bSrcHasNoData)
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
-            {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
-                {
-                    bLastLineHasNoDataValue = true;
-                    break;
-                }
-            }
-            if (!bLastLineHasNoDataValue)
-            {
-                for (; iX < nXSize; iX++)
-                {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
-                }
-            }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                        abLineHasNoDataValue[1] ||
-                                        abLineHasNoDataValue[2];
-        }
-
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            int j = 0;
-            T afWin[9] = {INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j + 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            pafOutputBuf[0] = fDstNoDataValue;
-        }
-
-        int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
-        {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
-        }
-
-        for (; j < nXSize - 1; j++)
-        {
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          pafThreeLineWin[nLine1Off + j + 1],
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          pafThreeLineWin[nLine2Off + j + 1],
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          pafThreeLineWin[nLine3Off + j + 1]};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
+        abLineHasNoDataValue[nLine3Off / nXSize] =
+            LineHasNoData(pafThreeLineWin + nLine3Off, sParams);
+        const bool bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
+                                               abLineHasNoDataValue[1] ||
+                                               abLineHasNoDataValue[2];
 
-        if (bComputeAtEdges && nXSize >= 2)
-        {
-            j = nXSize - 1;
-
-            T afWin[9] = {pafThreeLineWin[nLine1Off + j - 1],
-                          pafThreeLineWin[nLine1Off + j],
-                          INTERPOL(pafThreeLineWin[nLine1Off + j],
-                                   pafThreeLineWin[nLine1Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine2Off + j - 1],
-                          pafThreeLineWin[nLine2Off + j],
-                          INTERPOL(pafThreeLineWin[nLine2Off + j],
-                                   pafThreeLineWin[nLine2Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue),
-                          pafThreeLineWin[nLine3Off + j - 1],
-                          pafThreeLineWin[nLine3Off + j],
-                          INTERPOL(pafThreeLineWin[nLine3Off + j],
-                                   pafThreeLineWin[nLine3Off + j - 1],
-                                   bSrcHasNoData, fSrcNoDataValue)};
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
-        }
-        else
-        {
-            // Exclude the edges
-            if (nXSize > 1)
-                pafOutputBuf[nXSize - 1] = fDstNoDataValue;
-        }
+        ComputeInnerLine(pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off,
+                         bOneOfThreeLinesHasNoData, sParams, pafOutputBuf);
 
         /* -----------------------------------------
          * Write Line to Raster
@@ -636,34 +997,8 @@ static CPLErr GDALGeneric3x3Processing(
 
     if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
     {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
+        ComputeLastLine(pafThreeLineWin + nLine1Off,
+                        pafThreeLineWin + nLine2Off, sParams, pafOutputBuf);
         eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
                             nXSize, 1, GDT_Float32, 0, 0);
         if (eErr != CE_None)
@@ -723,26 +1058,6 @@ template <class T> struct Gradient<T, GradientAlg::ZEVENBERGEN_THORNE>
 /*                         GDALHillshade()                              */
 /************************************************************************/
 
-typedef struct
-{
-    double inv_nsres;
-    double inv_ewres;
-    double sin_altRadians;
-    double cos_alt_mul_z;
-    double azRadians;
-    double cos_az_mul_cos_alt_mul_z;
-    double sin_az_mul_cos_alt_mul_z;
-    double square_z;
-    double sin_altRadians_mul_254;
-    double cos_az_mul_cos_alt_mul_z_mul_254;
-    double sin_az_mul_cos_alt_mul_z_mul_254;
-
-    double square_z_mul_square_inv_res;
-    double cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
-    double sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
-    double z_scaled;
-} GDALHillshadeAlgData;
-
 /* Unoptimized formulas are :
     x = psData->z*((afWin[0] + afWin[3] + afWin[3] + afWin[6]) -
         (afWin[2] + afWin[5] + afWin[5] + afWin[8])) /
@@ -1146,19 +1461,6 @@ static void *GDALCreateHillshadeData(double *adfGeoTransform, double z,
 /*                   GDALHillshadeMultiDirectional()                    */
 /************************************************************************/
 
-typedef struct
-{
-    double inv_nsres;
-    double inv_ewres;
-    double square_z;
-    double sin_altRadians_mul_127;
-    double sin_altRadians_mul_254;
-
-    double cos_alt_mul_z_mul_127;
-    double cos225_az_mul_cos_alt_mul_z_mul_127;
-
-} GDALHillshadeMultiDirectionalAlgData;
-
 template <class T, GradientAlg alg>
 static float GDALHillshadeMultiDirectionalAlg(const T *afWin,
                                               float /*fDstNoDataValue*/,
@@ -1248,14 +1550,6 @@ static void *GDALCreateHillshadeMultiDirectionalData(double *adfGeoTransform,
 /*                         GDALSlope()                                  */
 /************************************************************************/
 
-typedef struct
-{
-    double nsres;
-    double ewres;
-    double scale;
-    int slopeFormat;
-} GDALSlopeAlgData;
-
 template <class T>
 static float GDALSlopeHornAlg(const T *afWin, float /*fDstNoDataValue*/,
                               void *pData)
@@ -2551,6 +2845,11 @@ template <class T> class GDALGeneric3x3Dataset : public GDALDataset
     double dfDstNoDataValue;
     int nCurLine;
     bool bComputeAtEdges;
+    int nThreads;
+    // Only used if nThreads > 1
+    std::unique_ptr<CPLJobQueue> poJobQueue{};
+    std::vector<T> afSrcStrip{};
+    std::vector<float> afOutputStrip{};
 
     CPL_DISALLOW_COPY_ASSIGN(GDALGeneric3x3Dataset)
 
@@ -2559,7 +2858,7 @@ template <class T> class GDALGeneric3x3Dataset : public GDALDataset
                           GDALDataType eDstDataType, int bDstHasNoData,
                           double dfDstNoDataValue,
                           typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
-                          void *pAlgData, bool bComputeAtEdges);
+                          void *pAlgData, bool bComputeAtEdges, int nThreads);
     ~GDALGeneric3x3Dataset();
 
     bool InitOK() const
@@ -2585,8 +2884,10 @@ template <class T> class GDALGeneric3x3RasterBand : public GDALRasterBand
     T fSrcNoDataValue;
     int bIsSrcNoDataNan;
     GDALDataType eReadDT;
+    GDALGeneric3x3ProcessingParams<T> sParams{};
 
     void InitWithNoData(void *pImage);
+    CPLErr IReadBlockMultiThreaded(int nBlockYOff, void *pImage);
 
   public:
     GDALGeneric3x3RasterBand(GDALGeneric3x3Dataset<T> *poDSIn,
@@ -2601,17 +2902,20 @@ GDALGeneric3x3Dataset<T>::GDALGeneric3x3Dataset(
     GDALDatasetH hSrcDSIn, GDALRasterBandH hSrcBandIn,
     GDALDataType eDstDataType, int bDstHasNoDataIn, double dfDstNoDataValueIn,
     typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlgIn, void *pAlgDataIn,
-    bool bComputeAtEdgesIn)
+    bool bComputeAtEdgesIn, int nThreadsIn)
     : pfnAlg(pfnAlgIn), pAlgData(pAlgDataIn), hSrcDS(hSrcDSIn),
       hSrcBand(hSrcBandIn), bDstHasNoData(bDstHasNoDataIn),
       dfDstNoDataValue(dfDstNoDataValueIn), nCurLine(-1),
-      bComputeAtEdges(bComputeAtEdgesIn)
+      bComputeAtEdges(bComputeAtEdgesIn), nThreads(nThreadsIn)
 {
     CPLAssert(eDstDataType == GDT_Byte || eDstDataType == GDT_Float32);
 
     nRasterXSize = GDALGetRasterXSize(hSrcDS);
     nRasterYSize = GDALGetRasterYSize(hSrcDS);
 
+    if (nThreads > 1)
+        poJobQueue = GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+
     SetBand(1, new GDALGeneric3x3RasterBand<T>(this, eDstDataType));
 
     apafSourceBuf[0] =
@@ -2652,67 +2956,140 @@ GDALGeneric3x3RasterBand<T>::GDALGeneric3x3RasterBand(
     eDataType = eDstDataType;
     nBlockXSize = poDS->GetRasterXSize();
     nBlockYSize = 1;
-
-    const double dfNoDataValue =
-        GDALGetRasterNoDataValue(poDSIn->hSrcBand, &bSrcHasNoData);
-    if (cpl::NumericLimits<T>::is_integer)
-    {
-        eReadDT = GDT_Int32;
-        if (bSrcHasNoData)
-        {
-            GDALDataType eSrcDT = GDALGetRasterDataType(poDSIn->hSrcBand);
-            CPLAssert(eSrcDT == GDT_Byte || eSrcDT == GDT_UInt16 ||
-                      eSrcDT == GDT_Int16);
-            const int nMinVal = (eSrcDT == GDT_Byte)     ? 0
-                                : (eSrcDT == GDT_UInt16) ? 0
-                                                         : -32768;
-            const int nMaxVal = (eSrcDT == GDT_Byte)     ? 255
-                                : (eSrcDT == GDT_UInt16) ? 65535
-                                                         : 32767;
-
-            if (fabs(dfNoDataValue - floor(dfNoDataValue + 0.5)) < 1e-2 &&
-                dfNoDataValue >= nMinVal && dfNoDataValue <= nMaxVal)
-            {
-                fSrcNoDataValue = static_cast<T>(floor(dfNoDataValue + 0.5));
-            }
-            else
-            {
-                bSrcHasNoData = FALSE;
-            }
-        }
-    }
-    else
+    if (poDSIn->nThreads > 1)
     {
-        eReadDT = GDT_Float32;
-        fSrcNoDataValue = static_cast<T>(dfNoDataValue);
-        bIsSrcNoDataNan = bSrcHasNoData && std::isnan(dfNoDataValue);
+        // Blocks of several lines, whose computation is split between
+        // threads, with a memory usage similar to the one of
+        // GDALGeneric3x3ProcessingMultiThreaded().
+        constexpr size_t MAX_BLOCK_BYTES = 16 * 1024 * 1024;
+        const size_t nMaxBlockLines = std::max<size_t>(
+            1, MAX_BLOCK_BYTES / (static_cast<size_t>(nBlockXSize) *
+                                  (sizeof(T) + sizeof(float))));
+        nBlockYSize = static_cast<int>(std::min<size_t>(
+            {nMaxBlockLines, static_cast<size_t>(64) * poDSIn->nThreads,
+             static_cast<size_t>(poDS->GetRasterYSize())}));
     }
+
+    eReadDT = GetSourceNoDataValue(poDSIn->hSrcBand, bSrcHasNoData,
+                                   fSrcNoDataValue, bIsSrcNoDataNan);
+
+    sParams.nXSize = poDS->GetRasterXSize();
+    sParams.nYSize = poDS->GetRasterYSize();
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.fSrcNoDataValue = fSrcNoDataValue;
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sParams.fDstNoDataValue = static_cast<float>(poDSIn->dfDstNoDataValue);
+    sParams.pfnAlg = poDSIn->pfnAlg;
+    sParams.pData = poDSIn->pAlgData;
+    sParams.bComputeAtEdges = poDSIn->bComputeAtEdges;
 }
 
 template <class T>
 void GDALGeneric3x3RasterBand<T>::InitWithNoData(void *pImage)
 {
     auto poGDS = cpl::down_cast<GDALGeneric3x3Dataset<T> *>(poDS);
+    const size_t nValues = static_cast<size_t>(nBlockXSize) * nBlockYSize;
     if (eDataType == GDT_Byte)
     {
-        for (int j = 0; j < nBlockXSize; j++)
+        for (size_t j = 0; j < nValues; j++)
             static_cast<GByte *>(pImage)[j] =
                 static_cast<GByte>(poGDS->dfDstNoDataValue);
     }
     else
     {
-        for (int j = 0; j < nBlockXSize; j++)
+        for (size_t j = 0; j < nValues; j++)
             static_cast<float *>(pImage)[j] =
                 static_cast<float>(poGDS->dfDstNoDataValue);
     }
 }
 
+template <class T>
+CPLErr GDALGeneric3x3RasterBand<T>::IReadBlockMultiThreaded(int nBlockYOff,
+                                                            void *pImage)
+{
+    auto poGDS = cpl::down_cast<GDALGeneric3x3Dataset<T> *>(poDS);
+
+    const int nYOff = nBlockYOff * nBlockYSize;
+    const int nLines = std::min(nBlockYSize, nRasterYSize - nYOff);
+    const int nSrcYOff = std::max(0, nYOff - 1);
+    const int nSrcLines = std::min(nRasterYSize, nYOff + nLines + 1) - nSrcYOff;
+
+    auto &afSrc = poGDS->afSrcStrip;
+    auto &afOutput = poGDS->afOutputStrip;
+    try
+    {
+        afSrc.resize(static_cast<size_t>(nSrcLines) * nBlockXSize);
+        if (eDataType == GDT_Byte)
+            afOutput.resize(static_cast<size_t>(nLines) * nBlockXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory allocating strip buffers");
+        InitWithNoData(pImage);
+        return CE_Failure;
+    }
+
+    const CPLErr eErr =
+        GDALRasterIO(poGDS->hSrcBand, GF_Read, 0, nSrcYOff, nBlockXSize,
+                     nSrcLines, afSrc.data(), nBlockXSize, nSrcLines, eReadDT,
+                     0, 0);
+    if (eErr != CE_None)
+    {
+        InitWithNoData(pImage);
+        return eErr;
+    }
+
+    float *pafOutput = eDataType == GDT_Byte ? afOutput.data()
+                                             : static_cast<float *>(pImage);
+
+    // Split the block in as many sub-strips as threads. Each sub-strip
+    // reads the source lines above and below it from afSrc.
+    const int nThreads = poGDS->nThreads;
+    const int nSubStripLines = DIV_ROUND_UP(nLines, nThreads);
+    for (int nSubYOff = nYOff; nSubYOff < nYOff + nLines;
+         nSubYOff += nSubStripLines)
+    {
+        const int nSubLines =
+            std::min(nSubStripLines, nYOff + nLines - nSubYOff);
+        const int nSubSrcYOff = std::max(0, nSubYOff - 1);
+        const int nSubSrcLines =
+            std::min(nRasterYSize, nSubYOff + nSubLines + 1) - nSubSrcYOff;
+        const T *pafSubSrc =
+            afSrc.data() + static_cast<size_t>(nSubSrcYOff - nSrcYOff) *
+                               nBlockXSize;
+        float *pafSubOutput =
+            pafOutput + static_cast<size_t>(nSubYOff - nYOff) * nBlockXSize;
+        poGDS->poJobQueue->SubmitJob(
+            [this, pafSubSrc, nSubSrcYOff, nSubSrcLines, nSubYOff, nSubLines,
+             pafSubOutput]()
+            {
+                ComputeStrip(pafSubSrc, nSubSrcYOff, nSubSrcLines, nSubYOff,
+                             nSubLines, sParams, pafSubOutput);
+            });
+    }
+    poGDS->poJobQueue->WaitCompletion();
+
+    if (eDataType == GDT_Byte)
+    {
+        GByte *pabyImage = static_cast<GByte *>(pImage);
+        const size_t nValues = static_cast<size_t>(nLines) * nBlockXSize;
+        for (size_t i = 0; i < nValues; ++i)
+            pabyImage[i] = static_cast<GByte>(pafOutput[i] + 0.5);
+    }
+
+    return CE_None;
+}
+
 template <class T>
 CPLErr GDALGeneric3x3RasterBand<T>::IReadBlock(int /*nBlockXOff*/,
                                                int nBlockYOff, void *pImage)
 {
     auto poGDS = cpl::down_cast<GDALGeneric3x3Dataset<T> *>(poDS);
 
+    if (poGDS->nThreads > 1)
+        return IReadBlockMultiThreaded(nBlockYOff, pImage);
+
     if (poGDS->bComputeAtEdges && nRasterXSize >= 2 && nRasterYSize >= 2)
     {
         if (nBlockYOff == 0)
@@ -3030,6 +3407,55 @@ static Algorithm GetAlgorithm(const char *pszProcessing)
     }
 }
 
+#ifdef HAVE_AVX2_LINE_KERNELS
+
+/************************************************************************/
+/*                      GetAlgMultisampleAVX2()                         */
+/************************************************************************/
+
+// Return the AVX2 line kernel matching the per-pixel function selected by
+// GDALDEMProcessing() for eUtilityMode, or nullptr if there is none.
+template <class T, GradientAlg alg>
+static typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+GetAlgMultisampleAVX2(Algorithm eUtilityMode,
+                      const GDALDEMProcessingOptions *psOptions,
+                      bool bSameRes)
+{
+    if (eUtilityMode == HILL_SHADE)
+    {
+        if (psOptions->bMultiDirectional)
+            return GDALHillshadeMultiDirectionalAlg_multisample_AVX2<T, alg>;
+        if (psOptions->bCombined)
+            return GDALHillshadeCombinedAlg_multisample_AVX2<T, alg>;
+        if (psOptions->bIgor)
+            return nullptr;
+        if (alg == GradientAlg::HORN && bSameRes)
+            return GDALHillshadeAlg_same_res_multisample_AVX2<T>;
+        return GDALHillshadeAlg_multisample_AVX2<T, alg>;
+    }
+    else if (eUtilityMode == SLOPE)
+    {
+        return GDALSlopeAlg_multisample_AVX2<T, alg>;
+    }
+    return nullptr;
+}
+
+template <class T>
+static typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+GetAlgMultisampleAVX2(Algorithm eUtilityMode,
+                      const GDALDEMProcessingOptions *psOptions,
+                      const double *adfGeoTransform)
+{
+    const bool bSameRes = adfGeoTransform[1] == -adfGeoTransform[5];
+    if (psOptions->eGradientAlg == GradientAlg::ZEVENBERGEN_THORNE)
+        return GetAlgMultisampleAVX2<T, GradientAlg::ZEVENBERGEN_THORNE>(
+            eUtilityMode, psOptions, bSameRes);
+    return GetAlgMultisampleAVX2<T, GradientAlg::HORN>(eUtilityMode,
+                                                       psOptions, bSameRes);
+}
+
+#endif
+
 /************************************************************************/
 /*                    GDALDEMAppOptionsGetParser()                      */
 /************************************************************************/
@@ -3068,6 +3494,23 @@ static std::unique_ptr<GDALArgumentParser> GDALDEMAppOptionsGetParser(
 
         subParser->add_creation_options_argument(psOptions->aosCreationOptions);
 
+        subParser->add_argument("-num_threads")
+            .metavar("<value>|ALL_CPUS")
+            .action(
+                [psOptions](const std::string &s)
+                {
+                    const int nNumThreads = EQUAL(s.c_str(), "ALL_CPUS")
+                                                ? CPLGetNumCPUs()
+                                                : atoi(s.c_str());
+                    if (nNumThreads <= 0)
+                    {
+                        throw std::invalid_argument(CPLSPrintf(
+                            "Invalid value for -num_threads: %s.", s.c_str()));
+                    }
+                    psOptions->nNumThreads = std::min(nNumThreads, 128);
+                })
+            .help(_("Number of threads to use for the computation."));
+
         if (psOptionsForBinary)
         {
             subParser->add_quiet_argument(&psOptionsForBinary->bQuiet);
@@ -3625,6 +4068,10 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     }
     GDALRasterBandH hSrcBand = GDALGetRasterBand(hSrcDataset, psOptions->nBand);
 
+    const int nNumThreads = psOptions->nNumThreads > 0
+                                ? psOptions->nNumThreads
+                                : GDALGetNumThreads();
+
     GDALGetGeoTransform(hSrcDataset, adfGeoTransform);
 
     CPLString osFormat;
@@ -3678,8 +4125,13 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     void *pData = nullptr;
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type
+        pfnAlgFloat_multisample = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type
         pfnAlgInt32_multisample = nullptr;
+    // Only the AVX2 line kernels may be run on lines with nodata values.
+    bool bAlgFloatMultisampleIgnoresNoData = false;
+    bool bAlgInt32MultisampleIgnoresNoData = false;
 
     if (eUtilityMode == HILL_SHADE && psOptions->bMultiDirectional)
     {
@@ -3840,6 +4292,26 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         pfnAlgInt32 = GDALRoughnessAlg<GInt32>;
     }
 
+#ifdef HAVE_AVX2_LINE_KERNELS
+    if (CPLHaveRuntimeAVX2() &&
+        CPLTestBool(CPLGetConfigOption("GDAL_USE_AVX2", "YES")))
+    {
+        pfnAlgFloat_multisample = GetAlgMultisampleAVX2<float>(
+            eUtilityMode, psOptions, adfGeoTransform);
+        bAlgFloatMultisampleIgnoresNoData = pfnAlgFloat_multisample != nullptr;
+        // Keep the existing SSE2 kernel, whose results slightly differ
+        // from the per-pixel ones, so that output does not depend on AVX2
+        // availability.
+        if (pfnAlgInt32_multisample == nullptr)
+        {
+            pfnAlgInt32_multisample = GetAlgMultisampleAVX2<GInt32>(
+                eUtilityMode, psOptions, adfGeoTransform);
+            bAlgInt32MultisampleIgnoresNoData =
+                pfnAlgInt32_multisample != nullptr;
+        }
+    }
+#endif
+
     const GDALDataType eDstDataType =
         (eUtilityMode == HILL_SHADE || eUtilityMode == COLOR_RELIEF)
             ? GDT_Byte
@@ -3937,7 +4409,7 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     new GDALGeneric3x3Dataset<GInt32>(
                         hSrcDataset, hSrcBand, eDstDataType, bDstHasNoData,
                         dfDstNoDataValue, pfnAlgInt32, pData,
-                        psOptions->bComputeAtEdges);
+                        psOptions->bComputeAtEdges, nNumThreads);
 
                 if (!(poDS->InitOK()))
                 {
@@ -3954,7 +4426,7 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     new GDALGeneric3x3Dataset<float>(
                         hSrcDataset, hSrcBand, eDstDataType, bDstHasNoData,
                         dfDstNoDataValue, pfnAlgFloat, pData,
-                        psOptions->bComputeAtEdges);
+                        psOptions->bComputeAtEdges, nNumThreads);
 
                 if (!(poDS->InitOK()))
                 {
@@ -4018,14 +4490,18 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         if (eSrcDT == GDT_Byte || eSrcDT == GDT_Int16 || eSrcDT == GDT_UInt16)
         {
             GDALGeneric3x3Processing<GInt32>(
-                hSrcBand, hDstBand, pfnAlgInt32, pfnAlgInt32_multisample, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                hSrcBand, hDstBand, pfnAlgInt32, pfnAlgInt32_multisample,
+                bAlgInt32MultisampleIgnoresNoData, pData,
+                psOptions->bComputeAtEdges, nNumThreads, pfnProgress,
+                pProgressData);
         }
         else
         {
             GDALGeneric3x3Processing<float>(
-                hSrcBand, hDstBand, pfnAlgFloat, nullptr, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                hSrcBand, hDstBand, pfnAlgFloat, pfnAlgFloat_multisample,
+                bAlgFloatMultisampleIgnoresNoData, pData,
+                psOptions->bComputeAtEdges, nNumThreads, pfnProgress,
+                pProgressData);
         }
     }
 
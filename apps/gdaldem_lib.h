@@ -0,0 +1,134 @@
+/******************************************************************************
+ *
+ * Project:  GDAL DEM Utilities
+ * Purpose:  Declarations shared between gdaldem_lib.cpp and its AVX2
+ *           specializations
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALDEM_LIB_H
+#define GDALDEM_LIB_H
+
+#ifndef DOXYGEN_SKIP
+
+#include "cpl_port.h"
+
+namespace gdal::GDALDEM
+{
+enum class GradientAlg
+{
+    HORN,
+    ZEVENBERGEN_THORNE,
+};
+
+enum class TRIAlg
+{
+    WILSON,
+    RILEY,
+};
+}  // namespace gdal::GDALDEM
+
+/************************************************************************/
+/*                         GDALHillshade()                              */
+/************************************************************************/
+
+typedef struct
+{
+    double inv_nsres;
+    double inv_ewres;
+    double sin_altRadians;
+    double cos_alt_mul_z;
+    double azRadians;
+    double cos_az_mul_cos_alt_mul_z;
+    double sin_az_mul_cos_alt_mul_z;
+    double square_z;
+    double sin_altRadians_mul_254;
+    double cos_az_mul_cos_alt_mul_z_mul_254;
+    double sin_az_mul_cos_alt_mul_z_mul_254;
+
+    double square_z_mul_square_inv_res;
+    double cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
+    double sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res;
+    double z_scaled;
+} GDALHillshadeAlgData;
+
+/************************************************************************/
+/*                   GDALHillshadeMultiDirectional()                    */
+/************************************************************************/
+
+typedef struct
+{
+    double inv_nsres;
+    double inv_ewres;
+    double square_z;
+    double sin_altRadians_mul_127;
+    double sin_altRadians_mul_254;
+
+    double cos_alt_mul_z_mul_127;
+    double cos225_az_mul_cos_alt_mul_z_mul_127;
+
+} GDALHillshadeMultiDirectionalAlgData;
+
+/************************************************************************/
+/*                         GDALSlope()                                  */
+/************************************************************************/
+
+typedef struct
+{
+    double nsres;
+    double ewres;
+    double scale;
+    int slopeFormat;
+} GDALSlopeAlgData;
+
+/************************************************************************/
+/*                        AVX2 line kernels                             */
+/************************************************************************/
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+// The below functions have the signature of
+// GDALGeneric3x3ProcessingAlg_multisample<T>::type. They compute the values
+// of the 3x3 windows centered on pixels [1, returned value[ of the line at
+// nLine2Off, processing 8 pixels at a time, and give the same results as
+// their per-pixel counterpart. Nodata values are not taken into account.
+// T is GInt32 or float.
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALHillshadeAlg_multisample_AVX2(const T *pafThreeLineWin, int nLine1Off,
+                                      int nLine2Off, int nLine3Off, int nXSize,
+                                      void *pData, float *pafOutputBuf);
+
+template <class T>
+int GDALHillshadeAlg_same_res_multisample_AVX2(const T *pafThreeLineWin,
+                                               int nLine1Off, int nLine2Off,
+                                               int nLine3Off, int nXSize,
+                                               void *pData,
+                                               float *pafOutputBuf);
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALHillshadeCombinedAlg_multisample_AVX2(const T *pafThreeLineWin,
+                                              int nLine1Off, int nLine2Off,
+                                              int nLine3Off, int nXSize,
+                                              void *pData,
+                                              float *pafOutputBuf);
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALHillshadeMultiDirectionalAlg_multisample_AVX2(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, void *pData, float *pafOutputBuf);
+
+template <class T, gdal::GDALDEM::GradientAlg alg>
+int GDALSlopeAlg_multisample_AVX2(const T *pafThreeLineWin, int nLine1Off,
+                                  int nLine2Off, int nLine3Off, int nXSize,
+                                  void *pData, float *pafOutputBuf);
+
+#endif
+
+#endif  // DOXYGEN_SKIP
+
+#endif  // GDALDEM_LIB_H
@@ -0,0 +1,557 @@
+/******************************************************************************
+ *
+ * Project:  GDAL DEM Utilities
+ * Purpose:  AVX2 line kernels for hillshade and slope computation
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#include "gdaldem_lib.h"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+using namespace gdal::GDALDEM;
+
+// Note: we deliberately avoid inline functions with external linkage here,
+// so that no AVX2 code gets selected by the linker for other translation
+// units. The below kernels must be kept consistent with their per-pixel
+// counterparts of gdaldem_lib.cpp, whose operations they perform in the same
+// order, so that results are identical.
+
+constexpr double kdfRadiansToDegrees = 180.0 / M_PI;
+constexpr double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI * M_PI) / 4);
+
+// Number of pixels processed per iteration.
+constexpr int VEC_SIZE = 8;
+
+namespace
+{
+
+/************************************************************************/
+/*                              AVX2Vec                                 */
+/************************************************************************/
+
+template <class T> struct AVX2Vec;
+
+template <> struct AVX2Vec<GInt32>
+{
+    typedef __m256i V;
+
+    static inline V Load(const GInt32 *p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+
+    static inline V Add(V a, V b)
+    {
+        return _mm256_add_epi32(a, b);
+    }
+
+    static inline V Sub(V a, V b)
+    {
+        return _mm256_sub_epi32(a, b);
+    }
+
+    static inline void ToDouble(V v, __m256d &lo, __m256d &hi)
+    {
+        lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(v));
+        hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1));
+    }
+};
+
+template <> struct AVX2Vec<float>
+{
+    typedef __m256 V;
+
+    static inline V Load(const float *p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    static inline V Add(V a, V b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    static inline V Sub(V a, V b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    static inline void ToDouble(V v, __m256d &lo, __m256d &hi)
+    {
+        lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+    }
+};
+
+/************************************************************************/
+/*                           GradientAVX2                               */
+/************************************************************************/
+
+// Unscaled gradients of the 8 windows whose upper left corners are at
+// l1[0..7], like Gradient<T, alg>::calc() before its multiplication by the
+// inverse resolution.
+template <class T, GradientAlg alg> struct GradientAVX2;
+
+template <class T> struct GradientAVX2<T, GradientAlg::HORN>
+{
+    typedef AVX2Vec<T> Vec;
+    typedef typename Vec::V V;
+
+    static inline void Calc(const T *l1, const T *l2, const T *l3, V &x, V &y)
+    {
+        const V a0 = Vec::Load(l1);
+        const V a1 = Vec::Load(l1 + 1);
+        const V a2 = Vec::Load(l1 + 2);
+        const V a3 = Vec::Load(l2);
+        const V a5 = Vec::Load(l2 + 2);
+        const V a6 = Vec::Load(l3);
+        const V a7 = Vec::Load(l3 + 1);
+        const V a8 = Vec::Load(l3 + 2);
+
+        // (afWin[0] + afWin[3] + afWin[3] + afWin[6]) -
+        // (afWin[2] + afWin[5] + afWin[5] + afWin[8])
+        x = Vec::Sub(Vec::Add(Vec::Add(Vec::Add(a0, a3), a3), a6),
+                     Vec::Add(Vec::Add(Vec::Add(a2, a5), a5), a8));
+        // (afWin[6] + afWin[7] + afWin[7] + afWin[8]) -
+        // (afWin[0] + afWin[1] + afWin[1] + afWin[2])
+        y = Vec::Sub(Vec::Add(Vec::Add(Vec::Add(a6, a7), a7), a8),
+                     Vec::Add(Vec::Add(Vec::Add(a0, a1), a1), a2));
+    }
+};
+
+template <class T> struct GradientAVX2<T, GradientAlg::ZEVENBERGEN_THORNE>
+{
+    typedef AVX2Vec<T> Vec;
+    typedef typename Vec::V V;
+
+    static inline void Calc(const T *l1, const T *l2, const T *l3, V &x, V &y)
+    {
+        // afWin[3] - afWin[5]
+        x = Vec::Sub(Vec::Load(l2), Vec::Load(l2 + 2));
+        // afWin[7] - afWin[1]
+        y = Vec::Sub(Vec::Load(l3 + 1), Vec::Load(l1 + 1));
+    }
+};
+
+/************************************************************************/
+/*                           LoadGradient()                             */
+/************************************************************************/
+
+// Unscaled gradients of the windows centered on pixels [j, j + 8[, as two
+// vectors of 4 doubles each.
+template <class T, GradientAlg alg>
+inline void LoadGradient(const T *pafThreeLineWin, int nLine1Off,
+                         int nLine2Off, int nLine3Off, int j, __m256d adfX[2],
+                         __m256d adfY[2])
+{
+    typename AVX2Vec<T>::V x, y;
+    GradientAVX2<T, alg>::Calc(pafThreeLineWin + nLine1Off + j - 1,
+                               pafThreeLineWin + nLine2Off + j - 1,
+                               pafThreeLineWin + nLine3Off + j - 1, x, y);
+    AVX2Vec<T>::ToDouble(x, adfX[0], adfX[1]);
+    AVX2Vec<T>::ToDouble(y, adfY[0], adfY[1]);
+}
+
+/************************************************************************/
+/*                      ApproxADivByInvSqrtB()                          */
+/************************************************************************/
+
+// Vector version of ApproxADivByInvSqrtB() of gdaldem_lib.cpp
+inline __m256d ApproxADivByInvSqrtB(__m256d a, __m256d b)
+{
+    const __m256d b_half = _mm256_mul_pd(b, _mm256_set1_pd(0.5));
+    // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
+    __m256d r = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(b)));
+    // And perform one step of Newton-Raphson approximation to improve it
+    r = _mm256_mul_pd(
+        r, _mm256_sub_pd(_mm256_set1_pd(1.5),
+                         _mm256_mul_pd(b_half, _mm256_mul_pd(r, r))));
+    return _mm256_mul_pd(a, r);
+}
+
+/************************************************************************/
+/*                          StoreAsFloat()                              */
+/************************************************************************/
+
+inline void StoreAsFloat(float *pafDst, __m256d lo, __m256d hi)
+{
+    _mm256_storeu_ps(pafDst,
+                     _mm256_set_m128(_mm256_cvtpd_ps(hi), _mm256_cvtpd_ps(lo)));
+}
+
+/************************************************************************/
+/*                         HillshadeValue()                             */
+/************************************************************************/
+
+// cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254
+inline __m256d HillshadeValue(__m256d cang_mul_254)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    return _mm256_blendv_pd(
+        _mm256_add_pd(one, cang_mul_254), one,
+        _mm256_cmp_pd(cang_mul_254, _mm256_setzero_pd(), _CMP_LE_OQ));
+}
+
+/************************************************************************/
+/*                          ClampNegative()                             */
+/************************************************************************/
+
+// val <= 0.0 ? 0.0 : val
+inline __m256d ClampNegative(__m256d val)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    return _mm256_blendv_pd(val, zero, _mm256_cmp_pd(val, zero, _CMP_LE_OQ));
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                 GDALHillshadeAlg_multisample_AVX2()                  */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALHillshadeAlg_multisample_AVX2(const T *pafThreeLineWin, int nLine1Off,
+                                      int nLine2Off, int nLine3Off, int nXSize,
+                                      void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m256d inv_ewres = _mm256_set1_pd(psData->inv_ewres);
+    const __m256d inv_nsres = _mm256_set1_pd(psData->inv_nsres);
+    const __m256d sin_altRadians_mul_254 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_254);
+    const __m256d cos_az_mul_cos_alt_mul_z_mul_254 =
+        _mm256_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254);
+    const __m256d sin_az_mul_cos_alt_mul_z_mul_254 =
+        _mm256_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254);
+    const __m256d square_z = _mm256_set1_pd(psData->square_z);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    int j = 1;
+    for (; j + VEC_SIZE < nXSize; j += VEC_SIZE)
+    {
+        __m256d adfX[2], adfY[2], adfRes[2];
+        LoadGradient<T, alg>(pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off,
+                             j, adfX, adfY);
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d x = _mm256_mul_pd(adfX[k], inv_ewres);
+            const __m256d y = _mm256_mul_pd(adfY[k], inv_nsres);
+            const __m256d xx_plus_yy =
+                _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+            const __m256d cang_mul_254 = ApproxADivByInvSqrtB(
+                _mm256_sub_pd(
+                    sin_altRadians_mul_254,
+                    _mm256_sub_pd(
+                        _mm256_mul_pd(y, cos_az_mul_cos_alt_mul_z_mul_254),
+                        _mm256_mul_pd(x, sin_az_mul_cos_alt_mul_z_mul_254))),
+                _mm256_add_pd(one, _mm256_mul_pd(square_z, xx_plus_yy)));
+            adfRes[k] = HillshadeValue(cang_mul_254);
+        }
+        StoreAsFloat(pafOutputBuf + j, adfRes[0], adfRes[1]);
+    }
+    return j;
+}
+
+/************************************************************************/
+/*            GDALHillshadeAlg_same_res_multisample_AVX2()              */
+/************************************************************************/
+
+template <class T>
+int GDALHillshadeAlg_same_res_multisample_AVX2(const T *pafThreeLineWin,
+                                               int nLine1Off, int nLine2Off,
+                                               int nLine3Off, int nXSize,
+                                               void *pData,
+                                               float *pafOutputBuf)
+{
+    typedef AVX2Vec<T> Vec;
+    typedef typename Vec::V V;
+
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m256d sin_altRadians_mul_254 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_254);
+    const __m256d fact_x =
+        _mm256_set1_pd(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d fact_y =
+        _mm256_set1_pd(psData->cos_az_mul_cos_alt_mul_z_mul_254_mul_inv_res);
+    const __m256d square_z_mul_square_inv_res =
+        _mm256_set1_pd(psData->square_z_mul_square_inv_res);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    int j = 1;
+    for (; j + VEC_SIZE < nXSize; j += VEC_SIZE)
+    {
+        const T *l1 = pafThreeLineWin + nLine1Off + j - 1;
+        const T *l2 = pafThreeLineWin + nLine2Off + j - 1;
+        const T *l3 = pafThreeLineWin + nLine3Off + j - 1;
+
+        V accX = Vec::Sub(Vec::Load(l1), Vec::Load(l3 + 2));
+        const V six_minus_two = Vec::Sub(Vec::Load(l3), Vec::Load(l1 + 2));
+        V accY = accX;
+        const V three_minus_five = Vec::Sub(Vec::Load(l2), Vec::Load(l2 + 2));
+        const V one_minus_seven =
+            Vec::Sub(Vec::Load(l1 + 1), Vec::Load(l3 + 1));
+        accX = Vec::Add(accX, three_minus_five);
+        accY = Vec::Add(accY, one_minus_seven);
+        accX = Vec::Add(accX, three_minus_five);
+        accY = Vec::Add(accY, one_minus_seven);
+        accX = Vec::Add(accX, six_minus_two);
+        accY = Vec::Sub(accY, six_minus_two);
+
+        __m256d adfX[2], adfY[2], adfRes[2];
+        Vec::ToDouble(accX, adfX[0], adfX[1]);
+        Vec::ToDouble(accY, adfY[0], adfY[1]);
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d x = adfX[k];
+            const __m256d y = adfY[k];
+            const __m256d xx_plus_yy =
+                _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+            const __m256d cang_mul_254 = ApproxADivByInvSqrtB(
+                _mm256_add_pd(sin_altRadians_mul_254,
+                              _mm256_add_pd(_mm256_mul_pd(x, fact_x),
+                                            _mm256_mul_pd(y, fact_y))),
+                _mm256_add_pd(
+                    one, _mm256_mul_pd(square_z_mul_square_inv_res,
+                                       xx_plus_yy)));
+            adfRes[k] = HillshadeValue(cang_mul_254);
+        }
+        StoreAsFloat(pafOutputBuf + j, adfRes[0], adfRes[1]);
+    }
+    return j;
+}
+
+/************************************************************************/
+/*             GDALHillshadeCombinedAlg_multisample_AVX2()              */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALHillshadeCombinedAlg_multisample_AVX2(const T *pafThreeLineWin,
+                                              int nLine1Off, int nLine2Off,
+                                              int nLine3Off, int nXSize,
+                                              void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeAlgData *psData =
+        static_cast<const GDALHillshadeAlgData *>(pData);
+    const __m256d inv_ewres = _mm256_set1_pd(psData->inv_ewres);
+    const __m256d inv_nsres = _mm256_set1_pd(psData->inv_nsres);
+    const __m256d sin_altRadians = _mm256_set1_pd(psData->sin_altRadians);
+    const __m256d cos_az_mul_cos_alt_mul_z =
+        _mm256_set1_pd(psData->cos_az_mul_cos_alt_mul_z);
+    const __m256d sin_az_mul_cos_alt_mul_z =
+        _mm256_set1_pd(psData->sin_az_mul_cos_alt_mul_z);
+    const __m256d square_z = _mm256_set1_pd(psData->square_z);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    int j = 1;
+    for (; j + VEC_SIZE < nXSize; j += VEC_SIZE)
+    {
+        __m256d adfX[2], adfY[2];
+        LoadGradient<T, alg>(pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off,
+                             j, adfX, adfY);
+        double adfCosAngle[VEC_SIZE];
+        double adfSlope[VEC_SIZE];
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d x = _mm256_mul_pd(adfX[k], inv_ewres);
+            const __m256d y = _mm256_mul_pd(adfY[k], inv_nsres);
+            const __m256d xx_plus_yy =
+                _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+            const __m256d slope = _mm256_mul_pd(xx_plus_yy, square_z);
+            _mm256_storeu_pd(adfSlope + 4 * k, slope);
+            _mm256_storeu_pd(
+                adfCosAngle + 4 * k,
+                ApproxADivByInvSqrtB(
+                    _mm256_sub_pd(
+                        sin_altRadians,
+                        _mm256_sub_pd(
+                            _mm256_mul_pd(y, cos_az_mul_cos_alt_mul_z),
+                            _mm256_mul_pd(x, sin_az_mul_cos_alt_mul_z))),
+                    _mm256_add_pd(one, slope)));
+        }
+
+        // No vectorized acos() and atan()
+        for (int k = 0; k < VEC_SIZE; k++)
+        {
+            double cang = acos(adfCosAngle[k]);
+            // combined shading
+            cang = 1 - cang * atan(sqrt(adfSlope[k])) * INV_SQUARE_OF_HALF_PI;
+            pafOutputBuf[j + k] =
+                cang <= 0.0 ? 1.0f : static_cast<float>(1.0 + (254.0 * cang));
+        }
+    }
+    return j;
+}
+
+/************************************************************************/
+/*         GDALHillshadeMultiDirectionalAlg_multisample_AVX2()          */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALHillshadeMultiDirectionalAlg_multisample_AVX2(
+    const T *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, void *pData, float *pafOutputBuf)
+{
+    const GDALHillshadeMultiDirectionalAlgData *psData =
+        static_cast<const GDALHillshadeMultiDirectionalAlgData *>(pData);
+    const __m256d inv_ewres = _mm256_set1_pd(psData->inv_ewres);
+    const __m256d inv_nsres = _mm256_set1_pd(psData->inv_nsres);
+    const __m256d square_z = _mm256_set1_pd(psData->square_z);
+    const __m256d sin_altRadians_mul_127 =
+        _mm256_set1_pd(psData->sin_altRadians_mul_127);
+    const __m256d cos_alt_mul_z_mul_127 =
+        _mm256_set1_pd(psData->cos_alt_mul_z_mul_127);
+    const __m256d cos225_az_mul_cos_alt_mul_z_mul_127 =
+        _mm256_set1_pd(psData->cos225_az_mul_cos_alt_mul_z_mul_127);
+    const __m256d flat_value =
+        _mm256_set1_pd(1.0 + psData->sin_altRadians_mul_254);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    int j = 1;
+    for (; j + VEC_SIZE < nXSize; j += VEC_SIZE)
+    {
+        __m256d adfX[2], adfY[2], adfRes[2];
+        LoadGradient<T, alg>(pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off,
+                             j, adfX, adfY);
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d x = _mm256_mul_pd(adfX[k], inv_ewres);
+            const __m256d y = _mm256_mul_pd(adfY[k], inv_nsres);
+            const __m256d xx = _mm256_mul_pd(x, x);
+            const __m256d yy = _mm256_mul_pd(y, y);
+            const __m256d xx_plus_yy = _mm256_add_pd(xx, yy);
+
+            // ... then the shade value from different azimuth
+            const __m256d val225_mul_127 = ClampNegative(_mm256_add_pd(
+                sin_altRadians_mul_127,
+                _mm256_mul_pd(_mm256_sub_pd(x, y),
+                              cos225_az_mul_cos_alt_mul_z_mul_127)));
+            const __m256d val270_mul_127 = ClampNegative(
+                _mm256_sub_pd(sin_altRadians_mul_127,
+                              _mm256_mul_pd(x, cos_alt_mul_z_mul_127)));
+            const __m256d val315_mul_127 = ClampNegative(_mm256_add_pd(
+                sin_altRadians_mul_127,
+                _mm256_mul_pd(_mm256_add_pd(x, y),
+                              cos225_az_mul_cos_alt_mul_z_mul_127)));
+            const __m256d val360_mul_127 = ClampNegative(
+                _mm256_sub_pd(sin_altRadians_mul_127,
+                              _mm256_mul_pd(y, cos_alt_mul_z_mul_127)));
+
+            // ... then the weighted shading
+            const __m256d weight_225 = _mm256_sub_pd(
+                _mm256_mul_pd(half, xx_plus_yy), _mm256_mul_pd(x, y));
+            const __m256d weight_270 = xx;
+            const __m256d weight_315 = _mm256_sub_pd(xx_plus_yy, weight_225);
+            const __m256d weight_360 = yy;
+            const __m256d sum = _mm256_add_pd(
+                _mm256_add_pd(
+                    _mm256_add_pd(_mm256_mul_pd(weight_225, val225_mul_127),
+                                  _mm256_mul_pd(weight_270, val270_mul_127)),
+                    _mm256_mul_pd(weight_315, val315_mul_127)),
+                _mm256_mul_pd(weight_360, val360_mul_127));
+            const __m256d cang_mul_127 = ApproxADivByInvSqrtB(
+                _mm256_div_pd(sum, xx_plus_yy),
+                _mm256_add_pd(one, _mm256_mul_pd(square_z, xx_plus_yy)));
+
+            adfRes[k] = _mm256_blendv_pd(
+                _mm256_add_pd(one, cang_mul_127), flat_value,
+                _mm256_cmp_pd(xx_plus_yy, zero, _CMP_EQ_OQ));
+        }
+        StoreAsFloat(pafOutputBuf + j, adfRes[0], adfRes[1]);
+    }
+    return j;
+}
+
+/************************************************************************/
+/*                  GDALSlopeAlg_multisample_AVX2()                     */
+/************************************************************************/
+
+template <class T, GradientAlg alg>
+int GDALSlopeAlg_multisample_AVX2(const T *pafThreeLineWin, int nLine1Off,
+                                  int nLine2Off, int nLine3Off, int nXSize,
+                                  void *pData, float *pafOutputBuf)
+{
+    const GDALSlopeAlgData *psData =
+        static_cast<const GDALSlopeAlgData *>(pData);
+    const __m256d ewres = _mm256_set1_pd(psData->ewres);
+    const __m256d nsres = _mm256_set1_pd(psData->nsres);
+    const __m256d scale_mul_factor = _mm256_set1_pd(
+        (alg == GradientAlg::ZEVENBERGEN_THORNE ? 2 : 8) * psData->scale);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const bool bDegrees = psData->slopeFormat == 1;
+
+    int j = 1;
+    for (; j + VEC_SIZE < nXSize; j += VEC_SIZE)
+    {
+        __m256d adfX[2], adfY[2], adfRes[2];
+        LoadGradient<T, alg>(pafThreeLineWin, nLine1Off, nLine2Off, nLine3Off,
+                             j, adfX, adfY);
+        for (int k = 0; k < 2; k++)
+        {
+            const __m256d dx = _mm256_div_pd(adfX[k], ewres);
+            const __m256d dy = _mm256_div_pd(adfY[k], nsres);
+            const __m256d key =
+                _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+            adfRes[k] = _mm256_div_pd(_mm256_sqrt_pd(key), scale_mul_factor);
+        }
+
+        if (bDegrees)
+        {
+            // No vectorized atan()
+            double adfTanSlope[VEC_SIZE];
+            _mm256_storeu_pd(adfTanSlope, adfRes[0]);
+            _mm256_storeu_pd(adfTanSlope + 4, adfRes[1]);
+            for (int k = 0; k < VEC_SIZE; k++)
+            {
+                pafOutputBuf[j + k] = static_cast<float>(atan(adfTanSlope[k]) *
+                                                         kdfRadiansToDegrees);
+            }
+        }
+        else
+        {
+            StoreAsFloat(pafOutputBuf + j, _mm256_mul_pd(hundred, adfRes[0]),
+                         _mm256_mul_pd(hundred, adfRes[1]));
+        }
+    }
+    return j;
+}
+
+/************************************************************************/
+/*                   Explicit template instantiations                   */
+/************************************************************************/
+
+#define INSTANTIATE_GRADIENT_KERNELS(T, alg)                                   \
+    template int GDALHillshadeAlg_multisample_AVX2<T, alg>(                    \
+        const T *, int, int, int, int, void *, float *);                       \
+    template int GDALHillshadeCombinedAlg_multisample_AVX2<T, alg>(            \
+        const T *, int, int, int, int, void *, float *);                       \
+    template int GDALHillshadeMultiDirectionalAlg_multisample_AVX2<T, alg>(    \
+        const T *, int, int, int, int, void *, float *);                       \
+    template int GDALSlopeAlg_multisample_AVX2<T, alg>(                        \
+        const T *, int, int, int, int, void *, float *);
+
+INSTANTIATE_GRADIENT_KERNELS(GInt32, GradientAlg::HORN)
+INSTANTIATE_GRADIENT_KERNELS(GInt32, GradientAlg::ZEVENBERGEN_THORNE)
+INSTANTIATE_GRADIENT_KERNELS(float, GradientAlg::HORN)
+INSTANTIATE_GRADIENT_KERNELS(float, GradientAlg::ZEVENBERGEN_THORNE)
+
+template int GDALHillshadeAlg_same_res_multisample_AVX2<GInt32>(
+    const GInt32 *, int, int, int, int, void *, float *);
+template int GDALHillshadeAlg_same_res_multisample_AVX2<float>(
+    const float *, int, int, int, int, void *, float *);
+
+#endif
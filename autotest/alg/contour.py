@@ -607,3 +607,73 @@ cellsize     1
             elev_values.append((f["ELEV_MIN"], f["ELEV_MAX"]))
 
         assert elev_values == expected_elev_values, (elev_values, expected_elev_values)
+
+
+###############################################################################
+# Test NUM_THREADS
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+@pytest.mark.parametrize("nodata", [False, True])
+def test_contour_num_threads(polygonize, nodata):
+
+    import math
+
+    xsize = 101
+    ysize = 113
+    values = []
+    for y in range(ysize):
+        for x in range(xsize):
+            if nodata and (x * 7 + y * 13) % 53 == 0:
+                values.append(-9999)
+            else:
+                values.append(
+                    50
+                    + 30 * math.sin(x / 13.0) * math.cos(y / 9.0)
+                    + 20 * math.sin((x + y) / 31.0)
+                )
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("f" * len(values), *values)
+    )
+
+    def _contour(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        geom_type = ogr.wkbMultiPolygon if polygonize else ogr.wkbLineString
+        lyr = ogr_ds.CreateLayer("contour", geom_type=geom_type)
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("ELEV_MIN", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("ELEV_MAX", ogr.OFTReal))
+        options = ["LEVEL_INTERVAL=10", "ID_FIELD=0", "NUM_THREADS=" + num_threads]
+        if nodata:
+            options.append("NODATA=-9999")
+        if polygonize:
+            options += ["ELEV_FIELD_MIN=2", "ELEV_FIELD_MAX=3", "POLYGONIZE=YES"]
+        else:
+            options.append("ELEV_FIELD=1")
+        assert (
+            gdal.ContourGenerateEx(src_ds.GetRasterBand(1), lyr, options=options)
+            == gdal.CE_None
+        )
+
+        # Features are written in a different order, and lines and rings
+        # may start at a different vertex, so compare a summary of them.
+        res = {}
+        for f in lyr:
+            g = f.GetGeometryRef()
+            key = (f["ELEV"], f["ELEV_MIN"], f["ELEV_MAX"])
+            count, measure = res.get(key, (0, 0))
+            if polygonize:
+                res[key] = (count + 1, measure + g.GetArea())
+            else:
+                res[key] = (count + 1, measure + g.Length())
+        return res
+
+    expected = _contour("1")
+    assert len(expected) > 1
+    for num_threads in ("2", "ALL_CPUS"):
+        got = _contour(num_threads)
+        assert got.keys() == expected.keys()
+        for key in expected:
+            assert got[key] == pytest.approx(expected[key], rel=1e-10), key
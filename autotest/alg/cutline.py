@@ -14,6 +14,8 @@
 ###############################################################################
 
 
+import struct
+
 import gdaltest
 import pytest
 
@@ -104,3 +106,41 @@ def test_cutline_4():
 
 
 ###############################################################################
+# Test CUTLINE_BLEND_ALGORITHM=DISTANCE_TRANSFORM
+
+
+def _open_cutline_blend_vrt(blend_algorithm):
+
+    with open("data/cutline_blend.vrt") as f:
+        vrt = f.read()
+    vrt = vrt.replace(
+        '<SourceDataset relativeToVRT="1">../../gcore/data/utmsmall.tif',
+        '<SourceDataset relativeToVRT="0">../gcore/data/utmsmall.tif',
+    )
+    if blend_algorithm:
+        vrt = vrt.replace(
+            "<Cutline>",
+            f'<Option name="CUTLINE_BLEND_ALGORITHM">{blend_algorithm}</Option>'
+            "<Cutline>",
+        )
+    return gdal.Open(vrt)
+
+
+@pytest.mark.require_geos
+def test_cutline_blend_distance_transform():
+
+    ref_ds = _open_cutline_blend_vrt(None)
+    ref_data = struct.unpack("B" * 100 * 100, ref_ds.ReadRaster())
+
+    ds = _open_cutline_blend_vrt("DISTANCE_TRANSFORM")
+    data = struct.unpack("B" * 100 * 100, ds.ReadRaster())
+
+    # Same falloff curve, up to rounding.
+    assert max(abs(a - b) for a, b in zip(ref_data, data)) <= 1
+
+
+def test_cutline_blend_algorithm_invalid():
+
+    ds = _open_cutline_blend_vrt("INVALID")
+    with pytest.raises(Exception, match="CUTLINE_BLEND_ALGORITHM"):
+        ds.GetRasterBand(1).Checksum()
@@ -386,3 +386,106 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Test INTERPOLATION=PYRAMID
+
+
+@pytest.mark.parametrize("num_threads", [None, "2", "ALL_CPUS"])
+def test_fillnodata_pyramid(num_threads):
+
+    ds = gdal.GetDriverByName("MEM").Create("", 3, 3)
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    ds.WriteRaster(0, 0, 3, 3, struct.pack("B" * 9, 20, 30, 40, 50, 0, 60, 70, 80, 90))
+    options = ["INTERPOLATION=PYRAMID"]
+    if num_threads:
+        options.append("NUM_THREADS=" + num_threads)
+    gdal.FillNodata(
+        targetBand=ds.GetRasterBand(1),
+        maxSearchDist=0,
+        maskBand=None,
+        smoothingIterations=0,
+        options=options,
+    )
+    assert struct.unpack("B" * 9, ds.ReadRaster()) == (
+        20,
+        30,
+        40,
+        50,
+        48,
+        60,
+        70,
+        80,
+        90,
+    )
+
+
+def test_fillnodata_pyramid_max_search_dist():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 7, 1)
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    ds.WriteRaster(0, 0, 7, 1, struct.pack("B" * 7, 10, 0, 0, 0, 0, 20, 30))
+    gdal.FillNodata(
+        targetBand=ds.GetRasterBand(1),
+        maxSearchDist=1,
+        maskBand=None,
+        smoothingIterations=0,
+        options=["INTERPOLATION=PYRAMID"],
+    )
+    assert struct.unpack("B" * 7, ds.ReadRaster()) == (10, 11, 0, 0, 18, 20, 30)
+
+
+def test_fillnodata_pyramid_nodata_option():
+
+    # Pixels at the NODATA value are neither interpolated from, nor
+    # modified if valid in the mask.
+    ds = gdal.GetDriverByName("MEM").Create("", 7, 1)
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    ds.WriteRaster(0, 0, 7, 1, struct.pack("B" * 7, 10, 0, 0, 5, 0, 0, 30))
+    gdal.FillNodata(
+        targetBand=ds.GetRasterBand(1),
+        maxSearchDist=100,
+        maskBand=None,
+        smoothingIterations=0,
+        options=["INTERPOLATION=PYRAMID", "NODATA=5"],
+    )
+    assert struct.unpack("B" * 7, ds.ReadRaster()) == (10, 11, 14, 5, 23, 26, 30)
+
+
+def test_fillnodata_pyramid_large_void():
+
+    # Plane with a large void, and a user provided mask.
+    size = 100
+    ds = gdal.GetDriverByName("MEM").Create("", size, size, 1, gdal.GDT_Float32)
+    values = [x + 2 * y for y in range(size) for x in range(size)]
+    mask_ds = gdal.GetDriverByName("MEM").Create("", size, size)
+    mask = [
+        0 if (x - 40) ** 2 + (y - 50) ** 2 < 30**2 else 255
+        for y in range(size)
+        for x in range(size)
+    ]
+    mask_ds.WriteRaster(0, 0, size, size, struct.pack("B" * size * size, *mask))
+    ds.WriteRaster(
+        0,
+        0,
+        size,
+        size,
+        struct.pack(
+            "f" * size * size, *[v if m else -1000 for v, m in zip(values, mask)]
+        ),
+    )
+
+    gdal.FillNodata(
+        targetBand=ds.GetRasterBand(1),
+        maxSearchDist=0,
+        maskBand=mask_ds.GetRasterBand(1),
+        smoothingIterations=2,
+        options=["INTERPOLATION=PYRAMID", "TEMP_FILE_DRIVER=MEM"],
+    )
+    got = struct.unpack("f" * size * size, ds.ReadRaster())
+    for y in range(size):
+        for x in range(size):
+            assert got[y * size + x] == pytest.approx(x + 2 * y, abs=20)
+    # The user provided mask is left untouched.
+    assert struct.unpack("B" * size * size, mask_ds.ReadRaster()) == tuple(mask)
@@ -427,3 +427,82 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that NUM_THREADS gives the same polygons as the single-threaded
+# algorithm, possibly in another order.
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("connectedness8", [False, True])
+@pytest.mark.parametrize("num_threads", ["2", "8", "ALL_CPUS"])
+def test_polygonize_num_threads(is_int_polygonize, connectedness8, num_threads):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTReal))
+        if connectedness8:
+            options = options + ["8CONNECTED=8"]
+        if is_int_polygonize:
+            result = gdal.Polygonize(
+                src_band, src_band.GetMaskBand(), mem_layer, 0, options
+            )
+        else:
+            result = gdal.FPolygonize(
+                src_band, src_band.GetMaskBand(), mem_layer, 0, options
+            )
+        assert result == 0, "Polygonize failed"
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    ref = polygonize([])
+    assert len(ref) > 1
+    assert polygonize(["NUM_THREADS=" + num_threads]) == ref
+
+
+###############################################################################
+# Test NUM_THREADS with polygons spanning many strips, and strips of a single
+# line.
+
+
+@pytest.mark.parametrize("connectedness8", [False, True])
+def test_polygonize_num_threads_spanning_polygons(connectedness8):
+
+    # Concentric square rings, crossed by a diagonal, and nodata pixels.
+    size = 33
+    values = []
+    for y in range(size):
+        for x in range(size):
+            if x == y:
+                values.append(255)
+            else:
+                values.append(max(abs(x - size // 2), abs(y - size // 2)) % 3)
+    src_ds = gdal.GetDriverByName("MEM").Create("", size, size)
+    src_ds.SetGeoTransform([10, 1, 0, 20, 0, -1])
+    src_band = src_ds.GetRasterBand(1)
+    src_band.WriteRaster(0, 0, size, size, struct.pack("B" * len(values), *values))
+    src_band.SetNoDataValue(255)
+
+    def polygonize(options):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        if connectedness8:
+            options = options + ["8CONNECTED=8"]
+        result = gdal.Polygonize(
+            src_band, src_band.GetMaskBand(), mem_layer, 0, options
+        )
+        assert result == 0, "Polygonize failed"
+        return sorted(
+            (f.GetField("DN"), f.GetGeometryRef().ExportToWkt()) for f in mem_layer
+        )
+
+    ref = polygonize([])
+    for num_threads in (2, 3, 64):
+        assert polygonize(["NUM_THREADS=%d" % num_threads]) == ref
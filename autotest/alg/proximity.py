@@ -12,6 +12,8 @@
 ###############################################################################
 
 
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -109,3 +111,90 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EXACT
+
+
+@pytest.mark.parametrize("num_threads", ["1", "3"])
+def test_proximity_exact(num_threads):
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 7, 5)
+    src_ds.SetGeoTransform([0, 2, 0, 0, 0, -2])
+    src_band = src_ds.GetRasterBand(1)
+    src_band.SetNoDataValue(9)
+    src_band.WriteRaster(1, 1, 1, 1, b"\x01")
+    src_band.WriteRaster(6, 4, 1, 1, b"\x02")
+    src_band.WriteRaster(3, 0, 1, 1, b"\x09")
+
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 7, 5, 1, gdal.GDT_Float32)
+    dst_band = dst_ds.GetRasterBand(1)
+
+    gdal.ComputeProximity(
+        src_band,
+        dst_band,
+        options=[
+            "ALGORITHM=EXACT",
+            "NUM_THREADS=" + num_threads,
+            "VALUES=1,2",
+            "DISTUNITS=GEO",
+            "MAXDIST=8",
+            "USE_INPUT_NODATA=YES",
+            "NODATA=-1",
+        ],
+    )
+
+    expected = []
+    for y in range(5):
+        for x in range(7):
+            if (x, y) == (3, 0):
+                expected.append(-1)
+                continue
+            dist = 2 * min(
+                ((x - 1) ** 2 + (y - 1) ** 2) ** 0.5,
+                ((x - 6) ** 2 + (y - 4) ** 2) ** 0.5,
+            )
+            expected.append(dist if dist <= 8 else -1)
+
+    got = struct.unpack("f" * 35, dst_band.ReadRaster())
+    assert got == pytest.approx(expected, rel=1e-6)
+
+
+###############################################################################
+# Test that ALGORITHM=EXACT gives the same result whatever the number of
+# threads and the output data type
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_Int16])
+def test_proximity_exact_num_threads(datatype):
+
+    src_band = gdal.Open("data/pat.tif").GetRasterBand(1)
+
+    checksums = []
+    for num_threads in ("1", "4", "ALL_CPUS"):
+        dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, datatype)
+        gdal.ComputeProximity(
+            src_band,
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=EXACT", "NUM_THREADS=" + num_threads],
+        )
+        checksums.append(dst_ds.GetRasterBand(1).Checksum())
+
+    assert checksums[1] == checksums[0]
+    assert checksums[2] == checksums[0]
+
+
+###############################################################################
+# Test invalid ALGORITHM
+
+
+def test_proximity_invalid_algorithm():
+
+    src_band = gdal.Open("data/pat.tif").GetRasterBand(1)
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25)
+
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM value"):
+        gdal.ComputeProximity(
+            src_band, dst_ds.GetRasterBand(1), options=["ALGORITHM=INVALID"]
+        )
@@ -998,3 +998,201 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Test the scanline polygon filler against known output, for vertices on
+# pixel centers, horizontal edges and several rings
+
+
+@pytest.mark.parametrize(
+    "wkt,options,expected",
+    [
+        pytest.param(
+            "POLYGON ((1.5 1.5,9.5 2.5,7.5 8.5,2.5 6.5,1.5 1.5))",
+            [],
+            [
+                "000000000000",
+                "000000000000",
+                "001111111100",
+                "001111111000",
+                "001111111000",
+                "001111111000",
+                "000111110000",
+                "000001110000",
+                "000000000000",
+                "000000000000",
+            ],
+            id="vertices_on_pixel_centers",
+        ),
+        pytest.param(
+            "POLYGON ((1.5 1.5,9.5 2.5,7.5 8.5,2.5 6.5,1.5 1.5))",
+            ["ALL_TOUCHED=YES"],
+            [
+                "000000000000",
+                "011111000000",
+                "011111111100",
+                "011111111100",
+                "001111111100",
+                "001111111000",
+                "001111111000",
+                "000111111000",
+                "000000110000",
+                "000000000000",
+            ],
+            id="vertices_on_pixel_centers_all_touched",
+        ),
+        pytest.param(
+            "POLYGON ((1.5 1.5,10.5 1.5,10.5 4.5,6.5 4.5,6.5 8.5,1 8.5,1.5 1.5))",
+            [],
+            [
+                "000000000000",
+                "001111111110",
+                "011111111110",
+                "011111111110",
+                "011111100000",
+                "011111100000",
+                "011111100000",
+                "011111100000",
+                "000000000000",
+                "000000000000",
+            ],
+            id="horizontal_edges_on_pixel_centers",
+        ),
+        pytest.param(
+            "POLYGON ((1.5 1.5,10.5 1.5,10.5 4.5,6.5 4.5,6.5 8.5,1 8.5,1.5 1.5))",
+            ["ALL_TOUCHED=YES"],
+            [
+                "000000000000",
+                "011111111110",
+                "011111111110",
+                "011111111110",
+                "011111111110",
+                "011111100000",
+                "011111100000",
+                "011111100000",
+                "011111100000",
+                "000000000000",
+            ],
+            id="horizontal_edges_on_pixel_centers_all_touched",
+        ),
+        pytest.param(
+            "POLYGON ((2 2,10 2,10 5,5 5,5 8,2 8,2 2))",
+            [],
+            [
+                "000000000000",
+                "000000000000",
+                "001111111100",
+                "001111111100",
+                "001111111100",
+                "001110000000",
+                "001110000000",
+                "001110000000",
+                "000000000000",
+                "000000000000",
+            ],
+            id="horizontal_edges_on_pixel_boundaries",
+        ),
+        pytest.param(
+            "POLYGON ((2 2,10 2,10 5,5 5,5 8,2 8,2 2))",
+            ["ALL_TOUCHED=YES"],
+            [
+                "000000000000",
+                "000000000000",
+                "001111111100",
+                "001111111100",
+                "001111111100",
+                "001110000000",
+                "001110000000",
+                "001110000000",
+                "000000000000",
+                "000000000000",
+            ],
+            id="horizontal_edges_on_pixel_boundaries_all_touched",
+        ),
+        pytest.param(
+            "POLYGON ((0.5 0.5,11.5 0.5,11.5 9.5,0.5 9.5,0.5 0.5),(3.5 2.5,8.5 2.5,8.5 7.5,3.5 7.5,3.5 2.5))",
+            [],
+            [
+                "011111111111",
+                "011111111111",
+                "011111111111",
+                "011100000111",
+                "011100000111",
+                "011100000111",
+                "011100000111",
+                "011111111111",
+                "011111111111",
+                "000000000000",
+            ],
+            id="polygon_with_hole",
+        ),
+        pytest.param(
+            "POLYGON ((0.5 0.5,11.5 0.5,11.5 9.5,0.5 9.5,0.5 0.5),(3.5 2.5,8.5 2.5,8.5 7.5,3.5 7.5,3.5 2.5))",
+            ["ALL_TOUCHED=YES"],
+            [
+                "111111111111",
+                "111111111111",
+                "111111111111",
+                "111100001111",
+                "111100001111",
+                "111100001111",
+                "111100001111",
+                "111111111111",
+                "111111111111",
+                "111111111111",
+            ],
+            id="polygon_with_hole_all_touched",
+        ),
+        pytest.param(
+            "MULTIPOLYGON (((0.5 0.5,5.5 0.5,5.5 9.5,0.5 9.5,0.5 0.5),(2 3,4 3,3 7,2 3)),((6.5 1.5,11.5 1.5,9 8.5,6.5 1.5)))",
+            [],
+            [
+                "011111000000",
+                "011111011111",
+                "011111011110",
+                "010011011110",
+                "010011001100",
+                "011111001100",
+                "011111001100",
+                "011111000000",
+                "011111000000",
+                "000000000000",
+            ],
+            id="multipolygon_with_hole",
+        ),
+        pytest.param(
+            "MULTIPOLYGON (((0.5 0.5,5.5 0.5,5.5 9.5,0.5 9.5,0.5 0.5),(2 3,4 3,3 7,2 3)),((6.5 1.5,11.5 1.5,9 8.5,6.5 1.5)))",
+            ["ALL_TOUCHED=YES"],
+            [
+                "111111000000",
+                "111111111111",
+                "111111111111",
+                "111111011110",
+                "111111011110",
+                "111111011110",
+                "111111001100",
+                "111111001100",
+                "111111001100",
+                "111111000000",
+            ],
+            id="multipolygon_with_hole_all_touched",
+        ),
+    ],
+)
+def test_rasterize_polygon_filler_known_output(wkt, options, expected):
+
+    target_ds = gdal.GetDriverByName("MEM").Create("", 12, 10, 1, gdal.GDT_Byte)
+    target_ds.SetGeoTransform((0, 1, 0, 0, 0, 1))
+
+    rast_ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("wrk")
+    rast_mem_lyr = rast_ogr_ds.CreateLayer("poly")
+    feat = ogr.Feature(rast_mem_lyr.GetLayerDefn())
+    feat.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+    rast_mem_lyr.CreateFeature(feat)
+
+    gdal.RasterizeLayer(target_ds, [1], rast_mem_lyr, burn_values=[1], options=options)
+
+    data = target_ds.GetRasterBand(1).ReadRaster()
+    got = ["".join(str(v) for v in data[y * 12 : (y + 1) * 12]) for y in range(10)]
+    assert got == expected
@@ -340,3 +340,45 @@ def test_sieve_all_masked():
     gdal.SieveFilter(src_band, mask_band, src_band, 4, 4)
 
     assert src_band.Checksum() == expected_cs
+
+
+###############################################################################
+# Test that NUM_THREADS gives the same result as the single-threaded
+# algorithm.
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+@pytest.mark.parametrize("num_threads", ["2", "3", "ALL_CPUS"])
+def test_sieve_num_threads(connectedness, use_mask, num_threads):
+
+    drv = gdal.GetDriverByName("MEM")
+    size = 61
+    src_ds = drv.Create("", size, size, 2, gdal.GDT_Byte)
+    # Polygons spanning many lines, and noise to sieve.
+    values = bytes(
+        ((x // 5) + (y // 3) * 2 + (x * y) % 7 // 6) % 4
+        for y in range(size)
+        for x in range(size)
+    )
+    mask = bytes(
+        0 if (x * 31 + y * 17) % 23 == 0 else 255
+        for y in range(size)
+        for x in range(size)
+    )
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, size, size, values)
+    src_ds.GetRasterBand(2).WriteRaster(0, 0, size, size, mask)
+    src_band = src_ds.GetRasterBand(1)
+    mask_band = src_ds.GetRasterBand(2) if use_mask else None
+
+    def sieve(options):
+        dst_ds = drv.Create("", size, size, 1, gdal.GDT_Byte)
+        dst_band = dst_ds.GetRasterBand(1)
+        gdal.SieveFilter(
+            src_band, mask_band, dst_band, 8, connectedness, options=options
+        )
+        return dst_band.ReadRaster()
+
+    ref = sieve([])
+    assert ref != values
+    assert sieve(["NUM_THREADS=" + num_threads]) == ref
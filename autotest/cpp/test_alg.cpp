@@ -11,10 +11,15 @@
  ****************************************************************************/
 
 #include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 #include "gdal_unit_test.h"
 
 #include "cpl_conv.h"
+#include "cpl_string.h"
 
 #include "gdal_alg.h"
 #include "gdalwarper.h"
@@ -504,4 +509,235 @@ TEST_F(test_alg, GDALIsLineOfSightVisible_through_mountain)
                                          nullptr, nullptr, nullptr));
 }
 
+// Test GDALIsLineOfSightVisibleMulti() against GDALIsLineOfSightVisible()
+TEST_F(test_alg, GDALIsLineOfSightVisibleMulti)
+{
+    GDALAllRegister();
+
+    const std::string path = data_ + SEP + "n43.dt0";
+    const auto poDS = GDALDatasetUniquePtr(
+        GDALDataset::FromHandle(GDALOpen(path.c_str(), GA_ReadOnly)));
+    if (!poDS)
+    {
+        GTEST_SKIP() << "Cannot open " << path;
+    }
+    auto pBand = poDS->GetRasterBand(1);
+    ASSERT_TRUE(pBand != nullptr);
+
+    // Pairs between points of a 10 pixel grid, at various heights, so that
+    // vertical, horizontal and oblique rays are all tested.
+    std::vector<int> xA, yA, xB, yB;
+    std::vector<double> zA, zB;
+    for (int y1 = 0; y1 < 121; y1 += 10)
+    {
+        for (int x1 = 0; x1 < 121; x1 += 10)
+        {
+            for (int y2 = 5; y2 < 121; y2 += 20)
+            {
+                for (int x2 = 0; x2 < 121; x2 += 20)
+                {
+                    xA.push_back(x1);
+                    yA.push_back(y1);
+                    zA.push_back(200 + (x1 + y2) % 150);
+                    xB.push_back(x2);
+                    yB.push_back(x2 % 40 == 0 ? y1 : y2);
+                    zB.push_back(200 + (x2 + y1) % 150);
+                }
+            }
+        }
+    }
+    const int nCount = static_cast<int>(xA.size());
+
+    for (const char *pszNumThreads : {"1", "4"})
+    {
+        std::unique_ptr<bool[]> abVisible(new bool[nCount]);
+        std::vector<int> xIntersection(nCount), yIntersection(nCount);
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        ASSERT_EQ(GDALIsLineOfSightVisibleMulti(
+                      pBand, nCount, xA.data(), yA.data(), zA.data(),
+                      xB.data(), yB.data(), zB.data(), abVisible.get(),
+                      xIntersection.data(), yIntersection.data(),
+                      aosOptions.List()),
+                  CE_None);
+        int nVisible = 0;
+        for (int i = 0; i < nCount; ++i)
+        {
+            int xExpected = 0;
+            int yExpected = 0;
+            const bool bExpected = GDALIsLineOfSightVisible(
+                pBand, xA[i], yA[i], zA[i], xB[i], yB[i], zB[i], &xExpected,
+                &yExpected, nullptr);
+            EXPECT_EQ(abVisible[i], bExpected) << i;
+            EXPECT_EQ(xIntersection[i], xExpected) << i;
+            EXPECT_EQ(yIntersection[i], yExpected) << i;
+            nVisible += bExpected ? 1 : 0;
+        }
+        EXPECT_GT(nVisible, 0);
+        EXPECT_LT(nVisible, nCount);
+    }
+
+    // Point outside of the raster
+    {
+        const int xOut = 121;
+        const int y = 0;
+        const double z = 1000;
+        bool bVisible = false;
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        EXPECT_EQ(GDALIsLineOfSightVisibleMulti(pBand, 1, &xOut, &y, &z, &y,
+                                                &y, &z, &bVisible, nullptr,
+                                                nullptr, nullptr),
+                  CE_Failure);
+    }
+}
+
+// Test GDALIsLineOfSightVisibleMulti() on a raster of several DEM tiles, with
+// a tile cache smaller than the number of tiles
+TEST_F(test_alg, GDALIsLineOfSightVisibleMulti_several_tiles)
+{
+    GDALAllRegister();
+
+    constexpr int nXSize = 1000;
+    constexpr int nYSize = 700;
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+    const auto poDS = GDALDatasetUniquePtr(
+        poDriver->Create("", nXSize, nYSize, 1, GDT_Float32, nullptr));
+    ASSERT_TRUE(poDS != nullptr);
+    std::vector<float> afDEM(static_cast<size_t>(nXSize) * nYSize);
+    for (int y = 0; y < nYSize; ++y)
+    {
+        for (int x = 0; x < nXSize; ++x)
+        {
+            afDEM[static_cast<size_t>(y) * nXSize + x] = static_cast<float>(
+                100 + 50 * std::sin(0.013 * x) * std::cos(0.021 * y) +
+                20 * std::sin(0.07 * (x + y)));
+        }
+    }
+    auto pBand = poDS->GetRasterBand(1);
+    ASSERT_EQ(pBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize, afDEM.data(),
+                              nXSize, nYSize, GDT_Float32, 0, 0, nullptr),
+              CE_None);
+
+    // Long rays in all directions, so that they cross several tiles.
+    std::vector<int> xA, yA, xB, yB;
+    std::vector<double> zA, zB;
+    for (int i = 0; i < 2000; ++i)
+    {
+        xA.push_back((i * 37) % nXSize);
+        yA.push_back((i * 91) % nYSize);
+        zA.push_back(150 + i % 60);
+        xB.push_back((i * 53 + 500) % nXSize);
+        yB.push_back((i * 29 + 350) % nYSize);
+        zB.push_back(120 + i % 80);
+    }
+    const int nCount = static_cast<int>(xA.size());
+
+    // The cache then holds 4 tiles per thread, out of the 12 of the raster.
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(1);
+    for (const char *pszNumThreads : {"1", "2"})
+    {
+        std::unique_ptr<bool[]> abVisible(new bool[nCount]);
+        std::vector<int> xIntersection(nCount), yIntersection(nCount);
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        EXPECT_EQ(GDALIsLineOfSightVisibleMulti(
+                      pBand, nCount, xA.data(), yA.data(), zA.data(),
+                      xB.data(), yB.data(), zB.data(), abVisible.get(),
+                      xIntersection.data(), yIntersection.data(),
+                      aosOptions.List()),
+                  CE_None);
+        int nVisible = 0;
+        for (int i = 0; i < nCount; ++i)
+        {
+            int xExpected = 0;
+            int yExpected = 0;
+            const bool bExpected = GDALIsLineOfSightVisible(
+                pBand, xA[i], yA[i], zA[i], xB[i], yB[i], zB[i], &xExpected,
+                &yExpected, nullptr);
+            EXPECT_EQ(abVisible[i], bExpected) << i;
+            EXPECT_EQ(xIntersection[i], xExpected) << i;
+            EXPECT_EQ(yIntersection[i], yExpected) << i;
+            nVisible += bExpected ? 1 : 0;
+        }
+        EXPECT_GT(nVisible, 0);
+        EXPECT_LT(nVisible, nCount);
+    }
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test that GDALIsLineOfSightVisibleMulti() reports DEM read errors
+TEST_F(test_alg, GDALIsLineOfSightVisibleMulti_read_error)
+{
+    // A flat DEM of 512x256 pixels whose right block cannot be read.
+    class FailingBand : public GDALRasterBand
+    {
+      protected:
+        CPLErr IReadBlock(int nBlockXOff, int, void *pImage) override
+        {
+            if (nBlockXOff == 1)
+            {
+                CPLError(CE_Failure, CPLE_FileIO, "Cannot read block");
+                return CE_Failure;
+            }
+            memset(pImage, 0, sizeof(double) * nBlockXSize * nBlockYSize);
+            return CE_None;
+        }
+
+      public:
+        FailingBand()
+        {
+            nRasterXSize = 512;
+            nRasterYSize = 256;
+            nBlockXSize = 256;
+            nBlockYSize = 256;
+            eDataType = GDT_Float64;
+        }
+    };
+
+    class FailingDataset : public GDALDataset
+    {
+      public:
+        FailingDataset()
+        {
+            nRasterXSize = 512;
+            nRasterYSize = 256;
+            SetBand(1, new FailingBand());
+        }
+    };
+
+    FailingDataset oDS;
+    auto pBand = oDS.GetRasterBand(1);
+    const int xA = 10;
+    const int y = 10;
+    const double z = 100;
+
+    {
+        const int xB = 200;
+        bool bVisible = false;
+        EXPECT_EQ(GDALIsLineOfSightVisibleMulti(pBand, 1, &xA, &y, &z, &xB,
+                                                &y, &z, &bVisible, nullptr,
+                                                nullptr, nullptr),
+                  CE_None);
+        EXPECT_TRUE(bVisible);
+    }
+
+    for (const char *pszNumThreads : {"1", "2"})
+    {
+        const int xB = 400;
+        bool bVisible = false;
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS", pszNumThreads);
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        EXPECT_EQ(GDALIsLineOfSightVisibleMulti(pBand, 1, &xA, &y, &z, &xB,
+                                                &y, &z, &bVisible, nullptr,
+                                                nullptr, aosOptions.List()),
+                  CE_Failure);
+    }
+}
+
 }  // namespace
@@ -4823,6 +4823,39 @@ TEST_F(test_cpl, CPLWorkerThreadPool_recursion)
     ASSERT_EQ(ctxt.nCounter, 3 * 3);
 }
 
+// Test CPLWorkerThreadPool with jobs submitted from worker threads, that
+// must be dispatched to the other worker threads by work stealing.
+TEST_F(test_cpl, CPLWorkerThreadPool_work_stealing)
+{
+    CPLWorkerThreadPool oPool;
+    ASSERT_TRUE(oPool.Setup(4, nullptr, nullptr, true));
+
+    std::atomic<int> nCounter{0};
+    const auto job = [&nCounter, &oPool]()
+    {
+        auto poQueue = oPool.CreateJobQueue();
+        for (int i = 0; i < 10; ++i)
+        {
+            poQueue->SubmitJob([&nCounter]() { nCounter++; });
+        }
+        poQueue->WaitCompletion();
+        nCounter++;
+    };
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(oPool.SubmitJob(job));
+    }
+    oPool.WaitCompletion();
+    EXPECT_EQ(nCounter, 100 * 11);
+
+    const auto sStats = oPool.GetStatistics();
+    EXPECT_EQ(sStats.nQueueDepth, 0);
+    EXPECT_GE(sStats.nMaxQueueDepth, 1);
+    EXPECT_GE(sStats.nJobsExecuted, 100U);
+    EXPECT_LE(sStats.nJobsExecuted, 100U * 11);
+    EXPECT_GE(sStats.dfIdleTime, 0.0);
+}
+
 // Test /vsimem/ PRead() implementation
 TEST_F(test_cpl, vsimem_pread)
 {
@@ -20,6 +20,7 @@
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
 
+#include <cstring>
 #include <limits>
 #include <string>
 
@@ -5010,6 +5011,259 @@ TEST_F(test_gdal, GDALComputeRasterMinMaxLocation_with_mask)
     EXPECT_EQ(nMaxY, 0);
 }
 
+// Test GDALComputeRasterMinMaxAndHistogram
+TEST_F(test_gdal, GDALComputeRasterMinMaxAndHistogram)
+{
+    GDALDatasetH hSrcDS = GDALOpen(GCORE_DATA_DIR "byte.tif", GA_ReadOnly);
+    ASSERT_NE(hSrcDS, nullptr);
+    // Work on a MEM copy, so that no .aux.xml file is written
+    GDALDatasetH hDS = GDALCreateCopy(GDALGetDriverByName("MEM"), "", hSrcDS,
+                                      false, nullptr, nullptr, nullptr);
+    GDALClose(hSrcDS);
+    ASSERT_NE(hDS, nullptr);
+    GDALRasterBandH hBand = GDALGetRasterBand(hDS, 1);
+    {
+        constexpr int nBuckets = 10;
+        double dfMin = 0;
+        double dfMax = 0;
+        std::vector<GUIntBig> anHistogram(nBuckets);
+        EXPECT_EQ(GDALComputeRasterMinMaxAndHistogram(hBand, &dfMin, &dfMax,
+                                                      nBuckets,
+                                                      anHistogram.data(),
+                                                      nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(dfMin, 74.0);
+        EXPECT_EQ(dfMax, 255.0);
+        std::vector<GUIntBig> anExpectedHistogram(nBuckets);
+        EXPECT_EQ(GDALGetRasterHistogramEx(hBand, dfMin, dfMax, nBuckets,
+                                           anExpectedHistogram.data(), TRUE,
+                                           FALSE, nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(anHistogram, anExpectedHistogram);
+    }
+    GDALClose(hDS);
+}
+
+// Test GDALRasterBand::ComputeRasterMinMaxAndHistogram() on various data types
+TEST_F(test_gdal, GDALComputeRasterMinMaxAndHistogram_data_types)
+{
+    for (GDALDataType eDT :
+         {GDT_Byte, GDT_Int8, GDT_UInt16, GDT_Int16, GDT_Int32, GDT_Float32,
+          GDT_Float64})
+    {
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+                ->Create("", 7, 5, 1, eDT, nullptr));
+        auto poBand = poDS->GetRasterBand(1);
+        std::vector<double> adfValues;
+        for (int i = 0; i < 7 * 5; ++i)
+            adfValues.push_back((i * 37) % 101);
+        EXPECT_EQ(poBand->RasterIO(GF_Write, 0, 0, 7, 5, adfValues.data(), 7,
+                                   5, GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+        poBand->SetNoDataValue(0);
+
+        double dfMin = 0;
+        double dfMax = 0;
+        std::vector<GUIntBig> anHistogram(7);
+        EXPECT_EQ(poBand->ComputeRasterMinMaxAndHistogram(
+                      &dfMin, &dfMax, static_cast<int>(anHistogram.size()),
+                      anHistogram.data(), nullptr, nullptr),
+                  CE_None)
+            << GDALGetDataTypeName(eDT);
+        double dfExpectedMin = std::numeric_limits<double>::infinity();
+        double dfExpectedMax = -std::numeric_limits<double>::infinity();
+        for (double dfVal : adfValues)
+        {
+            if (dfVal != 0)
+            {
+                dfExpectedMin = std::min(dfExpectedMin, dfVal);
+                dfExpectedMax = std::max(dfExpectedMax, dfVal);
+            }
+        }
+        EXPECT_EQ(dfMin, dfExpectedMin) << GDALGetDataTypeName(eDT);
+        EXPECT_EQ(dfMax, dfExpectedMax) << GDALGetDataTypeName(eDT);
+        std::vector<GUIntBig> anExpectedHistogram(anHistogram.size());
+        for (double dfVal : adfValues)
+        {
+            if (dfVal == 0)
+                continue;
+            const int iBucket = std::min(
+                static_cast<int>(anHistogram.size()) - 1,
+                static_cast<int>(std::floor((dfVal - dfExpectedMin) * 7 /
+                                            (dfExpectedMax - dfExpectedMin))));
+            ++anExpectedHistogram[iBucket];
+        }
+        EXPECT_EQ(anHistogram, anExpectedHistogram)
+            << GDALGetDataTypeName(eDT);
+    }
+}
+
+// Test GDALRasterBand::ComputeRasterMinMaxAndHistogram() edge cases
+TEST_F(test_gdal, GDALComputeRasterMinMaxAndHistogram_edge_cases)
+{
+    for (GDALDataType eDT : {GDT_Int16, GDT_Float32})
+    {
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+                ->Create("", 3, 2, 1, eDT, nullptr));
+        auto poBand = poDS->GetRasterBand(1);
+        EXPECT_EQ(poBand->Fill(5), CE_None);
+
+        // Single valid value
+        double dfMin = 0;
+        double dfMax = 0;
+        std::array<GUIntBig, 3> anHistogram = {1, 1, 1};
+        EXPECT_EQ(poBand->ComputeRasterMinMaxAndHistogram(
+                      &dfMin, &dfMax, static_cast<int>(anHistogram.size()),
+                      anHistogram.data(), nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(dfMin, 5);
+        EXPECT_EQ(dfMax, 5);
+        EXPECT_EQ(anHistogram[0], 6U);
+        EXPECT_EQ(anHistogram[1], 0U);
+        EXPECT_EQ(anHistogram[2], 0U);
+
+        // No valid value
+        poBand->SetNoDataValue(5);
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        EXPECT_EQ(poBand->ComputeRasterMinMaxAndHistogram(
+                      &dfMin, &dfMax, static_cast<int>(anHistogram.size()),
+                      anHistogram.data(), nullptr, nullptr),
+                  CE_Failure);
+
+        // Invalid number of buckets
+        EXPECT_EQ(poBand->ComputeRasterMinMaxAndHistogram(
+                      &dfMin, &dfMax, 0, anHistogram.data(), nullptr, nullptr),
+                  CE_Failure);
+    }
+}
+
+// Test GDALDataset::Prefetch()
+TEST_F(test_gdal, GDALDataset_Prefetch)
+{
+    auto poDrv = GDALDriver::FromHandle(GDALGetDriverByName("GTiff"));
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    // Not a multiple of the block size, to test partial blocks
+    constexpr int XSIZE = 250;
+    constexpr int YSIZE = 130;
+    constexpr int BAND_COUNT = 2;
+    const char *pszFilename = "/vsimem/test_gdal_prefetch.tif";
+    std::vector<GUInt16> anData(static_cast<size_t>(XSIZE) * YSIZE *
+                                BAND_COUNT);
+    for (size_t i = 0; i < anData.size(); ++i)
+        anData[i] = static_cast<GUInt16>((i * 37) % 65521);
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "64");
+        aosOptions.SetNameValue("BLOCKYSIZE", "32");
+        aosOptions.SetNameValue("INTERLEAVE", "BAND");
+        GDALDatasetUniquePtr poDS(poDrv->Create(pszFilename, XSIZE, YSIZE,
+                                                BAND_COUNT, GDT_UInt16,
+                                                aosOptions.List()));
+        ASSERT_TRUE(poDS != nullptr);
+        ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, XSIZE, YSIZE, anData.data(),
+                                 XSIZE, YSIZE, GDT_UInt16, BAND_COUNT, nullptr,
+                                 0, 0, 0, nullptr),
+                  CE_None);
+
+        // Not supported in update mode
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        const int anWindow[] = {0, 0, XSIZE, YSIZE};
+        EXPECT_EQ(poDS->Prefetch(1, anWindow, BAND_COUNT, nullptr, nullptr),
+                  CE_Failure);
+    }
+
+    const auto ReadAll = [](GDALDataset *poDS)
+    {
+        std::vector<GUInt16> anRead(static_cast<size_t>(XSIZE) * YSIZE *
+                                    BAND_COUNT);
+        EXPECT_EQ(poDS->RasterIO(GF_Read, 0, 0, XSIZE, YSIZE, anRead.data(),
+                                 XSIZE, YSIZE, GDT_UInt16, BAND_COUNT, nullptr,
+                                 0, 0, 0, nullptr),
+                  CE_None);
+        return anRead;
+    };
+
+    {
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_TRUE(poDS != nullptr);
+
+        {
+            CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+            const int anWindow[] = {0, 0, XSIZE + 1, YSIZE};
+            EXPECT_EQ(
+                poDS->Prefetch(1, anWindow, BAND_COUNT, nullptr, nullptr),
+                CE_Failure);
+            const int nBand = BAND_COUNT + 1;
+            EXPECT_EQ(poDS->Prefetch(1, anWindow, 1, &nBand, nullptr),
+                      CE_Failure);
+        }
+
+        const int anWindows[] = {0,   0,  100,         40,
+                                 100, 40, XSIZE - 100, YSIZE - 40};
+        const char *const apszOptions[] = {"NUM_THREADS=2", nullptr};
+        EXPECT_EQ(poDS->Prefetch(2, anWindows, BAND_COUNT, nullptr,
+                                 apszOptions),
+                  CE_None);
+        EXPECT_EQ(ReadAll(poDS.get()), anData);
+    }
+
+    // Memory limit lower than the size of a block: nothing is prefetched
+    {
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_TRUE(poDS != nullptr);
+        const int anWindow[] = {0, 0, XSIZE, YSIZE};
+        const char *const apszOptions[] = {"MAX_MEMORY=1KB", nullptr};
+        EXPECT_EQ(poDS->Prefetch(1, anWindow, BAND_COUNT, nullptr,
+                                 apszOptions),
+                  CE_None);
+        EXPECT_EQ(ReadAll(poDS.get()), anData);
+    }
+
+    // Cancellation with blocks not consumed, and prefetching through
+    // AdviseRead()
+    {
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_TRUE(poDS != nullptr);
+        const int anWindow[] = {0, 0, XSIZE, YSIZE};
+        const int nBand = 2;
+        EXPECT_EQ(poDS->Prefetch(1, anWindow, 1, &nBand, nullptr), CE_None);
+        GUInt16 nVal = 0;
+        EXPECT_EQ(poDS->GetRasterBand(2)->RasterIO(GF_Read, 0, 0, 1, 1, &nVal,
+                                                   1, 1, GDT_UInt16, 0, 0,
+                                                   nullptr),
+                  CE_None);
+        EXPECT_EQ(nVal, anData[static_cast<size_t>(XSIZE) * YSIZE]);
+        poDS->CancelPrefetch();
+
+        const char *const apszOptions[] = {"PREFETCH=YES", nullptr};
+        EXPECT_EQ(poDS->AdviseRead(0, 0, XSIZE, YSIZE, XSIZE, YSIZE,
+                                   GDT_UInt16, BAND_COUNT, nullptr,
+                                   const_cast<char **>(apszOptions)),
+                  CE_None);
+        EXPECT_EQ(ReadAll(poDS.get()), anData);
+    }
+
+    // Not supported on in-memory datasets
+    {
+        GDALDatasetUniquePtr poDS(
+            GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+                ->Create("", 10, 10, 1, GDT_Byte, nullptr));
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        const int anWindow[] = {0, 0, 10, 10};
+        EXPECT_EQ(poDS->Prefetch(1, anWindow, 1, nullptr, nullptr),
+                  CE_Failure);
+    }
+
+    VSIUnlink(pszFilename);
+}
+
 TEST_F(test_gdal, GDALTranspose2D)
 {
     constexpr int COUNT = 6;
@@ -5251,4 +5505,104 @@ TEST_F(test_gdal, GDALExpandPackedBitsToByteAt0Or255)
     EXPECT_EQ(out, expectedOut);
 }
 
+// Test that the single pass generation of overview levels is only used when
+// the overview bands have the data type of the source bands, and gives the
+// same result as the level-by-level generation
+TEST_F(test_gdal, GDALRegenerateOverviewsMultiBand_single_pass_data_type)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 300;
+    constexpr int nYSize = 280;
+    std::vector<float> afSrc(nXSize * nYSize);
+    for (int i = 0; i < nXSize * nYSize; ++i)
+    {
+        afSrc[i] = static_cast<float>((i * 7 + (i / nXSize) * 13) % 251) +
+                   0.37f * static_cast<float>(i % 3);
+    }
+
+    struct DebugMessages
+    {
+        bool bSinglePass = false;
+
+        static void CPL_STDCALL Handler(CPLErr eErr, CPLErrorNum,
+                                        const char *pszMsg)
+        {
+            auto psThis =
+                static_cast<DebugMessages *>(CPLGetErrorHandlerUserData());
+            if (eErr == CE_Debug && strstr(pszMsg, "single pass"))
+                psThis->bSinglePass = true;
+        }
+    };
+
+    // Returns the values of all the overview levels
+    const auto Regenerate = [&](GDALDataType eOvrDT, const char *pszSinglePass,
+                                bool &bSinglePass)
+    {
+        auto poSrcDS = std::unique_ptr<GDALDataset>(
+            poDrv->Create("", nXSize, nYSize, 1, GDT_Float32, nullptr));
+        EXPECT_EQ(poSrcDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, nXSize, nYSize, afSrc.data(), nXSize,
+                      nYSize, GDT_Float32, 0, 0, nullptr),
+                  CE_None);
+        std::vector<std::unique_ptr<GDALDataset>> apoOvrDS;
+        std::vector<GDALRasterBand *> apoOvrBands;
+        int nOvrXSize = nXSize;
+        int nOvrYSize = nYSize;
+        for (int i = 0; i < 3; ++i)
+        {
+            nOvrXSize = DIV_ROUND_UP(nOvrXSize, 2);
+            nOvrYSize = DIV_ROUND_UP(nOvrYSize, 2);
+            apoOvrDS.emplace_back(
+                poDrv->Create("", nOvrXSize, nOvrYSize, 1, eOvrDT, nullptr));
+            apoOvrBands.push_back(apoOvrDS.back()->GetRasterBand(1));
+        }
+
+        DebugMessages oMessages;
+        {
+            CPLConfigOptionSetter oSinglePass("GDAL_OVR_SINGLE_PASS",
+                                              pszSinglePass, false);
+            CPLConfigOptionSetter oDebug("CPL_DEBUG", "ON", false);
+            CPLErrorHandlerPusher oPusher(DebugMessages::Handler, &oMessages);
+            CPLSetCurrentErrorHandlerCatchDebug(true);
+            EXPECT_EQ(GDALRegenerateOverviewsMultiBand(
+                          {poSrcDS->GetRasterBand(1)}, {apoOvrBands},
+                          "AVERAGE", nullptr, nullptr, nullptr),
+                      CE_None);
+        }
+        bSinglePass = oMessages.bSinglePass;
+
+        std::vector<double> adfValues;
+        for (auto poOvrBand : apoOvrBands)
+        {
+            std::vector<double> adfLevel(static_cast<size_t>(
+                                             poOvrBand->GetXSize()) *
+                                         poOvrBand->GetYSize());
+            EXPECT_EQ(poOvrBand->RasterIO(
+                          GF_Read, 0, 0, poOvrBand->GetXSize(),
+                          poOvrBand->GetYSize(), adfLevel.data(),
+                          poOvrBand->GetXSize(), poOvrBand->GetYSize(),
+                          GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+            adfValues.insert(adfValues.end(), adfLevel.begin(),
+                             adfLevel.end());
+        }
+        return adfValues;
+    };
+
+    for (GDALDataType eOvrDT : {GDT_Float32, GDT_Byte})
+    {
+        bool bSinglePass = false;
+        const auto adfExpected = Regenerate(eOvrDT, "NO", bSinglePass);
+        EXPECT_FALSE(bSinglePass);
+        const auto adfGot = Regenerate(eOvrDT, "YES", bSinglePass);
+        EXPECT_EQ(bSinglePass, eOvrDT == GDT_Float32);
+        EXPECT_EQ(adfGot, adfExpected) << GDALGetDataTypeName(eOvrDT);
+    }
+}
+
 }  // namespace
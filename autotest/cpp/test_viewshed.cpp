@@ -11,12 +11,15 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 #include "gdal_unit_test.h"
 
 #include "gtest_include.h"
 
+#include "viewshed/cumulative.h"
 #include "viewshed/viewshed.h"
 
 namespace gdal
@@ -479,5 +482,83 @@ TEST(Viewshed, oor_below)
     }
 }
 
+// Test cumulative mode with a maximum distance on a raster larger than the
+// block cache.
+TEST(Viewshed, cumulative_max_distance_small_cache)
+{
+    GDALDriver *driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!driver)
+        GTEST_SKIP() << "GTiff driver missing";
+
+    // 480 KB of Float32, 960 KB once read as Float64.
+    const int xlen = 400;
+    const int ylen = 300;
+    const std::string srcFilename = "/vsimem/viewshed_cumulative_in.tif";
+    {
+        DatasetPtr ds(driver->Create(srcFilename.c_str(), xlen, ylen, 1,
+                                     GDT_Float32, nullptr));
+        ASSERT_TRUE(ds);
+        ds->SetGeoTransform(identity.data());
+        std::vector<float> in(static_cast<size_t>(xlen) * ylen);
+        for (int y = 0; y < ylen; ++y)
+            for (int x = 0; x < xlen; ++x)
+                in[static_cast<size_t>(y) * xlen + x] = static_cast<float>(
+                    30 * std::sin(x * 0.05) * std::cos(y * 0.04) +
+                    10 * std::sin((x + 2 * y) * 0.013));
+        ASSERT_EQ(ds->GetRasterBand(1)->RasterIO(GF_Write, 0, 0, xlen, ylen,
+                                                 in.data(), xlen, ylen,
+                                                 GDT_Float32, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    auto run = [&](double maxDistance, GIntBig cacheMax)
+    {
+        Options opts = stdOptions(0, 0);
+        opts.outputMode = OutputMode::Cumulative;
+        opts.outputFormat = "GTiff";
+        opts.outputFilename = "/vsimem/viewshed_cumulative_out.tif";
+        opts.observer.z = 5;
+        opts.observerSpacing = 40;
+        opts.maxDistance = maxDistance;
+
+        const GIntBig oldCacheMax = GDALGetCacheMax64();
+        GDALSetCacheMax64(cacheMax);
+        Cumulative cumulative(opts);
+        EXPECT_TRUE(cumulative.run(srcFilename));
+        GDALSetCacheMax64(oldCacheMax);
+
+        std::vector<uint8_t> out(static_cast<size_t>(xlen) * ylen);
+        DatasetPtr ds(GDALDataset::Open(opts.outputFilename.c_str()));
+        EXPECT_TRUE(ds);
+        if (ds)
+        {
+            EXPECT_EQ(ds->GetRasterBand(1)->RasterIO(
+                          GF_Read, 0, 0, xlen, ylen, out.data(), xlen, ylen,
+                          GDT_Byte, 0, 0, nullptr),
+                      CE_None);
+        }
+        ds.reset();
+        VSIUnlink(opts.outputFilename.c_str());
+        return out;
+    };
+
+    // With a maximum distance of 40, the batches then have 2 x 2 observers.
+    constexpr GIntBig SMALL_CACHE = 256 * 1024;
+
+    // A maximum distance larger than the raster gives the same result as the
+    // in-memory cumulative mode.
+    const std::vector<uint8_t> ref = run(0, SMALL_CACHE);
+    EXPECT_EQ(run(1000, SMALL_CACHE), ref);
+
+    // The result doesn't depend on the number of batches.
+    const std::vector<uint8_t> out = run(40, SMALL_CACHE);
+    EXPECT_NE(out, ref);
+    EXPECT_NE(std::count(out.begin(), out.end(), 0),
+              static_cast<std::ptrdiff_t>(out.size()));
+    EXPECT_EQ(run(40, 100 * 1024 * 1024), out);
+
+    VSIUnlink(srcFilename.c_str());
+}
+
 }  // namespace viewshed
 }  // namespace gdal
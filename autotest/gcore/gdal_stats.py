@@ -925,3 +925,121 @@ def test_stats_mask_band():
     assert src_ds.GetRasterBand(1).ComputeRasterMinMax(False) == (2, 3)
     assert src_ds.GetRasterBand(1).ComputeStatistics(False) == [2, 3, 2.5, 0.5]
     assert src_ds.GetRasterBand(1).GetHistogram(False) == [0, 0, 1, 1] + ([0] * 252)
+
+
+###############################################################################
+# Test that multi-threaded statistics and min/max computation give the same
+# results as the single-threaded code path
+
+
+@pytest.mark.parametrize(
+    "datatype,nodata",
+    [
+        (gdal.GDT_Byte, None),
+        (gdal.GDT_Byte, 7),
+        (gdal.GDT_UInt16, 7),
+        (gdal.GDT_Int16, None),
+        (gdal.GDT_Float32, 7),
+        (gdal.GDT_Float64, None),
+    ],
+)
+@pytest.mark.parametrize("approx_ok", [False, True])
+def test_stats_multithreaded(tmp_vsimem, datatype, nodata, approx_ok):
+
+    filename = str(tmp_vsimem / "test_stats_multithreaded.tif")
+    src_ds = gdal.GetDriverByName("MEM").Create("", 1000, 1000, 1, datatype)
+    values = [(i * 37) % 251 for i in range(100 * 100)]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0,
+        0,
+        1000,
+        1000,
+        struct.pack("d" * len(values), *values),
+        buf_type=gdal.GDT_Float64,
+        buf_xsize=100,
+        buf_ysize=100,
+    )
+    if nodata is not None:
+        src_ds.GetRasterBand(1).SetNoDataValue(nodata)
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename, src_ds, options=["TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64"]
+    )
+
+    for ds in (src_ds, gdal.Open(filename)):
+        band = ds.GetRasterBand(1)
+        ref_stats = band.ComputeStatistics(approx_ok)
+        ref_minmax = band.ComputeRasterMinMax(approx_ok)
+        with gdal.config_option("GDAL_NUM_THREADS", "4"):
+            stats = band.ComputeStatistics(approx_ok)
+            minmax = band.ComputeRasterMinMax(approx_ok)
+        assert stats == pytest.approx(ref_stats, rel=1e-12)
+        assert minmax == ref_minmax
+
+
+###############################################################################
+# Test that multi-threaded statistics computation takes into account the
+# mask band
+
+
+def test_stats_multithreaded_mask_band():
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", 100, 100, 1, gdal.GDT_Int16)
+    src_ds.GetRasterBand(1).Fill(10)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, 1, 1, struct.pack("h", 1))
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    mask_band = src_ds.GetRasterBand(1).GetMaskBand()
+    mask_band.Fill(255)
+    mask_band.WriteRaster(0, 0, 1, 1, struct.pack("B", 0))
+    with gdal.config_option("GDAL_NUM_THREADS", "4"):
+        assert src_ds.GetRasterBand(1).ComputeRasterMinMax(False) == (10, 10)
+        assert src_ds.GetRasterBand(1).ComputeStatistics(False) == [10, 10, 10, 0]
+
+
+###############################################################################
+# Test statistics of Int16, Int32, Float32 and Float64 bands with nodata
+# values and NaN, with widths exercising both the vectorized code paths and
+# their scalar tails.
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_type,nodata",
+    [
+        (gdal.GDT_Int16, "h", None),
+        (gdal.GDT_Int16, "h", -32768),
+        (gdal.GDT_Int32, "i", None),
+        (gdal.GDT_Int32, "i", -2000000000),
+        (gdal.GDT_Float32, "f", None),
+        (gdal.GDT_Float32, "f", -3.4028234663852886e38),
+        (gdal.GDT_Float64, "d", None),
+        (gdal.GDT_Float64, "d", -1e300),
+    ],
+)
+@pytest.mark.parametrize("width", [1, 7, 37, 1000])
+def test_stats_nodata_and_nan(datatype, struct_type, nodata, width):
+
+    height = 13
+    values = []
+    for i in range(width * height):
+        if nodata is not None and (i % 11) == 3:
+            values.append(nodata)
+        elif struct_type in ("f", "d") and (i % 13) == 5:
+            values.append(float("nan"))
+        else:
+            values.append(((i * 7919) % 20011) - 10000)
+
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, width, height, struct.pack(struct_type * len(values), *values)
+    )
+    if nodata is not None:
+        ds.GetRasterBand(1).SetNoDataValue(nodata)
+
+    valid = [v for v in values if v != nodata and not math.isnan(v)]
+    mean = sum(valid) / len(valid)
+    stddev = math.sqrt(sum((v - mean) ** 2 for v in valid) / len(valid))
+
+    stats = ds.GetRasterBand(1).ComputeStatistics(False)
+    assert stats[0] == min(valid)
+    assert stats[1] == max(valid)
+    assert stats[2] == pytest.approx(mean, rel=1e-12, abs=1e-12)
+    assert stats[3] == pytest.approx(stddev, rel=1e-10)
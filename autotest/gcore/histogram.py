@@ -743,3 +743,69 @@ def test_histogram_invalid_min_max(min, max):
         else:
             ret == [0, 0]
             assert gdal.GetLastErrorMsg() != ""
+
+
+###############################################################################
+# Test that multi-threaded histogram computation gives the same results as
+# the single-threaded code path
+
+
+@pytest.mark.parametrize(
+    "datatype,nodata",
+    [
+        (gdal.GDT_Byte, None),
+        (gdal.GDT_Byte, 7),
+        (gdal.GDT_UInt16, 7),
+        (gdal.GDT_Int16, None),
+        (gdal.GDT_Int32, 7),
+        (gdal.GDT_UInt32, None),
+        (gdal.GDT_Float32, 7),
+        (gdal.GDT_Float64, None),
+    ],
+)
+@pytest.mark.parametrize("approx_ok", [False, True])
+@pytest.mark.parametrize("include_out_of_range", [False, True])
+def test_histogram_multithreaded(datatype, nodata, approx_ok, include_out_of_range):
+
+    values = [(i * 37) % 251 for i in range(100 * 100)]
+
+    # Histograms are cached by PAM, so use a new dataset for each computation
+    def get_histogram(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 1000, 1000, 1, datatype)
+        band = ds.GetRasterBand(1)
+        band.WriteRaster(
+            0,
+            0,
+            1000,
+            1000,
+            struct.pack("d" * len(values), *values),
+            buf_type=gdal.GDT_Float64,
+            buf_xsize=100,
+            buf_ysize=100,
+        )
+        if nodata is not None:
+            band.SetNoDataValue(nodata)
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            return band.GetHistogram(
+                min=-10.5,
+                max=240.5,
+                buckets=50,
+                include_out_of_range=include_out_of_range,
+                approx_ok=approx_ok,
+            )
+
+    hist = get_histogram("4")
+    assert hist == get_histogram("1")
+
+    if not approx_ok:
+        expected_hist = [0] * 50
+        for v in values:
+            if v == nodata:
+                continue
+            idx = math.floor((v + 10.5) * (50 / 251.0))
+            if idx >= 50:
+                if not include_out_of_range:
+                    continue
+                idx = 49
+            expected_hist[idx] += 100
+        assert hist == expected_hist
@@ -3301,6 +3301,65 @@ def test_rasterio_constant_value(resample_alg, dt, struct_type, val):
     )
 
 
+###############################################################################
+# Test that bilinear and cubic resampling of Float32 and UInt16 bands without
+# mask, which uses a dedicated separable code path, gives the same results as
+# the generic code path, used when the band has a nodata value.
+
+
+@pytest.mark.parametrize("resample_alg", [gdal.GRIORA_Bilinear, gdal.GRIORA_Cubic])
+@pytest.mark.parametrize(
+    "dt,struct_type,nodata",
+    [(gdal.GDT_UInt16, "H", 65535), (gdal.GDT_Float32, "f", -1e30)],
+)
+def test_rasterio_resampled_separable(resample_alg, dt, struct_type, nodata):
+
+    width = 53
+    height = 41
+    values = [
+        (x * 37 + y * 101) % 1000 + (x * y) % 7
+        for y in range(height)
+        for x in range(width)
+    ]
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, dt)
+    ds.WriteRaster(
+        0, 0, width, height, struct.pack(struct_type * (width * height), *values)
+    )
+    ref_ds = gdal.GetDriverByName("MEM").CreateCopy("", ds)
+    ref_ds.GetRasterBand(1).SetNoDataValue(nodata)
+
+    for xoff, yoff, xsize, ysize, buf_xsize, buf_ysize in [
+        (0, 0, width, height, 26, 20),
+        (0, 0, width, height, 100, 90),
+        (0, 0, width, height, 7, 5),
+        (3, 5, 40, 30, 17, 11),
+        (10, 7, 21, 13, 63, 26),
+        (26, 20, 26, 20, 13, 10),
+    ]:
+        for buf_type in (dt, gdal.GDT_Float64):
+            got = ds.GetRasterBand(1).ReadRaster(
+                xoff,
+                yoff,
+                xsize,
+                ysize,
+                buf_xsize,
+                buf_ysize,
+                buf_type=buf_type,
+                resample_alg=resample_alg,
+            )
+            expected = ref_ds.GetRasterBand(1).ReadRaster(
+                xoff,
+                yoff,
+                xsize,
+                ysize,
+                buf_xsize,
+                buf_ysize,
+                buf_type=buf_type,
+                resample_alg=resample_alg,
+            )
+            assert got == expected, (xoff, yoff, xsize, ysize, buf_xsize, buf_ysize)
+
+
 ###############################################################################
 # Test RasterIO() overview selection logic
 
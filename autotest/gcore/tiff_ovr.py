@@ -3031,3 +3031,59 @@ def test_tiff_ovr_internal_mask_issue_11555(tmp_vsimem):
         ds.GetRasterBand(1).GetMaskBand().GetOverview(0).ReadRaster(0, 5271, 1, 1)
         == b"\x00"
     )
+
+
+###############################################################################
+# Test that generating several overview levels in a single pass gives the
+# same result as the level-by-level generation
+
+
+@pytest.mark.parametrize("resampling", ["NEAREST", "AVERAGE", "MODE", "CUBIC"])
+@pytest.mark.parametrize("external", [True, False])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_tiff_ovr_single_pass(tmp_vsimem, resampling, external, nodata):
+
+    checksums = {}
+    for single_pass in ("NO", "YES"):
+        tmpfilename = str(tmp_vsimem / f"test_{single_pass}.tif")
+        ds = gdal.Translate(
+            tmpfilename,
+            "data/stefan_full_rgba.tif",
+            bandList=[1, 2, 3],
+            creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+            noData=nodata,
+        )
+        if external:
+            ds = None
+            ds = gdal.Open(tmpfilename)
+        debug_msgs = []
+
+        def handler(err_class, err_no, msg):
+            if err_class == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        with gdaltest.config_options(
+            {
+                "GDAL_OVR_SINGLE_PASS": single_pass,
+                "COMPRESS_OVERVIEW": "LZW",
+                "INTERLEAVE_OVERVIEW": "PIXEL",
+                "CPL_DEBUG": "ON",
+            }
+        ), gdaltest.error_handler(handler):
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ds = None
+
+        # Check that the single pass generation was actually used
+        single_pass_used = any("in a single pass" in msg for msg in debug_msgs)
+        assert single_pass_used == (single_pass == "YES")
+
+        ds = gdal.Open(tmpfilename)
+        checksums[single_pass] = [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+            for i in range(3)
+            for j in range(4)
+        ]
+        ds = None
+
+    assert checksums["YES"] == checksums["NO"]
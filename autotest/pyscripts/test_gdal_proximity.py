@@ -143,3 +143,31 @@ def test_gdal_proximity_3(script_path, tmp_path):
     dst_ds = None
 
     assert cs == cs_expected, "got wrong checksum"
+
+
+###############################################################################
+# Try exact algorithm
+
+
+def test_gdal_proximity_exact(script_path, tmp_path):
+
+    output_tif = str(tmp_path / "proximity_exact.tif")
+
+    test_py_scripts.run_py_script(
+        script_path,
+        "gdal_proximity",
+        "-q -algorithm EXACT -num_threads 2 -values 65,64 "
+        + test_py_scripts.get_data_path("alg")
+        + f"pat.tif {output_tif}",
+    )
+
+    src_ds = gdal.Open(test_py_scripts.get_data_path("alg") + "pat.tif")
+    ref_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Float32)
+    gdal.ComputeProximity(
+        src_ds.GetRasterBand(1),
+        ref_ds.GetRasterBand(1),
+        options=["ALGORITHM=EXACT", "VALUES=65,64"],
+    )
+
+    dst_ds = gdal.Open(output_tif)
+    assert dst_ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
@@ -1120,3 +1120,141 @@ def test_gdal_grid_lib_errors():
             algorithm="invdist",
             SQLStatement="invalid",
         )
+
+
+###############################################################################
+# Test that the bucket grid point index gives the same results as the quadtree
+
+
+@pytest.mark.require_driver("CSV")
+@pytest.mark.parametrize(
+    "alg",
+    [
+        "invdistnn:radius=150:max_points=8",
+        "invdistnn:radius=150:min_points_per_quadrant=1",
+        "average:radius1=150:radius2=150",
+        "average:radius1=150:radius2=150:max_points_per_quadrant=2",
+        "nearest:radius1=100:radius2=100",
+        "minimum:radius1=150:radius2=150",
+        "maximum:radius1=150:radius2=150",
+        "range:radius1=150:radius2=150",
+        "count:radius1=150:radius2=150",
+        "average_distance:radius1=150:radius2=150",
+    ],
+)
+@pytest.mark.parametrize("num_threads", ["1", "ALL_CPUS"])
+def test_gdal_grid_lib_point_index_grid(alg, num_threads):
+    def grid(point_index):
+        with gdal.config_options(
+            {
+                "GDAL_GRID_POINT_COUNT_THRESHOLD": "0",
+                "GDAL_GRID_POINT_INDEX": point_index,
+                "GDAL_NUM_THREADS": num_threads,
+            }
+        ):
+            return gdal.Grid(
+                "",
+                "../utilities/data/grid.vrt",
+                format="MEM",
+                outputBounds=[440720.0, 3750120.0, 441920.0, 3751320.0],
+                width=40,
+                height=40,
+                outputType=gdal.GDT_Float64,
+                layers=["grid"],
+                algorithm=alg,
+            )
+
+    ds_ref = grid("QUADTREE")
+    ds = grid("GRID")
+    assert ds.ReadRaster() == ds_ref.ReadRaster()
+
+
+###############################################################################
+# Test scatter mode
+
+
+@pytest.mark.require_driver("CSV")
+@pytest.mark.parametrize(
+    "alg",
+    [
+        "average:radius1=150:radius2=100:min_points=2:nodata=-1",
+        "count:radius1=150:radius2=150",
+        "count:radius1=150:radius2=80:angle=30:min_points=3:nodata=-1",
+        "minimum:radius1=150:radius2=150:nodata=-1",
+        "maximum:radius1=150:radius2=150:nodata=-1",
+        "range:radius1=150:radius2=150:nodata=-1",
+    ],
+)
+@pytest.mark.parametrize("num_threads", ["1", "ALL_CPUS"])
+def test_gdal_grid_lib_scatter(alg, num_threads):
+    def grid(scatter):
+        with gdal.config_options(
+            {
+                # Brute force search, so that the points are visited in the
+                # same order, and averages are identical
+                "GDAL_GRID_POINT_COUNT_THRESHOLD": "1000000000",
+                "GDAL_NUM_THREADS": num_threads,
+            }
+        ):
+            return gdal.Grid(
+                "",
+                "../utilities/data/grid.vrt",
+                format="MEM",
+                outputBounds=[440720.0, 3750120.0, 441920.0, 3751320.0],
+                width=40,
+                height=30,
+                outputType=gdal.GDT_Float64,
+                layers=["grid"],
+                algorithm=alg,
+                scatter=scatter,
+            )
+
+    ds_ref = grid(False)
+    ds = grid(True)
+    assert ds.GetGeoTransform() == ds_ref.GetGeoTransform()
+    assert ds.ReadRaster() == ds_ref.ReadRaster()
+
+
+def test_gdal_grid_lib_scatter_errors():
+
+    mem_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = mem_ds.CreateLayer("test")
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(0 0 100)"))
+    lyr.CreateFeature(f)
+
+    with pytest.raises(Exception, match="Scatter mode is only supported"):
+        gdal.Grid(
+            "",
+            mem_ds,
+            width=3,
+            height=3,
+            outputBounds=[-0.25, -0.25, 1.25, 1.25],
+            format="MEM",
+            algorithm="invdist",
+            scatter=True,
+        )
+
+    with pytest.raises(Exception, match="strictly positive radius1 and radius2"):
+        gdal.Grid(
+            "",
+            mem_ds,
+            width=3,
+            height=3,
+            outputBounds=[-0.25, -0.25, 1.25, 1.25],
+            format="MEM",
+            algorithm="count",
+            scatter=True,
+        )
+
+    with pytest.raises(Exception, match="Per-quadrant parameters"):
+        gdal.Grid(
+            "",
+            mem_ds,
+            width=3,
+            height=3,
+            outputBounds=[-0.25, -0.25, 1.25, 1.25],
+            format="MEM",
+            algorithm="count:radius1=1:radius2=1:min_points_per_quadrant=1",
+            scatter=True,
+        )
@@ -761,6 +761,62 @@ def test_gdal_rasterize_lib_too_small_resolution():
         gdal.Rasterize("", vector_ds, format="MEM", xRes=1, yRes=1e-20)
 
 
+###############################################################################
+# Test -num_threads
+
+
+@pytest.mark.parametrize("all_touched", [False, True])
+@pytest.mark.parametrize("add", [False, True])
+def test_gdal_rasterize_lib_num_threads(all_touched, add):
+
+    vector_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0)
+    layer = vector_ds.CreateLayer("layer")
+    layer.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+
+    for i in range(200):
+        x = (i * 37) % 97
+        y = (i * 53) % 89
+        r = 1 + i % 7
+        if i % 3 == 0:
+            x2, y2 = x + 2 * r, y + 2 * r
+            wkt = f"POLYGON (({x} {y},{x2} {y + 0.5},{x + r} {y2},{x} {y}))"
+        elif i % 3 == 1:
+            wkt = f"LINESTRING ({x} {y},{x + 3 * r} {y + r})"
+        else:
+            wkt = f"MULTIPOINT ({x} {y},{x + r} {y - r})"
+        feature = ogr.Feature(layer.GetLayerDefn())
+        feature.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        feature["val"] = 1 + i % 11
+        layer.CreateFeature(feature)
+
+    def rasterize(options):
+        return gdal.Rasterize(
+            "",
+            vector_ds,
+            format="MEM",
+            outputType=gdal.GDT_Float32,
+            attribute="val",
+            outputBounds=[-10, -10, 110, 110],
+            width=120,
+            height=130,
+            allTouched=all_touched,
+            add=add,
+            options=options,
+        )
+
+    ref_ds = rasterize("-optim RASTER -chunkysize 7")
+    assert ref_ds.GetRasterBand(1).ComputeRasterMinMax()[1] > 0
+    ref = ref_ds.ReadRaster()
+    for num_threads in ["2", "3", "ALL_CPUS"]:
+        ds = rasterize(f"-num_threads {num_threads} -chunkysize 7")
+        assert ds.ReadRaster() == ref, num_threads
+    ds = rasterize("-num_threads 4")
+    assert ds.GetRasterBand(1).Checksum() == ref_ds.GetRasterBand(1).Checksum()
+
+    with pytest.raises(Exception, match="Invalid value for -num_threads"):
+        rasterize("-num_threads 0")
+
+
 ###############################################################################
 # Test option argument handling
 
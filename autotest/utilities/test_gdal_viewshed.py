@@ -227,6 +227,41 @@ def test_gdal_viewshed_cumulative(gdal_viewshed_path, tmp_path, viewshed_input):
     assert nodata == 0
 
 
+###############################################################################
+# Test cumulative mode with a maximum distance, processed by tiles.
+
+
+def test_gdal_viewshed_cumulative_max_distance(
+    gdal_viewshed_path, tmp_path, viewshed_input
+):
+
+    np = pytest.importorskip("numpy")
+    pytest.importorskip("osgeo.gdal_array")
+
+    def run(options):
+        viewshed_out = str(tmp_path / "test_gdal_viewshed_out.tif")
+        _, err = gdaltest.runexternal_out_and_err(
+            gdal_viewshed_path
+            + " -om ACCUM -f GTiff -os 20 {} {} {}".format(
+                options, viewshed_input, viewshed_out
+            )
+        )
+        assert err is None or err == ""
+        ds = gdal.Open(viewshed_out)
+        assert ds
+        return ds.GetRasterBand(1).ReadAsArray()
+
+    # A maximum distance larger than the raster gives the same result.
+    ref = run("")
+    assert np.array_equal(run("-md 1e9"), ref)
+
+    # The result doesn't depend on the size of the tiles.
+    out = run("-md 10000")
+    assert np.count_nonzero(out) > 0
+    assert not np.array_equal(out, ref)
+    assert np.array_equal(run("-md 10000 --config GDAL_CACHEMAX 100000"), out)
+
+
 ###############################################################################
 
 
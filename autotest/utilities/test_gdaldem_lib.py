@@ -782,3 +782,142 @@ def test_gdaldem_lib_dict_arguments():
     ind = opt.index("-co")
 
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
+
+
+###############################################################################
+# Test that multithreaded computation gives the same result as the single
+# threaded one
+
+
+@pytest.mark.parametrize(
+    "processing", ["hillshade", "slope", "aspect", "TRI", "TPI", "roughness"]
+)
+@pytest.mark.parametrize("computeEdges", [False, True])
+@pytest.mark.parametrize("format", ["MEM", "AAIGrid"])
+def test_gdaldem_lib_num_threads(tmp_vsimem, processing, computeEdges, format):
+
+    if gdal.GetDriverByName(format) is None:
+        pytest.skip(f"{format} driver not available")
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=gdal.GDT_Float32
+    )
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(10, 20, 3, 2, struct.pack("f" * 6, *([0] * 6)))
+
+    checksums = []
+    for numThreads in (1, 4, "ALL_CPUS"):
+        # AAIGrid only supports CreateCopy(), hence this tests the on-the-fly
+        # computation done through an intermediate dataset.
+        ds = gdal.DEMProcessing(
+            "" if format == "MEM" else tmp_vsimem / "out.asc",
+            src_ds,
+            processing,
+            format=format,
+            computeEdges=computeEdges,
+            numThreads=numThreads,
+        )
+        checksums.append(ds.GetRasterBand(1).Checksum())
+        ds = None
+
+    assert checksums[1] == checksums[0]
+    assert checksums[2] == checksums[0]
+
+
+def test_gdaldem_lib_num_threads_invalid():
+
+    with pytest.raises(Exception, match="Invalid value for -num_threads"):
+        gdal.DEMProcessing(
+            "",
+            gdal.Open("../gdrivers/data/n43.tif"),
+            "hillshade",
+            format="MEM",
+            numThreads=0,
+        )
+
+
+###############################################################################
+# Test that the AVX2 line kernels give the same result as the per-pixel code
+
+
+@pytest.mark.parametrize(
+    "processing,options",
+    [
+        ("hillshade", {}),
+        ("hillshade", {"combined": True}),
+        ("hillshade", {"multiDirectional": True}),
+        ("slope", {}),
+        ("slope", {"slopeFormat": "percent"}),
+    ],
+)
+@pytest.mark.parametrize("alg", ["Horn", "ZevenbergenThorne"])
+@pytest.mark.parametrize(
+    "datatype,nsres",
+    [
+        (gdal.GDT_Int16, -7.5),
+        (gdal.GDT_Float32, -7.5),
+        # Same resolution in both directions
+        (gdal.GDT_Float32, -10),
+    ],
+)
+@pytest.mark.parametrize("computeEdges", [False, True])
+def test_gdaldem_lib_avx2(processing, options, alg, datatype, nsres, computeEdges):
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=datatype
+    )
+    src_ds.SetGeoTransform([0, 10, 0, 0, 0, nsres])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        10, 20, 3, 2, struct.pack("f" * 6, *([0] * 6)), buf_type=gdal.GDT_Float32
+    )
+
+    def compute():
+        ds = gdal.DEMProcessing(
+            "",
+            src_ds,
+            processing,
+            format="MEM",
+            alg=alg,
+            computeEdges=computeEdges,
+            **options,
+        )
+        return ds.GetRasterBand(1).ReadRaster()
+
+    with gdal.config_option("GDAL_USE_AVX2", "NO"):
+        expected = compute()
+    assert compute() == expected
+
+
+###############################################################################
+# Test that the lines of an Int16 raster with the same resolution in both
+# directions whose 3x3 window contains nodata are computed by the per-pixel
+# code, and not by the SSE2 kernel
+
+
+def test_gdaldem_lib_hillshade_same_res_int16_nodata():
+
+    src_ds = gdal.Translate(
+        "", "../gdrivers/data/n43.tif", format="MEM", outputType=gdal.GDT_Int16
+    )
+    src_ds.SetGeoTransform([0, 10, 0, 0, 0, -10])
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        10, 20, 3, 2, struct.pack("h" * 6, *([0] * 6))
+    )
+    xsize = src_ds.RasterXSize
+
+    ds = gdal.DEMProcessing("", src_ds, "hillshade", format="MEM")
+
+    # Same values as Float32, which only uses the per-pixel code when AVX2
+    # is disabled
+    float_ds = gdal.Translate(
+        "", src_ds, format="MEM", outputType=gdal.GDT_Float32
+    )
+    with gdal.config_option("GDAL_USE_AVX2", "NO"):
+        ref_ds = gdal.DEMProcessing("", float_ds, "hillshade", format="MEM")
+
+    # Lines 19 to 22 have nodata in their 3x3 window
+    assert ds.ReadRaster(0, 19, xsize, 4) == ref_ds.ReadRaster(0, 19, xsize, 4)
+    for y in range(19, 23):
+        assert struct.unpack("B" * 5, ds.ReadRaster(9, y, 5, 1)) == (0,) * 5
@@ -4414,3 +4414,41 @@ def test_gdalwarp_lib_init_dest_no_source_window_mem():
     assert ds.GetRasterBand(1).GetNoDataValue() == 255
     ds.GetRasterBand(1).SetNoDataValue(0)
     assert ds.GetRasterBand(1).ComputeRasterMinMax() == (255, 255)
+
+
+###############################################################################
+# Test that the pipelined chunk processing of -multi gives the same result
+# as the sequential one, with many chunks.
+
+
+@pytest.mark.parametrize("dst_alpha", [False, True])
+@pytest.mark.parametrize("init_dest", [None, "0"])
+def test_gdalwarp_lib_multi_many_chunks(tmp_vsimem, dst_alpha, init_dest):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", width=400, height=500
+    )
+
+    def warp(multithread):
+        out_filename = tmp_vsimem / f"out_{multithread}.tif"
+        ds = gdal.GetDriverByName("GTiff").Create(
+            out_filename, 300, 350, 2 if dst_alpha else 1
+        )
+        ds.SetGeoTransform((440720, 80, 0, 3751320, 0, -70))
+        ds.SetProjection(src_ds.GetProjection())
+        ds.GetRasterBand(1).Fill(7)
+        ds = None
+        warpOptions = {"INIT_DEST": init_dest} if init_dest else {}
+        gdal.Warp(
+            out_filename,
+            src_ds,
+            multithread=multithread,
+            warpMemoryLimit=100000,
+            dstAlpha=dst_alpha,
+            resampleAlg="cubic",
+            warpOptions=warpOptions,
+        )
+        ds = gdal.Open(out_filename)
+        return [ds.GetRasterBand(i + 1).Checksum() for i in range(ds.RasterCount)]
+
+    assert warp(True) == warp(False)
@@ -1270,6 +1270,13 @@ CPLErr CPL_DLL CPL_STDCALL GDALDatasetAdviseRead(
     int nBXSize, int nBYSize, GDALDataType eBDataType, int nBandCount,
     int *panBandCount, CSLConstList papszOptions);
 
+CPLErr CPL_DLL GDALDatasetPrefetch(GDALDatasetH hDS, int nWindowCount,
+                                   const int *panWindows, int nBandCount,
+                                   const int *panBandList,
+                                   CSLConstList papszOptions);
+
+void CPL_DLL GDALDatasetCancelPrefetch(GDALDatasetH hDS);
+
 char CPL_DLL **
 GDALDatasetGetCompressionFormats(GDALDatasetH hDS, int nXOff, int nYOff,
                                  int nXSize, int nYSize, int nBandCount,
@@ -1688,6 +1695,9 @@ CPLErr CPL_DLL CPL_STDCALL GDALGetRasterHistogramEx(
     GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
     GUIntBig *panHistogram, int bIncludeOutOfRange, int bApproxOK,
     GDALProgressFunc pfnProgress, void *pProgressData);
+CPLErr CPL_DLL GDALComputeRasterMinMaxAndHistogram(
+    GDALRasterBandH hBand, double *pdfMin, double *pdfMax, int nBuckets,
+    GUIntBig *panHistogram, GDALProgressFunc pfnProgress, void *pProgressData);
 CPLErr CPL_DLL CPL_STDCALL
 GDALGetDefaultHistogram(GDALRasterBandH hBand, double *pdfMin, double *pdfMax,
                         int *pnBuckets, int **ppanHistogram, int bForce,
@@ -618,6 +618,7 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     virtual bool CanBeCloned(int nScopeFlags, bool bCanShareState) const;
 
     friend class GDALThreadSafeDataset;
+    friend class GDALDatasetPrefetcher;
     friend class MEMDataset;
     virtual std::unique_ptr<GDALDataset> Clone(int nScopeFlags,
                                                bool bCanShareState) const;
@@ -634,6 +635,9 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     friend class GDALRasterBand;
 
+    bool TakePrefetchedBlock(GDALRasterBand *poBand, int nXBlockOff,
+                             int nYBlockOff, void *pData);
+
     // The below methods related to read write mutex are fragile logic, and
     // should not be used by out-of-tree code if possible.
     int EnterReadWrite(GDALRWFlag eRWFlag);
@@ -757,6 +761,10 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                               int nBandCount, int *panBandList,
                               char **papszOptions);
 
+    CPLErr Prefetch(int nWindowCount, const int *panWindows, int nBandCount,
+                    const int *panBandList, CSLConstList papszOptions);
+    void CancelPrefetch();
+
     virtual CPLErr CreateMaskBand(int nFlagsIn);
 
     virtual GDALAsyncReader *
@@ -1880,6 +1888,11 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                                 GUIntBig *panHistogram, int bIncludeOutOfRange,
                                 int bApproxOK, GDALProgressFunc,
                                 void *pProgressData);
+    CPLErr ComputeRasterMinMaxAndHistogram(double *pdfMin, double *pdfMax,
+                                           int nBuckets,
+                                           GUIntBig *panHistogram,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData);
 
     virtual CPLErr GetDefaultHistogram(double *pdfMin, double *pdfMax,
                                        int *pnBuckets, GUIntBig **ppanHistogram,
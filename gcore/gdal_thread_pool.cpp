@@ -12,6 +12,10 @@
 
 #include "gdal_thread_pool.h"
 
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <cstdlib>
 #include <mutex>
 
 // For unclear reasons, attempts at making this a std::unique_ptr<>, even
@@ -52,3 +56,20 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/** Return the number of threads configured with the GDAL_NUM_THREADS
+ * configuration option (an integer value or ALL_CPUS), clamped to
+ * [1, nMaxVal].
+ *
+ * @param nMaxVal Maximum number of threads.
+ * @param bDefaultToAllCPUs Whether to use ALL_CPUS when GDAL_NUM_THREADS is
+ *                          not set, instead of 1.
+ */
+int GDALGetNumThreads(int nMaxVal, bool bDefaultToAllCPUs)
+{
+    const char *pszThreads = CPLGetConfigOption(
+        "GDAL_NUM_THREADS", bDefaultToAllCPUs ? "ALL_CPUS" : "1");
+    const int nThreads =
+        EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszThreads);
+    return std::max(1, std::min(nMaxVal, nThreads));
+}
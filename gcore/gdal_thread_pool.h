@@ -19,4 +19,7 @@ CPLWorkerThreadPool CPL_DLL *GDALGetGlobalThreadPool(int nThreads);
 
 void GDALDestroyGlobalThreadPool();
 
+int CPL_DLL GDALGetNumThreads(int nMaxVal = 128,
+                              bool bDefaultToAllCPUs = false);
+
 #endif  // GDAL_THREAD_POOL_H
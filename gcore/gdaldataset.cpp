@@ -37,6 +37,7 @@
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
 #include "gdal_alg.h"
+#include "gdalprefetcher.h"
 #include "ogr_api.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -114,6 +115,8 @@ class GDALDataset::Private
     std::vector<int>
         m_anBandMap{};  // used by RasterIO(). Values are 1, 2, etc.
 
+    std::unique_ptr<GDALDatasetPrefetcher> m_poPrefetcher{};
+
     Private() = default;
 };
 
@@ -279,6 +282,10 @@ GDALDataset::GDALDataset(int bForceCachedIOIn)
 GDALDataset::~GDALDataset()
 
 {
+    // Stop background reads before anything is torn down.
+    if (m_poPrivate)
+        m_poPrivate->m_poPrefetcher.reset();
+
     // we don't want to report destruction of datasets that
     // were never really open or meant as internal
     if (!bIsInternal && (nBands != 0 || !EQUAL(GetDescription(), "")))
@@ -3051,7 +3058,10 @@ int CPL_STDCALL GDALGetAccess(GDALDatasetH hDS)
  * nBandCount bands.
  *
  * @param papszOptions a list of name=value strings with special control
- * options.  Normally this is NULL.
+ * options.  Normally this is NULL. Starting with GDAL 3.11, PREFETCH=YES
+ * may be specified so that, for drivers that do not override AdviseRead(),
+ * the region is read asynchronously with Prefetch() when it is requested at
+ * full resolution. Other options are passed to Prefetch().
  *
  * @return CE_Failure if the request is invalid and CE_None if it works or
  * is ignored.
@@ -3073,6 +3083,15 @@ CPLErr GDALDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
     if (eErr != CE_None || bStopProcessing)
         return eErr;
 
+    if (nBufXSize == nXSize && nBufYSize == nYSize &&
+        CPLFetchBool(papszOptions, "PREFETCH", false))
+    {
+        const int anWindow[] = {nXOff, nYOff, nXSize, nYSize};
+        eErr = Prefetch(1, anWindow, nBandCount, panBandMap, papszOptions);
+        if (eErr != CE_None)
+            return eErr;
+    }
+
     for (int iBand = 0; iBand < nBandCount; ++iBand)
     {
         GDALRasterBand *poBand = nullptr;
@@ -3118,6 +3137,192 @@ CPLErr CPL_STDCALL GDALDatasetAdviseRead(GDALDatasetH hDS, int nXOff, int nYOff,
         panBandMap, const_cast<char **>(papszOptions));
 }
 
+/************************************************************************/
+/*                              Prefetch()                              */
+/************************************************************************/
+
+/**
+ * \brief Asynchronously read blocks of the dataset in the background.
+ *
+ * The blocks intersecting the specified windows are read, in order, by
+ * threads of the GDAL global thread pool, from a re-opened instance of the
+ * dataset. When a later RasterIO() or GDALRasterBand::GetLockedBlockRef()
+ * call needs one of them, it is taken from the prefetched data instead of
+ * being decoded again, or waited for if it is being read. This makes it
+ * possible to overlap the reading of the next window with the processing of
+ * the current one, for any driver with a block layout.
+ *
+ * Successive calls add windows to the queue of blocks to read. Blocks that
+ * are already in the block cache, or already queued, are skipped.
+ * CancelPrefetch() discards pending reads and prefetched blocks.
+ *
+ * Prefetching is only possible on datasets opened in read-only mode, that
+ * can be re-opened (which excludes the MEM driver, for example). Only full
+ * resolution blocks are prefetched.
+ *
+ * Prefetched blocks are held outside of the block cache until they are
+ * consumed, and count against the MAX_MEMORY limit. Reads are suspended when
+ * that limit is reached, and resume as blocks are consumed.
+ *
+ * The following options are supported. They are only taken into account
+ * by the first call after the dataset was opened, or after CancelPrefetch().
+ * <ul>
+ * <li>NUM_THREADS=integer or ALL_CPUS: maximum number of blocks read
+ * concurrently. Defaults to the value of the GDAL_NUM_THREADS configuration
+ * option, or ALL_CPUS.</li>
+ * <li>MAX_MEMORY=size: maximum amount of memory used by prefetched blocks.
+ * The value may be expressed in megabytes, with units (e.g. "500 MB"), or as
+ * a percentage of the RAM (e.g. "10%"). Defaults to a quarter of the block
+ * cache size (GDAL_CACHEMAX).</li>
+ * </ul>
+ *
+ * This method is the same as the C function GDALDatasetPrefetch().
+ *
+ * @param nWindowCount Number of windows.
+ * @param panWindows Array of 4 * nWindowCount values, with the xoff, yoff,
+ * xsize and ysize of each window, in pixels.
+ * @param nBandCount Number of bands to prefetch.
+ * @param panBandList List of nBandCount band numbers (1-based), or NULL to
+ * select the first nBandCount bands.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ *
+ * @return CE_None in case of success, CE_Failure if the parameters are
+ * invalid or prefetching is not supported on this dataset.
+ * @since GDAL 3.11
+ */
+
+CPLErr GDALDataset::Prefetch(int nWindowCount, const int *panWindows,
+                             int nBandCount, const int *panBandList,
+                             CSLConstList papszOptions)
+{
+    if (eAccess == GA_Update)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Prefetch() is not supported on datasets opened in "
+                    "update mode");
+        return CE_Failure;
+    }
+
+    std::vector<int> anWindows;
+    for (int i = 0; i < nWindowCount; ++i)
+    {
+        const int *panWindow = panWindows + 4 * i;
+        int bStopProcessing = FALSE;
+        const CPLErr eErr = ValidateRasterIOOrAdviseReadParameters(
+            "Prefetch()", &bStopProcessing, panWindow[0], panWindow[1],
+            panWindow[2], panWindow[3], panWindow[2], panWindow[3], nBandCount,
+            panBandList);
+        if (eErr != CE_None)
+            return eErr;
+        if (!bStopProcessing)
+            anWindows.insert(anWindows.end(), panWindow, panWindow + 4);
+    }
+    if (anWindows.empty() || nBandCount == 0)
+        return CE_None;
+
+    if (!m_poPrivate)
+        return CE_Failure;
+    if (!m_poPrivate->m_poPrefetcher)
+    {
+        m_poPrivate->m_poPrefetcher =
+            GDALDatasetPrefetcher::Create(this, papszOptions);
+        if (!m_poPrivate->m_poPrefetcher)
+            return CE_Failure;
+    }
+    m_poPrivate->m_poPrefetcher->AddWindows(
+        static_cast<int>(anWindows.size() / 4), anWindows.data(), nBandCount,
+        panBandList);
+    return CE_None;
+}
+
+/************************************************************************/
+/*                         GDALDatasetPrefetch()                        */
+/************************************************************************/
+
+/**
+ * \brief Asynchronously read blocks of the dataset in the background.
+ *
+ * @see GDALDataset::Prefetch()
+ * @since GDAL 3.11
+ */
+CPLErr GDALDatasetPrefetch(GDALDatasetH hDS, int nWindowCount,
+                           const int *panWindows, int nBandCount,
+                           const int *panBandList, CSLConstList papszOptions)
+
+{
+    VALIDATE_POINTER1(hDS, "GDALDatasetPrefetch", CE_Failure);
+
+    return GDALDataset::FromHandle(hDS)->Prefetch(
+        nWindowCount, panWindows, nBandCount, panBandList, papszOptions);
+}
+
+/************************************************************************/
+/*                           CancelPrefetch()                           */
+/************************************************************************/
+
+/**
+ * \brief Cancel background reads started by Prefetch().
+ *
+ * Blocks that are being read are waited for, and all prefetched blocks that
+ * have not been consumed yet are discarded.
+ *
+ * This method is the same as the C function GDALDatasetCancelPrefetch().
+ *
+ * @since GDAL 3.11
+ */
+
+void GDALDataset::CancelPrefetch()
+{
+    if (m_poPrivate)
+        m_poPrivate->m_poPrefetcher.reset();
+}
+
+/************************************************************************/
+/*                      GDALDatasetCancelPrefetch()                     */
+/************************************************************************/
+
+/**
+ * \brief Cancel background reads started by GDALDatasetPrefetch().
+ *
+ * @see GDALDataset::CancelPrefetch()
+ * @since GDAL 3.11
+ */
+void GDALDatasetCancelPrefetch(GDALDatasetH hDS)
+
+{
+    VALIDATE_POINTER0(hDS, "GDALDatasetCancelPrefetch");
+
+    GDALDataset::FromHandle(hDS)->CancelPrefetch();
+}
+
+/************************************************************************/
+/*                        TakePrefetchedBlock()                         */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+/** Called by GDALRasterBand::GetLockedBlockRef() when a block of poBand is
+ * missing from the block cache.
+ *
+ * If pData is not null and the block has been prefetched, copy it into pData
+ * and return true. If pData is null, discard any prefetched copy, as the
+ * caller is about to initialize the block by itself.
+ */
+bool GDALDataset::TakePrefetchedBlock(GDALRasterBand *poBand, int nXBlockOff,
+                                      int nYBlockOff, void *pData)
+{
+    if (!m_poPrivate || !m_poPrivate->m_poPrefetcher)
+        return false;
+    // Excludes mask and overview bands.
+    const int nBand = poBand->GetBand();
+    if (nBand < 1 || nBand > nBands || papoBands[nBand - 1] != poBand)
+        return false;
+    return m_poPrivate->m_poPrefetcher->TakeBlock(nBand, nXBlockOff,
+                                                  nYBlockOff, pData);
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                         GDALAntiRecursionStruct                      */
 /************************************************************************/
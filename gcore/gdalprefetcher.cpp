@@ -0,0 +1,380 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Asynchronous prefetching of raster blocks for GDALDataset
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdalprefetcher.h"
+
+#include "cpl_error.h"
+#include "cpl_string.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                       GDALDatasetPrefetcher()                        */
+/************************************************************************/
+
+GDALDatasetPrefetcher::GDALDatasetPrefetcher(
+    GDALDataset *poDS, std::unique_ptr<GDALDataset> poThreadSafeDS,
+    int nMaxRunningJobs, GIntBig nMaxMemory)
+    : m_poDS(poDS), m_poThreadSafeDS(std::move(poThreadSafeDS)),
+      m_nMaxRunningJobs(nMaxRunningJobs), m_nMaxMemory(nMaxMemory)
+{
+    for (int i = 1; i <= poDS->GetRasterCount(); ++i)
+    {
+        auto poBand = poDS->GetRasterBand(i);
+        int nBlockXSize = 0, nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        m_anBlockMemory.push_back(
+            static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+            GDALGetDataTypeSizeBytes(poBand->GetRasterDataType()));
+    }
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+/** Create a prefetcher for poDS.
+ *
+ * Supported options are NUM_THREADS (number of concurrent background reads,
+ * or ALL_CPUS. Defaults to the GDAL_NUM_THREADS configuration option, or
+ * ALL_CPUS) and MAX_MEMORY (maximum amount of memory used by blocks that have
+ * been prefetched but not consumed yet. Defaults to a quarter of
+ * GDAL_CACHEMAX. A value without units is interpreted as megabytes).
+ *
+ * Returns nullptr, with an error emitted, if poDS cannot be cloned.
+ */
+
+/* static */ std::unique_ptr<GDALDatasetPrefetcher>
+GDALDatasetPrefetcher::Create(GDALDataset *poDS, CSLConstList papszOptions)
+{
+    int nThreads;
+    const char *pszThreads = CSLFetchNameValue(papszOptions, "NUM_THREADS");
+    if (pszThreads == nullptr)
+        nThreads = GDALGetNumThreads(128, /* bDefaultToAllCPUs = */ true);
+    else if (EQUAL(pszThreads, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszThreads);
+    nThreads = std::clamp(nThreads, 1, 128);
+
+    GIntBig nMaxMemory = GDALGetCacheMax64() / 4;
+    if (const char *pszMaxMemory =
+            CSLFetchNameValue(papszOptions, "MAX_MEMORY"))
+    {
+        bool bUnitSpecified = false;
+        if (CPLParseMemorySize(pszMaxMemory, &nMaxMemory, &bUnitSpecified) !=
+            CE_None)
+        {
+            return nullptr;
+        }
+        if (!bUnitSpecified)
+            nMaxMemory *= 1024 * 1024;
+    }
+
+    // Do not share state with poDS, so that background reads are fully
+    // independent from it.
+    if (!poDS->CanBeCloned(GDAL_OF_RASTER, /* bCanShareState = */ false))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Prefetching is not supported on %s, as it cannot be "
+                 "re-opened",
+                 poDS->GetDescription());
+        return nullptr;
+    }
+    auto poClone = poDS->Clone(GDAL_OF_RASTER, /* bCanShareState = */ false);
+    if (!poClone)
+        return nullptr;
+    for (int i = 1; i <= poDS->GetRasterCount(); ++i)
+    {
+        auto poBand = poDS->GetRasterBand(i);
+        auto poCloneBand = poClone->GetRasterCount() == poDS->GetRasterCount()
+                               ? poClone->GetRasterBand(i)
+                               : nullptr;
+        int nBlockXSize = 0, nBlockYSize = 0;
+        int nCloneBlockXSize = 0, nCloneBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        if (poCloneBand)
+            poCloneBand->GetBlockSize(&nCloneBlockXSize, &nCloneBlockYSize);
+        if (!poCloneBand ||
+            poCloneBand->GetRasterDataType() != poBand->GetRasterDataType() ||
+            nCloneBlockXSize != nBlockXSize || nCloneBlockYSize != nBlockYSize)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Re-opened dataset for %s does not share the same "
+                     "characteristics as the original dataset",
+                     poDS->GetDescription());
+            return nullptr;
+        }
+    }
+
+    auto poThreadSafeDS =
+        GDALGetThreadSafeDataset(std::move(poClone), GDAL_OF_RASTER);
+    if (!poThreadSafeDS)
+        return nullptr;
+
+    auto poPrefetcher =
+        std::unique_ptr<GDALDatasetPrefetcher>(new GDALDatasetPrefetcher(
+            poDS, std::move(poThreadSafeDS), nThreads, nMaxMemory));
+    poPrefetcher->m_poJobQueue =
+        GDALGetGlobalThreadPool(nThreads)->CreateJobQueue();
+    return poPrefetcher;
+}
+
+/************************************************************************/
+/*                       ~GDALDatasetPrefetcher()                       */
+/************************************************************************/
+
+GDALDatasetPrefetcher::~GDALDatasetPrefetcher()
+{
+    {
+        std::lock_guard oLock(m_oMutex);
+        m_aoPendingBlocks.clear();
+        m_oSetPendingBlocks.clear();
+        // Jobs that have not started yet will return immediately.
+        m_oSetQueuedBlocks.clear();
+    }
+    m_poJobQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                             AddWindows()                             */
+/************************************************************************/
+
+/** Queue the blocks intersecting the nWindowCount windows (given as
+ * xoff, yoff, xsize, ysize quadruplets in panWindows) for the bands of
+ * panBandMap, that are not already in the block cache or queued.
+ *
+ * Must be called from the thread that uses m_poDS, as it queries its block
+ * cache. Parameters are assumed to have been validated by the caller.
+ */
+
+void GDALDatasetPrefetcher::AddWindows(int nWindowCount, const int *panWindows,
+                                       int nBandCount, const int *panBandMap)
+{
+    std::vector<BlockKey> aoKeys;
+    for (int iWindow = 0; iWindow < nWindowCount; ++iWindow)
+    {
+        const int nXOff = panWindows[4 * iWindow + 0];
+        const int nYOff = panWindows[4 * iWindow + 1];
+        const int nXSize = panWindows[4 * iWindow + 2];
+        const int nYSize = panWindows[4 * iWindow + 3];
+        for (int iBand = 0; iBand < nBandCount; ++iBand)
+        {
+            const int nBand = panBandMap ? panBandMap[iBand] : iBand + 1;
+            auto poBand = m_poDS->GetRasterBand(nBand);
+            int nBlockXSize = 0, nBlockYSize = 0;
+            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+            for (int iYBlock = nYOff / nBlockYSize;
+                 iYBlock <= (nYOff + nYSize - 1) / nBlockYSize; ++iYBlock)
+            {
+                for (int iXBlock = nXOff / nBlockXSize;
+                     iXBlock <= (nXOff + nXSize - 1) / nBlockXSize; ++iXBlock)
+                {
+                    if (auto poBlock =
+                            poBand->TryGetLockedBlockRef(iXBlock, iYBlock))
+                    {
+                        poBlock->DropLock();
+                        continue;
+                    }
+                    aoKeys.push_back(BlockKey{nBand, iXBlock, iYBlock});
+                }
+            }
+        }
+    }
+
+    std::vector<BlockKey> aoJobs;
+    {
+        std::lock_guard oLock(m_oMutex);
+        for (const auto &sKey : aoKeys)
+        {
+            if (!cpl::contains(m_oSetPendingBlocks, sKey) &&
+                !cpl::contains(m_oSetQueuedBlocks, sKey) &&
+                !cpl::contains(m_oSetReadingBlocks, sKey) &&
+                !cpl::contains(m_oMapReadyBlocks, sKey))
+            {
+                m_aoPendingBlocks.push_back(sKey);
+                m_oSetPendingBlocks.insert(sKey);
+            }
+        }
+        aoJobs = CollectJobsLocked();
+    }
+    SubmitJobs(aoJobs);
+}
+
+/************************************************************************/
+/*                         CollectJobsLocked()                          */
+/************************************************************************/
+
+/** Move pending blocks to the queued state, as long as the number of running
+ * jobs and the memory cap allow it, and return them. m_oMutex must be held.
+ */
+
+std::vector<GDALDatasetPrefetcher::BlockKey>
+GDALDatasetPrefetcher::CollectJobsLocked()
+{
+    std::vector<BlockKey> aoJobs;
+    while (!m_aoPendingBlocks.empty() && m_nRunningJobs < m_nMaxRunningJobs)
+    {
+        const BlockKey sKey = m_aoPendingBlocks.front();
+        if (!cpl::contains(m_oSetPendingBlocks, sKey))
+        {
+            // Already read by the owning dataset.
+            m_aoPendingBlocks.pop_front();
+            continue;
+        }
+        const GIntBig nBlockMemory = GetBlockMemory(sKey.nBand);
+        if (m_nMemoryUsed + nBlockMemory > m_nMaxMemory)
+            break;
+        m_aoPendingBlocks.pop_front();
+        m_oSetPendingBlocks.erase(sKey);
+        m_oSetQueuedBlocks.insert(sKey);
+        m_nMemoryUsed += nBlockMemory;
+        ++m_nRunningJobs;
+        aoJobs.push_back(sKey);
+    }
+    return aoJobs;
+}
+
+/************************************************************************/
+/*                             SubmitJobs()                             */
+/************************************************************************/
+
+void GDALDatasetPrefetcher::SubmitJobs(const std::vector<BlockKey> &aoKeys)
+{
+    for (const auto &sKey : aoKeys)
+    {
+        if (!m_poJobQueue->SubmitJob([this, sKey]() { ReadBlock(sKey); }))
+        {
+            std::lock_guard oLock(m_oMutex);
+            m_oSetQueuedBlocks.erase(sKey);
+            m_nMemoryUsed -= GetBlockMemory(sKey.nBand);
+            --m_nRunningJobs;
+        }
+    }
+}
+
+/************************************************************************/
+/*                             ReadBlock()                              */
+/************************************************************************/
+
+/** Job run on the thread pool, that reads a block from the thread-safe
+ * clone of the dataset. Errors are silently ignored: the block will be read
+ * again, and the error reported, when the owning dataset needs it.
+ */
+
+void GDALDatasetPrefetcher::ReadBlock(const BlockKey &sKey)
+{
+    const GIntBig nBlockMemory = GetBlockMemory(sKey.nBand);
+    bool bStarted;
+    {
+        std::lock_guard oLock(m_oMutex);
+        // The owning dataset may have read the block in the meantime, or
+        // the prefetcher may be being destroyed.
+        bStarted = m_oSetQueuedBlocks.erase(sKey) > 0;
+        if (bStarted)
+            m_oSetReadingBlocks.insert(sKey);
+    }
+
+    std::unique_ptr<GByte, VSIFreeReleaser> pabyData;
+    if (bStarted)
+    {
+        auto poBand = m_poThreadSafeDS->GetRasterBand(sKey.nBand);
+        const GDALDataType eDT = poBand->GetRasterDataType();
+        const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+        int nBlockXSize = 0, nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        int nXCheck = 0, nYCheck = 0;
+        poBand->GetActualBlockSize(sKey.nXBlockOff, sKey.nYBlockOff, &nXCheck,
+                                   &nYCheck);
+        // Partial blocks are zero-initialized outside of the valid area.
+        const bool bPartial = nXCheck < nBlockXSize || nYCheck < nBlockYSize;
+        pabyData.reset(static_cast<GByte *>(
+            bPartial ? VSICalloc(1, static_cast<size_t>(nBlockMemory))
+                     : VSIMalloc(static_cast<size_t>(nBlockMemory))));
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        if (pabyData &&
+            poBand->RasterIO(GF_Read, sKey.nXBlockOff * nBlockXSize,
+                             sKey.nYBlockOff * nBlockYSize, nXCheck, nYCheck,
+                             pabyData.get(), nXCheck, nYCheck, eDT, nDTSize,
+                             static_cast<GSpacing>(nDTSize) * nBlockXSize,
+                             nullptr) != CE_None)
+        {
+            pabyData.reset();
+        }
+    }
+
+    std::vector<BlockKey> aoJobs;
+    {
+        std::lock_guard oLock(m_oMutex);
+        --m_nRunningJobs;
+        if (bStarted)
+            m_oSetReadingBlocks.erase(sKey);
+        if (pabyData)
+            m_oMapReadyBlocks[sKey] = std::move(pabyData);
+        else
+            m_nMemoryUsed -= nBlockMemory;
+        aoJobs = CollectJobsLocked();
+    }
+    m_oCV.notify_all();
+    SubmitJobs(aoJobs);
+}
+
+/************************************************************************/
+/*                             TakeBlock()                              */
+/************************************************************************/
+
+/** Called by the owning dataset when a block is missing from its block cache.
+ *
+ * If the block has been prefetched, copy it into pDst (if not null), release
+ * it from the prefetcher and return true (or false if pDst is null).
+ * If it is being read, wait for that read to complete first.
+ * Otherwise, forget about it and return false: the caller must read it.
+ */
+
+bool GDALDatasetPrefetcher::TakeBlock(int nBand, int nXBlockOff,
+                                      int nYBlockOff, void *pDst)
+{
+    const BlockKey sKey{nBand, nXBlockOff, nYBlockOff};
+    std::unique_ptr<GByte, VSIFreeReleaser> pabyData;
+    std::vector<BlockKey> aoJobs;
+    {
+        std::unique_lock oLock(m_oMutex);
+        if (m_oSetPendingBlocks.erase(sKey) > 0 ||
+            m_oSetQueuedBlocks.erase(sKey) > 0)
+        {
+            // Not started yet: reading it directly is faster than waiting
+            // for a worker thread to pick it. Queued blocks release their
+            // memory reservation when their job runs.
+            return false;
+        }
+        m_oCV.wait(oLock, [this, &sKey]
+                   { return !cpl::contains(m_oSetReadingBlocks, sKey); });
+        auto oIter = m_oMapReadyBlocks.find(sKey);
+        if (oIter == m_oMapReadyBlocks.end())
+            return false;
+        pabyData = std::move(oIter->second);
+        m_oMapReadyBlocks.erase(oIter);
+        m_nMemoryUsed -= GetBlockMemory(nBand);
+        aoJobs = CollectJobsLocked();
+    }
+    SubmitJobs(aoJobs);
+
+    if (pDst == nullptr)
+        return false;
+    memcpy(pDst, pabyData.get(), static_cast<size_t>(GetBlockMemory(nBand)));
+    return true;
+}
+
+//! @endcond
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Asynchronous prefetching of raster blocks for GDALDataset
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALPREFETCHER_H_INCLUDED
+#define GDALPREFETCHER_H_INCLUDED
+
+//! @cond Doxygen_Suppress
+
+#include "cpl_conv.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_priv.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+/************************************************************************/
+/*                        GDALDatasetPrefetcher                         */
+/************************************************************************/
+
+/** Reads blocks of a dataset in the background, on the global thread pool,
+ * so that they are ready when GDALRasterBand::GetLockedBlockRef() needs them.
+ *
+ * Background reads are done on a thread-safe clone of the dataset. The
+ * owning dataset itself is only ever accessed from the thread that uses it,
+ * through TakeBlock(), called by GetLockedBlockRef() when a block is missing
+ * from the block cache.
+ */
+class GDALDatasetPrefetcher
+{
+  public:
+    static std::unique_ptr<GDALDatasetPrefetcher>
+    Create(GDALDataset *poDS, CSLConstList papszOptions);
+
+    ~GDALDatasetPrefetcher();
+
+    void AddWindows(int nWindowCount, const int *panWindows, int nBandCount,
+                    const int *panBandMap);
+
+    bool TakeBlock(int nBand, int nXBlockOff, int nYBlockOff, void *pDst);
+
+  private:
+    struct BlockKey
+    {
+        int nBand;
+        int nXBlockOff;
+        int nYBlockOff;
+
+        bool operator<(const BlockKey &other) const
+        {
+            return std::tie(nBand, nYBlockOff, nXBlockOff) <
+                   std::tie(other.nBand, other.nYBlockOff, other.nXBlockOff);
+        }
+    };
+
+    GDALDataset *const m_poDS;
+    std::unique_ptr<GDALDataset> m_poThreadSafeDS;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    const int m_nMaxRunningJobs;
+    const GIntBig m_nMaxMemory;
+    // Size in bytes of a block, for each band.
+    std::vector<GIntBig> m_anBlockMemory{};
+
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+
+    // Blocks not submitted yet, in request order. Entries no longer in
+    // m_oSetPendingBlocks are skipped.
+    std::deque<BlockKey> m_aoPendingBlocks{};
+    std::set<BlockKey> m_oSetPendingBlocks{};
+    // Blocks submitted to the thread pool, whose job has not started yet.
+    std::set<BlockKey> m_oSetQueuedBlocks{};
+    // Blocks being read by a worker thread.
+    std::set<BlockKey> m_oSetReadingBlocks{};
+    std::map<BlockKey, std::unique_ptr<GByte, VSIFreeReleaser>>
+        m_oMapReadyBlocks{};
+
+    // Memory reserved for queued, reading and ready blocks.
+    GIntBig m_nMemoryUsed = 0;
+    int m_nRunningJobs = 0;
+
+    GDALDatasetPrefetcher(GDALDataset *poDS,
+                          std::unique_ptr<GDALDataset> poThreadSafeDS,
+                          int nMaxRunningJobs, GIntBig nMaxMemory);
+
+    GIntBig GetBlockMemory(int nBand) const
+    {
+        return m_anBlockMemory[nBand - 1];
+    }
+
+    std::vector<BlockKey> CollectJobsLocked();
+    void SubmitJobs(const std::vector<BlockKey> &aoKeys);
+    void ReadBlock(const BlockKey &sKey);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALDatasetPrefetcher)
+};
+
+//! @endcond
+
+#endif /* GDALPREFETCHER_H_INCLUDED */
@@ -23,13 +23,18 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
@@ -38,9 +43,14 @@
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_interpolateatpoint.h"
 #include "gdal_minmax_element.hpp"
 
+#ifdef HAVE_AVX2_AT_COMPILE_TIME
+#include "gdalrasterband_avx2.h"
+#endif
+
 /************************************************************************/
 /*                           GDALRasterBand()                           */
 /************************************************************************/
@@ -2029,7 +2039,16 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
             return nullptr;
         }
 
-        if (!bJustInitialize)
+        if (bJustInitialize)
+        {
+            // Drop any prefetched copy, as the caller will fill the block.
+            if (poDS)
+                poDS->TakePrefetchedBlock(this, nXBlockOff, nYBlockOff,
+                                          nullptr);
+        }
+        else if (poDS == nullptr ||
+                 !poDS->TakePrefetchedBlock(this, nXBlockOff, nYBlockOff,
+                                            poBlock->GetDataRef()))
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
             int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
@@ -3979,6 +3998,634 @@ struct GDALNoDataValues
     }
 };
 
+/************************************************************************/
+/*                    GDALBlockSamplerMultiThreaded                     */
+/************************************************************************/
+
+namespace
+{
+/** Helper used by ComputeStatistics(), ComputeRasterMinMax() and
+ * GetHistogram() to process the sampled blocks of a band with several
+ * threads of the global thread pool, when GDAL_NUM_THREADS is set.
+ *
+ * Blocks are read through a thread-safe dataset (RFC 101), so that each
+ * worker thread uses its own dataset handle. The sampled blocks are split
+ * into contiguous chunks, so that callers can accumulate partial results
+ * per chunk and merge them in a deterministic order.
+ */
+class GDALBlockSamplerMultiThreaded
+{
+    GDALRasterBand *const m_poBand;
+    const GIntBig m_nSampledBlocks;
+    const int m_nSampleRate;
+    int m_nThreads = 1;
+    int m_nChunks = 0;
+    GDALDataset *m_poTSDS = nullptr;
+    GDALRasterBand *m_poTSBand = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALBlockSamplerMultiThreaded)
+
+  public:
+    GDALBlockSamplerMultiThreaded(GDALRasterBand *poBand, GIntBig nTotalBlocks,
+                                  int nSampleRate);
+    ~GDALBlockSamplerMultiThreaded();
+
+    /** Return the number of chunks, or 0 if the multi-threaded code path
+     * cannot be used. */
+    int GetChunkCount() const
+    {
+        return m_nChunks;
+    }
+
+    template <class BlockFunc>
+    bool Run(bool bWithMask, BlockFunc pfnBlock, GDALProgressFunc pfnProgress,
+             void *pProgressData, const char *pszProgressMsg);
+};
+
+GDALBlockSamplerMultiThreaded::GDALBlockSamplerMultiThreaded(
+    GDALRasterBand *poBand, GIntBig nTotalBlocks, int nSampleRate)
+    : m_poBand(poBand),
+      m_nSampledBlocks(DIV_ROUND_UP(nTotalBlocks, nSampleRate)),
+      m_nSampleRate(nSampleRate)
+{
+    m_nThreads = static_cast<int>(
+        std::min<GIntBig>(GDALGetNumThreads(), m_nSampledBlocks));
+    if (m_nThreads <= 1)
+        return;
+
+    GDALDataset *poDS = poBand->GetDataset();
+    const int nBand = poBand->GetBand();
+    if (poDS == nullptr || nBand <= 0 || nBand > poDS->GetRasterCount() ||
+        poDS->GetRasterBand(nBand) != poBand)
+    {
+        return;
+    }
+
+    // Per-thread datasets are re-opened from the file, and would not see
+    // pending modifications of a dataset opened in update mode. MEM datasets
+    // are fine since their clones share the same memory buffer.
+    if (poDS->GetAccess() == GA_Update)
+    {
+        GDALDriver *poDriver = poDS->GetDriver();
+        if (poDriver == nullptr || !EQUAL(poDriver->GetDescription(), "MEM") ||
+            poBand->FlushCache(false) != CE_None ||
+            poBand->GetMaskBand()->FlushCache(false) != CE_None)
+        {
+            return;
+        }
+    }
+
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        m_poTSDS = GDALGetThreadSafeDataset(poDS, GDAL_OF_RASTER);
+    }
+    if (m_poTSDS == nullptr)
+        return;
+    m_poTSBand = m_poTSDS->GetRasterBand(nBand);
+    if (m_poTSBand == nullptr || GDALGetGlobalThreadPool(m_nThreads) == nullptr)
+        return;
+
+    // A few chunks per thread to balance the load.
+    m_nChunks = static_cast<int>(
+        std::min<GIntBig>(m_nSampledBlocks, 4 * m_nThreads));
+}
+
+GDALBlockSamplerMultiThreaded::~GDALBlockSamplerMultiThreaded()
+{
+    if (m_poTSDS)
+        m_poTSDS->ReleaseRef();
+}
+
+/** Run pfnBlock(iChunk, pData, pabyMaskData, nXCheck, nYCheck) on each
+ * sampled block, where pData is the block content in the band data type with
+ * a line stride of nBlockXSize pixels, and pabyMaskData is the corresponding
+ * content of the mask band if bWithMask is set (nullptr otherwise).
+ * pfnBlock() may return false to stop the processing early (this is not
+ * considered as an error).
+ *
+ * @return false in case of error or user interruption.
+ */
+template <class BlockFunc>
+bool GDALBlockSamplerMultiThreaded::Run(bool bWithMask, BlockFunc pfnBlock,
+                                        GDALProgressFunc pfnProgress,
+                                        void *pProgressData,
+                                        const char *pszProgressMsg)
+{
+    CPLAssert(m_nChunks > 0);
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    m_poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(m_poBand->GetXSize(), nBlockXSize);
+    const GDALDataType eDataType = m_poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+
+    std::atomic<GIntBig> nProcessedBlocks{0};
+    std::atomic<bool> bStop{false};
+    std::atomic<bool> bError{false};
+    CPLErrorAccumulator oErrorAccumulator;
+
+    const GIntBig nBlocksPerChunk = m_nSampledBlocks / m_nChunks;
+    const GIntBig nRemainder = m_nSampledBlocks % m_nChunks;
+
+    auto poJobQueue = GDALGetGlobalThreadPool(m_nThreads)->CreateJobQueue();
+    for (int iChunk = 0; iChunk < m_nChunks; ++iChunk)
+    {
+        const GIntBig iFirst =
+            iChunk * nBlocksPerChunk + std::min<GIntBig>(iChunk, nRemainder);
+        const GIntBig iLast =
+            iFirst + nBlocksPerChunk + (iChunk < nRemainder ? 1 : 0);
+
+        poJobQueue->SubmitJob(
+            [this, &pfnBlock, &nProcessedBlocks, &bStop, &bError,
+             &oErrorAccumulator, bWithMask, nBlockXSize, nBlockYSize,
+             nBlocksPerRow, eDataType, nDTSize, iChunk, iFirst, iLast]()
+            {
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
+
+                GDALRasterBand *poMaskBand =
+                    bWithMask ? m_poTSBand->GetMaskBand() : nullptr;
+                std::unique_ptr<void, VSIFreeReleaser> pData(
+                    VSI_MALLOC3_VERBOSE(nDTSize, nBlockXSize, nBlockYSize));
+                std::unique_ptr<GByte, VSIFreeReleaser> pabyMaskData(
+                    bWithMask ? static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                                    nBlockXSize, nBlockYSize))
+                              : nullptr);
+                if (!pData || (bWithMask && (!poMaskBand || !pabyMaskData)))
+                {
+                    bError = true;
+                    bStop = true;
+                    return;
+                }
+
+                for (GIntBig i = iFirst; i < iLast && !bStop; ++i)
+                {
+                    const GIntBig iSampleBlock = i * m_nSampleRate;
+                    const int iYBlock =
+                        static_cast<int>(iSampleBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+                    int nXCheck = 0, nYCheck = 0;
+                    m_poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck,
+                                                 &nYCheck);
+
+                    if (m_poTSBand->RasterIO(
+                            GF_Read, iXBlock * nBlockXSize,
+                            iYBlock * nBlockYSize, nXCheck, nYCheck,
+                            pData.get(), nXCheck, nYCheck, eDataType, nDTSize,
+                            static_cast<GSpacing>(nDTSize) * nBlockXSize,
+                            nullptr) != CE_None ||
+                        (poMaskBand &&
+                         poMaskBand->RasterIO(
+                             GF_Read, iXBlock * nBlockXSize,
+                             iYBlock * nBlockYSize, nXCheck, nYCheck,
+                             pabyMaskData.get(), nXCheck, nYCheck, GDT_Byte, 0,
+                             nBlockXSize, nullptr) != CE_None))
+                    {
+                        bError = true;
+                        bStop = true;
+                        return;
+                    }
+
+                    if (!pfnBlock(iChunk, pData.get(), pabyMaskData.get(),
+                                  nXCheck, nYCheck))
+                    {
+                        bStop = true;
+                    }
+                    ++nProcessedBlocks;
+                }
+            });
+    }
+
+    bool bInterrupted = false;
+    while (poJobQueue->WaitEvent())
+    {
+        if (!bInterrupted &&
+            !pfnProgress(static_cast<double>(nProcessedBlocks) /
+                             static_cast<double>(m_nSampledBlocks),
+                         pszProgressMsg, pProgressData))
+        {
+            bInterrupted = true;
+            bStop = true;
+        }
+    }
+    poJobQueue->WaitCompletion();
+
+    oErrorAccumulator.ReplayErrors();
+
+    if (bInterrupted)
+    {
+        m_poBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                              "User terminated");
+        return false;
+    }
+    return !bError;
+}
+
+}  // namespace
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+/************************************************************************/
+/*                     GetIntegerNoDataInterval()                       */
+/************************************************************************/
+
+/** Return the interval [nLow, nHigh] of the values of [nTypeMin, nTypeMax]
+ * that GetPixelValue() considers as equal to the nodata value. The interval
+ * is empty if nLow > nHigh.
+ */
+static void GetIntegerNoDataInterval(const GDALNoDataValues &sNoDataValues,
+                                     int nTypeMin, int nTypeMax, int &nLow,
+                                     int &nHigh)
+{
+    nLow = 1;
+    nHigh = 0;
+    if (!sNoDataValues.bGotNoDataValue)
+        return;
+
+    const double dfNoDataValue = sNoDataValues.dfNoDataValue;
+    const auto IsNoData = [dfNoDataValue](int nVal)
+    { return ARE_REAL_EQUAL(static_cast<double>(nVal), dfNoDataValue); };
+    const auto Clamp = [nTypeMin, nTypeMax](double dfVal)
+    {
+        return static_cast<int>(std::clamp(dfVal, static_cast<double>(nTypeMin),
+                                           static_cast<double>(nTypeMax)));
+    };
+
+    // The values that are equal to the nodata value in the sense of
+    // ARE_REAL_EQUAL() form an interval that contains it. Depending on the
+    // magnitude of the nodata value, it may contain several integers.
+    int nStart = Clamp(std::floor(dfNoDataValue));
+    if (!IsNoData(nStart))
+    {
+        nStart = Clamp(std::ceil(dfNoDataValue));
+        if (!IsNoData(nStart))
+            return;
+    }
+    nLow = nStart;
+    while (nLow > nTypeMin && IsNoData(nLow - 1))
+        --nLow;
+    nHigh = nStart;
+    while (nHigh < nTypeMax && IsNoData(nHigh + 1))
+        ++nHigh;
+}
+
+#endif
+
+/************************************************************************/
+/*                    GDALHistogramAccumulatorPool                      */
+/************************************************************************/
+
+namespace
+{
+/** Pool of zero-initialized arrays of counts, used by the multi-threaded
+ * histogram computations so that each worker thread updates its own array
+ * without locking. Arrays are only allocated when no free one is available,
+ * so there are at most as many arrays as concurrently running workers.
+ */
+class GDALHistogramAccumulatorPool
+{
+    const size_t m_nSize;
+    std::mutex m_oMutex{};
+    std::vector<std::unique_ptr<GUIntBig, VSIFreeReleaser>> m_apanArrays{};
+    std::vector<GUIntBig *> m_apanFreeArrays{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALHistogramAccumulatorPool)
+
+  public:
+    explicit GDALHistogramAccumulatorPool(size_t nSize) : m_nSize(nSize)
+    {
+    }
+
+    /** Return an array of m_nSize counts, or nullptr if out of memory. */
+    GUIntBig *Acquire()
+    {
+        std::lock_guard oLock(m_oMutex);
+        if (!m_apanFreeArrays.empty())
+        {
+            GUIntBig *panArray = m_apanFreeArrays.back();
+            m_apanFreeArrays.pop_back();
+            return panArray;
+        }
+        GUIntBig *panArray = static_cast<GUIntBig *>(
+            VSI_CALLOC_VERBOSE(m_nSize, sizeof(GUIntBig)));
+        if (panArray)
+            m_apanArrays.emplace_back(panArray);
+        return panArray;
+    }
+
+    void Release(GUIntBig *panArray)
+    {
+        std::lock_guard oLock(m_oMutex);
+        m_apanFreeArrays.push_back(panArray);
+    }
+
+    /** Add the first nCount counts of all arrays to panSum. */
+    void Sum(GUIntBig *panSum, size_t nCount) const
+    {
+        for (const auto &panArray : m_apanArrays)
+        {
+            for (size_t i = 0; i < nCount; ++i)
+                panSum[i] += panArray.get()[i];
+        }
+    }
+};
+}  // namespace
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+/************************************************************************/
+/*                    UpdateHistogramWithBlockAVX2()                    */
+/************************************************************************/
+
+/** Variant of UpdateHistogramWithBlock() for Byte, UInt16, Int16, Int32,
+ * Float32 and Float64 blocks without mask band, where the bucket indices
+ * are computed with AVX2.
+ *
+ * @return false if the data type is not handled.
+ */
+static bool UpdateHistogramWithBlockAVX2(
+    const void *pData, GDALDataType eDataType, bool bSignedByte, int nXCheck,
+    int nYCheck, int nBlockXSize, const GDALNoDataValues &sNoDataValues,
+    double dfMin, double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *panHistogram)
+{
+    int nNoDataLow = 1;
+    int nNoDataHigh = 0;
+    switch (eDataType)
+    {
+        case GDT_Byte:
+            if (bSignedByte)
+                return false;
+            GetIntegerNoDataInterval(sNoDataValues, 0, UCHAR_MAX, nNoDataLow,
+                                     nNoDataHigh);
+            GDALComputeBlockHistogramUInt8_AVX2(
+                static_cast<const GByte *>(pData), nXCheck, nYCheck,
+                nBlockXSize, nNoDataLow, nNoDataHigh, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_UInt16:
+            GetIntegerNoDataInterval(sNoDataValues, 0, USHRT_MAX, nNoDataLow,
+                                     nNoDataHigh);
+            GDALComputeBlockHistogramUInt16_AVX2(
+                static_cast<const GUInt16 *>(pData), nXCheck, nYCheck,
+                nBlockXSize, nNoDataLow, nNoDataHigh, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_Int16:
+            GetIntegerNoDataInterval(sNoDataValues, SHRT_MIN, SHRT_MAX,
+                                     nNoDataLow, nNoDataHigh);
+            GDALComputeBlockHistogramInt16_AVX2(
+                static_cast<const GInt16 *>(pData), nXCheck, nYCheck,
+                nBlockXSize, nNoDataLow, nNoDataHigh, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_Int32:
+            GetIntegerNoDataInterval(sNoDataValues, INT_MIN, INT_MAX,
+                                     nNoDataLow, nNoDataHigh);
+            GDALComputeBlockHistogramInt32_AVX2(
+                static_cast<const GInt32 *>(pData), nXCheck, nYCheck,
+                nBlockXSize, nNoDataLow, nNoDataHigh, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_Float32:
+            GDALComputeBlockHistogramFloat32_AVX2(
+                static_cast<const float *>(pData), nXCheck, nYCheck,
+                nBlockXSize, sNoDataValues.bGotFloatNoDataValue,
+                sNoDataValues.fNoDataValue, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_Float64:
+            GDALComputeBlockHistogramFloat64_AVX2(
+                static_cast<const double *>(pData), nXCheck, nYCheck,
+                nBlockXSize, CPL_TO_BOOL(sNoDataValues.bGotNoDataValue),
+                sNoDataValues.dfNoDataValue, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+#endif
+
+/************************************************************************/
+/*                      UpdateHistogramWithBlock()                      */
+/************************************************************************/
+
+/** Add the valid pixels of a block, whose lines are separated by nBlockXSize
+ * pixels, to panHistogram.
+ *
+ * panHistogram must have nBuckets + 1 entries. The last one is a scratch
+ * bucket that may be incremented by the vectorized code paths, and must be
+ * ignored by the caller.
+ */
+static void UpdateHistogramWithBlock(
+    const void *pData, GDALDataType eDataType, bool bSignedByte,
+    const GByte *pabyMaskData, int nXCheck, int nYCheck, int nBlockXSize,
+    const GDALNoDataValues &sNoDataValues, double dfMin, double dfScale,
+    int nBuckets, bool bIncludeOutOfRange, GUIntBig *panHistogram)
+{
+    // this is a special case for a common situation.
+    if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
+        (dfMin >= -0.5 && dfMin <= 0.5) && nXCheck == nBlockXSize &&
+        nBuckets == 256)
+    {
+        const GPtrDiff_t nPixels = static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+
+        for (GPtrDiff_t i = 0; i < nPixels; i++)
+        {
+            if (pabyMaskData && pabyMaskData[i] == 0)
+                continue;
+            if (!(sNoDataValues.bGotNoDataValue &&
+                  (pabyData[i] ==
+                   static_cast<GByte>(sNoDataValues.dfNoDataValue))))
+            {
+                panHistogram[pabyData[i]]++;
+            }
+        }
+        return;
+    }
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+    if (pabyMaskData == nullptr && CPLHaveRuntimeAVX2() &&
+        UpdateHistogramWithBlockAVX2(pData, eDataType, bSignedByte, nXCheck,
+                                     nYCheck, nBlockXSize, sNoDataValues,
+                                     dfMin, dfScale, nBuckets,
+                                     bIncludeOutOfRange, panHistogram))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            double dfValue = 0.0;
+
+            switch (eDataType)
+            {
+                case GDT_Byte:
+                {
+                    if (bSignedByte)
+                        dfValue =
+                            static_cast<const signed char *>(pData)[iOffset];
+                    else
+                        dfValue = static_cast<const GByte *>(pData)[iOffset];
+                    break;
+                }
+                case GDT_Int8:
+                    dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt16:
+                    dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_Int16:
+                    dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt32:
+                    dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_Int32:
+                    dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GUInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Int64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Float16:
+                {
+                    const GFloat16 hfValue =
+                        static_cast<const GFloat16 *>(pData)[iOffset];
+                    if (CPLIsNan(hfValue) ||
+                        (sNoDataValues.bGotFloat16NoDataValue &&
+                         ARE_REAL_EQUAL(hfValue,
+                                        sNoDataValues.hfNoDataValue)))
+                        continue;
+                    dfValue = hfValue;
+                    break;
+                }
+                case GDT_Float32:
+                {
+                    const float fValue =
+                        static_cast<const float *>(pData)[iOffset];
+                    if (CPLIsNan(fValue) ||
+                        (sNoDataValues.bGotFloatNoDataValue &&
+                         ARE_REAL_EQUAL(fValue,
+                                        sNoDataValues.fNoDataValue)))
+                        continue;
+                    dfValue = fValue;
+                    break;
+                }
+                case GDT_Float64:
+                    dfValue = static_cast<const double *>(pData)[iOffset];
+                    if (std::isnan(dfValue))
+                        continue;
+                    break;
+                case GDT_CInt16:
+                {
+                    double dfReal =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CInt32:
+                {
+                    double dfReal =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat16:
+                {
+                    double dfReal =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2 + 1];
+                    if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat32:
+                {
+                    double dfReal =
+                        static_cast<const float *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const float *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat64:
+                {
+                    double dfReal =
+                        static_cast<const double *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const double *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_Unknown:
+                case GDT_TypeCount:
+                    CPLAssert(false);
+                    return;
+            }
+
+            if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
+                sNoDataValues.bGotNoDataValue &&
+                ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
+                continue;
+
+            // Given that dfValue and dfMin are not NaN, and dfScale > 0
+            // and finite, the result of the multiplication cannot be
+            // NaN
+            const double dfIndex = floor((dfValue - dfMin) * dfScale);
+
+            if (dfIndex < 0)
+            {
+                if (bIncludeOutOfRange)
+                    panHistogram[0]++;
+            }
+            else if (dfIndex >= nBuckets)
+            {
+                if (bIncludeOutOfRange)
+                    ++panHistogram[nBuckets - 1];
+            }
+            else
+            {
+                ++panHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    }
+
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -4354,252 +5001,125 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
         /* --------------------------------------------------------------------
          */
         /*      Read the blocks, and add to histogram. */
         /* --------------------------------------------------------------------
          */
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        // One extra bucket for UpdateHistogramWithBlock()
+        const size_t nHistogramSize = static_cast<size_t>(nBuckets) + 1;
+        GDALBlockSamplerMultiThreaded oSampler(this, nTotalBlocks,
+                                               nSampleRate);
+        if (oSampler.GetChunkCount() > 0)
+        {
+            // Each worker thread accumulates into its own histogram.
+            GDALHistogramAccumulatorPool oPool(nHistogramSize);
+            std::atomic<bool> bOutOfMemory{false};
+            if (!oSampler.Run(
+                    poMaskBand != nullptr,
+                    [this, bSignedByte, &sNoDataValues, dfMin, dfScale,
+                     nBuckets, bIncludeOutOfRange, &oPool, &bOutOfMemory](
+                        int /* iChunk */, const void *pData,
+                        const GByte *pabyMaskData, int nXCheck, int nYCheck)
+                    {
+                        GUIntBig *panThreadHistogram = oPool.Acquire();
+                        if (panThreadHistogram == nullptr)
+                        {
+                            bOutOfMemory = true;
+                            return false;
+                        }
+                        UpdateHistogramWithBlock(
+                            pData, eDataType, bSignedByte, pabyMaskData,
+                            nXCheck, nYCheck, nBlockXSize, sNoDataValues,
+                            dfMin, dfScale, nBuckets,
+                            CPL_TO_BOOL(bIncludeOutOfRange),
+                            panThreadHistogram);
+                        oPool.Release(panThreadHistogram);
+                        return true;
+                    },
+                    pfnProgress, pProgressData, "Compute Histogram") ||
+                bOutOfMemory)
             {
-                CPLFree(pabyMaskData);
                 return CE_Failure;
             }
 
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+            oPool.Sum(panHistogram, nBuckets);
+        }
+        else
+        {
+            std::unique_ptr<GUIntBig, VSIFreeReleaser> panHistogramTmp(
+                static_cast<GUIntBig *>(
+                    VSI_CALLOC_VERBOSE(nHistogramSize, sizeof(GUIntBig))));
+            if (!panHistogramTmp)
+                return CE_Failure;
 
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
             }
 
-            void *pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
-
-            // this is a special case for a common situation.
-            if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
-                (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
-                nXCheck == nBlockXSize && nBuckets == 256)
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+                 iSampleBlock += nSampleRate)
             {
-                const GPtrDiff_t nPixels =
-                    static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
-
-                for (GPtrDiff_t i = 0; i < nPixels; i++)
+                if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Histogram", pProgressData))
                 {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
-                        continue;
-                    if (!(sNoDataValues.bGotNoDataValue &&
-                          (pabyData[i] ==
-                           static_cast<GByte>(sNoDataValues.dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
                 }
 
-                poBlock->DropLock();
-                continue;  // To next sample block.
-            }
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
+                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
                 {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    double dfValue = 0.0;
+                void *pData = poBlock->GetDataRef();
 
-                    switch (eDataType)
-                    {
-                        case GDT_Byte:
-                        {
-                            if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
-                            else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
-                            break;
-                        }
-                        case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt64:
-                            dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Int64:
-                            dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Float16:
-                        {
-                            const GFloat16 hfValue =
-                                static_cast<GFloat16 *>(pData)[iOffset];
-                            if (CPLIsNan(hfValue) ||
-                                (sNoDataValues.bGotFloat16NoDataValue &&
-                                 ARE_REAL_EQUAL(hfValue,
-                                                sNoDataValues.hfNoDataValue)))
-                                continue;
-                            dfValue = hfValue;
-                            break;
-                        }
-                        case GDT_Float32:
-                        {
-                            const float fValue =
-                                static_cast<float *>(pData)[iOffset];
-                            if (CPLIsNan(fValue) ||
-                                (sNoDataValues.bGotFloatNoDataValue &&
-                                 ARE_REAL_EQUAL(fValue,
-                                                sNoDataValues.fNoDataValue)))
-                                continue;
-                            dfValue = fValue;
-                            break;
-                        }
-                        case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
-                            if (std::isnan(dfValue))
-                                continue;
-                            break;
-                        case GDT_CInt16:
-                        {
-                            double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CInt32:
-                        {
-                            double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat16:
-                        {
-                            double dfReal =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2 + 1];
-                            if (CPLIsNan(dfReal) || CPLIsNan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat32:
-                        {
-                            double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat64:
-                        {
-                            double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_Unknown:
-                        case GDT_TypeCount:
-                            CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
-                    }
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                    if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
-                        sNoDataValues.bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
-                        continue;
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    poBlock->DropLock();
+                    return CE_Failure;
+                }
 
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0
-                    // and finite, the result of the multiplication cannot be
-                    // NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
+                UpdateHistogramWithBlock(
+                    pData, eDataType, bSignedByte, pabyMaskData, nXCheck,
+                    nYCheck, nBlockXSize, sNoDataValues, dfMin, dfScale,
+                    nBuckets, CPL_TO_BOOL(bIncludeOutOfRange),
+                    panHistogramTmp.get());
 
-                    if (dfIndex < 0)
-                    {
-                        if (bIncludeOutOfRange)
-                            panHistogram[0]++;
-                    }
-                    else if (dfIndex >= nBuckets)
-                    {
-                        if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
-                }
+                poBlock->DropLock();
             }
 
-            poBlock->DropLock();
-        }
+            CPLFree(pabyMaskData);
 
-        CPLFree(pabyMaskData);
+            memcpy(panHistogram, panHistogramTmp.get(),
+                   sizeof(GUIntBig) * nBuckets);
+        }
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -4668,35 +5188,409 @@ CPLErr CPL_STDCALL GDALGetRasterHistogram(GDALRasterBandH hBand, double dfMin,
 
     CPLFree(panHistogramTemp);
 
-    return eErr;
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GDALGetRasterHistogramEx()                      */
+/************************************************************************/
+
+/**
+ * \brief Compute raster histogram.
+ *
+ * @see GDALRasterBand::GetHistogram()
+ *
+ * @since GDAL 2.0
+ */
+
+CPLErr CPL_STDCALL GDALGetRasterHistogramEx(
+    GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
+    GUIntBig *panHistogram, int bIncludeOutOfRange, int bApproxOK,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogramEx", CE_Failure);
+    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogramEx", CE_Failure);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    return poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
+                                bIncludeOutOfRange, bApproxOK, pfnProgress,
+                                pProgressData);
+}
+
+/************************************************************************/
+/*                          CountBlockValues()                          */
+/************************************************************************/
+
+/** Count the occurrences of each value of a block of a 8 or 16-bit integer
+ * data type, whose lines are separated by nBlockXSize pixels.
+ * panCounts[v - nValueMin] is incremented for each unmasked pixel of value v.
+ */
+template <class T>
+static void CountBlockValues(const void *pData, const GByte *pabyMaskData,
+                             int nXCheck, int nYCheck, int nBlockXSize,
+                             int nValueMin, GUIntBig *panCounts)
+{
+    const T *const paData = static_cast<const T *>(pData);
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iOffset = static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            if (pabyMaskData && pabyMaskData[iOffset + iX] == 0)
+                continue;
+            ++panCounts[static_cast<int>(paData[iOffset + iX]) - nValueMin];
+        }
+    }
+}
+
+/************************************************************************/
+/*                  ComputeRasterMinMaxAndHistogram()                   */
+/************************************************************************/
+
+/**
+ * \brief Compute the min/max values and the histogram of a band.
+ *
+ * The histogram has nBuckets buckets of equal size, covering the range
+ * between the minimum and maximum of the valid pixel values. It is the same
+ * as the one returned by GetHistogram(*pdfMin, *pdfMax, nBuckets,
+ * panHistogram, TRUE, FALSE, ...), except that all pixels are counted in the
+ * first bucket if the minimum and maximum values are equal.
+ *
+ * For Byte, Int8, UInt16 and Int16 bands, the min/max values and the
+ * histogram are computed in a single pass over the raster, by counting the
+ * occurrences of each value. For other data types, the raster is read a first
+ * time by ComputeRasterMinMax() and a second time by GetHistogram().
+ *
+ * Pixels whose value matches the nodata value or are masked by the mask
+ * band are ignored. Complex data types are not supported.
+ *
+ * This method is the same as the C function
+ * GDALComputeRasterMinMaxAndHistogram().
+ *
+ * @param[out] pdfMin Pointer to the minimum value, or nullptr.
+ * @param[out] pdfMax Pointer to the maximum value, or nullptr.
+ * @param nBuckets the number of buckets in panHistogram.
+ * @param[out] panHistogram array into which the histogram totals are placed.
+ * @param pfnProgress function to report progress to completion.
+ * @param pProgressData application data to pass to pfnProgress.
+ *
+ * @return CE_None on success, or CE_Failure if something goes wrong or if
+ * there is no valid pixel.
+ *
+ * @since GDAL 3.11
+ */
+
+CPLErr GDALRasterBand::ComputeRasterMinMaxAndHistogram(
+    double *pdfMin, double *pdfMax, int nBuckets, GUIntBig *panHistogram,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    CPLAssert(nullptr != panHistogram);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (GDALDataTypeIsComplex(eDataType))
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Complex data type not supported");
+        return CE_Failure;
+    }
+
+    if (nBuckets <= 0)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "nBuckets should be strictly positive");
+        return CE_Failure;
+    }
+    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    int nValueMin = 0;
+    int nValueCount = 0;
+    switch (eDataType)
+    {
+        case GDT_Byte:
+            nValueMin = bSignedByte ? SCHAR_MIN : 0;
+            nValueCount = 256;
+            break;
+        case GDT_Int8:
+            nValueMin = SCHAR_MIN;
+            nValueCount = 256;
+            break;
+        case GDT_UInt16:
+            nValueMin = 0;
+            nValueCount = 65536;
+            break;
+        case GDT_Int16:
+            nValueMin = SHRT_MIN;
+            nValueCount = 65536;
+            break;
+        default:
+            break;
+    }
+
+    double dfMin = 0;
+    double dfMax = 0;
+    if (nValueCount == 0)
+    {
+        // No single pass possible: compute the min/max values, and then the
+        // histogram.
+        double adfMinMax[2] = {0, 0};
+        if (ComputeRasterMinMax(FALSE, adfMinMax) != CE_None)
+            return CE_Failure;
+        dfMin = adfMinMax[0];
+        dfMax = adfMinMax[1];
+
+        CPLErr eErr;
+        if (dfMin == dfMax)
+        {
+            // With a single bucket and out-of-range values included, all
+            // valid pixels are counted whatever the histogram range.
+            eErr = GDALRasterBand::GetHistogram(0.0, 1.0, 1, panHistogram,
+                                                TRUE, FALSE, pfnProgress,
+                                                pProgressData);
+        }
+        else
+        {
+            eErr = GetHistogram(dfMin, dfMax, nBuckets, panHistogram, TRUE,
+                                FALSE, pfnProgress, pProgressData);
+        }
+        if (eErr != CE_None)
+            return eErr;
+    }
+    else
+    {
+        if (!InitBlockInfo())
+            return CE_Failure;
+
+        GDALNoDataValues sNoDataValues(this, eDataType);
+        GDALRasterBand *poMaskBand = nullptr;
+        if (!sNoDataValues.bGotNoDataValue)
+        {
+            const int l_nMaskFlags = GetMaskFlags();
+            if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+                GetColorInterpretation() != GCI_AlphaBand)
+            {
+                poMaskBand = GetMaskBand();
+            }
+        }
+
+        const auto CountValues = [this, bSignedByte, nValueMin](
+                                     const void *pData,
+                                     const GByte *pabyMaskData, int nXCheck,
+                                     int nYCheck, GUIntBig *panCounts)
+        {
+            if (eDataType == GDT_Int8 || (eDataType == GDT_Byte && bSignedByte))
+                CountBlockValues<GInt8>(pData, pabyMaskData, nXCheck, nYCheck,
+                                        nBlockXSize, nValueMin, panCounts);
+            else if (eDataType == GDT_Byte)
+                CountBlockValues<GByte>(pData, pabyMaskData, nXCheck, nYCheck,
+                                        nBlockXSize, nValueMin, panCounts);
+            else if (eDataType == GDT_UInt16)
+                CountBlockValues<GUInt16>(pData, pabyMaskData, nXCheck,
+                                          nYCheck, nBlockXSize, nValueMin,
+                                          panCounts);
+            else
+                CountBlockValues<GInt16>(pData, pabyMaskData, nXCheck,
+                                         nYCheck, nBlockXSize, nValueMin,
+                                         panCounts);
+        };
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Count the occurrences of each value. */
+        /* --------------------------------------------------------------------
+         */
+        std::vector<GUIntBig> anCounts(nValueCount);
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        GDALBlockSamplerMultiThreaded oSampler(this, nTotalBlocks, 1);
+        if (oSampler.GetChunkCount() > 0)
+        {
+            // Each worker thread accumulates into its own array of counts.
+            GDALHistogramAccumulatorPool oPool(nValueCount);
+            std::atomic<bool> bOutOfMemory{false};
+            if (!oSampler.Run(
+                    poMaskBand != nullptr,
+                    [&oPool, &bOutOfMemory, &CountValues](
+                        int /* iChunk */, const void *pData,
+                        const GByte *pabyMaskData, int nXCheck, int nYCheck)
+                    {
+                        GUIntBig *panThreadCounts = oPool.Acquire();
+                        if (panThreadCounts == nullptr)
+                        {
+                            bOutOfMemory = true;
+                            return false;
+                        }
+                        CountValues(pData, pabyMaskData, nXCheck, nYCheck,
+                                    panThreadCounts);
+                        oPool.Release(panThreadCounts);
+                        return true;
+                    },
+                    pfnProgress, pProgressData, "Compute Histogram") ||
+                bOutOfMemory)
+            {
+                return CE_Failure;
+            }
+
+            oPool.Sum(anCounts.data(), nValueCount);
+        }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
+            {
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
+            }
+
+            for (GIntBig iBlock = 0; iBlock < nTotalBlocks; ++iBlock)
+            {
+                if (!pfnProgress(static_cast<double>(iBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Histogram", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                const int iYBlock = static_cast<int>(iBlock / nBlocksPerRow);
+                const int iXBlock = static_cast<int>(iBlock % nBlocksPerRow);
+
+                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
+
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    poBlock->DropLock();
+                    return CE_Failure;
+                }
+
+                CountValues(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                            nYCheck, anCounts.data());
+
+                poBlock->DropLock();
+            }
+
+            CPLFree(pabyMaskData);
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Derive the min/max values and the histogram. */
+        /* --------------------------------------------------------------------
+         */
+        if (sNoDataValues.bGotNoDataValue)
+        {
+            for (int i = 0; i < nValueCount; ++i)
+            {
+                if (ARE_REAL_EQUAL(static_cast<double>(i + nValueMin),
+                                   sNoDataValues.dfNoDataValue))
+                    anCounts[i] = 0;
+            }
+        }
+
+        int iMin = 0;
+        while (iMin < nValueCount && anCounts[iMin] == 0)
+            ++iMin;
+        if (iMin == nValueCount)
+        {
+            ReportError(CE_Failure, CPLE_AppDefined,
+                        "Failed to compute min/max, no valid pixels found.");
+            return CE_Failure;
+        }
+        int iMax = nValueCount - 1;
+        while (anCounts[iMax] == 0)
+            --iMax;
+
+        dfMin = iMin + nValueMin;
+        dfMax = iMax + nValueMin;
+        if (iMin == iMax)
+        {
+            panHistogram[0] = anCounts[iMin];
+        }
+        else
+        {
+            // Same bucket computation as in GetHistogram()
+            const double dfScale = nBuckets / (dfMax - dfMin);
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                const double dfIndex =
+                    floor((static_cast<double>(i + nValueMin) - dfMin) *
+                          dfScale);
+                panHistogram[static_cast<int>(
+                    std::min(dfIndex, static_cast<double>(nBuckets - 1)))] +=
+                    anCounts[i];
+            }
+        }
+
+        pfnProgress(1.0, "Compute Histogram", pProgressData);
+    }
+
+    if (pdfMin)
+        *pdfMin = dfMin;
+    if (pdfMax)
+        *pdfMax = dfMax;
+    return CE_None;
 }
 
 /************************************************************************/
-/*                      GDALGetRasterHistogramEx()                      */
+/*                GDALComputeRasterMinMaxAndHistogram()                 */
 /************************************************************************/
 
 /**
- * \brief Compute raster histogram.
- *
- * @see GDALRasterBand::GetHistogram()
+ * \brief Compute the min/max values and the histogram of a band.
  *
- * @since GDAL 2.0
+ * @see GDALRasterBand::ComputeRasterMinMaxAndHistogram()
+ * @since GDAL 3.11
  */
 
-CPLErr CPL_STDCALL GDALGetRasterHistogramEx(
-    GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
-    GUIntBig *panHistogram, int bIncludeOutOfRange, int bApproxOK,
-    GDALProgressFunc pfnProgress, void *pProgressData)
+CPLErr GDALComputeRasterMinMaxAndHistogram(GDALRasterBandH hBand,
+                                           double *pdfMin, double *pdfMax,
+                                           int nBuckets, GUIntBig *panHistogram,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData)
 
 {
-    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogramEx", CE_Failure);
-    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogramEx", CE_Failure);
+    VALIDATE_POINTER1(hBand, "GDALComputeRasterMinMaxAndHistogram",
+                      CE_Failure);
+    VALIDATE_POINTER1(panHistogram, "GDALComputeRasterMinMaxAndHistogram",
+                      CE_Failure);
 
     GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
-
-    return poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
-                                bIncludeOutOfRange, bApproxOK, pfnProgress,
-                                pProgressData);
+    return poBand->ComputeRasterMinMaxAndHistogram(
+        pdfMin, pdfMax, nBuckets, panHistogram, pfnProgress, pProgressData);
 }
 
 /************************************************************************/
@@ -6325,6 +7219,238 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
 
 //! @endcond
 
+/************************************************************************/
+/*                      MergeWelfordStatistics()                        */
+/************************************************************************/
+
+/** Merge the count, mean and M2 of a set of values into running statistics,
+ * using the pairwise update of Chan et al.
+ */
+static void MergeWelfordStatistics(GUIntBig nOtherCount, double dfOtherMean,
+                                   double dfOtherM2, double &dfMean,
+                                   double &dfM2, GUIntBig &nValidCount)
+{
+    if (nOtherCount == 0)
+        return;
+    const GUIntBig nNewValidCount = nValidCount + nOtherCount;
+    const double dfDelta = dfOtherMean - dfMean;
+    const double dfRatio = static_cast<double>(nOtherCount) / nNewValidCount;
+    dfMean += dfDelta * dfRatio;
+    dfM2 += dfOtherM2 +
+            dfDelta * dfDelta * static_cast<double>(nValidCount) * dfRatio;
+    nValidCount = nNewValidCount;
+}
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+/************************************************************************/
+/*                   UpdateStatisticsWithBlockAVX2()                    */
+/************************************************************************/
+
+/** Variant of UpdateStatisticsWithBlock() for Int16, Int32, Float32 and
+ * Float64 blocks without mask band, using AVX2 kernels.
+ *
+ * The statistics of each block are computed with a two-pass algorithm (or
+ * exactly from the sum and sum of squares for Int16) and merged into the
+ * running statistics.
+ *
+ * @return false if the data type is not handled.
+ */
+static bool UpdateStatisticsWithBlockAVX2(
+    const void *pData, GDALDataType eDataType, int nXCheck, int nYCheck,
+    int nBlockXSize, const GDALNoDataValues &sNoDataValues, double &dfMin,
+    double &dfMax, double &dfMean, double &dfM2, GUIntBig &nValidCount)
+{
+    int nNoDataLow = 1;
+    int nNoDataHigh = 0;
+    switch (eDataType)
+    {
+        case GDT_Int16:
+            GetIntegerNoDataInterval(sNoDataValues, SHRT_MIN, SHRT_MAX,
+                                     nNoDataLow, nNoDataHigh);
+            break;
+        case GDT_Int32:
+            GetIntegerNoDataInterval(sNoDataValues, INT_MIN, INT_MAX,
+                                     nNoDataLow, nNoDataHigh);
+            break;
+        case GDT_Float32:
+        case GDT_Float64:
+            break;
+        default:
+            return false;
+    }
+
+    // Process lines by groups of at most 2^30 pixels (but at least one
+    // line), so that the integer accumulators of the kernels cannot overflow.
+    const int nLinesPerGroup = std::max(1, (1 << 30) / std::max(1, nXCheck));
+    for (int iY = 0; iY < nYCheck; iY += nLinesPerGroup)
+    {
+        const int nLines = std::min(nLinesPerGroup, nYCheck - iY);
+        const GPtrDiff_t nOffset = static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        GUIntBig nGroupValidCount = 0;
+        double dfGroupMin = 0;
+        double dfGroupMax = 0;
+        double dfGroupMean = 0;
+        double dfGroupM2 = 0;
+        switch (eDataType)
+        {
+            case GDT_Int16:
+            {
+                const GInt16 *panData =
+                    static_cast<const GInt16 *>(pData) + nOffset;
+                int nGroupMin = 0;
+                int nGroupMax = 0;
+                GInt64 nSum = 0;
+                GUIntBig nSumSquare = 0;
+                GDALComputeBlockSumsInt16_AVX2(
+                    panData, nXCheck, nLines, nBlockXSize, nNoDataLow,
+                    nNoDataHigh, nGroupValidCount, nGroupMin, nGroupMax, nSum,
+                    nSumSquare);
+                if (nGroupValidCount == 0)
+                    break;
+                dfGroupMin = nGroupMin;
+                dfGroupMax = nGroupMax;
+                dfGroupMean = static_cast<double>(nSum) / nGroupValidCount;
+                // M2 = (n * sum(x^2) - sum(x)^2) / n, computed exactly
+                // before the final division.
+                const GUIntBig nAbsSum = nSum < 0
+                                             ? static_cast<GUIntBig>(-nSum)
+                                             : static_cast<GUIntBig>(nSum);
+                dfGroupM2 =
+                    static_cast<double>(
+                        GDALUInt128::Mul(nGroupValidCount, nSumSquare) -
+                        GDALUInt128::Mul(nAbsSum, nAbsSum)) /
+                    nGroupValidCount;
+                break;
+            }
+
+            case GDT_Int32:
+            {
+                const GInt32 *panData =
+                    static_cast<const GInt32 *>(pData) + nOffset;
+                int nGroupMin = 0;
+                int nGroupMax = 0;
+                GInt64 nSum = 0;
+                GDALComputeBlockSumsInt32_AVX2(
+                    panData, nXCheck, nLines, nBlockXSize, nNoDataLow,
+                    nNoDataHigh, nGroupValidCount, nGroupMin, nGroupMax, nSum);
+                if (nGroupValidCount == 0)
+                    break;
+                dfGroupMin = nGroupMin;
+                dfGroupMax = nGroupMax;
+                dfGroupMean = static_cast<double>(nSum) / nGroupValidCount;
+                dfGroupM2 = GDALComputeBlockM2Int32_AVX2(
+                    panData, nXCheck, nLines, nBlockXSize, nNoDataLow,
+                    nNoDataHigh, dfGroupMean);
+                break;
+            }
+
+            case GDT_Float32:
+            {
+                const float *pafData =
+                    static_cast<const float *>(pData) + nOffset;
+                double dfSum = 0;
+                GDALComputeBlockSumsFloat32_AVX2(
+                    pafData, nXCheck, nLines, nBlockXSize,
+                    sNoDataValues.bGotFloatNoDataValue,
+                    sNoDataValues.fNoDataValue, nGroupValidCount, dfGroupMin,
+                    dfGroupMax, dfSum);
+                if (nGroupValidCount == 0)
+                    break;
+                dfGroupMean = dfSum / nGroupValidCount;
+                dfGroupM2 = GDALComputeBlockM2Float32_AVX2(
+                    pafData, nXCheck, nLines, nBlockXSize,
+                    sNoDataValues.bGotFloatNoDataValue,
+                    sNoDataValues.fNoDataValue, dfGroupMean);
+                break;
+            }
+
+            default:
+            {
+                CPLAssert(eDataType == GDT_Float64);
+                const double *padfData =
+                    static_cast<const double *>(pData) + nOffset;
+                double dfSum = 0;
+                GDALComputeBlockSumsFloat64_AVX2(
+                    padfData, nXCheck, nLines, nBlockXSize,
+                    CPL_TO_BOOL(sNoDataValues.bGotNoDataValue),
+                    sNoDataValues.dfNoDataValue, nGroupValidCount, dfGroupMin,
+                    dfGroupMax, dfSum);
+                if (nGroupValidCount == 0)
+                    break;
+                dfGroupMean = dfSum / nGroupValidCount;
+                dfGroupM2 = GDALComputeBlockM2Float64_AVX2(
+                    padfData, nXCheck, nLines, nBlockXSize,
+                    CPL_TO_BOOL(sNoDataValues.bGotNoDataValue),
+                    sNoDataValues.dfNoDataValue, dfGroupMean);
+                break;
+            }
+        }
+
+        if (nGroupValidCount == 0)
+            continue;
+        dfMin = std::min(dfMin, dfGroupMin);
+        dfMax = std::max(dfMax, dfGroupMax);
+        MergeWelfordStatistics(nGroupValidCount, dfGroupMean, dfGroupM2,
+                               dfMean, dfM2, nValidCount);
+    }
+    return true;
+}
+
+#endif
+
+/************************************************************************/
+/*                     UpdateStatisticsWithBlock()                      */
+/************************************************************************/
+
+/** Update the running minimum, maximum, mean and M2 (sum of square of
+ * differences to the mean) with the valid pixels of a block, using the
+ * Welford algorithm.
+ */
+static void UpdateStatisticsWithBlock(
+    const void *pData, GDALDataType eDataType, bool bSignedByte,
+    const GByte *pabyMaskData, int nXCheck, int nYCheck, int nBlockXSize,
+    const GDALNoDataValues &sNoDataValues, double &dfMin, double &dfMax,
+    double &dfMean, double &dfM2, GUIntBig &nValidCount)
+{
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+    if (pabyMaskData == nullptr && CPLHaveRuntimeAVX2() &&
+        UpdateStatisticsWithBlockAVX2(pData, eDataType, nXCheck, nYCheck,
+                                      nBlockXSize, sNoDataValues, dfMin, dfMax,
+                                      dfMean, dfM2, nValidCount))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            bool bValid = true;
+            double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
+                                           iOffset, sNoDataValues, bValid);
+
+            if (!bValid)
+                continue;
+
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+
+            nValidCount++;
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / nValidCount;
+            dfM2 += dfDelta * (dfValue - dfMean);
+        }
+    }
+}
+
 /************************************************************************/
 /*                         ComputeStatistics()                          */
 /************************************************************************/
@@ -6342,6 +7468,11 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.11, if the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), blocks are read and processed
+ * by several threads, provided that the dataset can be opened in a
+ * thread-safe way (see GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -6607,34 +7738,23 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            const auto ComputeBlockStatistics =
+                [this, nMaxValueType,
+                 nNoDataValue](const void *pData, int nXCheck, int nYCheck,
+                               GUInt32 &nMinAcc, GUInt32 &nMaxAcc,
+                               GUIntBig &nSumAcc, GUIntBig &nSumSquareAcc,
+                               GUIntBig &nSampleCountAcc,
+                               GUIntBig &nValidCountAcc)
             {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
                 if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue, nMinAcc,
+                          nMaxAcc, nSumAcc, nSumSquareAcc, nSampleCountAcc,
+                          nValidCountAcc);
                 }
                 else
                 {
@@ -6642,21 +7762,98 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue, nMinAcc,
+                          nMaxAcc, nSumAcc, nSumSquareAcc, nSampleCountAcc,
+                          nValidCountAcc);
                 }
+            };
 
-                poBlock->DropLock();
-
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
+            GDALBlockSamplerMultiThreaded oSampler(
+                this, static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn,
+                nSampleRate);
+            if (oSampler.GetChunkCount() > 0)
+            {
+                // Partial results are integers, so merging them gives
+                // exactly the same result as the single-threaded code path.
+                struct ChunkStatistics
+                {
+                    GUInt32 nMin;
+                    GUInt32 nMax;
+                    GUIntBig nSum;
+                    GUIntBig nSumSquare;
+                    GUIntBig nSampleCount;
+                    GUIntBig nValidCount;
+                };
+
+                std::vector<ChunkStatistics> asChunkStats(
+                    oSampler.GetChunkCount(),
+                    ChunkStatistics{nMaxValueType, 0, 0, 0, 0, 0});
+                if (!oSampler.Run(
+                        /* bWithMask = */ false,
+                        [&asChunkStats, &ComputeBlockStatistics](
+                            int iChunk, const void *pData, const GByte *,
+                            int nXCheck, int nYCheck)
+                        {
+                            auto &sStats = asChunkStats[iChunk];
+                            ComputeBlockStatistics(
+                                pData, nXCheck, nYCheck, sStats.nMin,
+                                sStats.nMax, sStats.nSum, sStats.nSumSquare,
+                                sStats.nSampleCount, sStats.nValidCount);
+                            return true;
+                        },
+                        pfnProgress, pProgressData, "Compute Statistics"))
                 {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
                     return CE_Failure;
                 }
+
+                for (const auto &sStats : asChunkStats)
+                {
+                    nMin = std::min(nMin, sStats.nMin);
+                    nMax = std::max(nMax, sStats.nMax);
+                    nSum += sStats.nSum;
+                    nSumSquare += sStats.nSumSquare;
+                    nSampleCount += sStats.nSampleCount;
+                    nValidCount += sStats.nValidCount;
+                }
+            }
+            else
+            {
+                for (GIntBig iSampleBlock = 0;
+                     iSampleBlock <
+                     static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+                     iSampleBlock += nSampleRate)
+                {
+                    const int iYBlock =
+                        static_cast<int>(iSampleBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+                    GDALRasterBlock *const poBlock =
+                        GetLockedBlockRef(iXBlock, iYBlock);
+                    if (poBlock == nullptr)
+                        return CE_Failure;
+
+                    void *const pData = poBlock->GetDataRef();
+
+                    int nXCheck = 0, nYCheck = 0;
+                    GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                    ComputeBlockStatistics(pData, nXCheck, nYCheck, nMin, nMax,
+                                           nSum, nSumSquare, nSampleCount,
+                                           nValidCount);
+
+                    poBlock->DropLock();
+
+                    if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                         (static_cast<double>(nBlocksPerRow) *
+                                          nBlocksPerColumn),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
+                }
             }
 
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6724,93 +7921,128 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             return CE_Failure;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        GDALBlockSamplerMultiThreaded oSampler(
+            this, static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn,
+            nSampleRate);
+        if (oSampler.GetChunkCount() > 0)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            struct ChunkStatistics
+            {
+                double dfMin;
+                double dfMax;
+                double dfMean;
+                double dfM2;
+                GUIntBig nSampleCount;
+                GUIntBig nValidCount;
+            };
+
+            std::vector<ChunkStatistics> asChunkStats(
+                oSampler.GetChunkCount(),
+                ChunkStatistics{dfMin, dfMax, 0.0, 0.0, 0, 0});
+            if (!oSampler.Run(
+                    poMaskBand != nullptr,
+                    [this, bSignedByte, &sNoDataValues, &asChunkStats](
+                        int iChunk, const void *pData,
+                        const GByte *pabyMaskData, int nXCheck, int nYCheck)
+                    {
+                        auto &sStats = asChunkStats[iChunk];
+                        UpdateStatisticsWithBlock(
+                            pData, eDataType, bSignedByte, pabyMaskData,
+                            nXCheck, nYCheck, nBlockXSize, sNoDataValues,
+                            sStats.dfMin, sStats.dfMax, sStats.dfMean,
+                            sStats.dfM2, sStats.nValidCount);
+                        sStats.nSampleCount +=
+                            static_cast<GUIntBig>(nXCheck) * nYCheck;
+                        return true;
+                    },
+                    pfnProgress, pProgressData, "Compute Statistics"))
             {
                 return CE_Failure;
             }
-        }
-
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            // Merge the partial results in chunk order.
+            for (const auto &sStats : asChunkStats)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                nSampleCount += sStats.nSampleCount;
+                if (sStats.nValidCount == 0)
+                    continue;
+                dfMin = std::min(dfMin, sStats.dfMin);
+                dfMax = std::max(dfMax, sStats.dfMax);
+                MergeWelfordStatistics(sStats.nValidCount, sStats.dfMean,
+                                       sStats.dfM2, dfMean, dfM2, nValidCount);
             }
-
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+        }
+        else
+        {
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
             {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
             }
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
+            for (GIntBig iSampleBlock = 0;
+                 iSampleBlock <
+                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+                 iSampleBlock += nSampleRate)
             {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-                    bool bValid = true;
-                    double dfValue =
-                        GetPixelValue(eDataType, bSignedByte, pData, iOffset,
-                                      sNoDataValues, bValid);
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    if (!bValid)
-                        continue;
+                void *const pData = poBlock->GetDataRef();
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                         iYBlock * nBlockYSize, nXCheck,
+                                         nYCheck, pabyMaskData, nXCheck,
+                                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                                         nullptr) != CE_None)
+                {
+                    CPLFree(pabyMaskData);
+                    poBlock->DropLock();
+                    return CE_Failure;
                 }
-            }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                UpdateStatisticsWithBlock(pData, eDataType, bSignedByte,
+                                          pabyMaskData, nXCheck, nYCheck,
+                                          nBlockXSize, sNoDataValues, dfMin,
+                                          dfMax, dfMean, dfM2, nValidCount);
 
-            poBlock->DropLock();
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
 
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                poBlock->DropLock();
+
+                if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                                     (static_cast<double>(nBlocksPerRow) *
+                                      nBlocksPerColumn),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
             }
-        }
 
-        CPLFree(pabyMaskData);
+            CPLFree(pabyMaskData);
+        }
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -7214,6 +8446,11 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.11, if the GDAL_NUM_THREADS configuration option is
+ * set to a value greater than 1 (or ALL_CPUS), blocks are read and processed
+ * by several threads, provided that the dataset can be opened in a
+ * thread-safe way (see GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7304,9 +8541,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, &sNoDataValues, &nMin, &nMax, &nMinInt16,
-         &nMaxInt16](const void *pData, int nXCheck, int nBufferWidth,
-                     int nYCheck)
+        [this, bSignedByte, &sNoDataValues](
+            const void *pData, int nXCheck, int nBufferWidth, int nYCheck,
+            GUInt32 &nMinAcc, GUInt32 &nMaxAcc, GInt16 &nMinInt16Acc,
+            GInt16 &nMaxInt16Acc)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7323,7 +8561,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinAcc, nMaxAcc, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7340,7 +8579,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nMinAcc, nMaxAcc, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7358,7 +8598,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nMinInt16Acc, &nMaxInt16Acc);
                 }
             }
             else
@@ -7368,7 +8608,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nMinInt16Acc, &nMaxInt16Acc);
                 }
             }
         }
@@ -7434,7 +8674,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced,
+                                  nMin, nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -7472,11 +8713,68 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        const GIntBig nTotalBlocks =
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+        GDALBlockSamplerMultiThreaded oSampler(this, nTotalBlocks,
+                                               nSampleRate);
+        if (oSampler.GetChunkCount() > 0)
         {
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+            struct ChunkMinMax
+            {
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GInt16 nMinInt16;
+                GInt16 nMaxInt16;
+                double dfMin;
+                double dfMax;
+            };
+
+            std::vector<ChunkMinMax> asChunkMinMax(
+                oSampler.GetChunkCount(),
+                ChunkMinMax{nMin, nMax, nMinInt16, nMaxInt16, dfMin, dfMax});
+            if (!oSampler.Run(
+                    poMaskBand != nullptr,
+                    [this, bSignedByte, bUseOptimizedPath, &sNoDataValues,
+                     &asChunkMinMax, &ComputeMinMaxForBlock](
+                        int iChunk, const void *pData,
+                        const GByte *pabyMaskData, int nXCheck, int nYCheck)
+                    {
+                        auto &sMinMax = asChunkMinMax[iChunk];
+                        if (bUseOptimizedPath)
+                        {
+                            ComputeMinMaxForBlock(
+                                pData, nXCheck, nBlockXSize, nYCheck,
+                                sMinMax.nMin, sMinMax.nMax, sMinMax.nMinInt16,
+                                sMinMax.nMaxInt16);
+                            // No need to go further once the whole range of
+                            // Byte values has been found.
+                            return !(eDataType == GDT_Byte && !bSignedByte &&
+                                     sMinMax.nMin == 0 && sMinMax.nMax == 255);
+                        }
+                        ComputeMinMaxGeneric(pData, eDataType, bSignedByte,
+                                             nXCheck, nYCheck, nBlockXSize,
+                                             sNoDataValues, pabyMaskData,
+                                             sMinMax.dfMin, sMinMax.dfMax);
+                        return true;
+                    },
+                    nullptr, nullptr, nullptr))
+            {
+                return CE_Failure;
+            }
+
+            for (const auto &sMinMax : asChunkMinMax)
+            {
+                nMin = std::min(nMin, sMinMax.nMin);
+                nMax = std::max(nMax, sMinMax.nMax);
+                nMinInt16 = std::min(nMinInt16, sMinMax.nMinInt16);
+                nMaxInt16 = std::max(nMaxInt16, sMinMax.nMaxInt16);
+                dfMin = std::min(dfMin, sMinMax.dfMin);
+                dfMax = std::max(dfMax, sMinMax.dfMax);
+            }
+        }
+        else if (bUseOptimizedPath)
+        {
+            for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
                  iSampleBlock += nSampleRate)
             {
                 const int iYBlock =
@@ -7493,7 +8791,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      nMin, nMax, nMinInt16, nMaxInt16);
 
                 poBlock->DropLock();
 
@@ -7504,8 +8803,6 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
                     this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
                     nBlocksPerRow, sNoDataValues, poMaskBand, dfMin, dfMax))
@@ -0,0 +1,985 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALRasterBand statistics and histogram
+ *           computation
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#include "gdalrasterband_avx2.h"
+
+#include <immintrin.h>
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+// Note: we deliberately avoid inline functions with external linkage here
+// (including the ones of gdal_priv.h), so that no AVX2 code gets selected by
+// the linker for other translation units. The below helpers must be kept
+// consistent with ARE_REAL_EQUAL() and GetPixelValue() of gdalrasterband.cpp.
+
+constexpr float POS_INF_FLOAT = HUGE_VALF;
+constexpr double POS_INF_DOUBLE = HUGE_VAL;
+
+/************************************************************************/
+/*                           IsValidFloat()                             */
+/************************************************************************/
+
+template <class T> static inline T Abs(T x)
+{
+    return x < 0 ? -x : x;
+}
+
+static inline bool IsValidFloat(float fVal, bool bHasNoData, float fNoData)
+{
+    if (fVal != fVal)  // NaN
+        return false;
+    return !bHasNoData ||
+           !(fVal == fNoData ||
+             Abs(fVal - fNoData) < FLT_EPSILON * Abs(fVal + fNoData) * 2);
+}
+
+static inline bool IsValidDouble(double dfVal, bool bHasNoData,
+                                 double dfNoData)
+{
+    if (dfVal != dfVal)  // NaN
+        return false;
+    return !bHasNoData ||
+           !(dfVal == dfNoData ||
+             Abs(dfVal - dfNoData) < static_cast<double>(FLT_EPSILON) *
+                                         Abs(dfVal + dfNoData) * 2);
+}
+
+/************************************************************************/
+/*                          Horizontal sums                             */
+/************************************************************************/
+
+static inline GInt64 HorizontalSumInt64(__m256i v)
+{
+    const __m128i v128 = _mm_add_epi64(_mm256_castsi256_si128(v),
+                                       _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(v128) + _mm_extract_epi64(v128, 1);
+}
+
+static inline GInt64 HorizontalSumInt32(__m256i v)
+{
+    return HorizontalSumInt64(_mm256_add_epi64(
+        _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)),
+        _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1))));
+}
+
+static inline double HorizontalSumDouble(__m256d v)
+{
+    const __m128d v128 =
+        _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(v128, _mm_unpackhi_pd(v128, v128)));
+}
+
+/************************************************************************/
+/*                     Integer validity mask                            */
+/************************************************************************/
+
+// Return all bits set for pixels outside of [low, high]
+static inline __m256i ValidMaskInt16(__m256i v, __m256i low, __m256i high)
+{
+    return _mm256_or_si256(_mm256_cmpgt_epi16(low, v),
+                           _mm256_cmpgt_epi16(v, high));
+}
+
+static inline __m256i ValidMaskInt32(__m256i v, __m256i low, __m256i high)
+{
+    return _mm256_or_si256(_mm256_cmpgt_epi32(low, v),
+                           _mm256_cmpgt_epi32(v, high));
+}
+
+/************************************************************************/
+/*                  GDALComputeBlockSumsInt16_AVX2()                    */
+/************************************************************************/
+
+void GDALComputeBlockSumsInt16_AVX2(const GInt16 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    GUIntBig &nValidCount, int &nMin,
+                                    int &nMax, GInt64 &nSum,
+                                    GUIntBig &nSumSquare)
+{
+    // An empty interval is represented as [1, 0], which works as such in
+    // the vector comparisons.
+    if (nNoDataLow > nNoDataHigh)
+    {
+        nNoDataLow = 1;
+        nNoDataHigh = 0;
+    }
+    const __m256i ymm_low = _mm256_set1_epi16(static_cast<short>(nNoDataLow));
+    const __m256i ymm_high =
+        _mm256_set1_epi16(static_cast<short>(nNoDataHigh));
+    const __m256i ymm_ones = _mm256_set1_epi16(1);
+    const __m256i ymm_int16_max = _mm256_set1_epi16(SHRT_MAX);
+    const __m256i ymm_int16_min = _mm256_set1_epi16(SHRT_MIN);
+    const __m256i ymm_zero = _mm256_setzero_si256();
+
+    __m256i ymm_min = ymm_int16_max;
+    __m256i ymm_max = ymm_int16_min;
+    __m256i ymm_sumsquare = ymm_zero;  // 4 x uint64
+    GInt64 nLocalValidCount = 0;
+    GInt64 nLocalSum = 0;
+    GUIntBig nLocalSumSquare = 0;
+    int nLocalMin = SHRT_MAX;
+    int nLocalMax = SHRT_MIN;
+
+    constexpr int VALS_PER_ITER = 16;
+    // Each iteration adds at most 2 * 32768 in absolute value to a lane of
+    // the 32-bit accumulators, so they must be flushed regularly.
+    constexpr int MAX_ITERS_32BIT = 16384;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GInt16 *CPL_RESTRICT panLine =
+            panData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        while (nXCheck - iX >= VALS_PER_ITER)
+        {
+            __m256i ymm_sum = ymm_zero;    // 8 x int32
+            __m256i ymm_count = ymm_zero;  // 8 x int32, negated
+            int nIters = (nXCheck - iX) / VALS_PER_ITER;
+            if (nIters > MAX_ITERS_32BIT)
+                nIters = MAX_ITERS_32BIT;
+            for (int i = 0; i < nIters; ++i, iX += VALS_PER_ITER)
+            {
+                const __m256i ymm = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(panLine + iX));
+                const __m256i ymm_mask =
+                    ValidMaskInt16(ymm, ymm_low, ymm_high);
+                const __m256i ymm_valid = _mm256_and_si256(ymm, ymm_mask);
+                ymm_min = _mm256_min_epi16(
+                    ymm_min, _mm256_blendv_epi8(ymm_int16_max, ymm, ymm_mask));
+                ymm_max = _mm256_max_epi16(
+                    ymm_max, _mm256_blendv_epi8(ymm_int16_min, ymm, ymm_mask));
+                ymm_sum = _mm256_add_epi32(
+                    ymm_sum, _mm256_madd_epi16(ymm_valid, ymm_ones));
+                ymm_count = _mm256_add_epi32(
+                    ymm_count, _mm256_madd_epi16(ymm_mask, ymm_ones));
+                // The sum of two squares of int16 values is at most 2^31,
+                // which fits on a uint32.
+                const __m256i ymm_square =
+                    _mm256_madd_epi16(ymm_valid, ymm_valid);
+                ymm_sumsquare = _mm256_add_epi64(
+                    ymm_sumsquare,
+                    _mm256_add_epi64(
+                        _mm256_unpacklo_epi32(ymm_square, ymm_zero),
+                        _mm256_unpackhi_epi32(ymm_square, ymm_zero)));
+            }
+            nLocalSum += HorizontalSumInt32(ymm_sum);
+            nLocalValidCount -= HorizontalSumInt32(ymm_count);
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const int nVal = panLine[iX];
+            if (nVal >= nNoDataLow && nVal <= nNoDataHigh)
+                continue;
+            nLocalValidCount++;
+            nLocalSum += nVal;
+            nLocalSumSquare += static_cast<GUIntBig>(nVal * nVal);
+            if (nVal < nLocalMin)
+                nLocalMin = nVal;
+            if (nVal > nLocalMax)
+                nLocalMax = nVal;
+        }
+    }
+
+    GInt16 anMin[16];
+    GInt16 anMax[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(anMin), ymm_min);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(anMax), ymm_max);
+    for (int i = 0; i < 16; ++i)
+    {
+        if (anMin[i] < nLocalMin)
+            nLocalMin = anMin[i];
+        if (anMax[i] > nLocalMax)
+            nLocalMax = anMax[i];
+    }
+
+    nValidCount = static_cast<GUIntBig>(nLocalValidCount);
+    nMin = nLocalMin;
+    nMax = nLocalMax;
+    nSum = nLocalSum;
+    nSumSquare = nLocalSumSquare +
+                 static_cast<GUIntBig>(HorizontalSumInt64(ymm_sumsquare));
+}
+
+/************************************************************************/
+/*                  GDALComputeBlockSumsInt32_AVX2()                    */
+/************************************************************************/
+
+void GDALComputeBlockSumsInt32_AVX2(const GInt32 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    GUIntBig &nValidCount, int &nMin,
+                                    int &nMax, GInt64 &nSum)
+{
+    if (nNoDataLow > nNoDataHigh)
+    {
+        nNoDataLow = 1;
+        nNoDataHigh = 0;
+    }
+    const __m256i ymm_low = _mm256_set1_epi32(nNoDataLow);
+    const __m256i ymm_high = _mm256_set1_epi32(nNoDataHigh);
+    const __m256i ymm_int32_max = _mm256_set1_epi32(INT_MAX);
+    const __m256i ymm_int32_min = _mm256_set1_epi32(INT_MIN);
+    const __m256i ymm_zero = _mm256_setzero_si256();
+
+    __m256i ymm_min = ymm_int32_max;
+    __m256i ymm_max = ymm_int32_min;
+    __m256i ymm_sum_lo = ymm_zero;  // 4 x int64
+    __m256i ymm_sum_hi = ymm_zero;  // 4 x int64
+    __m256i ymm_count = ymm_zero;   // 8 x int32, negated
+    GInt64 nLocalValidCount = 0;
+    GInt64 nLocalSum = 0;
+    int nLocalMin = INT_MAX;
+    int nLocalMax = INT_MIN;
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GInt32 *CPL_RESTRICT panLine =
+            panData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256i ymm = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(panLine + iX));
+            const __m256i ymm_mask = ValidMaskInt32(ymm, ymm_low, ymm_high);
+            const __m256i ymm_valid = _mm256_and_si256(ymm, ymm_mask);
+            ymm_min = _mm256_min_epi32(
+                ymm_min, _mm256_blendv_epi8(ymm_int32_max, ymm, ymm_mask));
+            ymm_max = _mm256_max_epi32(
+                ymm_max, _mm256_blendv_epi8(ymm_int32_min, ymm, ymm_mask));
+            ymm_sum_lo = _mm256_add_epi64(
+                ymm_sum_lo,
+                _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ymm_valid)));
+            ymm_sum_hi = _mm256_add_epi64(
+                ymm_sum_hi,
+                _mm256_cvtepi32_epi64(_mm256_extracti128_si256(ymm_valid, 1)));
+            ymm_count = _mm256_add_epi32(ymm_count, ymm_mask);
+        }
+        // Flush the 32-bit counters at the end of each line
+        nLocalValidCount -= HorizontalSumInt32(ymm_count);
+        ymm_count = ymm_zero;
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const int nVal = panLine[iX];
+            if (nVal >= nNoDataLow && nVal <= nNoDataHigh)
+                continue;
+            nLocalValidCount++;
+            nLocalSum += nVal;
+            if (nVal < nLocalMin)
+                nLocalMin = nVal;
+            if (nVal > nLocalMax)
+                nLocalMax = nVal;
+        }
+    }
+
+    int anMin[8];
+    int anMax[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(anMin), ymm_min);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(anMax), ymm_max);
+    for (int i = 0; i < 8; ++i)
+    {
+        if (anMin[i] < nLocalMin)
+            nLocalMin = anMin[i];
+        if (anMax[i] > nLocalMax)
+            nLocalMax = anMax[i];
+    }
+
+    nValidCount = static_cast<GUIntBig>(nLocalValidCount);
+    nMin = nLocalMin;
+    nMax = nLocalMax;
+    nSum = nLocalSum +
+           HorizontalSumInt64(_mm256_add_epi64(ymm_sum_lo, ymm_sum_hi));
+}
+
+/************************************************************************/
+/*                   GDALComputeBlockM2Int32_AVX2()                     */
+/************************************************************************/
+
+double GDALComputeBlockM2Int32_AVX2(const GInt32 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    double dfMean)
+{
+    if (nNoDataLow > nNoDataHigh)
+    {
+        nNoDataLow = 1;
+        nNoDataHigh = 0;
+    }
+    const __m256i ymm_low = _mm256_set1_epi32(nNoDataLow);
+    const __m256i ymm_high = _mm256_set1_epi32(nNoDataHigh);
+    const __m256d ymm_mean = _mm256_set1_pd(dfMean);
+
+    __m256d ymm_m2_lo = _mm256_setzero_pd();
+    __m256d ymm_m2_hi = _mm256_setzero_pd();
+    double dfM2 = 0;
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GInt32 *CPL_RESTRICT panLine =
+            panData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256i ymm = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(panLine + iX));
+            const __m256i ymm_mask = ValidMaskInt32(ymm, ymm_low, ymm_high);
+            const __m256d ymm_mask_lo = _mm256_castsi256_pd(
+                _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ymm_mask)));
+            const __m256d ymm_mask_hi = _mm256_castsi256_pd(
+                _mm256_cvtepi32_epi64(_mm256_extracti128_si256(ymm_mask, 1)));
+            const __m256d ymm_delta_lo = _mm256_and_pd(
+                _mm256_sub_pd(
+                    _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm)), ymm_mean),
+                ymm_mask_lo);
+            const __m256d ymm_delta_hi = _mm256_and_pd(
+                _mm256_sub_pd(
+                    _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1)),
+                    ymm_mean),
+                ymm_mask_hi);
+            ymm_m2_lo = _mm256_add_pd(
+                ymm_m2_lo, _mm256_mul_pd(ymm_delta_lo, ymm_delta_lo));
+            ymm_m2_hi = _mm256_add_pd(
+                ymm_m2_hi, _mm256_mul_pd(ymm_delta_hi, ymm_delta_hi));
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const int nVal = panLine[iX];
+            if (nVal >= nNoDataLow && nVal <= nNoDataHigh)
+                continue;
+            const double dfDelta = nVal - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    return dfM2 + HorizontalSumDouble(_mm256_add_pd(ymm_m2_lo, ymm_m2_hi));
+}
+
+/************************************************************************/
+/*                      Floating-point validity mask                    */
+/************************************************************************/
+
+// Return all bits set for pixels that are not NaN, and not equal to the
+// nodata value in the sense of ARE_REAL_EQUAL()
+static inline __m256 ValidMaskFloat32(__m256 v, bool bHasNoData,
+                                      __m256 noData)
+{
+    const __m256 notNaN = _mm256_cmp_ps(v, v, _CMP_ORD_Q);
+    if (!bHasNoData)
+        return notNaN;
+    const __m256 absMask =
+        _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 absDiff = _mm256_and_ps(_mm256_sub_ps(v, noData), absMask);
+    const __m256 tolerance = _mm256_mul_ps(
+        _mm256_mul_ps(_mm256_set1_ps(FLT_EPSILON),
+                      _mm256_and_ps(_mm256_add_ps(v, noData), absMask)),
+        _mm256_set1_ps(2.0f));
+    const __m256 isNoData =
+        _mm256_or_ps(_mm256_cmp_ps(v, noData, _CMP_EQ_OQ),
+                     _mm256_cmp_ps(absDiff, tolerance, _CMP_LT_OQ));
+    return _mm256_andnot_ps(isNoData, notNaN);
+}
+
+static inline __m256d ValidMaskFloat64(__m256d v, bool bHasNoData,
+                                       __m256d noData)
+{
+    const __m256d notNaN = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+    if (!bHasNoData)
+        return notNaN;
+    const __m256d absMask =
+        _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m256d absDiff = _mm256_and_pd(_mm256_sub_pd(v, noData), absMask);
+    const __m256d tolerance = _mm256_mul_pd(
+        _mm256_mul_pd(_mm256_set1_pd(static_cast<double>(FLT_EPSILON)),
+                      _mm256_and_pd(_mm256_add_pd(v, noData), absMask)),
+        _mm256_set1_pd(2.0));
+    const __m256d isNoData =
+        _mm256_or_pd(_mm256_cmp_pd(v, noData, _CMP_EQ_OQ),
+                     _mm256_cmp_pd(absDiff, tolerance, _CMP_LT_OQ));
+    return _mm256_andnot_pd(isNoData, notNaN);
+}
+
+/************************************************************************/
+/*                 GDALComputeBlockSumsFloat32_AVX2()                   */
+/************************************************************************/
+
+void GDALComputeBlockSumsFloat32_AVX2(const float *CPL_RESTRICT pafData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      float fNoDataValue,
+                                      GUIntBig &nValidCount, double &dfMin,
+                                      double &dfMax, double &dfSum)
+{
+    const __m256 ymm_nodata = _mm256_set1_ps(fNoDataValue);
+    const __m256 ymm_pos_inf =
+        _mm256_set1_ps(POS_INF_FLOAT);
+    const __m256 ymm_neg_inf =
+        _mm256_set1_ps(-POS_INF_FLOAT);
+
+    __m256 ymm_min = ymm_pos_inf;
+    __m256 ymm_max = ymm_neg_inf;
+    __m256d ymm_sum_lo = _mm256_setzero_pd();
+    __m256d ymm_sum_hi = _mm256_setzero_pd();
+    __m256i ymm_count = _mm256_setzero_si256();  // 8 x int32, negated
+    GInt64 nLocalValidCount = 0;
+    double dfLocalSum = 0;
+    float fLocalMin = POS_INF_FLOAT;
+    float fLocalMax = -POS_INF_FLOAT;
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const float *CPL_RESTRICT pafLine =
+            pafData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256 ymm = _mm256_loadu_ps(pafLine + iX);
+            const __m256 ymm_mask =
+                ValidMaskFloat32(ymm, bHasNoData, ymm_nodata);
+            const __m256 ymm_valid = _mm256_and_ps(ymm, ymm_mask);
+            ymm_min = _mm256_min_ps(
+                ymm_min, _mm256_blendv_ps(ymm_pos_inf, ymm, ymm_mask));
+            ymm_max = _mm256_max_ps(
+                ymm_max, _mm256_blendv_ps(ymm_neg_inf, ymm, ymm_mask));
+            ymm_sum_lo = _mm256_add_pd(
+                ymm_sum_lo,
+                _mm256_cvtps_pd(_mm256_castps256_ps128(ymm_valid)));
+            ymm_sum_hi = _mm256_add_pd(
+                ymm_sum_hi,
+                _mm256_cvtps_pd(_mm256_extractf128_ps(ymm_valid, 1)));
+            ymm_count =
+                _mm256_add_epi32(ymm_count, _mm256_castps_si256(ymm_mask));
+        }
+        nLocalValidCount -= HorizontalSumInt32(ymm_count);
+        ymm_count = _mm256_setzero_si256();
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const float fVal = pafLine[iX];
+            if (!IsValidFloat(fVal, bHasNoData, fNoDataValue))
+                continue;
+            nLocalValidCount++;
+            dfLocalSum += fVal;
+            if (fVal < fLocalMin)
+                fLocalMin = fVal;
+            if (fVal > fLocalMax)
+                fLocalMax = fVal;
+        }
+    }
+
+    float afMin[8];
+    float afMax[8];
+    _mm256_storeu_ps(afMin, ymm_min);
+    _mm256_storeu_ps(afMax, ymm_max);
+    for (int i = 0; i < 8; ++i)
+    {
+        if (afMin[i] < fLocalMin)
+            fLocalMin = afMin[i];
+        if (afMax[i] > fLocalMax)
+            fLocalMax = afMax[i];
+    }
+
+    nValidCount = static_cast<GUIntBig>(nLocalValidCount);
+    dfMin = fLocalMin;
+    dfMax = fLocalMax;
+    dfSum =
+        dfLocalSum + HorizontalSumDouble(_mm256_add_pd(ymm_sum_lo, ymm_sum_hi));
+}
+
+/************************************************************************/
+/*                  GDALComputeBlockM2Float32_AVX2()                    */
+/************************************************************************/
+
+double GDALComputeBlockM2Float32_AVX2(const float *CPL_RESTRICT pafData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      float fNoDataValue, double dfMean)
+{
+    const __m256 ymm_nodata = _mm256_set1_ps(fNoDataValue);
+    const __m256d ymm_mean = _mm256_set1_pd(dfMean);
+
+    __m256d ymm_m2_lo = _mm256_setzero_pd();
+    __m256d ymm_m2_hi = _mm256_setzero_pd();
+    double dfM2 = 0;
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const float *CPL_RESTRICT pafLine =
+            pafData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256 ymm = _mm256_loadu_ps(pafLine + iX);
+            const __m256i ymm_mask = _mm256_castps_si256(
+                ValidMaskFloat32(ymm, bHasNoData, ymm_nodata));
+            const __m256d ymm_mask_lo = _mm256_castsi256_pd(
+                _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ymm_mask)));
+            const __m256d ymm_mask_hi = _mm256_castsi256_pd(
+                _mm256_cvtepi32_epi64(_mm256_extracti128_si256(ymm_mask, 1)));
+            const __m256d ymm_delta_lo = _mm256_and_pd(
+                _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(ymm)),
+                              ymm_mean),
+                ymm_mask_lo);
+            const __m256d ymm_delta_hi = _mm256_and_pd(
+                _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(ymm, 1)),
+                              ymm_mean),
+                ymm_mask_hi);
+            ymm_m2_lo = _mm256_add_pd(
+                ymm_m2_lo, _mm256_mul_pd(ymm_delta_lo, ymm_delta_lo));
+            ymm_m2_hi = _mm256_add_pd(
+                ymm_m2_hi, _mm256_mul_pd(ymm_delta_hi, ymm_delta_hi));
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const float fVal = pafLine[iX];
+            if (!IsValidFloat(fVal, bHasNoData, fNoDataValue))
+                continue;
+            const double dfDelta = fVal - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    return dfM2 + HorizontalSumDouble(_mm256_add_pd(ymm_m2_lo, ymm_m2_hi));
+}
+
+/************************************************************************/
+/*                 GDALComputeBlockSumsFloat64_AVX2()                   */
+/************************************************************************/
+
+void GDALComputeBlockSumsFloat64_AVX2(const double *CPL_RESTRICT padfData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      double dfNoDataValue,
+                                      GUIntBig &nValidCount, double &dfMin,
+                                      double &dfMax, double &dfSum)
+{
+    const __m256d ymm_nodata = _mm256_set1_pd(dfNoDataValue);
+    const __m256d ymm_pos_inf =
+        _mm256_set1_pd(POS_INF_DOUBLE);
+    const __m256d ymm_neg_inf =
+        _mm256_set1_pd(-POS_INF_DOUBLE);
+
+    __m256d ymm_min = ymm_pos_inf;
+    __m256d ymm_max = ymm_neg_inf;
+    __m256d ymm_sum = _mm256_setzero_pd();
+    __m256i ymm_count = _mm256_setzero_si256();  // 4 x int64, negated
+    GInt64 nLocalValidCount = 0;
+    double dfLocalSum = 0;
+    double dfLocalMin = POS_INF_DOUBLE;
+    double dfLocalMax = -POS_INF_DOUBLE;
+
+    constexpr int VALS_PER_ITER = 4;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const double *CPL_RESTRICT padfLine =
+            padfData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256d ymm = _mm256_loadu_pd(padfLine + iX);
+            const __m256d ymm_mask =
+                ValidMaskFloat64(ymm, bHasNoData, ymm_nodata);
+            ymm_min = _mm256_min_pd(
+                ymm_min, _mm256_blendv_pd(ymm_pos_inf, ymm, ymm_mask));
+            ymm_max = _mm256_max_pd(
+                ymm_max, _mm256_blendv_pd(ymm_neg_inf, ymm, ymm_mask));
+            ymm_sum = _mm256_add_pd(ymm_sum, _mm256_and_pd(ymm, ymm_mask));
+            ymm_count =
+                _mm256_add_epi64(ymm_count, _mm256_castpd_si256(ymm_mask));
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const double dfVal = padfLine[iX];
+            if (!IsValidDouble(dfVal, bHasNoData, dfNoDataValue))
+                continue;
+            nLocalValidCount++;
+            dfLocalSum += dfVal;
+            if (dfVal < dfLocalMin)
+                dfLocalMin = dfVal;
+            if (dfVal > dfLocalMax)
+                dfLocalMax = dfVal;
+        }
+    }
+
+    double adfMin[4];
+    double adfMax[4];
+    _mm256_storeu_pd(adfMin, ymm_min);
+    _mm256_storeu_pd(adfMax, ymm_max);
+    for (int i = 0; i < 4; ++i)
+    {
+        if (adfMin[i] < dfLocalMin)
+            dfLocalMin = adfMin[i];
+        if (adfMax[i] > dfLocalMax)
+            dfLocalMax = adfMax[i];
+    }
+
+    nValidCount =
+        static_cast<GUIntBig>(nLocalValidCount - HorizontalSumInt64(ymm_count));
+    dfMin = dfLocalMin;
+    dfMax = dfLocalMax;
+    dfSum = dfLocalSum + HorizontalSumDouble(ymm_sum);
+}
+
+/************************************************************************/
+/*                  GDALComputeBlockM2Float64_AVX2()                    */
+/************************************************************************/
+
+double GDALComputeBlockM2Float64_AVX2(const double *CPL_RESTRICT padfData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      double dfNoDataValue, double dfMean)
+{
+    const __m256d ymm_nodata = _mm256_set1_pd(dfNoDataValue);
+    const __m256d ymm_mean = _mm256_set1_pd(dfMean);
+
+    __m256d ymm_m2 = _mm256_setzero_pd();
+    double dfM2 = 0;
+
+    constexpr int VALS_PER_ITER = 4;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const double *CPL_RESTRICT padfLine =
+            padfData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256d ymm = _mm256_loadu_pd(padfLine + iX);
+            const __m256d ymm_mask =
+                ValidMaskFloat64(ymm, bHasNoData, ymm_nodata);
+            const __m256d ymm_delta =
+                _mm256_and_pd(_mm256_sub_pd(ymm, ymm_mean), ymm_mask);
+            ymm_m2 = _mm256_add_pd(ymm_m2, _mm256_mul_pd(ymm_delta, ymm_delta));
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const double dfVal = padfLine[iX];
+            if (!IsValidDouble(dfVal, bHasNoData, dfNoDataValue))
+                continue;
+            const double dfDelta = dfVal - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    return dfM2 + HorizontalSumDouble(ymm_m2);
+}
+
+/************************************************************************/
+/*                          Histogram binning                           */
+/************************************************************************/
+
+namespace
+{
+struct HistogramParams
+{
+    double dfMin;
+    double dfScale;
+    int nBuckets;
+    bool bIncludeOutOfRange;
+    __m256d ymm_min;
+    __m256d ymm_scale;
+    __m256d ymm_zero;
+    __m256d ymm_last;
+    __m256d ymm_scratch;
+
+    HistogramParams(double dfMinIn, double dfScaleIn, int nBucketsIn,
+                    bool bIncludeOutOfRangeIn)
+        : dfMin(dfMinIn), dfScale(dfScaleIn), nBuckets(nBucketsIn),
+          bIncludeOutOfRange(bIncludeOutOfRangeIn),
+          ymm_min(_mm256_set1_pd(dfMinIn)),
+          ymm_scale(_mm256_set1_pd(dfScaleIn)),
+          ymm_zero(_mm256_setzero_pd()),
+          ymm_last(_mm256_set1_pd(static_cast<double>(nBucketsIn - 1))),
+          ymm_scratch(_mm256_set1_pd(static_cast<double>(nBucketsIn)))
+    {
+    }
+};
+}  // namespace
+
+// Add 4 values to the histogram. Lanes of ymm_valid with all bits set are
+// the valid values.
+static inline void AddToHistogram(__m256d ymm_val, __m256d ymm_valid,
+                                  const HistogramParams &sParams,
+                                  GUIntBig *CPL_RESTRICT panHistogram)
+{
+    // Same computation as in GetHistogram(). For valid values, the index
+    // cannot be NaN.
+    const __m256d ymm_index = _mm256_floor_pd(_mm256_mul_pd(
+        _mm256_sub_pd(ymm_val, sParams.ymm_min), sParams.ymm_scale));
+    __m256d ymm_keep = ymm_valid;
+    if (!sParams.bIncludeOutOfRange)
+    {
+        ymm_keep = _mm256_and_pd(
+            ymm_keep,
+            _mm256_and_pd(
+                _mm256_cmp_pd(ymm_index, sParams.ymm_zero, _CMP_GE_OQ),
+                _mm256_cmp_pd(ymm_index, sParams.ymm_last, _CMP_LE_OQ)));
+    }
+    // _mm256_max_pd() returns its second operand for NaN lanes
+    const __m256d ymm_clamped = _mm256_min_pd(
+        _mm256_max_pd(ymm_index, sParams.ymm_zero), sParams.ymm_last);
+    const __m128i xmm_index = _mm256_cvttpd_epi32(
+        _mm256_blendv_pd(sParams.ymm_scratch, ymm_clamped, ymm_keep));
+
+    alignas(16) int anIndex[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(anIndex), xmm_index);
+    ++panHistogram[anIndex[0]];
+    ++panHistogram[anIndex[1]];
+    ++panHistogram[anIndex[2]];
+    ++panHistogram[anIndex[3]];
+}
+
+static inline void AddToHistogram(double dfVal, const HistogramParams &sParams,
+                                  GUIntBig *CPL_RESTRICT panHistogram)
+{
+    const double dfIndex = floor((dfVal - sParams.dfMin) * sParams.dfScale);
+    if (dfIndex < 0)
+    {
+        if (sParams.bIncludeOutOfRange)
+            ++panHistogram[0];
+    }
+    else if (dfIndex >= sParams.nBuckets)
+    {
+        if (sParams.bIncludeOutOfRange)
+            ++panHistogram[sParams.nBuckets - 1];
+    }
+    else
+    {
+        ++panHistogram[static_cast<int>(dfIndex)];
+    }
+}
+
+// Load 8 values, converted to int32
+static inline __m256i LoadAsInt32(const GByte *pabyData)
+{
+    return _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pabyData)));
+}
+
+static inline __m256i LoadAsInt32(const GUInt16 *panData)
+{
+    return _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panData)));
+}
+
+static inline __m256i LoadAsInt32(const GInt16 *panData)
+{
+    return _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panData)));
+}
+
+static inline __m256i LoadAsInt32(const GInt32 *panData)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(panData));
+}
+
+/************************************************************************/
+/*                   ComputeBlockHistogramInteger()                     */
+/************************************************************************/
+
+template <class T>
+static void ComputeBlockHistogramInteger(
+    const T *CPL_RESTRICT panData, int nXCheck, int nYCheck, int nLineStride,
+    int nNoDataLow, int nNoDataHigh, double dfMin, double dfScale,
+    int nBuckets, bool bIncludeOutOfRange, GUIntBig *CPL_RESTRICT panHistogram)
+{
+    if (nNoDataLow > nNoDataHigh)
+    {
+        nNoDataLow = 1;
+        nNoDataHigh = 0;
+    }
+    const __m256i ymm_low = _mm256_set1_epi32(nNoDataLow);
+    const __m256i ymm_high = _mm256_set1_epi32(nNoDataHigh);
+    const HistogramParams sParams(dfMin, dfScale, nBuckets,
+                                  bIncludeOutOfRange);
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const T *CPL_RESTRICT panLine =
+            panData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256i ymm = LoadAsInt32(panLine + iX);
+            const __m256i ymm_mask = ValidMaskInt32(ymm, ymm_low, ymm_high);
+            AddToHistogram(
+                _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm)),
+                _mm256_castsi256_pd(
+                    _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ymm_mask))),
+                sParams, panHistogram);
+            AddToHistogram(
+                _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm, 1)),
+                _mm256_castsi256_pd(_mm256_cvtepi32_epi64(
+                    _mm256_extracti128_si256(ymm_mask, 1))),
+                sParams, panHistogram);
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const int nVal = panLine[iX];
+            if (nVal >= nNoDataLow && nVal <= nNoDataHigh)
+                continue;
+            AddToHistogram(static_cast<double>(nVal), sParams, panHistogram);
+        }
+    }
+}
+
+/************************************************************************/
+/*                 GDALComputeBlockHistogramXXXX_AVX2()                 */
+/************************************************************************/
+
+void GDALComputeBlockHistogramUInt8_AVX2(
+    const GByte *CPL_RESTRICT pabyData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    ComputeBlockHistogramInteger(pabyData, nXCheck, nYCheck, nLineStride,
+                                 nNoDataLow, nNoDataHigh, dfMin, dfScale,
+                                 nBuckets, bIncludeOutOfRange, panHistogram);
+}
+
+void GDALComputeBlockHistogramUInt16_AVX2(
+    const GUInt16 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    ComputeBlockHistogramInteger(panData, nXCheck, nYCheck, nLineStride,
+                                 nNoDataLow, nNoDataHigh, dfMin, dfScale,
+                                 nBuckets, bIncludeOutOfRange, panHistogram);
+}
+
+void GDALComputeBlockHistogramInt16_AVX2(
+    const GInt16 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    ComputeBlockHistogramInteger(panData, nXCheck, nYCheck, nLineStride,
+                                 nNoDataLow, nNoDataHigh, dfMin, dfScale,
+                                 nBuckets, bIncludeOutOfRange, panHistogram);
+}
+
+void GDALComputeBlockHistogramInt32_AVX2(
+    const GInt32 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    ComputeBlockHistogramInteger(panData, nXCheck, nYCheck, nLineStride,
+                                 nNoDataLow, nNoDataHigh, dfMin, dfScale,
+                                 nBuckets, bIncludeOutOfRange, panHistogram);
+}
+
+void GDALComputeBlockHistogramFloat32_AVX2(
+    const float *CPL_RESTRICT pafData, int nXCheck, int nYCheck,
+    int nLineStride, bool bHasNoData, float fNoDataValue, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    const __m256 ymm_nodata = _mm256_set1_ps(fNoDataValue);
+    const HistogramParams sParams(dfMin, dfScale, nBuckets,
+                                  bIncludeOutOfRange);
+
+    constexpr int VALS_PER_ITER = 8;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const float *CPL_RESTRICT pafLine =
+            pafData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256 ymm = _mm256_loadu_ps(pafLine + iX);
+            const __m256i ymm_mask = _mm256_castps_si256(
+                ValidMaskFloat32(ymm, bHasNoData, ymm_nodata));
+            AddToHistogram(
+                _mm256_cvtps_pd(_mm256_castps256_ps128(ymm)),
+                _mm256_castsi256_pd(
+                    _mm256_cvtepi32_epi64(_mm256_castsi256_si128(ymm_mask))),
+                sParams, panHistogram);
+            AddToHistogram(
+                _mm256_cvtps_pd(_mm256_extractf128_ps(ymm, 1)),
+                _mm256_castsi256_pd(_mm256_cvtepi32_epi64(
+                    _mm256_extracti128_si256(ymm_mask, 1))),
+                sParams, panHistogram);
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const float fVal = pafLine[iX];
+            if (!IsValidFloat(fVal, bHasNoData, fNoDataValue))
+                continue;
+            AddToHistogram(static_cast<double>(fVal), sParams, panHistogram);
+        }
+    }
+}
+
+void GDALComputeBlockHistogramFloat64_AVX2(
+    const double *CPL_RESTRICT padfData, int nXCheck, int nYCheck,
+    int nLineStride, bool bHasNoData, double dfNoDataValue, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram)
+{
+    const __m256d ymm_nodata = _mm256_set1_pd(dfNoDataValue);
+    const HistogramParams sParams(dfMin, dfScale, nBuckets,
+                                  bIncludeOutOfRange);
+
+    constexpr int VALS_PER_ITER = 4;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const double *CPL_RESTRICT padfLine =
+            padfData + static_cast<GPtrDiff_t>(iY) * nLineStride;
+        int iX = 0;
+        for (; iX + VALS_PER_ITER <= nXCheck; iX += VALS_PER_ITER)
+        {
+            const __m256d ymm = _mm256_loadu_pd(padfLine + iX);
+            AddToHistogram(ymm, ValidMaskFloat64(ymm, bHasNoData, ymm_nodata),
+                           sParams, panHistogram);
+        }
+
+        for (; iX < nXCheck; ++iX)
+        {
+            const double dfVal = padfLine[iX];
+            if (!IsValidDouble(dfVal, bHasNoData, dfNoDataValue))
+                continue;
+            AddToHistogram(dfVal, sParams, panHistogram);
+        }
+    }
+}
+
+#endif  // defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) ||
+        // defined(_M_X64))
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALRasterBand statistics and histogram
+ *           computation
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALRASTERBAND_AVX2_H_INCLUDED
+#define GDALRASTERBAND_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+//! @cond Doxygen_Suppress
+
+// All functions below process nYCheck lines of nXCheck pixels, separated by
+// nLineStride pixels, and ignore invalid pixels.
+// For integer data types, a pixel is invalid if its value is in the
+// [nNoDataLow, nNoDataHigh] interval (which is empty if nNoDataLow >
+// nNoDataHigh).
+// For floating-point data types, a pixel is invalid if it is NaN, or if
+// bHasNoData is set and ARE_REAL_EQUAL(value, noData) is true.
+// nMin/nMax and dfMin/dfMax are only meaningful if nValidCount > 0.
+
+void GDALComputeBlockSumsInt16_AVX2(const GInt16 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    GUIntBig &nValidCount, int &nMin,
+                                    int &nMax, GInt64 &nSum,
+                                    GUIntBig &nSumSquare);
+
+void GDALComputeBlockSumsInt32_AVX2(const GInt32 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    GUIntBig &nValidCount, int &nMin,
+                                    int &nMax, GInt64 &nSum);
+
+double GDALComputeBlockM2Int32_AVX2(const GInt32 *CPL_RESTRICT panData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    int nNoDataLow, int nNoDataHigh,
+                                    double dfMean);
+
+void GDALComputeBlockSumsFloat32_AVX2(const float *CPL_RESTRICT pafData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      float fNoDataValue,
+                                      GUIntBig &nValidCount, double &dfMin,
+                                      double &dfMax, double &dfSum);
+
+double GDALComputeBlockM2Float32_AVX2(const float *CPL_RESTRICT pafData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      float fNoDataValue, double dfMean);
+
+void GDALComputeBlockSumsFloat64_AVX2(const double *CPL_RESTRICT padfData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      double dfNoDataValue,
+                                      GUIntBig &nValidCount, double &dfMin,
+                                      double &dfMax, double &dfSum);
+
+double GDALComputeBlockM2Float64_AVX2(const double *CPL_RESTRICT padfData,
+                                      int nXCheck, int nYCheck,
+                                      int nLineStride, bool bHasNoData,
+                                      double dfNoDataValue, double dfMean);
+
+// The GDALComputeBlockHistogramXXXX_AVX2() functions add the valid pixels
+// to panHistogram, in the bucket floor((value - dfMin) * dfScale) like
+// GDALRasterBand::GetHistogram() does. panHistogram must have nBuckets + 1
+// entries: the last one is a scratch bucket, where invalid pixels, and
+// out-of-range ones if bIncludeOutOfRange is not set, are counted.
+
+void GDALComputeBlockHistogramUInt8_AVX2(
+    const GByte *CPL_RESTRICT pabyData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+void GDALComputeBlockHistogramUInt16_AVX2(
+    const GUInt16 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+void GDALComputeBlockHistogramInt16_AVX2(
+    const GInt16 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+void GDALComputeBlockHistogramInt32_AVX2(
+    const GInt32 *CPL_RESTRICT panData, int nXCheck, int nYCheck,
+    int nLineStride, int nNoDataLow, int nNoDataHigh, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+void GDALComputeBlockHistogramFloat32_AVX2(
+    const float *CPL_RESTRICT pafData, int nXCheck, int nYCheck,
+    int nLineStride, bool bHasNoData, float fNoDataValue, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+void GDALComputeBlockHistogramFloat64_AVX2(
+    const double *CPL_RESTRICT padfData, int nXCheck, int nYCheck,
+    int nLineStride, bool bHasNoData, double dfNoDataValue, double dfMin,
+    double dfScale, int nBuckets, bool bIncludeOutOfRange,
+    GUIntBig *CPL_RESTRICT panHistogram);
+
+//! @endcond
+
+#endif
+
+#endif /* GDALRASTERBAND_AVX2_H_INCLUDED */
@@ -17,8 +17,11 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <limits>
 #include <mutex>
 
 #include "cpl_atomic_ops.h"
@@ -30,21 +33,36 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
-#else
+/************************************************************************/
+/*                      GDALRasterBlockCacheShard                       */
+/************************************************************************/
+
+// The global block cache is split into one or several shards, each with
+// its own lock and LRU list. By default there is a single shard, which is
+// the historical behavior. With GDAL_BLOCK_CACHE_SHARDS > 1, a block is
+// assigned to a shard from a hash of its band and block coordinates, so
+// that threads working on different blocks rarely compete for the same lock.
+
+constexpr int MAX_CACHE_SHARDS = 64;
+
+namespace
+{
+struct GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    std::atomic<GIntBig> nCacheUsed{0};
+};
+}  // namespace
+
+static GDALRasterBlockCacheShard aoShards[MAX_CACHE_SHARDS];
+static int nShards = 1;
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -75,13 +93,110 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(oShard)                                                \
+    CPLLockHolderD(&((oShard).hLock), GetLockType());                          \
+    CPLLockSetDebugPerf((oShard).hLock, bDebugContention)
+#define TAKE_LOCK(oShard) CPLLockHolderOptionalLockD((oShard).hLock)
+#define DESTROY_LOCK(oShard) CPLDestroyLock((oShard).hLock)
 
-#endif
+/************************************************************************/
+/*                          InitializeLocks()                           */
+/************************************************************************/
+
+static void InitializeLocks()
+{
+    for (int i = 0; i < nShards; ++i)
+    {
+        INITIALIZE_LOCK(aoShards[i]);
+    }
+}
+
+/************************************************************************/
+/*                        GetNumberOfShards()                           */
+/************************************************************************/
+
+static int GetNumberOfShards()
+{
+    const char *pszShards = CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1");
+    int nVal;
+    if (EQUAL(pszShards, "AUTO") || EQUAL(pszShards, "ALL_CPUS"))
+    {
+        nVal = CPLGetNumCPUs();
+    }
+    else
+    {
+        nVal = atoi(pszShards);
+        if (nVal <= 0)
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "Invalid value for GDAL_BLOCK_CACHE_SHARDS. Using 1");
+            nVal = 1;
+        }
+    }
+    return std::min(nVal, MAX_CACHE_SHARDS);
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+static GDALRasterBlockCacheShard &GetShard(const GDALRasterBand *poBand,
+                                           int nXOff, int nYOff)
+{
+    if (nShards == 1)
+        return aoShards[0];
+
+    // Mix the band pointer with the block coordinates (splitmix64 finalizer)
+    uint64_t nHash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(poBand));
+    nHash ^= static_cast<uint64_t>(static_cast<uint32_t>(nXOff)) *
+             UINT64_C(0x9E3779B97F4A7C15);
+    nHash ^= static_cast<uint64_t>(static_cast<uint32_t>(nYOff)) *
+             UINT64_C(0xC2B2AE3D27D4EB4F);
+    nHash = (nHash ^ (nHash >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    nHash = (nHash ^ (nHash >> 27)) * UINT64_C(0x94D049BB133111EB);
+    nHash ^= nHash >> 31;
+    return aoShards[nHash % static_cast<unsigned>(nShards)];
+}
+
+static GDALRasterBlockCacheShard &GetShard(GDALRasterBlock *poBlock)
+{
+    return GetShard(poBlock->GetBand(), poBlock->GetXOff(),
+                    poBlock->GetYOff());
+}
+
+/************************************************************************/
+/*                         PickShardToEvict()                           */
+/************************************************************************/
+
+// Returns the index of the shard, among the ones not yet tried, that
+// exceeds the most its share of the cache budget, or -1 if all shards have
+// been tried. Reads of the per-shard usage are done without locks, so this is
+// only a heuristics, which is fine since it only affects eviction fairness.
+static int PickShardToEvict(int iPreferredShard, uint64_t nTriedMask,
+                            GIntBig nShardCacheMax)
+{
+    if ((nTriedMask & (UINT64_C(1) << iPreferredShard)) == 0 &&
+        aoShards[iPreferredShard].nCacheUsed > nShardCacheMax)
+    {
+        return iPreferredShard;
+    }
+
+    int iBestShard = -1;
+    GIntBig nBestExcess = std::numeric_limits<GIntBig>::min();
+    for (int i = 0; i < nShards; ++i)
+    {
+        if ((nTriedMask & (UINT64_C(1) << i)) == 0)
+        {
+            const GIntBig nExcess = aoShards[i].nCacheUsed - nShardCacheMax;
+            if (nExcess > nBestExcess)
+            {
+                nBestExcess = nExcess;
+                iBestShard = i;
+            }
+        }
+    }
+    return iBestShard;
+}
 
 // #define ENABLE_DEBUG
 
@@ -221,9 +336,10 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
-            {
-                INITIALIZE_LOCK;
-            }
+            nShards = GetNumberOfShards();
+            InitializeLocks();
+            if (nShards > 1)
+                CPLDebug("GDAL", "Using %d block cache shards", nShards);
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -273,14 +389,15 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
-    if (nCacheUsed > INT_MAX)
+    const GIntBig nRes = nCacheUsed.load();
+    if (nRes > INT_MAX)
     {
         CPLErrorOnce(CE_Warning, CPLE_AppDefined,
                      "Cache used value doesn't fit on a 32 bit integer. "
                      "Call GDALGetCacheUsed64() instead");
         return INT_MAX;
     }
-    return static_cast<int>(nCacheUsed);
+    return static_cast<int>(nRes);
 }
 
 /************************************************************************/
@@ -298,7 +415,7 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
-    return nCacheUsed;
+    return nCacheUsed.load();
 }
 
 /************************************************************************/
@@ -378,11 +495,21 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    // This call will initialize the shard locks, if not already done.
+    GDALGetCacheMax64();
 
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Start with the shard that is the most over its share of the cache
+    // budget, and then try the other ones in turn.
+    const int iFirstShard =
+        nShards == 1 ? 0 : PickShardToEvict(0, 0, nCacheMax / nShards);
+    for (int iIter = 0; iIter < nShards && poTarget == nullptr; ++iIter)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockCacheShard &oShard =
+            aoShards[(iFirstShard + iIter) % nShards];
+        TAKE_LOCK(oShard);
+        poTarget = oShard.poOldest;
 
         while (poTarget != nullptr)
         {
@@ -396,7 +523,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -410,6 +537,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -531,11 +661,11 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
       poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
 {
-    if (!hRBLock)
+    if (!aoShards[0].hLock)
     {
         // Needed for scenarios where GDALAllRegister() is called after
         // GDALDestroyDriverManager()
-        INITIALIZE_LOCK;
+        InitializeLocks();
     }
 
     CPLAssert(poBandIn != nullptr);
@@ -652,19 +782,21 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
 
-    if (poNewest == this)
+    if (oShard.poOldest == this)
+        oShard.poOldest = poPrevious;
+
+    if (oShard.poNewest == this)
     {
-        poNewest = poNext;
+        oShard.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -678,7 +810,11 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = false;
 
     if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    {
+        const GIntBig nEffectiveSize = GetEffectiveBlockSize(GetBlockSize());
+        oShard.nCacheUsed -= nEffectiveSize;
+        nCacheUsed -= nEffectiveSize;
+    }
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -698,26 +834,31 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (int i = 0; i < nShards; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        GDALRasterBlockCacheShard &oShard = aoShards[i];
+        TAKE_LOCK(oShard);
+
+        CPLAssert((oShard.poNewest == nullptr && oShard.poOldest == nullptr) ||
+                  (oShard.poNewest != nullptr && oShard.poOldest != nullptr));
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        if (oShard.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(oShard.poNewest->poPrevious == nullptr);
+            CPLAssert(oShard.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = oShard.poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+                CPLAssert(&GetShard(poBlock) == &oShard);
+
+                poLast = poBlock;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(oShard.poOldest == poLast);
+        }
     }
 }
 
@@ -730,24 +871,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int i = 0; i < nShards; ++i)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(aoShards[i]);
+        for (GDALRasterBlock *poBlock = aoShards[i].poNewest;
+             poBlock != nullptr; poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -804,32 +948,36 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    if (oShard.poOldest == this)
+        oShard.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -838,19 +986,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oShard.poNewest;
 
-    if (poNewest != nullptr)
+    if (oShard.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oShard.poNewest->poPrevious == nullptr);
+        oShard.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oShard.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oShard.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oShard.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -879,13 +1027,20 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the block cache locks. Other call places can
     // only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
 
+    GDALRasterBlockCacheShard &oShard = GetShard(this);
+    const int iShard = static_cast<int>(&oShard - aoShards);
+    const GIntBig nShardCacheMax = nCurCacheMax / nShards;
+    // Bit mask of the shards in which we could not find anything to evict
+    uint64_t nTriedShardsMask = 0;
+    bool bTouched = false;
+
     /* -------------------------------------------------------------------- */
     /*      Flush old blocks if we are nearing our memory limit.            */
     /* -------------------------------------------------------------------- */
@@ -897,13 +1052,40 @@ CPLErr GDALRasterBlock::Internalize()
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
+
+        if (bFirstIter)
         {
-            TAKE_LOCK;
+            const GIntBig nEffectiveSize = GetEffectiveBlockSize(nSizeInBytes);
+            oShard.nCacheUsed += nEffectiveSize;
+            nCacheUsed += nEffectiveSize;
+        }
 
-            if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
+        // When there are several shards, evict preferably from our own
+        // shard, unless it is below its share of the budget, in which case
+        // we evict from the shard that exceeds the most its share, so
+        // that eviction remains fair across the whole cache.
+        int iVictimShard = iShard;
+        bool bRespectShardBudget = false;
+        if (nShards > 1 && nCacheUsed > nCurCacheMax)
+        {
+            iVictimShard =
+                PickShardToEvict(iShard, nTriedShardsMask, nShardCacheMax);
+            if (iVictimShard < 0)
+                iVictimShard = iShard;
+            else
+                bRespectShardBudget =
+                    aoShards[iVictimShard].nCacheUsed > nShardCacheMax;
+        }
+        GDALRasterBlockCacheShard &oVictimShard = aoShards[iVictimShard];
+
+        {
+            TAKE_LOCK(oVictimShard);
+
+            GDALRasterBlock *poTarget = oVictimShard.poOldest;
+            bool bShardExhausted = false;
+            while (nCacheUsed > nCurCacheMax &&
+                   (!bRespectShardBudget ||
+                    oVictimShard.nCacheUsed > nShardCacheMax))
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
@@ -949,7 +1131,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oVictimShard.poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1000,17 +1182,38 @@ CPLErr GDALRasterBlock::Internalize()
                 }
                 else
                 {
+                    // Nothing more can be evicted from that shard. Try
+                    // another one if there are any left.
+                    bShardExhausted = true;
+                    if (nShards > 1)
+                    {
+                        nTriedShardsMask |= UINT64_C(1) << iVictimShard;
+                        bLoopAgain =
+                            nTriedShardsMask !=
+                            (nShards == 64 ? ~UINT64_C(0)
+                                           : (UINT64_C(1) << nShards) - 1);
+                    }
                     break;
                 }
             }
 
+            // The shard budget has been reached, but the global one not.
+            if (bRespectShardBudget && !bLoopAgain && !bShardExhausted &&
+                nCacheUsed > nCurCacheMax)
+            {
+                bLoopAgain = true;
+            }
+
             /* ------------------------------------------------------------------
              */
             /*      Add this block to the list. */
             /* ------------------------------------------------------------------
              */
-            if (!bLoopAgain)
+            if (!bLoopAgain && iVictimShard == iShard)
+            {
                 Touch_unlocked();
+                bTouched = true;
+            }
         }
 
         bFirstIter = false;
@@ -1057,6 +1260,12 @@ CPLErr GDALRasterBlock::Internalize()
         }
     } while (bLoopAgain);
 
+    if (!bTouched)
+    {
+        TAKE_LOCK(oShard);
+        Touch_unlocked();
+    }
+
     if (pNewData == nullptr)
     {
         pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
@@ -1118,9 +1327,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (auto &oShard : aoShards)
+    {
+        if (oShard.hLock != nullptr)
+            DESTROY_LOCK(oShard);
+        oShard.hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1199,7 +1411,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(GetShard(this));
 
     return FALSE;
 }
@@ -1208,14 +1420,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int i = 0; i < nShards; ++i )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = aoShards[i].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d\n", iBlock);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
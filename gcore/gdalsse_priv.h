@@ -776,6 +776,10 @@ class XMMReg2Double
 
 #endif /*  defined(__x86_64) || defined(_M_X64) */
 
+// The AVX variant is selected at compile time, and is only used when the
+// including translation unit is built with -mavx or higher. The runtime
+// dispatched AVX2 kernels of default builds (the *_avx2.cpp files) use
+// intrinsics directly and do not depend on it.
 #if defined(__AVX__) && !defined(USE_SSE2_EMULATION)
 
 #include <immintrin.h>
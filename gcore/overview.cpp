@@ -26,6 +26,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -36,6 +37,7 @@
 #include "gdal.h"
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
+#include "memdataset.h"
 
 #ifdef USE_NEON_OPTIMIZATIONS
 #include "include_sse2neon.h"
@@ -59,10 +61,13 @@
 #ifdef __SSE4_1__
 #include <smmintrin.h>
 #endif
-#ifdef __AVX2__
-#include <immintrin.h>
+
 #endif
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+#define HAVE_AVX2_DISPATCH
+#include "cpl_cpu_features.h"
+#include "overview_avx2.h"
 #endif
 
 // To be included after above USE_SSE2 and include gdalsse_priv.h
@@ -341,7 +346,7 @@ inline GUInt16 ComputeIntegerRMS_4values<GUInt16, double>(double sumSquares)
 #ifdef USE_SSE2
 
 /************************************************************************/
-/*                   QuadraticMeanByteSSE2OrAVX2()                      */
+/*                       QuadraticMeanByteSSE2()                        */
 /************************************************************************/
 
 #if defined(__SSE4_1__) || defined(__AVX__) || defined(USE_NEON_OPTIMIZATIONS)
@@ -376,41 +381,6 @@ inline __m128i sse2_hadd_epi16(__m128i a, __m128i b)
 }
 #endif
 
-#ifdef __AVX2__
-
-#define DEST_ELTS 16
-#define set1_epi16 _mm256_set1_epi16
-#define set1_epi32 _mm256_set1_epi32
-#define setzero _mm256_setzero_si256
-#define set1_ps _mm256_set1_ps
-#define loadu_int(x) _mm256_loadu_si256(reinterpret_cast<__m256i const *>(x))
-#define unpacklo_epi8 _mm256_unpacklo_epi8
-#define unpackhi_epi8 _mm256_unpackhi_epi8
-#define madd_epi16 _mm256_madd_epi16
-#define add_epi32 _mm256_add_epi32
-#define mul_ps _mm256_mul_ps
-#define cvtepi32_ps _mm256_cvtepi32_ps
-#define sqrt_ps _mm256_sqrt_ps
-#define cvttps_epi32 _mm256_cvttps_epi32
-#define packs_epi32 _mm256_packs_epi32
-#define packus_epi32 _mm256_packus_epi32
-#define srli_epi32 _mm256_srli_epi32
-#define mullo_epi16 _mm256_mullo_epi16
-#define srli_epi16 _mm256_srli_epi16
-#define cmpgt_epi16 _mm256_cmpgt_epi16
-#define add_epi16 _mm256_add_epi16
-#define sub_epi16 _mm256_sub_epi16
-#define packus_epi16 _mm256_packus_epi16
-/* AVX2 operates on 2 separate 128-bit lanes, so we have to do shuffling */
-/* to get the lower 128-bit bits of what would be a true 256-bit vector register
- */
-#define store_lo(x, y)                                                         \
-    _mm_storeu_si128(reinterpret_cast<__m128i *>(x),                           \
-                     _mm256_extracti128_si256(                                 \
-                         _mm256_permute4x64_epi64((y), 0 | (2 << 2)), 0))
-#define hadd_epi16 _mm256_hadd_epi16
-#define zeroupper() _mm256_zeroupper()
-#else
 #define DEST_ELTS 8
 #define set1_epi16 _mm_set1_epi16
 #define set1_epi32 _mm_set1_epi32
@@ -436,32 +406,12 @@ inline __m128i sse2_hadd_epi16(__m128i a, __m128i b)
 #define packus_epi16 _mm_packus_epi16
 #define store_lo(x, y) _mm_storel_epi64(reinterpret_cast<__m128i *>(x), (y))
 #define hadd_epi16 sse2_hadd_epi16
-#define zeroupper() (void)0
-#endif
-
-#if defined(__GNUC__) && defined(__AVX2__)
-// Disabling inlining works around a bug with gcc 9.3 (Ubuntu 20.04) in
-// -O2 -mavx2 mode in QuadraticMeanFloatSSE2(),
-// where the registry that contains minus_zero is correctly
-// loaded the first time the function is called (looking at the disassembly,
-// one sees it is loaded much earlier than the function), but gets corrupted
-// (zeroed) in following iterations.
-// It appears the bug is due to the explicit zeroupper() call at the end of
-// the function.
-// The bug is at least solved in gcc 10.2.
-// Inlining doesn't bring much here to performance.
-// This is also needed with gcc 9.3 on QuadraticMeanByteSSE2OrAVX2() in
-// -O3 -mavx2 mode
-#define NOINLINE __attribute__((noinline))
-#else
-#define NOINLINE
-#endif
 
 template <class T>
-static int NOINLINE
-QuadraticMeanByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
-                            const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
-                            T *CPL_RESTRICT pDstScanline)
+static int
+QuadraticMeanByteSSE2(int nDstXWidth, int nChunkXSize,
+                      const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                      T *CPL_RESTRICT pDstScanline)
 {
     // Optimized implementation for RMS on Byte by
     // processing by group of 8 output pixels, so as to use
@@ -536,21 +486,42 @@ QuadraticMeanByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
         store_lo(&pDstScanline[iDstPixel], rms);
         pSrcScanlineShifted += 2 * DEST_ELTS;
     }
-    zeroupper();
 
     pSrcScanlineShiftedInOut = pSrcScanlineShifted;
     return iDstPixel;
 }
 
 /************************************************************************/
-/*                      AverageByteSSE2OrAVX2()                         */
+/*                    QuadraticMeanByteSSE2OrAVX2()                     */
 /************************************************************************/
 
 template <class T>
 static int
-AverageByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
-                      const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
-                      T *CPL_RESTRICT pDstScanline)
+QuadraticMeanByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
+                            const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                            T *CPL_RESTRICT pDstScanline)
+{
+#ifdef HAVE_AVX2_DISPATCH
+    if constexpr (std::is_same_v<T, GByte>)
+    {
+        if (CPLHaveRuntimeAVX2())
+            return GDALQuadraticMeanByte_AVX2(nDstXWidth, nChunkXSize,
+                                              pSrcScanlineShiftedInOut,
+                                              pDstScanline);
+    }
+#endif
+    return QuadraticMeanByteSSE2(nDstXWidth, nChunkXSize,
+                                 pSrcScanlineShiftedInOut, pDstScanline);
+}
+
+/************************************************************************/
+/*                          AverageByteSSE2()                           */
+/************************************************************************/
+
+template <class T>
+static int AverageByteSSE2(int nDstXWidth, int nChunkXSize,
+                           const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                           T *CPL_RESTRICT pDstScanline)
 {
     // Optimized implementation for average on Byte by
     // processing by group of 8 output pixels.
@@ -587,12 +558,33 @@ AverageByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
         store_lo(&pDstScanline[iDstPixel], average);
         pSrcScanlineShifted += 2 * DEST_ELTS;
     }
-    zeroupper();
 
     pSrcScanlineShiftedInOut = pSrcScanlineShifted;
     return iDstPixel;
 }
 
+/************************************************************************/
+/*                       AverageByteSSE2OrAVX2()                        */
+/************************************************************************/
+
+template <class T>
+static int
+AverageByteSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
+                      const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                      T *CPL_RESTRICT pDstScanline)
+{
+#ifdef HAVE_AVX2_DISPATCH
+    if constexpr (std::is_same_v<T, GByte>)
+    {
+        if (CPLHaveRuntimeAVX2())
+            return GDALAverageByte_AVX2(nDstXWidth, nChunkXSize,
+                                        pSrcScanlineShiftedInOut, pDstScanline);
+    }
+#endif
+    return AverageByteSSE2(nDstXWidth, nChunkXSize, pSrcScanlineShiftedInOut,
+                           pDstScanline);
+}
+
 /************************************************************************/
 /*                     QuadraticMeanUInt16SSE2()                        */
 /************************************************************************/
@@ -615,25 +607,6 @@ inline __m128d SQUARE(__m128d x)
     return _mm_mul_pd(x, x);
 }
 
-#ifdef __AVX2__
-
-inline __m256d SQUARE(__m256d x)
-{
-    return _mm256_mul_pd(x, x);
-}
-
-inline __m256d FIXUP_LANES(__m256d x)
-{
-    return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 1, 2, 0));
-}
-
-inline __m256 FIXUP_LANES(__m256 x)
-{
-    return _mm256_castpd_ps(FIXUP_LANES(_mm256_castps_pd(x)));
-}
-
-#endif
-
 template <class T>
 static int
 QuadraticMeanUInt16SSE2(int nDstXWidth, int nChunkXSize,
@@ -647,17 +620,8 @@ QuadraticMeanUInt16SSE2(int nDstXWidth, int nChunkXSize,
     int iDstPixel = 0;
     const auto zero = _mm_setzero_si128();
 
-#ifdef __AVX2__
-    const auto zeroDot25 = _mm256_set1_pd(0.25);
-    const auto zeroDot5 = _mm256_set1_pd(0.5);
-
-    // The first four 0's could be anything, as we only take the bottom
-    // 128 bits.
-    const auto permutation = _mm256_set_epi32(0, 0, 0, 0, 6, 4, 2, 0);
-#else
     const auto zeroDot25 = _mm_set1_pd(0.25);
     const auto zeroDot5 = _mm_set1_pd(0.5);
-#endif
 
     for (; iDstPixel < nDstXWidth - 3; iDstPixel += 4)
     {
@@ -733,45 +697,6 @@ QuadraticMeanUInt16SSE2(int nDstXWidth, int nChunkXSize,
         const auto secondLineLo = _mm_unpacklo_epi16(secondLine, zero);
         const auto secondLineHi = _mm_unpackhi_epi16(secondLine, zero);
 
-#ifdef __AVX2__
-        // Multiplication of 32 bit values previously converted to 64 bit double
-        const auto firstLineLoDbl = SQUARE(_mm256_cvtepi32_pd(firstLineLo));
-        const auto firstLineHiDbl = SQUARE(_mm256_cvtepi32_pd(firstLineHi));
-        const auto secondLineLoDbl = SQUARE(_mm256_cvtepi32_pd(secondLineLo));
-        const auto secondLineHiDbl = SQUARE(_mm256_cvtepi32_pd(secondLineHi));
-
-        // Vertical addition of squares
-        const auto sumSquaresLo =
-            _mm256_add_pd(firstLineLoDbl, secondLineLoDbl);
-        const auto sumSquaresHi =
-            _mm256_add_pd(firstLineHiDbl, secondLineHiDbl);
-
-        // Horizontal addition of squares
-        const auto sumSquares =
-            FIXUP_LANES(_mm256_hadd_pd(sumSquaresLo, sumSquaresHi));
-
-        const auto sumDivWeight = _mm256_mul_pd(sumSquares, zeroDot25);
-
-        // Take square root and truncate/floor to int32
-        auto rms = _mm256_cvttpd_epi32(_mm256_sqrt_pd(sumDivWeight));
-        const auto rmsDouble = _mm256_cvtepi32_pd(rms);
-        const auto right = _mm256_sub_pd(
-            sumDivWeight, _mm256_add_pd(SQUARE(rmsDouble), rmsDouble));
-
-        auto mask =
-            _mm256_castpd_ps(_mm256_cmp_pd(zeroDot5, right, _CMP_LT_OS));
-        // Extract 32-bit from each of the 4 64-bit masks
-        // mask = FIXUP_LANES(_mm256_shuffle_ps(mask, mask,
-        // _MM_SHUFFLE(2,0,2,0)));
-        mask = _mm256_permutevar8x32_ps(mask, permutation);
-        const auto maskI = _mm_castps_si128(_mm256_extractf128_ps(mask, 0));
-
-        // Apply the correction
-        rms = _mm_sub_epi32(rms, maskI);
-
-        // Pack each 32 bit RMS value to 16 bits
-        rms = _mm_packus_epi32(rms, rms /* could be anything */);
-#else
         // Multiplication of 32 bit values previously converted to 64 bit double
         const auto firstLineLoLo = SQUARE(_mm_cvtepi32_pd(firstLineLo));
         const auto firstLineLoHi =
@@ -827,19 +752,39 @@ QuadraticMeanUInt16SSE2(int nDstXWidth, int nChunkXSize,
 
         // Pack each 32 bit RMS value to 16 bits
         rms = sse2_packus_epi32(rms, rms /* could be anything */);
-#endif
 
         _mm_storel_epi64(reinterpret_cast<__m128i *>(&pDstScanline[iDstPixel]),
                          rms);
         pSrcScanlineShifted += 8;
     }
 
-    zeroupper();
-
     pSrcScanlineShiftedInOut = pSrcScanlineShifted;
     return iDstPixel;
 }
 
+/************************************************************************/
+/*                   QuadraticMeanUInt16SSE2OrAVX2()                    */
+/************************************************************************/
+
+template <class T>
+static int
+QuadraticMeanUInt16SSE2OrAVX2(int nDstXWidth, int nChunkXSize,
+                              const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                              T *CPL_RESTRICT pDstScanline)
+{
+#ifdef HAVE_AVX2_DISPATCH
+    if constexpr (std::is_same_v<T, GUInt16>)
+    {
+        if (CPLHaveRuntimeAVX2())
+            return GDALQuadraticMeanUInt16_AVX2(nDstXWidth, nChunkXSize,
+                                                pSrcScanlineShiftedInOut,
+                                                pDstScanline);
+    }
+#endif
+    return QuadraticMeanUInt16SSE2(nDstXWidth, nChunkXSize,
+                                   pSrcScanlineShiftedInOut, pDstScanline);
+}
+
 /************************************************************************/
 /*                         AverageUInt16SSE2()                          */
 /************************************************************************/
@@ -919,32 +864,6 @@ static int AverageUInt16SSE2(int nDstXWidth, int nChunkXSize,
 /*                      QuadraticMeanFloatSSE2()                        */
 /************************************************************************/
 
-#ifdef __AVX2__
-#define RMS_FLOAT_ELTS 8
-#define set1_ps _mm256_set1_ps
-#define loadu_ps _mm256_loadu_ps
-#define andnot_ps _mm256_andnot_ps
-#define and_ps _mm256_and_ps
-#define max_ps _mm256_max_ps
-#define shuffle_ps _mm256_shuffle_ps
-#define div_ps _mm256_div_ps
-#define cmpeq_ps(x, y) _mm256_cmp_ps(x, y, _CMP_EQ_OQ)
-#define mul_ps _mm256_mul_ps
-#define add_ps _mm256_add_ps
-#define hadd_ps _mm256_hadd_ps
-#define sqrt_ps _mm256_sqrt_ps
-#define or_ps _mm256_or_ps
-#define unpacklo_ps _mm256_unpacklo_ps
-#define unpackhi_ps _mm256_unpackhi_ps
-#define storeu_ps _mm256_storeu_ps
-
-inline __m256 SQUARE(__m256 x)
-{
-    return _mm256_mul_ps(x, x);
-}
-
-#else
-
 #ifdef __SSE3__
 #define sse2_hadd_ps _mm_hadd_ps
 #else
@@ -984,10 +903,8 @@ inline __m128 FIXUP_LANES(__m128 x)
     return x;
 }
 
-#endif
-
 template <class T>
-static int NOINLINE
+static int
 QuadraticMeanFloatSSE2(int nDstXWidth, int nChunkXSize,
                        const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
                        T *CPL_RESTRICT pDstScanline)
@@ -1070,12 +987,33 @@ QuadraticMeanFloatSSE2(int nDstXWidth, int nChunkXSize,
         pSrcScanlineShifted += RMS_FLOAT_ELTS * 2;
     }
 
-    zeroupper();
-
     pSrcScanlineShiftedInOut = pSrcScanlineShifted;
     return iDstPixel;
 }
 
+/************************************************************************/
+/*                    QuadraticMeanFloatSSE2OrAVX2()                    */
+/************************************************************************/
+
+template <class T>
+static int
+QuadraticMeanFloatSSE2OrAVX2(int nDstXWidth, int nChunkXSize,
+                             const T *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                             T *CPL_RESTRICT pDstScanline)
+{
+#ifdef HAVE_AVX2_DISPATCH
+    if constexpr (std::is_same_v<T, float>)
+    {
+        if (CPLHaveRuntimeAVX2())
+            return GDALQuadraticMeanFloat_AVX2(nDstXWidth, nChunkXSize,
+                                               pSrcScanlineShiftedInOut,
+                                               pDstScanline);
+    }
+#endif
+    return QuadraticMeanFloatSSE2(nDstXWidth, nChunkXSize,
+                                  pSrcScanlineShiftedInOut, pDstScanline);
+}
+
 /************************************************************************/
 /*                        AverageFloatSSE2()                            */
 /************************************************************************/
@@ -1319,7 +1257,7 @@ GDALResampleChunk_AverageOrRMS_T(const GDALOverviewResampleArgs &args,
                     }
                     else if (bQuadraticMean /* && eWrkDataType == GDT_UInt16 */)
                     {
-                        iDstPixel = QuadraticMeanUInt16SSE2(
+                        iDstPixel = QuadraticMeanUInt16SSE2OrAVX2(
                             nDstXWidth, nChunkXSize, pSrcScanlineShifted,
                             pDstScanline);
                     }
@@ -1382,7 +1320,7 @@ GDALResampleChunk_AverageOrRMS_T(const GDALOverviewResampleArgs &args,
                     {
                         if (bQuadraticMean)
                         {
-                            iDstPixel = QuadraticMeanFloatSSE2(
+                            iDstPixel = QuadraticMeanFloatSSE2OrAVX2(
                                 nDstXWidth, nChunkXSize, pSrcScanlineShifted,
                                 pDstScanline);
                         }
@@ -2672,75 +2610,6 @@ static inline void GDALResampleConvolutionVertical_2cols(
 
 #ifdef USE_SSE2
 
-#ifdef __AVX__
-/************************************************************************/
-/*             GDALResampleConvolutionVertical_16cols<T>                */
-/************************************************************************/
-
-template <class T>
-static inline void
-GDALResampleConvolutionVertical_16cols(const T *pChunk, int nStride,
-                                       const double *padfWeights,
-                                       int nSrcLineCount, float *afDest)
-{
-    int i = 0;
-    int j = 0;
-    XMMReg4Double v_acc0 = XMMReg4Double::Zero();
-    XMMReg4Double v_acc1 = XMMReg4Double::Zero();
-    XMMReg4Double v_acc2 = XMMReg4Double::Zero();
-    XMMReg4Double v_acc3 = XMMReg4Double::Zero();
-    for (; i + 3 < nSrcLineCount; i += 4, j += 4 * nStride)
-    {
-        XMMReg4Double w0 =
-            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 0);
-        XMMReg4Double w1 =
-            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 1);
-        XMMReg4Double w2 =
-            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 2);
-        XMMReg4Double w3 =
-            XMMReg4Double::Load1ValHighAndLow(padfWeights + i + 3);
-        v_acc0 += XMMReg4Double::Load4Val(pChunk + j + 0 + 0 * nStride) * w0;
-        v_acc1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 0 * nStride) * w0;
-        v_acc2 += XMMReg4Double::Load4Val(pChunk + j + 8 + 0 * nStride) * w0;
-        v_acc3 += XMMReg4Double::Load4Val(pChunk + j + 12 + 0 * nStride) * w0;
-        v_acc0 += XMMReg4Double::Load4Val(pChunk + j + 0 + 1 * nStride) * w1;
-        v_acc1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 1 * nStride) * w1;
-        v_acc2 += XMMReg4Double::Load4Val(pChunk + j + 8 + 1 * nStride) * w1;
-        v_acc3 += XMMReg4Double::Load4Val(pChunk + j + 12 + 1 * nStride) * w1;
-        v_acc0 += XMMReg4Double::Load4Val(pChunk + j + 0 + 2 * nStride) * w2;
-        v_acc1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 2 * nStride) * w2;
-        v_acc2 += XMMReg4Double::Load4Val(pChunk + j + 8 + 2 * nStride) * w2;
-        v_acc3 += XMMReg4Double::Load4Val(pChunk + j + 12 + 2 * nStride) * w2;
-        v_acc0 += XMMReg4Double::Load4Val(pChunk + j + 0 + 3 * nStride) * w3;
-        v_acc1 += XMMReg4Double::Load4Val(pChunk + j + 4 + 3 * nStride) * w3;
-        v_acc2 += XMMReg4Double::Load4Val(pChunk + j + 8 + 3 * nStride) * w3;
-        v_acc3 += XMMReg4Double::Load4Val(pChunk + j + 12 + 3 * nStride) * w3;
-    }
-    for (; i < nSrcLineCount; ++i, j += nStride)
-    {
-        XMMReg4Double w = XMMReg4Double::Load1ValHighAndLow(padfWeights + i);
-        v_acc0 += XMMReg4Double::Load4Val(pChunk + j + 0) * w;
-        v_acc1 += XMMReg4Double::Load4Val(pChunk + j + 4) * w;
-        v_acc2 += XMMReg4Double::Load4Val(pChunk + j + 8) * w;
-        v_acc3 += XMMReg4Double::Load4Val(pChunk + j + 12) * w;
-    }
-    v_acc0.Store4Val(afDest);
-    v_acc1.Store4Val(afDest + 4);
-    v_acc2.Store4Val(afDest + 8);
-    v_acc3.Store4Val(afDest + 12);
-}
-
-template <class T>
-static inline void GDALResampleConvolutionVertical_16cols(const T *, int,
-                                                          const double *, int,
-                                                          double *)
-{
-    // Cannot be reached
-    CPLAssert(false);
-}
-
-#else
-
 /************************************************************************/
 /*              GDALResampleConvolutionVertical_8cols<T>                */
 /************************************************************************/
@@ -2793,8 +2662,6 @@ static inline void GDALResampleConvolutionVertical_8cols(const T *, int,
     CPLAssert(false);
 }
 
-#endif  // __AVX__
-
 /************************************************************************/
 /*              GDALResampleConvolutionHorizontalSSE2<T>                */
 /************************************************************************/
@@ -3567,24 +3434,27 @@ static CPLErr GDALResampleChunk_ConvolutionT(
 #ifdef USE_SSE2
             if constexpr (eWrkDataType == GDT_Float32)
             {
-#ifdef __AVX__
-                for (; iFilteredPixelOff + 15 < nDstXSize;
-                     iFilteredPixelOff += 16, j += 16)
+#ifdef HAVE_AVX2_DISPATCH
+                if (CPLHaveRuntimeAVX2())
                 {
-                    GDALResampleConvolutionVertical_16cols(
-                        padfHorizontalFiltered + j, nDstXSize, padfWeights,
-                        nSrcLineCount, pafDstScanline + iFilteredPixelOff);
-                    if (bHasNoData)
+                    for (; iFilteredPixelOff + 15 < nDstXSize;
+                         iFilteredPixelOff += 16, j += 16)
                     {
-                        for (int k = 0; k < 16; k++)
+                        GDALResampleConvolutionVertical_16cols_AVX2(
+                            padfHorizontalFiltered + j, nDstXSize, padfWeights,
+                            nSrcLineCount, pafDstScanline + iFilteredPixelOff);
+                        if (bHasNoData)
                         {
-                            pafDstScanline[iFilteredPixelOff + k] =
-                                replaceValIfNodata(
-                                    pafDstScanline[iFilteredPixelOff + k]);
+                            for (int k = 0; k < 16; k++)
+                            {
+                                pafDstScanline[iFilteredPixelOff + k] =
+                                    replaceValIfNodata(
+                                        pafDstScanline[iFilteredPixelOff + k]);
+                            }
                         }
                     }
                 }
-#else
+#endif
                 for (; iFilteredPixelOff + 7 < nDstXSize;
                      iFilteredPixelOff += 8, j += 8)
                 {
@@ -3601,7 +3471,6 @@ static CPLErr GDALResampleChunk_ConvolutionT(
                         }
                     }
                 }
-#endif
 
                 for (; iFilteredPixelOff < nDstXSize; iFilteredPixelOff++, j++)
                 {
@@ -5050,6 +4919,788 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*                    GDALComputeOvrLevelChunking()                     */
+/************************************************************************/
+
+namespace
+{
+// Geometry of the chunks used to compute an overview level from its source
+struct OvrLevelChunking
+{
+    double dfXRatioDstToSrc = 0;
+    double dfYRatioDstToSrc = 0;
+    int nOvrFactor = 1;
+    int nDstChunkXSize = 0;
+    int nDstChunkYSize = 0;
+    int nFullResXChunkQueried = 0;
+    int nFullResYChunkQueried = 0;
+};
+}  // namespace
+
+static OvrLevelChunking GDALComputeOvrLevelChunking(
+    GDALRasterBand *poOvrBand, int nSrcWidth, int nSrcHeight, int nDstWidth,
+    CSLConstList papszOptions, int nKernelRadius, int nBands,
+    int nWrkDataTypeSize, int nChunkMaxSize)
+{
+    const double dfXRatioDstToSrc =
+        static_cast<double>(nSrcWidth) / poOvrBand->GetXSize();
+    const double dfYRatioDstToSrc =
+        static_cast<double>(nSrcHeight) / poOvrBand->GetYSize();
+
+    int nOvrFactor = std::max(static_cast<int>(0.5 + dfXRatioDstToSrc),
+                              static_cast<int>(0.5 + dfYRatioDstToSrc));
+    if (nOvrFactor == 0)
+        nOvrFactor = 1;
+
+    int nDstChunkXSize = 0;
+    int nDstChunkYSize = 0;
+    poOvrBand->GetBlockSize(&nDstChunkXSize, &nDstChunkYSize);
+
+    const char *pszDST_CHUNK_X_SIZE =
+        CSLFetchNameValue(papszOptions, "DST_CHUNK_X_SIZE");
+    const char *pszDST_CHUNK_Y_SIZE =
+        CSLFetchNameValue(papszOptions, "DST_CHUNK_Y_SIZE");
+    if (pszDST_CHUNK_X_SIZE && pszDST_CHUNK_Y_SIZE)
+    {
+        nDstChunkXSize = std::max(1, atoi(pszDST_CHUNK_X_SIZE));
+        nDstChunkYSize = std::max(1, atoi(pszDST_CHUNK_Y_SIZE));
+        CPLDebug("GDAL", "Using dst chunk size %d x %d", nDstChunkXSize,
+                 nDstChunkYSize);
+    }
+
+    // Try to extend the chunk size so that the memory needed to acquire
+    // source pixels goes up to 10 MB.
+    // This can help for drivers that support multi-threaded reading
+    const int nFullResYChunk =
+        2 + static_cast<int>(nDstChunkYSize * dfYRatioDstToSrc);
+    const int nFullResYChunkQueried =
+        nFullResYChunk + 2 * nKernelRadius * nOvrFactor;
+    while (nDstChunkXSize < nDstWidth)
+    {
+        const int nFullResXChunk =
+            2 + static_cast<int>(2 * nDstChunkXSize * dfXRatioDstToSrc);
+
+        const int nFullResXChunkQueried =
+            nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+
+        if (static_cast<GIntBig>(nFullResXChunkQueried) *
+                nFullResYChunkQueried * nBands * nWrkDataTypeSize >
+            nChunkMaxSize)
+        {
+            break;
+        }
+
+        nDstChunkXSize *= 2;
+    }
+    nDstChunkXSize = std::min(nDstChunkXSize, nDstWidth);
+
+    const int nFullResXChunk =
+        2 + static_cast<int>(nDstChunkXSize * dfXRatioDstToSrc);
+
+    OvrLevelChunking sChunking;
+    sChunking.dfXRatioDstToSrc = dfXRatioDstToSrc;
+    sChunking.dfYRatioDstToSrc = dfYRatioDstToSrc;
+    sChunking.nOvrFactor = nOvrFactor;
+    sChunking.nDstChunkXSize = nDstChunkXSize;
+    sChunking.nDstChunkYSize = nDstChunkYSize;
+    sChunking.nFullResXChunkQueried =
+        nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+    sChunking.nFullResYChunkQueried = nFullResYChunkQueried;
+    return sChunking;
+}
+
+/************************************************************************/
+/*                      GDALComputeOvrSrcWindow()                       */
+/************************************************************************/
+
+// Computes, along one dimension, the window of the source level needed to
+// compute [nDstOff, nDstOff + nDstCount) in the overview level, nMargin being
+// the number of extra source pixels needed on each side by the kernel.
+static void GDALComputeOvrSrcWindow(int nDstOff, int nDstCount,
+                                    int nDstTotalSize, int nSrcTotalSize,
+                                    double dfRatioDstToSrc, int nMargin,
+                                    int &nSrcOffQueried, int &nSrcSizeQueried)
+{
+    const int nSrcOff = static_cast<int>(nDstOff * dfRatioDstToSrc);
+    int nSrcOff2 =
+        static_cast<int>(ceil((nDstOff + nDstCount) * dfRatioDstToSrc));
+    if (nSrcOff2 > nSrcTotalSize || nDstOff + nDstCount == nDstTotalSize)
+        nSrcOff2 = nSrcTotalSize;
+
+    nSrcOffQueried = nSrcOff - nMargin;
+    nSrcSizeQueried = nSrcOff2 - nSrcOff + 2 * nMargin;
+    if (nSrcOffQueried < 0)
+    {
+        nSrcSizeQueried += nSrcOffQueried;
+        nSrcOffQueried = 0;
+    }
+    if (nSrcSizeQueried + nSrcOffQueried > nSrcTotalSize)
+        nSrcSizeQueried = nSrcTotalSize - nSrcOffQueried;
+}
+
+/************************************************************************/
+/*                    GDALComputeNoDataMaskOfBuffer()                   */
+/************************************************************************/
+
+// Computes the nodata mask of a window of a buffer of eDataType values, the
+// same way as GDALNoDataMaskBand does for raster bands.
+static CPLErr GDALComputeNoDataMaskOfBuffer(const GByte *pabyData,
+                                            GDALDataType eDataType,
+                                            int nXSize, int nYSize,
+                                            GSpacing nLineSpace,
+                                            double dfNoDataValue,
+                                            GByte *pabyMask)
+{
+    std::unique_ptr<MEMDataset> poMEMDS(
+        MEMDataset::Create("", nXSize, nYSize, 0, eDataType, nullptr));
+    if (!poMEMDS)
+        return CE_Failure;
+    GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+        poMEMDS.get(), 1, const_cast<GByte *>(pabyData), eDataType,
+        GDALGetDataTypeSizeBytes(eDataType), nLineSpace, false);
+    poMEMDS->AddMEMBand(hMEMBand);
+    GDALRasterBand *poMEMBand = poMEMDS->GetRasterBand(1);
+    poMEMBand->SetNoDataValue(dfNoDataValue);
+    return poMEMBand->GetMaskBand()->RasterIO(GF_Read, 0, 0, nXSize, nYSize,
+                                              pabyMask, nXSize, nYSize,
+                                              GDT_Byte, 0, 0, nullptr);
+}
+
+/************************************************************************/
+/*                 GDALIsOverviewCompressionLossless()                  */
+/************************************************************************/
+
+static bool GDALIsOverviewCompressionLossless(GDALRasterBand *poOvrBand)
+{
+    GDALDataset *poOvrDS = poOvrBand->GetDataset();
+    if (poOvrDS == nullptr)
+        return true;
+    const char *pszReversibility = poOvrDS->GetMetadataItem(
+        "COMPRESSION_REVERSIBILITY", "IMAGE_STRUCTURE");
+    if (pszReversibility)
+        return EQUAL(pszReversibility, "LOSSLESS");
+    const char *pszCompression =
+        poOvrDS->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE");
+    return pszCompression == nullptr || EQUAL(pszCompression, "NONE") ||
+           EQUAL(pszCompression, "LZW") || EQUAL(pszCompression, "DEFLATE") ||
+           EQUAL(pszCompression, "PACKBITS") ||
+           EQUAL(pszCompression, "ZSTD") || EQUAL(pszCompression, "LZMA") ||
+           EQUAL(pszCompression, "CCITTRLE") ||
+           EQUAL(pszCompression, "CCITTFAX3") ||
+           EQUAL(pszCompression, "CCITTFAX4");
+}
+
+/************************************************************************/
+/*                  GDALGetFirstSinglePassOverview()                    */
+/************************************************************************/
+
+// Returns the index of the first of the overview levels that can be generated
+// by GDALRegenerateOverviewsMultiBandSinglePass(), or nOverviews if there is
+// no such sequence of at least 2 levels. The chunk geometry of each of those
+// levels is returned in asChunking, indexed from that first level.
+static int GDALGetFirstSinglePassOverview(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands,
+    const char *pszResampling, CSLConstList papszOptions, int nKernelRadius,
+    GDALDataType eWrkDataType, bool bUseNoDataMask, int nChunkMaxSize,
+    std::vector<OvrLevelChunking> &asChunking)
+{
+    const char *pszSinglePass =
+        CPLGetConfigOption("GDAL_OVR_SINGLE_PASS", "AUTO");
+    const bool bAuto = EQUAL(pszSinglePass, "AUTO");
+    if (nOverviews < 2 || (!bAuto && !CPLTestBool(pszSinglePass)))
+        return nOverviews;
+
+    // Only resampling methods whose kernel is small enough so that the
+    // lines of a level kept in memory remain a small fraction of it.
+    if (!STARTS_WITH_CI(pszResampling, "NEAR") &&
+        !EQUAL(pszResampling, "AVERAGE") && !EQUAL(pszResampling, "MODE") &&
+        !EQUAL(pszResampling, "CUBIC"))
+    {
+        return nOverviews;
+    }
+
+    // When refreshing a subset, or when called on a temporary dataset with
+    // a forced chunk size, use the level-by-level approach.
+    if (CSLFetchNameValue(papszOptions, "XOFF") ||
+        CSLFetchNameValue(papszOptions, "YOFF") ||
+        CSLFetchNameValue(papszOptions, "XSIZE") ||
+        CSLFetchNameValue(papszOptions, "YSIZE") ||
+        CSLFetchNameValue(papszOptions, "DST_CHUNK_X_SIZE") ||
+        CSLFetchNameValue(papszOptions, "DST_CHUNK_Y_SIZE"))
+    {
+        return nOverviews;
+    }
+
+    const GDALDataType eDataType = papoSrcBands[0]->GetRasterDataType();
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+    // The validity mask of the kept lines must be computable from their
+    // values.
+    if (bUseNoDataMask)
+    {
+        if (papoSrcBands[0]->IsMaskBand() || eDataType == GDT_Int64 ||
+            eDataType == GDT_UInt64)
+        {
+            return nOverviews;
+        }
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papoSrcBands[iBand]->GetMaskFlags() != GMF_NODATA)
+                return nOverviews;
+            const double dfNoData = papoSrcBands[iBand]->GetNoDataValue();
+            for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+            {
+                auto poOvrBand = papapoOverviewBands[iBand][iOverview];
+                int bHasNoData = FALSE;
+                const double dfOvrNoData =
+                    poOvrBand->GetNoDataValue(&bHasNoData);
+                if (poOvrBand->GetMaskFlags() != GMF_NODATA || !bHasNoData ||
+                    !(dfOvrNoData == dfNoData ||
+                      (std::isnan(dfOvrNoData) && std::isnan(dfNoData))))
+                {
+                    return nOverviews;
+                }
+            }
+        }
+    }
+
+    // The kept lines are stored in the data type of the source bands, which
+    // must therefore be the one of all the bands of the generated levels.
+    const auto HasSourceDataType = [&](int iOverview)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papapoOverviewBands[iBand][iOverview]->GetRasterDataType() !=
+                eDataType)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Find the longest sequence of levels, ending at the last one, each
+    // computed from the previous one, and that do not need a temporary
+    // dataset.
+    const int nToplevelSrcWidth = papoSrcBands[0]->GetXSize();
+    const int nToplevelSrcHeight = papoSrcBands[0]->GetYSize();
+    std::vector<OvrLevelChunking> asAllChunking(nOverviews);
+    int iFirst = nOverviews;
+    for (int iOverview = nOverviews - 1; iOverview >= 0; --iOverview)
+    {
+        GDALRasterBand *poOvrBand = papapoOverviewBands[0][iOverview];
+        if (bAuto && !GDALIsOverviewCompressionLossless(poOvrBand))
+            break;
+        if (!HasSourceDataType(iOverview))
+            break;
+
+        int nSrcWidth = nToplevelSrcWidth;
+        int nSrcHeight = nToplevelSrcHeight;
+        const bool bFromPreviousLevel =
+            iOverview > 0 && papapoOverviewBands[0][iOverview - 1]->GetXSize() >
+                                 poOvrBand->GetXSize();
+        if (bFromPreviousLevel)
+        {
+            nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
+            nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
+        }
+        asAllChunking[iOverview] = GDALComputeOvrLevelChunking(
+            poOvrBand, nSrcWidth, nSrcHeight, poOvrBand->GetXSize(),
+            papszOptions, nKernelRadius, nBands, nWrkDataTypeSize,
+            nChunkMaxSize);
+        const auto &sChunking = asAllChunking[iOverview];
+        if (static_cast<GIntBig>(sChunking.nFullResXChunkQueried) *
+                sChunking.nFullResYChunkQueried * nBands * nWrkDataTypeSize >
+            nChunkMaxSize)
+        {
+            break;
+        }
+        iFirst = iOverview;
+        if (!bFromPreviousLevel)
+            break;
+    }
+
+    // If the first level is computed from a previous one, that one is the
+    // source of the single pass.
+    if (iFirst > 0 && iFirst < nOverviews &&
+        papapoOverviewBands[0][iFirst - 1]->GetXSize() >
+            papapoOverviewBands[0][iFirst]->GetXSize() &&
+        !HasSourceDataType(iFirst - 1))
+    {
+        ++iFirst;
+    }
+
+    // Estimate the working set of the levels [iFirst, nOverviews), and
+    // shorten the sequence until it fits in the block cache size.
+    const auto GetLevelWorkingSet = [&](int iOverview)
+    {
+        const auto &sChunking = asAllChunking[iOverview];
+        const int nDstWidth = papapoOverviewBands[0][iOverview]->GetXSize();
+        const GIntBig nXChunks =
+            DIV_ROUND_UP(nDstWidth, sChunking.nDstChunkXSize);
+        // Source and mask buffers of all the chunks of a strip
+        GIntBig nSize = nXChunks * sChunking.nFullResXChunkQueried *
+                        sChunking.nFullResYChunkQueried * nBands *
+                        (nWrkDataTypeSize + (bUseNoDataMask ? 1 : 0));
+        // Output buffers of a strip
+        nSize += static_cast<GIntBig>(nDstWidth) * sChunking.nDstChunkYSize *
+                 nBands * std::max(nWrkDataTypeSize, nDataTypeSize);
+        // Lines kept for the next level
+        if (iOverview + 1 < nOverviews)
+        {
+            nSize += static_cast<GIntBig>(nDstWidth) *
+                     (asAllChunking[iOverview + 1].nFullResYChunkQueried +
+                      sChunking.nDstChunkYSize) *
+                     nBands * nDataTypeSize;
+        }
+        return nSize;
+    };
+    GIntBig nWorkingSet = 0;
+    for (int iOverview = iFirst; iOverview < nOverviews; ++iOverview)
+        nWorkingSet += GetLevelWorkingSet(iOverview);
+    const GIntBig nMaxWorkingSet = GDALGetCacheMax64();
+    while (iFirst < nOverviews && nWorkingSet > nMaxWorkingSet)
+    {
+        nWorkingSet -= GetLevelWorkingSet(iFirst);
+        ++iFirst;
+    }
+
+    if (nOverviews - iFirst < 2)
+        return nOverviews;
+
+    asChunking.assign(asAllChunking.begin() + iFirst, asAllChunking.end());
+    return iFirst;
+}
+
+/************************************************************************/
+/*             GDALRegenerateOverviewsMultiBandSinglePass()             */
+/************************************************************************/
+
+// Generates the overview levels [iFirstOverview, nOverviews), each one being
+// computed from the previous one, and the first one from papoSrcBands, in a
+// single pass: the lines of each level that are needed to compute the next
+// one are kept in memory instead of being read back from the overview bands.
+// Levels are processed by strips of the height of their chunks, the deepest
+// level being processed as soon as enough lines of its source are available,
+// so that only a few strips of each level are kept at any time.
+// The result is identical to the one of the level-by-level approach of
+// GDALRegenerateOverviewsMultiBand(), as long as writing to the overview bands
+// is lossless.
+
+static CPLErr GDALRegenerateOverviewsMultiBandSinglePass(
+    int nBands, GDALRasterBand *const *papoSrcBands, int iFirstOverview,
+    int nOverviews, GDALRasterBand *const *const *papapoOverviewBands,
+    const std::vector<OvrLevelChunking> &asChunking,
+    GDALResampleFunction pfnResampleFn, int nKernelRadius,
+    const char *pszResampling, GDALDataType eWrkDataType, bool bUseNoDataMask,
+    const bool *pabHasNoData, const double *padfNoDataValue,
+    bool bPropagateNoData, CPLJobQueue *poJobQueue, double dfTotalPixelCount,
+    double &dfCurPixelCount, GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const GDALDataType eDataType = papoSrcBands[0]->GetRasterDataType();
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+    struct OvrLevel
+    {
+        int nSrcWidth = 0;
+        int nSrcHeight = 0;
+        int nDstWidth = 0;
+        int nDstHeight = 0;
+
+        // First line of the next strip to compute
+        int nDstYOff = 0;
+
+        // Lines [nKeptYOff, nKeptYOff + nKeptLines) of the level, per band,
+        // that are still needed to compute the next level.
+        int nKeptYOff = 0;
+        int nKeptLines = 0;
+        std::vector<std::vector<GByte>> aabyKept{};
+    };
+
+    const int nLevels = nOverviews - iFirstOverview;
+    std::vector<OvrLevel> asLevels(nLevels);
+    for (int i = 0; i < nLevels; ++i)
+    {
+        auto &sLevel = asLevels[i];
+        GDALRasterBand *poOvrBand = papapoOverviewBands[0][iFirstOverview + i];
+        sLevel.nDstWidth = poOvrBand->GetXSize();
+        sLevel.nDstHeight = poOvrBand->GetYSize();
+        sLevel.nSrcWidth =
+            i == 0 ? papoSrcBands[0]->GetXSize() : asLevels[i - 1].nDstWidth;
+        sLevel.nSrcHeight =
+            i == 0 ? papoSrcBands[0]->GetYSize() : asLevels[i - 1].nDstHeight;
+        if (i + 1 < nLevels)
+            sLevel.aabyKept.resize(nBands);
+    }
+
+    // Lines of the source of level i needed to compute its strip starting at
+    // nDstYOff
+    const auto GetSrcLines = [&asLevels, &asChunking, nKernelRadius](
+                                 int i, int nDstYOff, int &nSrcYOff,
+                                 int &nSrcYSize)
+    {
+        const auto &sLevel = asLevels[i];
+        const auto &sChunking = asChunking[i];
+        const int nDstYCount =
+            std::min(sChunking.nDstChunkYSize, sLevel.nDstHeight - nDstYOff);
+        GDALComputeOvrSrcWindow(nDstYOff, nDstYCount, sLevel.nDstHeight,
+                                sLevel.nSrcHeight, sChunking.dfYRatioDstToSrc,
+                                nKernelRadius * sChunking.nOvrFactor, nSrcYOff,
+                                nSrcYSize);
+    };
+
+    // Structure describing a resampling job
+    struct OvrJob
+    {
+        // Buffers to free when job is finished
+        std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
+        std::unique_ptr<PointerHolder> oSrcBufferHolder{};
+        std::unique_ptr<PointerHolder> oDstBufferHolder{};
+
+        int iBand = 0;
+
+        // Input parameters of pfnResampleFn
+        GDALResampleFunction pfnResampleFn = nullptr;
+        GDALOverviewResampleArgs args{};
+
+        // Output values of resampling function
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+    };
+
+    // Thread function to resample
+    const auto JobResampleFunc = [](void *pData)
+    {
+        OvrJob *poJob = static_cast<OvrJob *>(pData);
+
+        poJob->eErr = poJob->pfnResampleFn(
+            poJob->args, poJob->oSrcBufferHolder->ptr, &(poJob->pDstBuffer),
+            &(poJob->eDstBufferDataType));
+
+        poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
+    };
+
+    // Computes the next strip of level i, writes it to the overview bands
+    // and keeps it if needed by the next level.
+    const auto ComputeStrip = [&](int i)
+    {
+        auto &sLevel = asLevels[i];
+        const auto &sChunking = asChunking[i];
+        const int iOverview = iFirstOverview + i;
+        const int nDstYOff = sLevel.nDstYOff;
+        const int nDstYCount =
+            std::min(sChunking.nDstChunkYSize, sLevel.nDstHeight - nDstYOff);
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+        GetSrcLines(i, nDstYOff, nChunkYOffQueried, nChunkYSizeQueried);
+
+        CPLErr eErr = CE_None;
+        std::vector<std::unique_ptr<OvrJob>> apoJobs;
+        for (int nDstXOff = 0; nDstXOff < sLevel.nDstWidth && eErr == CE_None;
+             nDstXOff += sChunking.nDstChunkXSize)
+        {
+            const int nDstXCount = std::min(sChunking.nDstChunkXSize,
+                                            sLevel.nDstWidth - nDstXOff);
+            int nChunkXOffQueried = 0;
+            int nChunkXSizeQueried = 0;
+            GDALComputeOvrSrcWindow(
+                nDstXOff, nDstXCount, sLevel.nDstWidth, sLevel.nSrcWidth,
+                sChunking.dfXRatioDstToSrc,
+                nKernelRadius * sChunking.nOvrFactor, nChunkXOffQueried,
+                nChunkXSizeQueried);
+
+            for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            {
+                auto poJob = std::make_unique<OvrJob>();
+                GByte *pabyChunk = static_cast<GByte *>(VSI_MALLOC3_VERBOSE(
+                    nChunkXSizeQueried, nChunkYSizeQueried, nWrkDataTypeSize));
+                poJob->oSrcBufferHolder.reset(new PointerHolder(pabyChunk));
+                GByte *pabyChunkNoDataMask = nullptr;
+                if (bUseNoDataMask)
+                {
+                    pabyChunkNoDataMask =
+                        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                            nChunkXSizeQueried, nChunkYSizeQueried));
+                    poJob->oSrcMaskBufferHolder.reset(
+                        new PointerHolder(pabyChunkNoDataMask));
+                }
+                if (pabyChunk == nullptr ||
+                    (bUseNoDataMask && pabyChunkNoDataMask == nullptr))
+                {
+                    eErr = CE_Failure;
+                    break;
+                }
+
+                if (i == 0)
+                {
+                    GDALRasterBand *poSrcBand = papoSrcBands[iBand];
+                    eErr = poSrcBand->RasterIO(
+                        GF_Read, nChunkXOffQueried, nChunkYOffQueried,
+                        nChunkXSizeQueried, nChunkYSizeQueried, pabyChunk,
+                        nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType,
+                        0, 0, nullptr);
+                    if (bUseNoDataMask && eErr == CE_None)
+                    {
+                        eErr = poSrcBand->GetMaskBand()->RasterIO(
+                            GF_Read, nChunkXOffQueried, nChunkYOffQueried,
+                            nChunkXSizeQueried, nChunkYSizeQueried,
+                            pabyChunkNoDataMask, nChunkXSizeQueried,
+                            nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
+                    }
+                }
+                else
+                {
+                    // Take the source lines from the ones kept for the
+                    // previous level, with the same conversion as if
+                    // they had been read back from its overview band.
+                    const auto &sSrcLevel = asLevels[i - 1];
+                    CPLAssert(nChunkYOffQueried >= sSrcLevel.nKeptYOff);
+                    CPLAssert(nChunkYOffQueried + nChunkYSizeQueried <=
+                              sSrcLevel.nKeptYOff + sSrcLevel.nKeptLines);
+                    const size_t nSrcLineSize =
+                        static_cast<size_t>(sSrcLevel.nDstWidth) *
+                        nDataTypeSize;
+                    const GByte *pabySrc =
+                        sSrcLevel.aabyKept[iBand].data() +
+                        static_cast<size_t>(nChunkYOffQueried -
+                                            sSrcLevel.nKeptYOff) *
+                            nSrcLineSize +
+                        static_cast<size_t>(nChunkXOffQueried) * nDataTypeSize;
+                    for (int iY = 0; iY < nChunkYSizeQueried; ++iY)
+                    {
+                        GDALCopyWords64(
+                            pabySrc + iY * nSrcLineSize, eDataType,
+                            nDataTypeSize,
+                            pabyChunk + static_cast<size_t>(iY) *
+                                            nChunkXSizeQueried *
+                                            nWrkDataTypeSize,
+                            eWrkDataType, nWrkDataTypeSize,
+                            nChunkXSizeQueried);
+                    }
+                    if (bUseNoDataMask)
+                    {
+                        const double dfNoData =
+                            papapoOverviewBands[iBand][iOverview - 1]
+                                ->GetNoDataValue();
+                        eErr = GDALComputeNoDataMaskOfBuffer(
+                            pabySrc, eDataType, nChunkXSizeQueried,
+                            nChunkYSizeQueried, nSrcLineSize, dfNoData,
+                            pabyChunkNoDataMask);
+                    }
+                }
+
+                GDALRasterBand *poDstBand =
+                    papapoOverviewBands[iBand][iOverview];
+                poJob->iBand = iBand;
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->args.eOvrDataType = poDstBand->GetRasterDataType();
+                poJob->args.nOvrXSize = poDstBand->GetXSize();
+                poJob->args.nOvrYSize = poDstBand->GetYSize();
+                const char *pszNBITS =
+                    poDstBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+                poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
+                poJob->args.dfXRatioDstToSrc = sChunking.dfXRatioDstToSrc;
+                poJob->args.dfYRatioDstToSrc = sChunking.dfYRatioDstToSrc;
+                poJob->args.eWrkDataType = eWrkDataType;
+                poJob->args.pabyChunkNodataMask = pabyChunkNoDataMask;
+                poJob->args.nChunkXOff = nChunkXOffQueried;
+                poJob->args.nChunkXSize = nChunkXSizeQueried;
+                poJob->args.nChunkYOff = nChunkYOffQueried;
+                poJob->args.nChunkYSize = nChunkYSizeQueried;
+                poJob->args.nDstXOff = nDstXOff;
+                poJob->args.nDstXOff2 = nDstXOff + nDstXCount;
+                poJob->args.nDstYOff = nDstYOff;
+                poJob->args.nDstYOff2 = nDstYOff + nDstYCount;
+                poJob->args.pszResampling = pszResampling;
+                poJob->args.bHasNoData = pabHasNoData[iBand];
+                poJob->args.dfNoDataValue = padfNoDataValue[iBand];
+                poJob->args.eSrcDataType = eDataType;
+                poJob->args.bPropagateNoData = bPropagateNoData;
+                apoJobs.emplace_back(std::move(poJob));
+            }
+        }
+
+        // Resample all the chunks of the strip
+        if (eErr == CE_None)
+        {
+            if (poJobQueue)
+            {
+                for (auto &poJob : apoJobs)
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                poJobQueue->WaitCompletion();
+            }
+            else
+            {
+                for (auto &poJob : apoJobs)
+                    JobResampleFunc(poJob.get());
+            }
+        }
+
+        // Make room for the lines of the strip if they are needed by the next
+        // level.
+        const bool bKeep = i + 1 < nLevels;
+        const size_t nDstLineSize =
+            static_cast<size_t>(sLevel.nDstWidth) * nDataTypeSize;
+        if (bKeep && eErr == CE_None)
+        {
+            CPLAssert(sLevel.nKeptYOff + sLevel.nKeptLines == nDstYOff);
+            const size_t nNeededSize =
+                static_cast<size_t>(sLevel.nKeptLines + nDstYCount) *
+                nDstLineSize;
+            try
+            {
+                for (auto &abyKept : sLevel.aabyKept)
+                {
+                    if (abyKept.size() < nNeededSize)
+                        abyKept.resize(nNeededSize);
+                }
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in overview computation");
+                eErr = CE_Failure;
+            }
+        }
+
+        // Write the strip, and keep it if needed
+        for (const auto &poJob : apoJobs)
+        {
+            if (eErr != CE_None)
+                break;
+            eErr = poJob->eErr;
+            if (eErr != CE_None)
+                break;
+            const auto &args = poJob->args;
+            const int nDstXCount = args.nDstXOff2 - args.nDstXOff;
+            eErr = papapoOverviewBands[poJob->iBand][iOverview]->RasterIO(
+                GF_Write, args.nDstXOff, nDstYOff, nDstXCount, nDstYCount,
+                poJob->pDstBuffer, nDstXCount, nDstYCount,
+                poJob->eDstBufferDataType, 0, 0, nullptr);
+            if (bKeep)
+            {
+                const int nDstBufferDTSize =
+                    GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+                GByte *pabyKept =
+                    sLevel.aabyKept[poJob->iBand].data() +
+                    static_cast<size_t>(sLevel.nKeptLines) * nDstLineSize +
+                    static_cast<size_t>(args.nDstXOff) * nDataTypeSize;
+                for (int iY = 0; iY < nDstYCount; ++iY)
+                {
+                    GDALCopyWords64(
+                        static_cast<const GByte *>(poJob->pDstBuffer) +
+                            static_cast<size_t>(iY) * nDstXCount *
+                                nDstBufferDTSize,
+                        poJob->eDstBufferDataType, nDstBufferDTSize,
+                        pabyKept + iY * nDstLineSize, eDataType,
+                        nDataTypeSize, nDstXCount);
+                }
+            }
+        }
+        if (eErr != CE_None)
+            return eErr;
+
+        if (bKeep)
+            sLevel.nKeptLines += nDstYCount;
+        sLevel.nDstYOff += nDstYCount;
+        dfCurPixelCount += static_cast<double>(sLevel.nDstWidth) * nDstYCount;
+
+        // Discard the lines of the previous level that are no longer needed
+        if (i > 0)
+        {
+            auto &sSrcLevel = asLevels[i - 1];
+            int nNeededYOff = sSrcLevel.nDstHeight;
+            if (sLevel.nDstYOff < sLevel.nDstHeight)
+            {
+                int nNeededYSize = 0;
+                GetSrcLines(i, sLevel.nDstYOff, nNeededYOff, nNeededYSize);
+            }
+            const int nDiscarded =
+                std::min(nNeededYOff - sSrcLevel.nKeptYOff,
+                         sSrcLevel.nKeptLines);
+            if (nDiscarded > 0)
+            {
+                const size_t nSrcLineSize =
+                    static_cast<size_t>(sSrcLevel.nDstWidth) * nDataTypeSize;
+                for (auto &abyKept : sSrcLevel.aabyKept)
+                {
+                    memmove(abyKept.data(),
+                            abyKept.data() + nDiscarded * nSrcLineSize,
+                            (sSrcLevel.nKeptLines - nDiscarded) *
+                                nSrcLineSize);
+                }
+                sSrcLevel.nKeptYOff += nDiscarded;
+                sSrcLevel.nKeptLines -= nDiscarded;
+            }
+        }
+
+        return CE_None;
+    };
+
+    CPLErr eErr = CE_None;
+    while (eErr == CE_None)
+    {
+        // Process the deepest level for which enough source lines are
+        // available. The first level can always be processed, until it is
+        // complete.
+        int iLevel = nLevels - 1;
+        for (; iLevel >= 0; --iLevel)
+        {
+            const auto &sLevel = asLevels[iLevel];
+            if (sLevel.nDstYOff == sLevel.nDstHeight)
+                continue;
+            if (iLevel == 0)
+                break;
+            int nSrcYOff = 0;
+            int nSrcYSize = 0;
+            GetSrcLines(iLevel, sLevel.nDstYOff, nSrcYOff, nSrcYSize);
+            const auto &sSrcLevel = asLevels[iLevel - 1];
+            if (nSrcYOff + nSrcYSize <=
+                sSrcLevel.nKeptYOff + sSrcLevel.nKeptLines)
+            {
+                break;
+            }
+        }
+        if (iLevel < 0)
+            break;
+
+        if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+            break;
+        }
+
+        eErr = ComputeStrip(iLevel);
+    }
+
+    for (const auto &sLevel : asLevels)
+    {
+        if (eErr == CE_None && sLevel.nDstYOff != sLevel.nDstHeight)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "GDALRegenerateOverviewsMultiBandSinglePass(): "
+                     "incomplete computation of overview level");
+            eErr = CE_Failure;
+        }
+    }
+
+    // Flush the data to overviews.
+    for (int iOverview = iFirstOverview; iOverview < nOverviews; ++iOverview)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+            papapoOverviewBands[iBand][iOverview]->FlushCache(false);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -5088,6 +5739,11 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  * to "ALL_CPUS" or a integer value to specify the number of threads to use for
  * overview computation.
  *
+ * Starting with GDAL 3.11, when several levels are each computed from the
+ * previous one, the last ones may be generated in a single pass, without
+ * reading back the previous level from the overview bands. This is controlled
+ * by the GDAL_OVR_SINGLE_PASS configuration option.
+ *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
  * @param papoSrcBands the list of source bands to downsample
@@ -5260,11 +5916,19 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const int nChunkMaxSize = std::max(
         100, atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760")));
 
+    // Determine the last levels that can be generated in a single pass,
+    // after the other ones.
+    std::vector<OvrLevelChunking> asSinglePassChunking;
+    const int iFirstSinglePassOverview = GDALGetFirstSinglePassOverview(
+        nBands, papoSrcBands, nOverviews, papapoOverviewBands, pszResampling,
+        papszOptions, nKernelRadius, eWrkDataType, bUseNoDataMask,
+        nChunkMaxSize, asSinglePassChunking);
+
     // Second pass to do the real job.
     double dfCurPixelCount = 0;
     CPLErr eErr = CE_None;
-    for (int iOverview = 0; iOverview < nOverviews && eErr == CE_None;
-         ++iOverview)
+    for (int iOverview = 0;
+         iOverview < iFirstSinglePassOverview && eErr == CE_None; ++iOverview)
     {
         int iSrcOverview = -1;  // -1 means the source bands.
 
@@ -5308,63 +5972,22 @@ CPLErr GDALRegenerateOverviewsMultiBand(
             iSrcOverview = iOverview - 1;
         }
 
-        const double dfXRatioDstToSrc =
-            static_cast<double>(nSrcWidth) / nDstTotalWidth;
-        const double dfYRatioDstToSrc =
-            static_cast<double>(nSrcHeight) / nDstTotalHeight;
-
-        int nOvrFactor = std::max(static_cast<int>(0.5 + dfXRatioDstToSrc),
-                                  static_cast<int>(0.5 + dfYRatioDstToSrc));
-        if (nOvrFactor == 0)
-            nOvrFactor = 1;
-
-        int nDstChunkXSize = 0;
-        int nDstChunkYSize = 0;
-        papapoOverviewBands[0][iOverview]->GetBlockSize(&nDstChunkXSize,
-                                                        &nDstChunkYSize);
-
         const char *pszDST_CHUNK_X_SIZE =
             CSLFetchNameValue(papszOptions, "DST_CHUNK_X_SIZE");
         const char *pszDST_CHUNK_Y_SIZE =
             CSLFetchNameValue(papszOptions, "DST_CHUNK_Y_SIZE");
-        if (pszDST_CHUNK_X_SIZE && pszDST_CHUNK_Y_SIZE)
-        {
-            nDstChunkXSize = std::max(1, atoi(pszDST_CHUNK_X_SIZE));
-            nDstChunkYSize = std::max(1, atoi(pszDST_CHUNK_Y_SIZE));
-            CPLDebug("GDAL", "Using dst chunk size %d x %d", nDstChunkXSize,
-                     nDstChunkYSize);
-        }
-
-        // Try to extend the chunk size so that the memory needed to acquire
-        // source pixels goes up to 10 MB.
-        // This can help for drivers that support multi-threaded reading
-        const int nFullResYChunk =
-            2 + static_cast<int>(nDstChunkYSize * dfYRatioDstToSrc);
-        const int nFullResYChunkQueried =
-            nFullResYChunk + 2 * nKernelRadius * nOvrFactor;
-        while (nDstChunkXSize < nDstWidth)
-        {
-            const int nFullResXChunk =
-                2 + static_cast<int>(2 * nDstChunkXSize * dfXRatioDstToSrc);
 
-            const int nFullResXChunkQueried =
-                nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
-
-            if (static_cast<GIntBig>(nFullResXChunkQueried) *
-                    nFullResYChunkQueried * nBands * nWrkDataTypeSize >
-                nChunkMaxSize)
-            {
-                break;
-            }
-
-            nDstChunkXSize *= 2;
-        }
-        nDstChunkXSize = std::min(nDstChunkXSize, nDstWidth);
-
-        const int nFullResXChunk =
-            2 + static_cast<int>(nDstChunkXSize * dfXRatioDstToSrc);
-        const int nFullResXChunkQueried =
-            nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
+        const OvrLevelChunking sChunking = GDALComputeOvrLevelChunking(
+            papapoOverviewBands[0][iOverview], nSrcWidth, nSrcHeight,
+            nDstWidth, papszOptions, nKernelRadius, nBands, nWrkDataTypeSize,
+            nChunkMaxSize);
+        const double dfXRatioDstToSrc = sChunking.dfXRatioDstToSrc;
+        const double dfYRatioDstToSrc = sChunking.dfYRatioDstToSrc;
+        const int nOvrFactor = sChunking.nOvrFactor;
+        const int nDstChunkXSize = sChunking.nDstChunkXSize;
+        const int nDstChunkYSize = sChunking.nDstChunkYSize;
+        const int nFullResXChunkQueried = sChunking.nFullResXChunkQueried;
+        const int nFullResYChunkQueried = sChunking.nFullResYChunkQueried;
 
         // Make sure that the RAM requirements to acquire the source data does
         // not exceed nChunkMaxSize
@@ -5655,24 +6278,12 @@ CPLErr GDALRegenerateOverviewsMultiBand(
             else
                 nDstYCount = nDstYOffEnd - nDstYOff;
 
-            int nChunkYOff = static_cast<int>(nDstYOff * dfYRatioDstToSrc);
-            int nChunkYOff2 = static_cast<int>(
-                ceil((nDstYOff + nDstYCount) * dfYRatioDstToSrc));
-            if (nChunkYOff2 > nSrcHeight ||
-                nDstYOff + nDstYCount == nDstTotalHeight)
-                nChunkYOff2 = nSrcHeight;
-            int nYCount = nChunkYOff2 - nChunkYOff;
-            CPLAssert(nYCount <= nFullResYChunk);
-
-            int nChunkYOffQueried = nChunkYOff - nKernelRadius * nOvrFactor;
-            int nChunkYSizeQueried = nYCount + 2 * nKernelRadius * nOvrFactor;
-            if (nChunkYOffQueried < 0)
-            {
-                nChunkYSizeQueried += nChunkYOffQueried;
-                nChunkYOffQueried = 0;
-            }
-            if (nChunkYSizeQueried + nChunkYOffQueried > nSrcHeight)
-                nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
+            int nChunkYOffQueried = 0;
+            int nChunkYSizeQueried = 0;
+            GDALComputeOvrSrcWindow(nDstYOff, nDstYCount, nDstTotalHeight,
+                                    nSrcHeight, dfYRatioDstToSrc,
+                                    nKernelRadius * nOvrFactor,
+                                    nChunkYOffQueried, nChunkYSizeQueried);
             CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
 
             if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
@@ -5695,25 +6306,12 @@ CPLErr GDALRegenerateOverviewsMultiBand(
 
                 dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
 
-                int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
-                int nChunkXOff2 = static_cast<int>(
-                    ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
-                if (nChunkXOff2 > nSrcWidth ||
-                    nDstXOff + nDstXCount == nDstTotalWidth)
-                    nChunkXOff2 = nSrcWidth;
-                const int nXCount = nChunkXOff2 - nChunkXOff;
-                CPLAssert(nXCount <= nFullResXChunk);
-
-                int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
-                int nChunkXSizeQueried =
-                    nXCount + 2 * nKernelRadius * nOvrFactor;
-                if (nChunkXOffQueried < 0)
-                {
-                    nChunkXSizeQueried += nChunkXOffQueried;
-                    nChunkXOffQueried = 0;
-                }
-                if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
-                    nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
+                int nChunkXOffQueried = 0;
+                int nChunkXSizeQueried = 0;
+                GDALComputeOvrSrcWindow(nDstXOff, nDstXCount, nDstTotalWidth,
+                                        nSrcWidth, dfXRatioDstToSrc,
+                                        nKernelRadius * nOvrFactor,
+                                        nChunkXOffQueried, nChunkXSizeQueried);
                 CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
 #if DEBUG_VERBOSE
                 CPLDebug("GDAL",
@@ -5883,6 +6481,31 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         }
     }
 
+    if (eErr == CE_None && iFirstSinglePassOverview < nOverviews)
+    {
+        CPLDebug("GDAL", "Generating overview levels %d to %d in a single pass",
+                 iFirstSinglePassOverview, nOverviews - 1);
+        std::vector<GDALRasterBand *> apoSinglePassSrcBands(
+            papoSrcBands, papoSrcBands + nBands);
+        if (iFirstSinglePassOverview > 0 &&
+            papapoOverviewBands[0][iFirstSinglePassOverview - 1]->GetXSize() >
+                papapoOverviewBands[0][iFirstSinglePassOverview]->GetXSize())
+        {
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                apoSinglePassSrcBands[iBand] =
+                    papapoOverviewBands[iBand][iFirstSinglePassOverview - 1];
+            }
+        }
+        eErr = GDALRegenerateOverviewsMultiBandSinglePass(
+            nBands, apoSinglePassSrcBands.data(), iFirstSinglePassOverview,
+            nOverviews, papapoOverviewBands, asSinglePassChunking,
+            pfnResampleFn, nKernelRadius, pszResampling, eWrkDataType,
+            bUseNoDataMask, pabHasNoData, padfNoDataValue, bPropagateNoData,
+            poJobQueue.get(), dfTotalPixelCount, dfCurPixelCount, pfnProgress,
+            pProgressData);
+    }
+
     CPLFree(pabHasNoData);
     CPLFree(padfNoDataValue);
 
@@ -0,0 +1,478 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of overview kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#include "overview_avx2.h"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+// Note: we deliberately avoid inline functions with external linkage here,
+// so that no AVX2 code gets selected by the linker for other translation
+// units. The below functions must be kept consistent with their SSE2
+// counterparts of overview.cpp, which are used when AVX2 is not available at
+// runtime.
+
+/************************************************************************/
+/*                              SQUARE()                                */
+/************************************************************************/
+
+static inline __m256d SQUARE(__m256d x)
+{
+    return _mm256_mul_pd(x, x);
+}
+
+static inline __m256 SQUARE(__m256 x)
+{
+    return _mm256_mul_ps(x, x);
+}
+
+/************************************************************************/
+/*                            FIXUP_LANES()                             */
+/************************************************************************/
+
+// AVX2 operates on 2 separate 128-bit lanes, so results of horizontal
+// operations must be shuffled to be in the order of a true 256-bit register.
+
+static inline __m256d FIXUP_LANES(__m256d x)
+{
+    return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static inline __m256 FIXUP_LANES(__m256 x)
+{
+    return _mm256_castpd_ps(FIXUP_LANES(_mm256_castps_pd(x)));
+}
+
+/************************************************************************/
+/*                             store_lo()                               */
+/************************************************************************/
+
+// Store the 64 lower bits of each 128-bit lane of y, that is the lower 128
+// bits of what would be a true 256-bit vector register after packing.
+static inline void store_lo(void *p, __m256i y)
+{
+    _mm_storeu_si128(
+        static_cast<__m128i *>(p),
+        _mm256_extracti128_si256(_mm256_permute4x64_epi64(y, 0 | (2 << 2)), 0));
+}
+
+/************************************************************************/
+/*                     GDALQuadraticMeanByte_AVX2()                     */
+/************************************************************************/
+
+int GDALQuadraticMeanByte_AVX2(int nDstXWidth, int nChunkXSize,
+                               const GByte *&CPL_RESTRICT
+                                   pSrcScanlineShiftedInOut,
+                               GByte *CPL_RESTRICT pDstScanline)
+{
+    // Optimized implementation for RMS on Byte by
+    // processing by group of 16 output pixels, so as to use
+    // a single _mm256_sqrt_ps() call for 8 output pixels
+    constexpr int DEST_ELTS = 16;
+    const GByte *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
+
+    int iDstPixel = 0;
+    const auto one16 = _mm256_set1_epi16(1);
+    const auto one32 = _mm256_set1_epi32(1);
+    const auto zero = _mm256_setzero_si256();
+    const auto minus32768 = _mm256_set1_epi16(-32768);
+
+    for (; iDstPixel < nDstXWidth - (DEST_ELTS - 1); iDstPixel += DEST_ELTS)
+    {
+        // Load 2 * DEST_ELTS bytes from each line
+        auto firstLine = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(pSrcScanlineShifted));
+        auto secondLine = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(
+            pSrcScanlineShifted + nChunkXSize));
+        // Extend those Bytes as UInt16s
+        auto firstLineLo = _mm256_unpacklo_epi8(firstLine, zero);
+        auto firstLineHi = _mm256_unpackhi_epi8(firstLine, zero);
+        auto secondLineLo = _mm256_unpacklo_epi8(secondLine, zero);
+        auto secondLineHi = _mm256_unpackhi_epi8(secondLine, zero);
+
+        // Multiplication of 16 bit values and horizontal
+        // addition of 32 bit results
+        // [ src[2*i+0]^2 + src[2*i+1]^2 for i in range(4) ]
+        firstLineLo = _mm256_madd_epi16(firstLineLo, firstLineLo);
+        firstLineHi = _mm256_madd_epi16(firstLineHi, firstLineHi);
+        secondLineLo = _mm256_madd_epi16(secondLineLo, secondLineLo);
+        secondLineHi = _mm256_madd_epi16(secondLineHi, secondLineHi);
+
+        // Vertical addition
+        const auto sumSquaresLo = _mm256_add_epi32(firstLineLo, secondLineLo);
+        const auto sumSquaresHi = _mm256_add_epi32(firstLineHi, secondLineHi);
+
+        const auto sumSquaresPlusOneDiv4Lo =
+            _mm256_srli_epi32(_mm256_add_epi32(sumSquaresLo, one32), 2);
+        const auto sumSquaresPlusOneDiv4Hi =
+            _mm256_srli_epi32(_mm256_add_epi32(sumSquaresHi, one32), 2);
+
+        // Take square root and truncate/floor to int32
+        const auto rmsLo = _mm256_cvttps_epi32(
+            _mm256_sqrt_ps(_mm256_cvtepi32_ps(sumSquaresPlusOneDiv4Lo)));
+        const auto rmsHi = _mm256_cvttps_epi32(
+            _mm256_sqrt_ps(_mm256_cvtepi32_ps(sumSquaresPlusOneDiv4Hi)));
+
+        // Merge back low and high registers with each RMS value
+        // as a 16 bit value.
+        auto rms = _mm256_packs_epi32(rmsLo, rmsHi);
+
+        // Round to upper value if it minimizes the
+        // error |rms^2 - sumSquares/4|
+        // if( rms * (rms + 1) < (sumSquares+1) / 4 )
+        //    rms += 1;
+        // And both left and right parts fit on 16 (unsigned) bits
+        const auto sumSquaresPlusOneDiv4 = _mm256_packus_epi32(
+            sumSquaresPlusOneDiv4Lo, sumSquaresPlusOneDiv4Hi);
+        // cmpgt_epi16 operates on signed int16, but here
+        // we have unsigned values, so shift them by -32768 before
+        auto mask = _mm256_cmpgt_epi16(
+            _mm256_add_epi16(sumSquaresPlusOneDiv4, minus32768),
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(rms, _mm256_add_epi16(rms, one16)),
+                minus32768));
+        // The value of the mask will be -1 when the correction needs to be
+        // applied
+        rms = _mm256_sub_epi16(rms, mask);
+
+        // Pack each 16 bit RMS value to 8 bits
+        rms = _mm256_packus_epi16(rms, rms /* could be anything */);
+        store_lo(&pDstScanline[iDstPixel], rms);
+        pSrcScanlineShifted += 2 * DEST_ELTS;
+    }
+    _mm256_zeroupper();
+
+    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*                        GDALAverageByte_AVX2()                        */
+/************************************************************************/
+
+int GDALAverageByte_AVX2(int nDstXWidth, int nChunkXSize,
+                         const GByte *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                         GByte *CPL_RESTRICT pDstScanline)
+{
+    // Optimized implementation for average on Byte by
+    // processing by group of 16 output pixels.
+    constexpr int DEST_ELTS = 16;
+    const auto zero = _mm256_setzero_si256();
+    const auto two16 = _mm256_set1_epi16(2);
+    const GByte *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
+
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - (DEST_ELTS - 1); iDstPixel += DEST_ELTS)
+    {
+        // Load 2 * DEST_ELTS bytes from each line
+        const auto firstLine = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const *>(pSrcScanlineShifted));
+        const auto secondLine =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(
+                pSrcScanlineShifted + nChunkXSize));
+        // Extend those Bytes as UInt16s
+        const auto firstLineLo = _mm256_unpacklo_epi8(firstLine, zero);
+        const auto firstLineHi = _mm256_unpackhi_epi8(firstLine, zero);
+        const auto secondLineLo = _mm256_unpacklo_epi8(secondLine, zero);
+        const auto secondLineHi = _mm256_unpackhi_epi8(secondLine, zero);
+
+        // Vertical addition
+        const auto sumLo = _mm256_add_epi16(firstLineLo, secondLineLo);
+        const auto sumHi = _mm256_add_epi16(firstLineHi, secondLineHi);
+
+        // Horizontal addition of adjacent pairs, and recombine low and high
+        // parts
+        const auto sum = _mm256_hadd_epi16(sumLo, sumHi);
+
+        // average = (sum + 2) / 4
+        auto average = _mm256_srli_epi16(_mm256_add_epi16(sum, two16), 2);
+
+        // Pack each 16 bit average value to 8 bits
+        average =
+            _mm256_packus_epi16(average, average /* could be anything */);
+        store_lo(&pDstScanline[iDstPixel], average);
+        pSrcScanlineShifted += 2 * DEST_ELTS;
+    }
+    _mm256_zeroupper();
+
+    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*                    GDALQuadraticMeanUInt16_AVX2()                    */
+/************************************************************************/
+
+int GDALQuadraticMeanUInt16_AVX2(int nDstXWidth, int nChunkXSize,
+                                 const GUInt16 *&CPL_RESTRICT
+                                     pSrcScanlineShiftedInOut,
+                                 GUInt16 *CPL_RESTRICT pDstScanline)
+{
+    // Optimized implementation for RMS on UInt16 by
+    // processing by group of 4 output pixels.
+    const GUInt16 *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
+
+    int iDstPixel = 0;
+    const auto zero = _mm_setzero_si128();
+
+    const auto zeroDot25 = _mm256_set1_pd(0.25);
+    const auto zeroDot5 = _mm256_set1_pd(0.5);
+
+    // The first four 0's could be anything, as we only take the bottom
+    // 128 bits.
+    const auto permutation = _mm256_set_epi32(0, 0, 0, 0, 6, 4, 2, 0);
+
+    for (; iDstPixel < nDstXWidth - 3; iDstPixel += 4)
+    {
+        // Load 8 UInt16 from each line
+        const auto firstLine = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(pSrcScanlineShifted));
+        const auto secondLine =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(
+                pSrcScanlineShifted + nChunkXSize));
+
+        // Detect if all of the source values fit in 14 bits.
+        // because if x < 2^14, then 4 * x^2 < 2^30 which fits in a signed int32
+        // and we can do a much faster implementation.
+        const auto maskTmp =
+            _mm_srli_epi16(_mm_or_si128(firstLine, secondLine), 14);
+        const auto nMaskFitsIn14Bits = _mm_cvtsi128_si64(
+            _mm_packus_epi16(maskTmp, maskTmp /* could be anything */));
+        if (nMaskFitsIn14Bits == 0)
+        {
+            // Multiplication of 16 bit values and horizontal
+            // addition of 32 bit results
+            const auto firstLineHSumSquare =
+                _mm_madd_epi16(firstLine, firstLine);
+            const auto secondLineHSumSquare =
+                _mm_madd_epi16(secondLine, secondLine);
+            // Vertical addition
+            const auto sumSquares =
+                _mm_add_epi32(firstLineHSumSquare, secondLineHSumSquare);
+            // In theory we should take sqrt(sumSquares * 0.25f)
+            // but given the rounding we do, this is equivalent to
+            // sqrt((sumSquares + 1)/4). This has been verified exhaustively for
+            // sumSquares <= 4 * 16383^2
+            const auto one32 = _mm_set1_epi32(1);
+            const auto sumSquaresPlusOneDiv4 =
+                _mm_srli_epi32(_mm_add_epi32(sumSquares, one32), 2);
+            // Take square root and truncate/floor to int32
+            auto rms = _mm_cvttps_epi32(
+                _mm_sqrt_ps(_mm_cvtepi32_ps(sumSquaresPlusOneDiv4)));
+
+            // Round to upper value if it minimizes the
+            // error |rms^2 - sumSquares/4|
+            // if( rms * rms + rms < (sumSquares+1) / 4 )
+            //    rms += 1;
+            auto mask =
+                _mm_cmpgt_epi32(sumSquaresPlusOneDiv4,
+                                _mm_add_epi32(_mm_madd_epi16(rms, rms), rms));
+            rms = _mm_sub_epi32(rms, mask);
+            // Pack each 32 bit RMS value to 16 bits
+            rms = _mm_packs_epi32(rms, rms /* could be anything */);
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i *>(&pDstScanline[iDstPixel]), rms);
+            pSrcScanlineShifted += 8;
+            continue;
+        }
+
+        // Extend those UInt16s as UInt32s
+        const auto firstLineLo = _mm_unpacklo_epi16(firstLine, zero);
+        const auto firstLineHi = _mm_unpackhi_epi16(firstLine, zero);
+        const auto secondLineLo = _mm_unpacklo_epi16(secondLine, zero);
+        const auto secondLineHi = _mm_unpackhi_epi16(secondLine, zero);
+
+        // Multiplication of 32 bit values previously converted to 64 bit double
+        const auto firstLineLoDbl = SQUARE(_mm256_cvtepi32_pd(firstLineLo));
+        const auto firstLineHiDbl = SQUARE(_mm256_cvtepi32_pd(firstLineHi));
+        const auto secondLineLoDbl = SQUARE(_mm256_cvtepi32_pd(secondLineLo));
+        const auto secondLineHiDbl = SQUARE(_mm256_cvtepi32_pd(secondLineHi));
+
+        // Vertical addition of squares
+        const auto sumSquaresLo =
+            _mm256_add_pd(firstLineLoDbl, secondLineLoDbl);
+        const auto sumSquaresHi =
+            _mm256_add_pd(firstLineHiDbl, secondLineHiDbl);
+
+        // Horizontal addition of squares
+        const auto sumSquares =
+            FIXUP_LANES(_mm256_hadd_pd(sumSquaresLo, sumSquaresHi));
+
+        const auto sumDivWeight = _mm256_mul_pd(sumSquares, zeroDot25);
+
+        // Take square root and truncate/floor to int32
+        auto rms = _mm256_cvttpd_epi32(_mm256_sqrt_pd(sumDivWeight));
+        const auto rmsDouble = _mm256_cvtepi32_pd(rms);
+        const auto right = _mm256_sub_pd(
+            sumDivWeight, _mm256_add_pd(SQUARE(rmsDouble), rmsDouble));
+
+        auto mask =
+            _mm256_castpd_ps(_mm256_cmp_pd(zeroDot5, right, _CMP_LT_OS));
+        // Extract 32-bit from each of the 4 64-bit masks
+        mask = _mm256_permutevar8x32_ps(mask, permutation);
+        const auto maskI = _mm_castps_si128(_mm256_extractf128_ps(mask, 0));
+
+        // Apply the correction
+        rms = _mm_sub_epi32(rms, maskI);
+
+        // Pack each 32 bit RMS value to 16 bits
+        rms = _mm_packus_epi32(rms, rms /* could be anything */);
+
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(&pDstScanline[iDstPixel]),
+                         rms);
+        pSrcScanlineShifted += 8;
+    }
+
+    _mm256_zeroupper();
+
+    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*                    GDALQuadraticMeanFloat_AVX2()                     */
+/************************************************************************/
+
+int GDALQuadraticMeanFloat_AVX2(int nDstXWidth, int nChunkXSize,
+                                const float *&CPL_RESTRICT
+                                    pSrcScanlineShiftedInOut,
+                                float *CPL_RESTRICT pDstScanline)
+{
+    // Optimized implementation for RMS on Float32 by
+    // processing by group of 8 output pixels.
+    constexpr int RMS_FLOAT_ELTS = 8;
+    const float *CPL_RESTRICT pSrcScanlineShifted = pSrcScanlineShiftedInOut;
+
+    int iDstPixel = 0;
+    const auto minus_zero = _mm256_set1_ps(-0.0f);
+    const auto zeroDot25 = _mm256_set1_ps(0.25f);
+    const auto one = _mm256_set1_ps(1.0f);
+    const auto infv = _mm256_set1_ps(HUGE_VALF);
+
+    for (; iDstPixel < nDstXWidth - (RMS_FLOAT_ELTS - 1);
+         iDstPixel += RMS_FLOAT_ELTS)
+    {
+        // Load 2*RMS_FLOAT_ELTS Float32 from each line
+        auto firstLineLo = _mm256_loadu_ps(pSrcScanlineShifted);
+        auto firstLineHi =
+            _mm256_loadu_ps(pSrcScanlineShifted + RMS_FLOAT_ELTS);
+        auto secondLineLo = _mm256_loadu_ps(pSrcScanlineShifted + nChunkXSize);
+        auto secondLineHi = _mm256_loadu_ps(pSrcScanlineShifted +
+                                            RMS_FLOAT_ELTS + nChunkXSize);
+
+        // Take the absolute value
+        firstLineLo = _mm256_andnot_ps(minus_zero, firstLineLo);
+        firstLineHi = _mm256_andnot_ps(minus_zero, firstLineHi);
+        secondLineLo = _mm256_andnot_ps(minus_zero, secondLineLo);
+        secondLineHi = _mm256_andnot_ps(minus_zero, secondLineHi);
+
+        auto firstLineEven = _mm256_shuffle_ps(firstLineLo, firstLineHi,
+                                               _MM_SHUFFLE(2, 0, 2, 0));
+        auto firstLineOdd = _mm256_shuffle_ps(firstLineLo, firstLineHi,
+                                              _MM_SHUFFLE(3, 1, 3, 1));
+        auto secondLineEven = _mm256_shuffle_ps(secondLineLo, secondLineHi,
+                                                _MM_SHUFFLE(2, 0, 2, 0));
+        auto secondLineOdd = _mm256_shuffle_ps(secondLineLo, secondLineHi,
+                                               _MM_SHUFFLE(3, 1, 3, 1));
+
+        // Compute the maximum of each RMS_FLOAT_ELTS value to RMS-average
+        const auto maxV =
+            _mm256_max_ps(_mm256_max_ps(firstLineEven, firstLineOdd),
+                          _mm256_max_ps(secondLineEven, secondLineEven));
+
+        // Normalize each value by the maximum of the RMS_FLOAT_ELTS ones.
+        // This step is important to avoid that the square evaluates to infinity
+        // for sufficiently big input.
+        auto invMax = _mm256_div_ps(one, maxV);
+        // Deal with 0 being the maximum to correct division by zero
+        // note: comparing to -0 leads to identical results as to comparing with
+        // 0
+        invMax = _mm256_andnot_ps(_mm256_cmp_ps(maxV, minus_zero, _CMP_EQ_OQ),
+                                  invMax);
+
+        firstLineEven = _mm256_mul_ps(firstLineEven, invMax);
+        firstLineOdd = _mm256_mul_ps(firstLineOdd, invMax);
+        secondLineEven = _mm256_mul_ps(secondLineEven, invMax);
+        secondLineOdd = _mm256_mul_ps(secondLineOdd, invMax);
+
+        // Compute squares
+        firstLineEven = SQUARE(firstLineEven);
+        firstLineOdd = SQUARE(firstLineOdd);
+        secondLineEven = SQUARE(secondLineEven);
+        secondLineOdd = SQUARE(secondLineOdd);
+
+        const auto sumSquares =
+            _mm256_add_ps(_mm256_add_ps(firstLineEven, firstLineOdd),
+                          _mm256_add_ps(secondLineEven, secondLineOdd));
+
+        auto rms = _mm256_mul_ps(
+            maxV, _mm256_sqrt_ps(_mm256_mul_ps(sumSquares, zeroDot25)));
+
+        // Deal with infinity being the maximum
+        const auto maskIsInf = _mm256_cmp_ps(maxV, infv, _CMP_EQ_OQ);
+        rms = _mm256_or_ps(_mm256_andnot_ps(maskIsInf, rms),
+                           _mm256_and_ps(maskIsInf, infv));
+
+        rms = FIXUP_LANES(rms);
+
+        _mm256_storeu_ps(&pDstScanline[iDstPixel], rms);
+        pSrcScanlineShifted += RMS_FLOAT_ELTS * 2;
+    }
+
+    _mm256_zeroupper();
+
+    pSrcScanlineShiftedInOut = pSrcScanlineShifted;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*            GDALResampleConvolutionVertical_16cols_AVX2()             */
+/************************************************************************/
+
+void GDALResampleConvolutionVertical_16cols_AVX2(const double *pChunk,
+                                                 int nStride,
+                                                 const double *padfWeights,
+                                                 int nSrcLineCount,
+                                                 float *afDest)
+{
+    int i = 0;
+    int j = 0;
+    __m256d v_acc0 = _mm256_setzero_pd();
+    __m256d v_acc1 = _mm256_setzero_pd();
+    __m256d v_acc2 = _mm256_setzero_pd();
+    __m256d v_acc3 = _mm256_setzero_pd();
+    for (; i < nSrcLineCount; ++i, j += nStride)
+    {
+        const __m256d w = _mm256_set1_pd(padfWeights[i]);
+        v_acc0 = _mm256_add_pd(
+            v_acc0, _mm256_mul_pd(_mm256_loadu_pd(pChunk + j + 0), w));
+        v_acc1 = _mm256_add_pd(
+            v_acc1, _mm256_mul_pd(_mm256_loadu_pd(pChunk + j + 4), w));
+        v_acc2 = _mm256_add_pd(
+            v_acc2, _mm256_mul_pd(_mm256_loadu_pd(pChunk + j + 8), w));
+        v_acc3 = _mm256_add_pd(
+            v_acc3, _mm256_mul_pd(_mm256_loadu_pd(pChunk + j + 12), w));
+    }
+    _mm_storeu_ps(afDest, _mm256_cvtpd_ps(v_acc0));
+    _mm_storeu_ps(afDest + 4, _mm256_cvtpd_ps(v_acc1));
+    _mm_storeu_ps(afDest + 8, _mm256_cvtpd_ps(v_acc2));
+    _mm_storeu_ps(afDest + 12, _mm256_cvtpd_ps(v_acc3));
+
+    _mm256_zeroupper();
+}
+
+#endif  // defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) ||
+        // defined(_M_X64))
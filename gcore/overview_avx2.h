@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of overview kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef OVERVIEW_AVX2_H_INCLUDED
+#define OVERVIEW_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+//! @cond Doxygen_Suppress
+
+// All functions below compute the overview by a factor of 2 of a pair of
+// source lines, separated by nChunkXSize pixels, for as many destination
+// pixels as can be processed with full vectors. They advance
+// pSrcScanlineShiftedInOut accordingly and return the number of destination
+// pixels that have been computed. The remaining ones must be computed by the
+// caller.
+
+int GDALQuadraticMeanByte_AVX2(int nDstXWidth, int nChunkXSize,
+                               const GByte *&CPL_RESTRICT
+                                   pSrcScanlineShiftedInOut,
+                               GByte *CPL_RESTRICT pDstScanline);
+
+int GDALAverageByte_AVX2(int nDstXWidth, int nChunkXSize,
+                         const GByte *&CPL_RESTRICT pSrcScanlineShiftedInOut,
+                         GByte *CPL_RESTRICT pDstScanline);
+
+int GDALQuadraticMeanUInt16_AVX2(int nDstXWidth, int nChunkXSize,
+                                 const GUInt16 *&CPL_RESTRICT
+                                     pSrcScanlineShiftedInOut,
+                                 GUInt16 *CPL_RESTRICT pDstScanline);
+
+int GDALQuadraticMeanFloat_AVX2(int nDstXWidth, int nChunkXSize,
+                                const float *&CPL_RESTRICT
+                                    pSrcScanlineShiftedInOut,
+                                float *CPL_RESTRICT pDstScanline);
+
+// Compute 16 consecutive pixels of the vertical pass of the convolution
+// resampling, from nSrcLineCount lines of pChunk separated by nStride values.
+// Must be kept consistent with GDALResampleConvolutionVertical_8cols() of
+// overview.cpp.
+
+void GDALResampleConvolutionVertical_16cols_AVX2(const double *pChunk,
+                                                 int nStride,
+                                                 const double *padfWeights,
+                                                 int nSrcLineCount,
+                                                 float *afDest);
+
+//! @endcond
+
+#endif
+
+#endif /* OVERVIEW_AVX2_H_INCLUDED */
@@ -26,18 +26,24 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_float.h"
+#include "cpl_mem_cache.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
 #include "gdal_vrt.h"
+#include "gdalsse_priv.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
 #include "vrtdataset.h"
@@ -994,6 +1000,393 @@ static int GDALRasterIOTransformer(void *pTransformerArg, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                    GDALRasterIOResampleWeights                       */
+/************************************************************************/
+
+namespace
+{
+// Convolution coefficients, along one dimension, of a resampled RasterIO()
+// request. Destination pixel i is computed from the anSrcCount[i] source
+// pixels starting at anSrcStart[i] (relative to the start of the source
+// window), with the weights adfWeights[i * nTaps + k]. nTaps is the maximum
+// of anSrcCount[].
+struct GDALRasterIOResampleWeights
+{
+    int nTaps = 0;
+    std::vector<int> anSrcStart{};
+    std::vector<int> anSrcCount{};
+    std::vector<double> adfWeights{};
+};
+}  // namespace
+
+/************************************************************************/
+/*                  GDALGetRasterIOResampleWeights()                    */
+/************************************************************************/
+
+// Computes the weights of the destination pixels [nDstOff, nDstOff+nDstCount)
+// from the source window [nSrcWindowOff, nSrcWindowOff + nSrcWindowSize),
+// in the same way as the horizontal pass of the overview convolution code.
+// Tables are cached, since the requests of a tile server typically share
+// them: all tiles of a column share their horizontal weights, and all tiles
+// of a row their vertical weights.
+static std::shared_ptr<const GDALRasterIOResampleWeights>
+GDALGetRasterIOResampleWeights(GDALResampleAlg eResampleAlg,
+                               double dfRatioDstToSrc, double dfSrcDelta,
+                               int nDstOff, int nDstCount, int nSrcWindowOff,
+                               int nSrcWindowSize)
+{
+    static lru11::Cache<std::string,
+                        std::shared_ptr<const GDALRasterIOResampleWeights>,
+                        std::mutex>
+        oCache(32);
+
+    const std::string osKey(CPLSPrintf(
+        "%d,%.17g,%.17g,%d,%d,%d,%d", static_cast<int>(eResampleAlg),
+        dfRatioDstToSrc, dfSrcDelta, nDstOff, nDstCount, nSrcWindowOff,
+        nSrcWindowSize));
+    std::shared_ptr<const GDALRasterIOResampleWeights> poCachedWeights;
+    if (oCache.tryGet(osKey, poCachedWeights))
+        return poCachedWeights;
+
+    const int nKernelRadius = GWKGetFilterRadius(eResampleAlg);
+    const FilterFuncType pfnFilterFunc = GWKGetFilterFunc(eResampleAlg);
+    const FilterFunc4ValuesType pfnFilterFunc4Values =
+        GWKGetFilterFunc4Values(eResampleAlg);
+
+    const double dfScale = 1.0 / dfRatioDstToSrc;
+    const double dfScaleWeight = (dfScale >= 1.0) ? 1.0 : dfScale;
+    const double dfScaledRadius = nKernelRadius / dfScaleWeight;
+    const int nSrcWindowEnd = nSrcWindowOff + nSrcWindowSize;
+
+    auto poWeights = std::make_shared<GDALRasterIOResampleWeights>();
+    try
+    {
+        poWeights->anSrcStart.resize(nDstCount);
+        poWeights->anSrcCount.resize(nDstCount);
+        int nMaxCount = 0;
+        for (int i = 0; i < nDstCount; ++i)
+        {
+            const double dfSrcPixel =
+                (nDstOff + i + 0.5) * dfRatioDstToSrc + dfSrcDelta;
+            const int nSrcPixelStart = std::max(
+                nSrcWindowOff, static_cast<int>(floor(
+                                   dfSrcPixel - dfScaledRadius + 0.5)));
+            const int nSrcPixelStop = std::min(
+                nSrcWindowEnd,
+                static_cast<int>(dfSrcPixel + dfScaledRadius + 0.5));
+            poWeights->anSrcStart[i] =
+                std::min(nSrcPixelStart, nSrcWindowEnd) - nSrcWindowOff;
+            poWeights->anSrcCount[i] =
+                std::max(0, nSrcPixelStop - nSrcPixelStart);
+            nMaxCount = std::max(nMaxCount, poWeights->anSrcCount[i]);
+        }
+        poWeights->nTaps = nMaxCount;
+        poWeights->adfWeights.resize(static_cast<size_t>(nDstCount) *
+                                     poWeights->nTaps);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALGetRasterIOResampleWeights()");
+        return nullptr;
+    }
+
+    for (int i = 0; i < nDstCount; ++i)
+    {
+        const double dfSrcPixel =
+            (nDstOff + i + 0.5) * dfRatioDstToSrc + dfSrcDelta;
+        const int nSrcPixelStart = nSrcWindowOff + poWeights->anSrcStart[i];
+        const int nSrcPixelCount = poWeights->anSrcCount[i];
+        double *padfWeights =
+            poWeights->adfWeights.data() +
+            static_cast<size_t>(i) * poWeights->nTaps;
+        double dfWeightSum = 0.0;
+
+        int k = 0;
+        double dfX = dfScaleWeight * (nSrcPixelStart - dfSrcPixel + 0.5);
+        for (; k + 3 < nSrcPixelCount; k += 4)
+        {
+            padfWeights[k] = dfX;
+            dfX += dfScaleWeight;
+            padfWeights[k + 1] = dfX;
+            dfX += dfScaleWeight;
+            padfWeights[k + 2] = dfX;
+            dfX += dfScaleWeight;
+            padfWeights[k + 3] = dfX;
+            dfX += dfScaleWeight;
+            dfWeightSum += pfnFilterFunc4Values(padfWeights + k);
+        }
+        for (; k < nSrcPixelCount; ++k, dfX += dfScaleWeight)
+        {
+            padfWeights[k] = pfnFilterFunc(dfX);
+            dfWeightSum += padfWeights[k];
+        }
+
+        if (dfWeightSum != 0)
+        {
+            const double dfInvWeightSum = 1.0 / dfWeightSum;
+            for (k = 0; k < nSrcPixelCount; ++k)
+                padfWeights[k] *= dfInvWeightSum;
+        }
+    }
+
+    // Do not keep huge tables around.
+    if (poWeights->adfWeights.size() <= 1024 * 1024 / sizeof(double))
+        oCache.insert(osKey, poWeights);
+
+    return poWeights;
+}
+
+/************************************************************************/
+/*                GDALRasterIOResampledSeparableT()                     */
+/************************************************************************/
+
+// Resamples the source window [nSrcXOff, nSrcXOff + nSrcXSize) x
+// [nSrcYOff, nSrcYOff + nSrcYSize) of poBand into pData. The source window is
+// read by strips of lines. For each destination line, a vertical pass over
+// the source lines produces an intermediate line over the width of the
+// window, which is then reduced by a horizontal pass. Both passes work on 4
+// or 8 values at a time.
+template <class T>
+static CPLErr GDALRasterIOResampledSeparableT(
+    GDALRasterBand *poBand, const GDALRasterIOResampleWeights &oXWeights,
+    int nSrcXOff, int nSrcXSize, const GDALRasterIOResampleWeights &oYWeights,
+    int nSrcYOff, int nSrcYSize, void *pData, int nBufXSize, int nBufYSize,
+    GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    const int nXTaps = oXWeights.nTaps;
+    const int nYTaps = oYWeights.nTaps;
+    constexpr int MAX_STRIP_PIXELS = 1024 * 1024;
+
+    const int nMaxStripLines =
+        std::max(MAX_STRIP_PIXELS / nSrcXSize, std::max(nYTaps, 1));
+
+    std::vector<T> aSrcStrip;
+    std::vector<double> adfLine;
+    std::vector<float> afDstLine;
+    std::vector<T> aDstLine;
+    try
+    {
+        aSrcStrip.resize(static_cast<size_t>(nMaxStripLines) * nSrcXSize);
+        adfLine.resize(nSrcXSize);
+        afDstLine.resize(nBufXSize);
+        if (eDataType != GDT_Float32)
+            aDstLine.resize(nBufXSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALRasterIOResampledSeparableT()");
+        return CE_Failure;
+    }
+
+    int iDstLine = 0;
+    while (iDstLine < nBufYSize)
+    {
+        // Gather the destination lines whose source lines fit in the strip.
+        const int nStripYOff = oYWeights.anSrcStart[iDstLine];
+        int nStripYEnd = nStripYOff + oYWeights.anSrcCount[iDstLine];
+        int iDstLineEnd = iDstLine + 1;
+        while (iDstLineEnd < nBufYSize)
+        {
+            const int nEnd = oYWeights.anSrcStart[iDstLineEnd] +
+                             oYWeights.anSrcCount[iDstLineEnd];
+            if (std::max(nEnd, nStripYEnd) - nStripYOff > nMaxStripLines)
+                break;
+            nStripYEnd = std::max(nEnd, nStripYEnd);
+            ++iDstLineEnd;
+        }
+        nStripYEnd = std::min(nStripYEnd, nSrcYSize);
+
+        if (nStripYEnd > nStripYOff &&
+            poBand->RasterIO(GF_Read, nSrcXOff, nSrcYOff + nStripYOff,
+                             nSrcXSize, nStripYEnd - nStripYOff,
+                             aSrcStrip.data(), nSrcXSize,
+                             nStripYEnd - nStripYOff, eDataType, 0, 0,
+                             nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        for (; iDstLine < iDstLineEnd; ++iDstLine)
+        {
+            // Vertical pass.
+            const T *pSrc =
+                aSrcStrip.data() +
+                static_cast<size_t>(oYWeights.anSrcStart[iDstLine] -
+                                    nStripYOff) *
+                    nSrcXSize;
+            const double *padfYWeights =
+                oYWeights.adfWeights.data() +
+                static_cast<size_t>(iDstLine) * nYTaps;
+            const int nSrcLineCount = oYWeights.anSrcCount[iDstLine];
+            double *padfLine = adfLine.data();
+            int iX = 0;
+            for (; iX + 7 < nSrcXSize; iX += 8)
+            {
+                XMMReg4Double v0 = XMMReg4Double::Zero();
+                XMMReg4Double v1 = XMMReg4Double::Zero();
+                const T *pSrcCol = pSrc + iX;
+                for (int k = 0; k < nSrcLineCount; ++k, pSrcCol += nSrcXSize)
+                {
+                    const auto w =
+                        XMMReg4Double::Load1ValHighAndLow(padfYWeights + k);
+                    v0 += XMMReg4Double::Load4Val(pSrcCol) * w;
+                    v1 += XMMReg4Double::Load4Val(pSrcCol + 4) * w;
+                }
+                v0.Store4Val(padfLine + iX);
+                v1.Store4Val(padfLine + iX + 4);
+            }
+            for (; iX < nSrcXSize; ++iX)
+            {
+                double dfVal = 0.0;
+                for (int k = 0; k < nSrcLineCount; ++k)
+                {
+                    dfVal += padfYWeights[k] *
+                             pSrc[static_cast<size_t>(k) * nSrcXSize + iX];
+                }
+                padfLine[iX] = dfVal;
+            }
+
+            // Horizontal pass.
+            for (int i = 0; i < nBufXSize; ++i)
+            {
+                const double *padfSrc = padfLine + oXWeights.anSrcStart[i];
+                const double *padfXWeights =
+                    oXWeights.adfWeights.data() +
+                    static_cast<size_t>(i) * nXTaps;
+                const int nSrcPixelCount = oXWeights.anSrcCount[i];
+                XMMReg4Double v = XMMReg4Double::Zero();
+                int k = 0;
+                for (; k + 3 < nSrcPixelCount; k += 4)
+                {
+                    v += XMMReg4Double::Load4Val(padfSrc + k) *
+                         XMMReg4Double::Load4Val(padfXWeights + k);
+                }
+                double dfVal = v.GetHorizSum();
+                // Do not multiply pixels outside of the kernel by zero
+                // weights, as they might be infinite or NaN.
+                for (; k < nSrcPixelCount; ++k)
+                    dfVal += padfSrc[k] * padfXWeights[k];
+                afDstLine[i] = static_cast<float>(dfVal);
+            }
+
+            GByte *pabyDst =
+                static_cast<GByte *>(pData) + nLineSpace * iDstLine;
+            if (eDataType == GDT_Float32)
+            {
+                GDALCopyWords64(afDstLine.data(), GDT_Float32, sizeof(float),
+                                pabyDst, eBufType,
+                                static_cast<int>(nPixelSpace), nBufXSize);
+            }
+            else
+            {
+                GDALCopyWords64(afDstLine.data(), GDT_Float32, sizeof(float),
+                                aDstLine.data(), eDataType, sizeof(T),
+                                nBufXSize);
+                GDALCopyWords64(aDstLine.data(), eDataType, sizeof(T), pabyDst,
+                                eBufType, static_cast<int>(nPixelSpace),
+                                nBufXSize);
+            }
+        }
+
+        if (pfnProgress != nullptr &&
+            !pfnProgress(1.0 * iDstLine / nBufYSize, "", pProgressData))
+        {
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                 GDALRasterIOResampledSeparable()                     */
+/************************************************************************/
+
+// Fast path of GDALRasterBand::RasterIOResampled() for bilinear and cubic
+// resampling of Float32 and UInt16 bands without mask. It avoids the MEM
+// dataset wrapping the output buffer and the chunking of the generic overview
+// convolution code. Sets *pbHandled to false when the request is not
+// eligible, in which case nothing has been done.
+static CPLErr GDALRasterIOResampledSeparable(
+    GDALRasterBand *poBand, int nXOff, int nYOff, double dfXRatioDstToSrc,
+    double dfYRatioDstToSrc, double dfSrcXDelta, double dfSrcYDelta,
+    bool bHasXOffVirtual, bool bHasYOffVirtual, int nDestXOffVirtual,
+    int nDestYOffVirtual, void *pData, int nBufXSize, int nBufYSize,
+    GDALDataType eBufType, GSpacing nPixelSpace, GSpacing nLineSpace,
+    const GDALRasterIOExtraArg *psExtraArg, bool *pbHandled)
+{
+    *pbHandled = false;
+
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    if ((psExtraArg->eResampleAlg != GRIORA_Bilinear &&
+         psExtraArg->eResampleAlg != GRIORA_Cubic) ||
+        (eDataType != GDT_Float32 && eDataType != GDT_UInt16) ||
+        (poBand->GetMaskFlags() & GMF_ALL_VALID) == 0 ||
+        poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
+    {
+        return CE_None;
+    }
+
+    const GDALResampleAlg eResampleAlg =
+        psExtraArg->eResampleAlg == GRIORA_Bilinear ? GRA_Bilinear
+                                                    : GRA_Cubic;
+    const int nKernelRadius = GWKGetFilterRadius(eResampleAlg);
+    const int nRasterXSize = poBand->GetXSize();
+    const int nRasterYSize = poBand->GetYSize();
+
+    // Source window, with the same margins as the generic code.
+    const int nOvrXFactor =
+        std::max(1, static_cast<int>(0.5 + dfXRatioDstToSrc));
+    const int nOvrYFactor =
+        std::max(1, static_cast<int>(0.5 + dfYRatioDstToSrc));
+    const int nSrcXOff = std::max(0, nXOff - nKernelRadius * nOvrXFactor);
+    const int nSrcYOff = std::max(0, nYOff - nKernelRadius * nOvrYFactor);
+    const double dfSrcXEnd = std::min<double>(
+        nRasterXSize, nXOff + 1 + ceil(nBufXSize * dfXRatioDstToSrc) +
+                          nKernelRadius * nOvrXFactor);
+    const double dfSrcYEnd = std::min<double>(
+        nRasterYSize, nYOff + 1 + ceil(nBufYSize * dfYRatioDstToSrc) +
+                          nKernelRadius * nOvrYFactor);
+    const int nSrcXSize = static_cast<int>(dfSrcXEnd) - nSrcXOff;
+    const int nSrcYSize = static_cast<int>(dfSrcYEnd) - nSrcYOff;
+    if (nSrcXSize <= 0 || nSrcYSize <= 0)
+        return CE_None;
+
+    // Source and destination coordinates are expressed in the "virtual"
+    // output raster, as in the generic code.
+    const auto poYWeights = GDALGetRasterIOResampleWeights(
+        eResampleAlg, dfYRatioDstToSrc, dfSrcYDelta, nDestYOffVirtual,
+        nBufYSize, nSrcYOff - (bHasYOffVirtual ? 0 : nYOff), nSrcYSize);
+    if (!poYWeights)
+        return CE_None;
+    // Let the generic code chunk requests with a large downsampling factor.
+    if (static_cast<GIntBig>(poYWeights->nTaps) * nSrcXSize > 1024 * 1024)
+        return CE_None;
+    const auto poXWeights = GDALGetRasterIOResampleWeights(
+        eResampleAlg, dfXRatioDstToSrc, dfSrcXDelta, nDestXOffVirtual,
+        nBufXSize, nSrcXOff - (bHasXOffVirtual ? 0 : nXOff), nSrcXSize);
+    if (!poXWeights)
+        return CE_None;
+
+    *pbHandled = true;
+    if (eDataType == GDT_Float32)
+    {
+        return GDALRasterIOResampledSeparableT<float>(
+            poBand, *poXWeights, nSrcXOff, nSrcXSize, *poYWeights, nSrcYOff,
+            nSrcYSize, pData, nBufXSize, nBufYSize, eBufType, nPixelSpace,
+            nLineSpace, psExtraArg->pfnProgress, psExtraArg->pProgressData);
+    }
+    return GDALRasterIOResampledSeparableT<GUInt16>(
+        poBand, *poXWeights, nSrcXOff, nSrcXSize, *poYWeights, nSrcYOff,
+        nSrcYSize, pData, nBufXSize, nBufYSize, eBufType, nPixelSpace,
+        nLineSpace, psExtraArg->pfnProgress, psExtraArg->pProgressData);
+}
+
 /************************************************************************/
 /*                          RasterIOResampled()                         */
 /************************************************************************/
@@ -1049,6 +1442,18 @@ CPLErr GDALRasterBand::RasterIOResampled(
         nDestYOffVirtual = static_cast<int>(dfDestYOff + 0.5);
     }
 
+    if (!bUseWarp)
+    {
+        bool bHandled = false;
+        const CPLErr eErr = GDALRasterIOResampledSeparable(
+            this, nXOff, nYOff, dfXRatioDstToSrc, dfYRatioDstToSrc,
+            dfXOff - nXOff, dfYOff - nYOff, bHasXOffVirtual, bHasYOffVirtual,
+            nDestXOffVirtual, nDestYOffVirtual, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg, &bHandled);
+        if (bHandled)
+            return eErr;
+    }
+
     // Create a MEM dataset that wraps the output buffer.
     GDALDataset *poMEMDS;
     void *pTempBuffer = nullptr;
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test scalability of concurrent GDALRasterBand::GetLockedBlockRef()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("Usage: testperf_block_cache_contention [-threads X] "
+           "[-iters X] [-blocks X]\n");
+    printf("\n");
+    printf("Use --config GDAL_BLOCK_CACHE_SHARDS X to set the number of "
+           "block cache shards\n");
+    printf("and --config GDAL_CACHEMAX X to test scenarios with "
+           "evictions.\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                             Worker()                                 */
+/************************************************************************/
+
+static void Worker(GDALDataset *poDS, int nIters, unsigned nSeed)
+{
+    GDALRasterBand *poBand = poDS->GetRasterBand(1);
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(nullptr, &nBlockYSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+
+    std::mt19937 gen(nSeed);
+    std::uniform_int_distribution<int> dist(0, nBlocksPerColumn - 1);
+    for (int i = 0; i < nIters; ++i)
+    {
+        GDALRasterBlock *poBlock =
+            poBand->GetLockedBlockRef(0, dist(gen), FALSE);
+        if (poBlock)
+            poBlock->DropLock();
+    }
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    int nMaxThreads = CPLGetNumCPUs();
+    int nIters = 1000 * 1000;
+    int nBlocks = 1024;
+    for (int iArg = 1; iArg < argc; ++iArg)
+    {
+        if (iArg + 1 < argc && strcmp(argv[iArg], "-threads") == 0)
+        {
+            nMaxThreads = std::max(1, atoi(argv[iArg + 1]));
+            ++iArg;
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-iters") == 0)
+        {
+            nIters = std::max(1, atoi(argv[iArg + 1]));
+            ++iArg;
+        }
+        else if (iArg + 1 < argc && strcmp(argv[iArg], "-blocks") == 0)
+        {
+            nBlocks = std::max(1, atoi(argv[iArg + 1]));
+            ++iArg;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    CSLDestroy(argv);
+
+    GDALAllRegister();
+    GDALDriver *poDrv = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDrv)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        exit(1);
+    }
+
+    // One dataset per thread, as datasets are not thread-safe, but they
+    // all share the global block cache.
+    std::vector<std::unique_ptr<GDALDataset>> apoDS;
+    for (int i = 0; i < nMaxThreads; ++i)
+    {
+        apoDS.emplace_back(
+            poDrv->Create("", 256, nBlocks, 1, GDT_Byte, nullptr));
+    }
+
+    printf("GDAL_BLOCK_CACHE_SHARDS=%s, GDAL_CACHEMAX=" CPL_FRMT_GIB
+           " bytes\n",
+           CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1"),
+           GDALGetCacheMax64());
+
+    double dfRefThroughput = 0;
+    for (int nThreads = 1; nThreads <= nMaxThreads;
+         nThreads = (nThreads == nMaxThreads)
+                        ? nMaxThreads + 1
+                        : std::min(nThreads * 2, nMaxThreads))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> aoThreads;
+        for (int i = 0; i < nThreads; ++i)
+        {
+            aoThreads.emplace_back(Worker, apoDS[i].get(), nIters,
+                                   static_cast<unsigned>(i));
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double dfElapsed =
+            std::chrono::duration<double>(end - start).count();
+        const double dfThroughput =
+            static_cast<double>(nIters) * nThreads / dfElapsed;
+        if (nThreads == 1)
+            dfRefThroughput = dfThroughput;
+        printf("threads=%d: %.3f s, %.2f M GetLockedBlockRef()/s, "
+               "scaling=%.2f\n",
+               nThreads, dfElapsed, dfThroughput / 1e6,
+               dfThroughput / dfRefThroughput);
+    }
+
+    apoDS.clear();
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of GDALRasterBand::ComputeStatistics()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+constexpr int XSIZE = 4000;
+constexpr int YSIZE = 2500;
+constexpr int N_ITERS = 1;
+
+template <class T> static void randomFill(T *v, size_t size, T noData)
+{
+    std::random_device rd;
+    std::mt19937 gen{rd()};
+    std::normal_distribution<> dist{127, 30};
+    for (size_t i = 0; i < size; i++)
+    {
+        v[i] = static_cast<T>(dist(gen));
+        if ((i % 97) == 0)
+            v[i] = noData;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if ((i % 1024) == 5)
+                v[i] = std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+}
+
+/************************************************************************/
+/*                        ComputeStatsReference()                       */
+/************************************************************************/
+
+// Per-pixel Welford algorithm, as used by ComputeStatistics() before
+// vectorized code paths were added.
+template <class T>
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+static void
+ComputeStatsReference(const std::vector<T> &x, bool bHasNoData, T noData,
+                      double &dfMean, double &dfStdDev)
+{
+    double dfM2 = 0;
+    GUIntBig nValidCount = 0;
+    dfMean = 0;
+    for (const T val : x)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isnan(val))
+                continue;
+        }
+        const double dfValue = static_cast<double>(val);
+        if constexpr (std::is_same_v<T, float>)
+        {
+            if (bHasNoData && ARE_REAL_EQUAL(val, noData))
+                continue;
+        }
+        else
+        {
+            if (bHasNoData &&
+                ARE_REAL_EQUAL(dfValue, static_cast<double>(noData)))
+                continue;
+        }
+        nValidCount++;
+        const double dfDelta = dfValue - dfMean;
+        dfMean += dfDelta / static_cast<double>(nValidCount);
+        dfM2 += dfDelta * (dfValue - dfMean);
+    }
+    dfStdDev =
+        nValidCount ? sqrt(dfM2 / static_cast<double>(nValidCount)) : 0.0;
+}
+
+/************************************************************************/
+/*                               bench()                                */
+/************************************************************************/
+
+template <class T> static void bench(GDALDataType eDT, T noData)
+{
+    std::vector<T> x(static_cast<size_t>(XSIZE) * YSIZE);
+    randomFill(x.data(), x.size(), noData);
+
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GetGDALDriverManager()->GetDriverByName("MEM")->Create(
+            "", XSIZE, YSIZE, 1, eDT, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+    CPL_IGNORE_RET_VAL(poBand->RasterIO(GF_Write, 0, 0, XSIZE, YSIZE,
+                                        x.data(), XSIZE, YSIZE, eDT, 0, 0,
+                                        nullptr));
+
+    for (const bool bHasNoData : {false, true})
+    {
+        if (bHasNoData)
+            poBand->SetNoDataValue(static_cast<double>(noData));
+        else
+            poBand->DeleteNoDataValue();
+
+        {
+            auto start = std::chrono::steady_clock::now();
+            double dfMean = 0;
+            double dfStdDev = 0;
+            for (int i = 0; i < N_ITERS; ++i)
+            {
+                CPL_IGNORE_RET_VAL(poBand->ComputeStatistics(
+                    false, nullptr, nullptr, &dfMean, &dfStdDev, nullptr,
+                    nullptr));
+            }
+            auto end = std::chrono::steady_clock::now();
+            printf("mean=%.15g stddev=%.15g (%s, ComputeStatistics())\n",
+                   dfMean, dfStdDev, bHasNoData ? "nodata" : "no nodata");
+            printf("-> elapsed=%d\n", static_cast<int>((end - start).count()));
+        }
+        {
+            auto start = std::chrono::steady_clock::now();
+            double dfMean = 0;
+            double dfStdDev = 0;
+            for (int i = 0; i < N_ITERS; ++i)
+            {
+                ComputeStatsReference(x, bHasNoData, noData, dfMean,
+                                      dfStdDev);
+            }
+            auto end = std::chrono::steady_clock::now();
+            printf("mean=%.15g stddev=%.15g (%s, per-pixel reference)\n",
+                   dfMean, dfStdDev, bHasNoData ? "nodata" : "no nodata");
+            printf("-> elapsed=%d\n", static_cast<int>((end - start).count()));
+        }
+    }
+}
+
+int main(int /* argc */, char * /* argv */[])
+{
+    GDALAllRegister();
+    {
+        printf("int16:\n");
+        bench<int16_t>(GDT_Int16, -32768);
+    }
+    printf("--------------------\n");
+    {
+        printf("int32:\n");
+        bench<int32_t>(GDT_Int32, -9999);
+    }
+    printf("--------------------\n");
+    {
+        printf("float:\n");
+        bench<float>(GDT_Float32, -9999.0f);
+    }
+    printf("--------------------\n");
+    {
+        printf("double:\n");
+        bench<double>(GDT_Float64, -9999.0);
+    }
+    GDALDestroyDriverManager();
+    return 0;
+}
@@ -13,14 +13,17 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <thread>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_vsi.h"
 
 static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
+static thread_local CPLWorkerThread *threadLocalCurrentWorkerThread = nullptr;
 
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
@@ -30,8 +33,14 @@ static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
  *
  * The pool is in an uninitialized state after this call. The Setup() method
  * must be called.
+ *
+ * Each worker thread has its own queue of jobs. Jobs submitted from outside
+ * the pool are dispatched to an idle worker thread, or in a round-robin way
+ * if all of them are busy. Jobs submitted from a worker thread are queued on
+ * that thread. A worker thread whose queue is empty steals jobs from the
+ * queue of the other ones, so that the load remains balanced.
  */
-CPLWorkerThreadPool::CPLWorkerThreadPool() : jobQueue{}
+CPLWorkerThreadPool::CPLWorkerThreadPool()
 {
 }
 
@@ -39,7 +48,7 @@ CPLWorkerThreadPool::CPLWorkerThreadPool() : jobQueue{}
  *
  * \param nThreads  Number of threads in the pool.
  */
-CPLWorkerThreadPool::CPLWorkerThreadPool(int nThreads) : jobQueue{}
+CPLWorkerThreadPool::CPLWorkerThreadPool(int nThreads)
 {
     Setup(nThreads, nullptr, nullptr);
 }
@@ -83,6 +92,28 @@ int CPLWorkerThreadPool::GetThreadCount() const
     return m_nMaxThreads;
 }
 
+/************************************************************************/
+/*                           GetStatistics()                            */
+/************************************************************************/
+
+/** Return statistics on the activity of the pool.
+ *
+ * The values are collected without synchronization with running jobs, and
+ * are thus only approximate while jobs are running.
+ *
+ * @since GDAL 3.11
+ */
+CPLWorkerThreadPoolStatistics CPLWorkerThreadPool::GetStatistics() const
+{
+    CPLWorkerThreadPoolStatistics sStats;
+    sStats.nQueueDepth = m_nQueuedJobs.load();
+    sStats.nMaxQueueDepth = m_nMaxQueuedJobs.load();
+    sStats.nJobsExecuted = m_nJobsExecuted.load();
+    sStats.nSteals = m_nSteals.load();
+    sStats.dfIdleTime = static_cast<double>(m_nIdleTimeNS.load()) * 1e-9;
+    return sStats;
+}
+
 /************************************************************************/
 /*                       WorkerThreadFunction()                         */
 /************************************************************************/
@@ -93,6 +124,7 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
     CPLWorkerThreadPool *poTP = psWT->poTP;
 
     threadLocalCurrentThreadPool = poTP;
+    threadLocalCurrentWorkerThread = psWT;
 
     if (psWT->pfnInitFunc)
         psWT->pfnInitFunc(psWT->pInitData);
@@ -107,6 +139,7 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
 #if DEBUG_VERBOSE
         CPLDebug("JOB", "%p finished a job", psWT);
 #endif
+        poTP->m_nJobsExecuted++;
         poTP->DeclareJobFinished();
     }
 }
@@ -133,89 +166,58 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
  */
 bool CPLWorkerThreadPool::SubmitJob(std::function<void()> task)
 {
-#ifdef DEBUG
-    {
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        CPLAssert(m_nMaxThreads > 0);
-    }
-#endif
+    std::unique_lock<std::mutex> oGuard(m_mutex);
+    CPLAssert(m_nMaxThreads > 0);
 
-    bool bMustIncrementWaitingWorkerThreadsAfterSubmission = false;
+    CPLWorkerThread *psTargetWorkerThread = nullptr;
     if (threadLocalCurrentThreadPool == this)
     {
         // If there are waiting threads or we have not started all allowed
         // threads, we can submit this job asynchronously
-        {
-            std::unique_lock<std::mutex> oGuard(m_mutex);
-            if (nWaitingWorkerThreads > 0 ||
-                static_cast<int>(aWT.size()) < m_nMaxThreads)
-            {
-                bMustIncrementWaitingWorkerThreadsAfterSubmission = true;
-                nWaitingWorkerThreads--;
-            }
-        }
-        if (!bMustIncrementWaitingWorkerThreadsAfterSubmission)
+        if (nWaitingWorkerThreads == 0 &&
+            static_cast<int>(aWT.size()) >= m_nMaxThreads)
         {
             // otherwise there is a risk of deadlock, so execute synchronously.
+            oGuard.unlock();
             task();
             return true;
         }
-    }
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
+        // Queue the job on the current worker thread. A waiting worker
+        // thread will be woken up below and steal it, unless the current
+        // thread gets back to its queue first.
+        psTargetWorkerThread = threadLocalCurrentWorkerThread;
+    }
 
-    if (bMustIncrementWaitingWorkerThreadsAfterSubmission)
-        nWaitingWorkerThreads++;
+    if (!StartWorkerThreadIfNeeded() && aWT.empty())
+        return false;
 
-    if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+    CPLWorkerThread *psWokenWorkerThread = PopWaitingWorkerThread();
+    if (psTargetWorkerThread == nullptr)
     {
-        // CPLDebug("CPL", "Starting new thread...");
-        auto wt = std::make_unique<CPLWorkerThread>();
-        wt->poTP = this;
-        //ABELL - Why should this fail? And this is a *pool* thread, not necessarily
-        //  tied to the submitted job. The submitted job still needs to run, even if
-        //  this fails. If we can't create a thread, should the entire pool become invalid?
-        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-        /**
-        if (!wt->hThread)
+        if (psWokenWorkerThread)
         {
-            VSIFree(psJob);
-            VSIFree(psItem);
-            return false;
+            psTargetWorkerThread = psWokenWorkerThread;
+        }
+        else
+        {
+            psTargetWorkerThread = aWT[m_nNextWorkerThread % aWT.size()].get();
+            ++m_nNextWorkerThread;
         }
-        **/
-        if (wt->hThread)
-            aWT.emplace_back(std::move(wt));
     }
 
-    jobQueue.emplace(task);
     nPendingJobs++;
+    PushJob(psTargetWorkerThread, std::move(task));
 
-    if (psWaitingWorkerThreadsList)
-    {
-        CPLWorkerThread *psWorkerThread =
-            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
-
-        CPLAssert(psWorkerThread->bMarkedAsWaiting);
-        psWorkerThread->bMarkedAsWaiting = false;
-
-        CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-        CPLList *psToFree = psWaitingWorkerThreadsList;
-        psWaitingWorkerThreadsList = psNext;
-        nWaitingWorkerThreads--;
+    oGuard.unlock();
 
+    if (psWokenWorkerThread)
+    {
 #if DEBUG_VERBOSE
-        CPLDebug("JOB", "Waking up %p", psWorkerThread);
+        CPLDebug("JOB", "Waking up %p", psWokenWorkerThread);
 #endif
-
-        {
-            std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-            // coverity[ uninit_use_in_call]
-            oGuard.unlock();
-            psWorkerThread->m_cv.notify_one();
-        }
-
-        CPLFree(psToFree);
+        std::lock_guard<std::mutex> oGuardWT(psWokenWorkerThread->m_mutex);
+        psWokenWorkerThread->m_cv.notify_one();
     }
 
     return true;
@@ -253,65 +255,39 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
         return true;
     }
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-
-    for (void *pData : apData)
+    std::vector<CPLWorkerThread *> apsWokenWorkerThreads;
     {
-        if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+
+        for (void *pData : apData)
         {
-            std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
-            wt->poTP = this;
-            wt->hThread =
-                CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-            if (wt->hThread == nullptr)
+            if (!StartWorkerThreadIfNeeded() && aWT.empty())
+                return false;
+
+            CPLWorkerThread *psTargetWorkerThread = PopWaitingWorkerThread();
+            if (psTargetWorkerThread)
             {
-                if (aWT.empty())
-                    return false;
+                apsWokenWorkerThreads.push_back(psTargetWorkerThread);
             }
             else
             {
-                aWT.emplace_back(std::move(wt));
+                psTargetWorkerThread =
+                    aWT[m_nNextWorkerThread % aWT.size()].get();
+                ++m_nNextWorkerThread;
             }
-        }
 
-        jobQueue.emplace([=] { pfnFunc(pData); });
-        nPendingJobs++;
+            nPendingJobs++;
+            PushJob(psTargetWorkerThread, [=] { pfnFunc(pData); });
+        }
     }
 
-    for (size_t i = 0; i < apData.size(); i++)
+    for (CPLWorkerThread *psWorkerThread : apsWokenWorkerThreads)
     {
-        if (psWaitingWorkerThreadsList)
-        {
-            CPLWorkerThread *psWorkerThread;
-
-            psWorkerThread = static_cast<CPLWorkerThread *>(
-                psWaitingWorkerThreadsList->pData);
-
-            CPLAssert(psWorkerThread->bMarkedAsWaiting);
-            psWorkerThread->bMarkedAsWaiting = false;
-
-            CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-            CPLList *psToFree = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psNext;
-            nWaitingWorkerThreads--;
-
 #if DEBUG_VERBOSE
-            CPLDebug("JOB", "Waking up %p", psWorkerThread);
+        CPLDebug("JOB", "Waking up %p", psWorkerThread);
 #endif
-            {
-                std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-                // coverity[ uninit_use_in_call]
-                oGuard.unlock();
-                psWorkerThread->m_cv.notify_one();
-            }
-
-            CPLFree(psToFree);
-            oGuard.lock();
-        }
-        else
-        {
-            break;
-        }
+        std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+        psWorkerThread->m_cv.notify_one();
     }
 
     return true;
@@ -332,8 +308,10 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
     if (nMaxRemainingJobs < 0)
         nMaxRemainingJobs = 0;
     std::unique_lock<std::mutex> oGuard(m_mutex);
+    m_nCompletionWaiters++;
     m_cv.wait(oGuard, [this, nMaxRemainingJobs]
               { return nPendingJobs <= nMaxRemainingJobs; });
+    m_nCompletionWaiters--;
 }
 
 /************************************************************************/
@@ -348,11 +326,14 @@ void CPLWorkerThreadPool::WaitEvent()
     // a notification occurs, jobs could be submitted which would increase
     // nPendingJobs, so a job completion may looks like a spurious wakeup.
     std::unique_lock<std::mutex> oGuard(m_mutex);
-    if (nPendingJobs == 0)
-        return;
+    m_nCompletionWaiters++;
     const int nPendingJobsBefore = nPendingJobs;
-    m_cv.wait(oGuard, [this, nPendingJobsBefore]
-              { return nPendingJobs < nPendingJobsBefore; });
+    if (nPendingJobsBefore > 0)
+    {
+        m_cv.wait(oGuard, [this, nPendingJobsBefore]
+                  { return nPendingJobs < nPendingJobsBefore; });
+    }
+    m_nCompletionWaiters--;
 }
 
 /************************************************************************/
@@ -399,10 +380,13 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
     bool bRet = true;
     for (int i = static_cast<int>(aWT.size()); i < nThreads; i++)
     {
+        // Worker threads iterate over aWT under m_mutex when stealing jobs.
+        std::lock_guard<std::mutex> oGuard(m_mutex);
         auto wt = std::make_unique<CPLWorkerThread>();
         wt->pfnInitFunc = pfnInitFunc;
         wt->pInitData = pasInitData ? pasInitData[i] : nullptr;
         wt->poTP = this;
+        wt->nIndex = static_cast<int>(aWT.size());
         wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
         if (wt->hThread == nullptr)
         {
@@ -441,9 +425,129 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
 
 void CPLWorkerThreadPool::DeclareJobFinished()
 {
-    std::lock_guard<std::mutex> oGuard(m_mutex);
     nPendingJobs--;
-    m_cv.notify_one();
+    // Only take the mutex if a thread might be waiting for that event
+    if (m_nCompletionWaiters > 0)
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_cv.notify_all();
+    }
+}
+
+/************************************************************************/
+/*                     StartWorkerThreadIfNeeded()                      */
+/************************************************************************/
+
+// Must be called with m_mutex held.
+// Returns false if a thread should have been started but this failed.
+bool CPLWorkerThreadPool::StartWorkerThreadIfNeeded()
+{
+    if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+    {
+        // CPLDebug("CPL", "Starting new thread...");
+        auto wt = std::make_unique<CPLWorkerThread>();
+        wt->poTP = this;
+        wt->nIndex = static_cast<int>(aWT.size());
+        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
+        if (!wt->hThread)
+            return false;
+        aWT.emplace_back(std::move(wt));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       PopWaitingWorkerThread()                       */
+/************************************************************************/
+
+// Must be called with m_mutex held.
+// Returns a worker thread waiting for a job (that must then be woken up by
+// the caller), or nullptr.
+CPLWorkerThread *CPLWorkerThreadPool::PopWaitingWorkerThread()
+{
+    if (!psWaitingWorkerThreadsList)
+        return nullptr;
+
+    CPLWorkerThread *psWorkerThread =
+        static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
+
+    CPLAssert(psWorkerThread->bMarkedAsWaiting);
+    psWorkerThread->bMarkedAsWaiting = false;
+
+    CPLList *psNext = psWaitingWorkerThreadsList->psNext;
+    CPLList *psToFree = psWaitingWorkerThreadsList;
+    psWaitingWorkerThreadsList = psNext;
+    nWaitingWorkerThreads--;
+    CPLFree(psToFree);
+
+    return psWorkerThread;
+}
+
+/************************************************************************/
+/*                              PushJob()                               */
+/************************************************************************/
+
+// Must be called with m_mutex held, so that a worker thread cannot go to
+// sleep between the time it has checked m_nQueuedJobs and the time the job
+// is queued.
+void CPLWorkerThreadPool::PushJob(CPLWorkerThread *psWorkerThread,
+                                  std::function<void()> task)
+{
+    std::lock_guard<std::mutex> oGuard(psWorkerThread->m_mutexJobs);
+    psWorkerThread->m_jobs.emplace_back(std::move(task));
+
+    const int nQueuedJobs = ++m_nQueuedJobs;
+    int nMaxQueuedJobs = m_nMaxQueuedJobs.load();
+    while (nQueuedJobs > nMaxQueuedJobs &&
+           !m_nMaxQueuedJobs.compare_exchange_weak(nMaxQueuedJobs,
+                                                   nQueuedJobs))
+    {
+    }
+}
+
+/************************************************************************/
+/*                              PopJob()                                */
+/************************************************************************/
+
+bool CPLWorkerThreadPool::PopJob(CPLWorkerThread *psWorkerThread,
+                                 std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> oGuard(psWorkerThread->m_mutexJobs);
+    if (psWorkerThread->m_jobs.empty())
+        return false;
+    task = std::move(psWorkerThread->m_jobs.front());
+    psWorkerThread->m_jobs.pop_front();
+    --m_nQueuedJobs;
+    return true;
+}
+
+/************************************************************************/
+/*                             StealJob()                               */
+/************************************************************************/
+
+// Must be called with m_mutex held, as it iterates over aWT.
+bool CPLWorkerThreadPool::StealJob(CPLWorkerThread *psWorkerThread,
+                                   std::function<void()> &task)
+{
+    const size_t nWorkerThreads = aWT.size();
+    for (size_t i = 0; i < nWorkerThreads; ++i)
+    {
+        CPLWorkerThread *psVictim =
+            aWT[(psWorkerThread->nIndex + 1 + i) % nWorkerThreads].get();
+        if (PopJob(psVictim, task))
+        {
+            if (psVictim != psWorkerThread)
+            {
+#if DEBUG_VERBOSE
+                CPLDebug("JOB", "%p stole a job from %p", psWorkerThread,
+                         psVictim);
+#endif
+                m_nSteals++;
+            }
+            return true;
+        }
+    }
+    return false;
 }
 
 /************************************************************************/
@@ -455,20 +559,34 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
 {
     while (true)
     {
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        if (eState == CPLWTS_STOP)
-            return std::function<void()>();
+        std::function<void()> task;
 
-        if (jobQueue.size())
+        // Fast path: no need to take the pool mutex to dequeue a job from
+        // our own queue.
+        if (PopJob(psWorkerThread, task))
         {
 #if DEBUG_VERBOSE
             CPLDebug("JOB", "%p got a job", psWorkerThread);
 #endif
-            auto task = std::move(jobQueue.front());
-            jobQueue.pop();
             return task;
         }
 
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        if (eState == CPLWTS_STOP)
+            return std::function<void()>();
+
+        if (m_nQueuedJobs > 0)
+        {
+            if (StealJob(psWorkerThread, task))
+                return task;
+
+            // The job(s) we have seen have been taken in the meantime by
+            // another worker thread. Retry.
+            oGuard.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+
         if (!psWorkerThread->bMarkedAsWaiting)
         {
             psWorkerThread->bMarkedAsWaiting = true;
@@ -503,8 +621,12 @@ CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
         std::unique_lock<std::mutex> oGuardThisThread(psWorkerThread->m_mutex);
         // coverity[uninit_use_in_call]
         oGuard.unlock();
+        const auto start = std::chrono::steady_clock::now();
         // coverity[wait_not_in_locked_loop]
         psWorkerThread->m_cv.wait(oGuardThisThread);
+        m_nIdleTimeNS += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
     }
 }
 
@@ -16,11 +16,12 @@
 #include "cpl_multiproc.h"
 #include "cpl_list.h"
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 /**
@@ -43,9 +44,15 @@ struct CPLWorkerThread
     CPLWorkerThreadPool *poTP = nullptr;
     CPLJoinableThread *hThread = nullptr;
     bool bMarkedAsWaiting = false;
+    int nIndex = 0;
 
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
+
+    // Jobs queued on this worker. Protected by m_mutexJobs. Other worker
+    // threads may steal jobs from it when their own queue is empty.
+    std::mutex m_mutexJobs{};
+    std::deque<std::function<void()>> m_jobs{};
 };
 
 typedef enum
@@ -60,6 +67,25 @@ class CPLJobQueue;
 /// Unique pointer to a job queue.
 using CPLJobQueuePtr = std::unique_ptr<CPLJobQueue>;
 
+/** Statistics of a CPLWorkerThreadPool, as returned by
+ * CPLWorkerThreadPool::GetStatistics().
+ *
+ * @since GDAL 3.11
+ */
+struct CPLWorkerThreadPoolStatistics
+{
+    /** Number of jobs submitted and not yet started */
+    int nQueueDepth = 0;
+    /** Maximum number of jobs that have been simultaneously queued */
+    int nMaxQueueDepth = 0;
+    /** Number of jobs that have been run by worker threads */
+    GUIntBig nJobsExecuted = 0;
+    /** Number of jobs a worker thread took from the queue of another one */
+    GUIntBig nSteals = 0;
+    /** Cumulated time, in seconds, spent by worker threads waiting for jobs */
+    double dfIdleTime = 0;
+};
+
 /** Pool of worker threads */
 class CPL_DLL CPLWorkerThreadPool
 {
@@ -69,18 +95,34 @@ class CPL_DLL CPLWorkerThreadPool
     mutable std::mutex m_mutex{};
     std::condition_variable m_cv{};
     volatile CPLWorkerThreadState eState = CPLWTS_OK;
-    std::queue<std::function<void()>> jobQueue;
-    int nPendingJobs = 0;
+    std::atomic<int> nPendingJobs{0};
+    std::atomic<int> m_nCompletionWaiters{0};
 
     CPLList *psWaitingWorkerThreadsList = nullptr;
     int nWaitingWorkerThreads = 0;
 
     int m_nMaxThreads = 0;
 
+    // Round-robin index of the next worker thread queue to which to
+    // dispatch a job submitted from outside the pool. Protected by m_mutex.
+    size_t m_nNextWorkerThread = 0;
+
+    std::atomic<int> m_nQueuedJobs{0};
+    std::atomic<int> m_nMaxQueuedJobs{0};
+    std::atomic<GUIntBig> m_nJobsExecuted{0};
+    std::atomic<GUIntBig> m_nSteals{0};
+    std::atomic<GIntBig> m_nIdleTimeNS{0};
+
     static void WorkerThreadFunction(void *user_data);
 
     void DeclareJobFinished();
     std::function<void()> GetNextJob(CPLWorkerThread *psWorkerThread);
+    void PushJob(CPLWorkerThread *psWorkerThread, std::function<void()> task);
+    bool PopJob(CPLWorkerThread *psWorkerThread, std::function<void()> &task);
+    bool StealJob(CPLWorkerThread *psWorkerThread,
+                  std::function<void()> &task);
+    CPLWorkerThread *PopWaitingWorkerThread();
+    bool StartWorkerThreadIfNeeded();
 
   public:
     CPLWorkerThreadPool();
@@ -101,6 +143,8 @@ class CPL_DLL CPLWorkerThreadPool
 
     /** Return the number of threads setup */
     int GetThreadCount() const;
+
+    CPLWorkerThreadPoolStatistics GetStatistics() const;
 };
 
 /** Job queue */
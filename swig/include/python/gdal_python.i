@@ -3495,7 +3495,7 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
               zFactor=None, scale=None, azimuth=None, altitude=None,
               combined=False, multiDirectional=False, igor=False,
               slopeFormat=None, trigonometric=False, zeroForFlat=False,
-              addAlpha=None, colorSelection=None,
+              addAlpha=None, colorSelection=None, numThreads=None,
               callback=None, callback_data=None):
     """Create a DEMProcessingOptions() object that can be passed to gdal.DEMProcessing()
 
@@ -3539,6 +3539,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
         adds an alpha band to the output file (only for processing = 'color-relief')
     colorSelection:
         (color-relief only) Determines how color entries are selected from an input value. Can be "nearest_color_entry", "exact_color_entry" or "linear_interpolation". Defaults to "linear_interpolation"
+    numThreads:
+        number of threads to use, or "ALL_CPUS". Defaults to the value of the GDAL_NUM_THREADS configuration option.
     callback:
         callback method
     callback_data:
@@ -3596,6 +3598,8 @@ def DEMProcessingOptions(options=None, colorFilename=None, format=None,
                 raise ValueError("Unsupported value for colorSelection")
         if addAlpha:
             new_options += ['-alpha']
+        if numThreads is not None:
+            new_options += ['-num_threads', str(numThreads)]
 
     if return_option_list:
         return new_options
@@ -3763,6 +3767,7 @@ def GridOptions(options=None, format=None,
               zfield=None,
               z_increase=None,
               z_multiply=None,
+              scatter=False,
               callback=None, callback_data=None):
     """ Create a GridOptions() object that can be passed to gdal.Grid()
 
@@ -3808,6 +3813,9 @@ def GridOptions(options=None, format=None,
         Multiplication ratio for Z field. This can be used for shift from e.g. foot to meters
         or from  elevation to deep. The result value will be
         (Z value + Z increase value) * Z multiply value. The default value is 1.
+    scatter:
+        whether to accumulate each point into the grid nodes it covers, reading
+        the points by batches (average, count, minimum, maximum and range only)
     callback:
         callback method
     callback_data:
@@ -3858,6 +3866,8 @@ def GridOptions(options=None, format=None,
             new_options += ['-z_multiply', str(z_multiply)]
         if spatFilter is not None:
             new_options += ['-spat', str(spatFilter[0]), str(spatFilter[1]), str(spatFilter[2]), str(spatFilter[3])]
+        if scatter:
+            new_options += ['-scatter']
 
     if return_option_list:
         return new_options
@@ -215,7 +215,7 @@ class GDALFillNoData(GDALScript):
             "-interp",
             "--interpolation",
             dest="interpolation",
-            choices=["inv_dist", "nearest"],
+            choices=["inv_dist", "nearest", "pyramid"],
             help="Interpolation method.",
         )
 
@@ -31,7 +31,8 @@ Usage: gdal_proximity [--help] [--help-general]
                   [-ot {Byte|UInt16|UInt32|Float32|etc}]
                   [-values <n>,<n>,<n>] [-distunits {PIXEL|GEO}]
                   [-maxdist <n>] [-nodata <n>] [-use_input_nodata {YES|NO}]
-                  [-fixed-buf-val <n>] [-q] """,
+                  [-fixed-buf-val <n>] [-algorithm {SCANLINE|EXACT}]
+                  [-num_threads <n>|ALL_CPUS] [-q] """,
         file=f,
     )
     return 2 if isError else 0
@@ -98,6 +99,14 @@ def main(argv=sys.argv):
             i = i + 1
             alg_options.append("FIXED_BUF_VAL=" + argv[i])
 
+        elif arg == "-algorithm":
+            i = i + 1
+            alg_options.append("ALGORITHM=" + argv[i])
+
+        elif arg == "-num_threads":
+            i = i + 1
+            alg_options.append("NUM_THREADS=" + argv[i])
+
         elif arg == "-srcband":
             i = i + 1
             src_band_n = int(argv[i])